@@ -0,0 +1,40 @@
+#include "stm32f3xx_hal.h"
+#include "driverHWBoot.h"
+#include "middleBootControl.h"
+
+// Picks the slot to boot from the boot control journal and jumps into it. Downloads, BOOT state and FoE are
+// handled by the running application, which always writes the slot it is not running from; this only has to start
+// the right image, give a new one its trial and roll back when that image never confirmed. It runs on the reset
+// clock and touches nothing but flash and the watchdog, so the image starts from a core it can configure freely.
+
+#define bootloaderNoImageBlink							250																	// ms
+#define bootloaderDebugLEDPort							GPIOB																// Same LED as STAT_LED_DEBUG
+#define bootloaderDebugLEDPin								GPIO_PIN_15
+
+int main(void) {
+	bool trial;
+	uint32_t image;
+
+	HAL_Init();																																				// SysTick for the flash timeouts
+
+	image = middleBootControlSelect(&trial);
+	if(image) {
+		if(trial)
+			driverHWBootWatchdogStart(middleBootControlTrialWatchdog);
+		driverHWBootJump(image);
+	}
+
+	// Neither slot holds an image, only a debugger can help now. Blink the debug LED so it is obvious
+	__HAL_RCC_GPIOB_CLK_ENABLE();
+	GPIO_InitTypeDef gpioInit = {bootloaderDebugLEDPin, GPIO_MODE_OUTPUT_PP, GPIO_NOPULL, GPIO_SPEED_FREQ_LOW, 0};
+	HAL_GPIO_Init(bootloaderDebugLEDPort,&gpioInit);
+
+	while(true) {
+		HAL_GPIO_TogglePin(bootloaderDebugLEDPort,bootloaderDebugLEDPin);
+		HAL_Delay(bootloaderNoImageBlink);
+	}
+}
+
+void SysTick_Handler(void) {
+	HAL_IncTick();
+}
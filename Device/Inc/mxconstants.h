@@ -71,6 +71,19 @@
 #define I2C1_INT_GPIO_Port GPIOB
 /* USER CODE BEGIN Private defines */
 
+/* Interrupt priority plan, NVIC_PRIORITYGROUP_4 so 0 (highest) to 15 preemption levels. Faults stay at 0.
+ * SYNC0 shares EXTI15_10 with the ESC IRQ, so the ESC IRQ runs at the sync level. Handlers at the sync
+ * level must not touch the ESC, they only timestamp and release tasks. Everything that does access the
+ * ESC from an ISR has to live at IRQ_PRIORITY_PDI or below, PDI_Disable_Global_Interrupt masks exactly that. The lock
+ * is let go while a PDI access backs off from a busy ESC, an ISR access in that window fails with PDI_TIMEOUT. */
+#define IRQ_PRIORITY_SYNC						1																		// EXTI15_10 (SYNC0 + ESC IRQ), EXTI0 (SYNC1)
+#define IRQ_PRIORITY_PDI						2																		// ESC access lock level
+#define IRQ_PRIORITY_DMA						3																		// I2C3 transfers, SPI DMA completion
+#define IRQ_PRIORITY_TICK						4																		// TIM2 compare/wakeup, SysTick
+#define IRQ_PRIORITY_HOUSEKEEPING		6																		// USB
+#define IRQ_PRIORITY_KERNEL					15																	// SVCall, PendSV, DebugMonitor
+#define IRQ_PRIORITY_TO_BASEPRI(x)	((x) << (8 - __NVIC_PRIO_BITS))
+
 /* USER CODE END Private defines */
 
 /**
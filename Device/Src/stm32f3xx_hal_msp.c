@@ -60,13 +60,13 @@ void HAL_MspInit(void)
   /* UsageFault_IRQn interrupt configuration */
   HAL_NVIC_SetPriority(UsageFault_IRQn, 0, 0);
   /* SVCall_IRQn interrupt configuration */
-  HAL_NVIC_SetPriority(SVCall_IRQn, 0, 0);
+  HAL_NVIC_SetPriority(SVCall_IRQn, IRQ_PRIORITY_KERNEL, 0);
   /* DebugMonitor_IRQn interrupt configuration */
-  HAL_NVIC_SetPriority(DebugMonitor_IRQn, 0, 0);
+  HAL_NVIC_SetPriority(DebugMonitor_IRQn, IRQ_PRIORITY_KERNEL, 0);
   /* PendSV_IRQn interrupt configuration */
-  HAL_NVIC_SetPriority(PendSV_IRQn, 0, 0);
+  HAL_NVIC_SetPriority(PendSV_IRQn, IRQ_PRIORITY_KERNEL, 0);
   /* SysTick_IRQn interrupt configuration */
-  HAL_NVIC_SetPriority(SysTick_IRQn, 0, 0);
+  HAL_NVIC_SetPriority(SysTick_IRQn, IRQ_PRIORITY_TICK, 0);
 
   /* USER CODE BEGIN MspInit 1 */
 
@@ -182,6 +182,10 @@ void HAL_I2C_MspInit(I2C_HandleTypeDef* hi2c)
     /* Peripheral clock enable */
     __HAL_RCC_I2C3_CLK_ENABLE();
   /* USER CODE BEGIN I2C3_MspInit 1 */
+    HAL_NVIC_SetPriority(I2C3_EV_IRQn, IRQ_PRIORITY_DMA, 0);						// Nunchuck transfers run on interrupts, see the plan in mxconstants.h
+    HAL_NVIC_EnableIRQ(I2C3_EV_IRQn);
+    HAL_NVIC_SetPriority(I2C3_ER_IRQn, IRQ_PRIORITY_DMA, 0);
+    HAL_NVIC_EnableIRQ(I2C3_ER_IRQn);
 
   /* USER CODE END I2C3_MspInit 1 */
   }
@@ -226,7 +230,8 @@ void HAL_I2C_MspDeInit(I2C_HandleTypeDef* hi2c)
     HAL_GPIO_DeInit(GPIOA, GPIO_PIN_8);
 
   /* USER CODE BEGIN I2C3_MspDeInit 1 */
-
+    HAL_NVIC_DisableIRQ(I2C3_EV_IRQn);
+    HAL_NVIC_DisableIRQ(I2C3_ER_IRQn);
   /* USER CODE END I2C3_MspDeInit 1 */
   }
 
@@ -342,7 +347,7 @@ void HAL_TIM_Base_MspInit(TIM_HandleTypeDef* htim_base)
     /* Peripheral clock enable */
     __HAL_RCC_TIM2_CLK_ENABLE();
     /* Peripheral interrupt init */
-    HAL_NVIC_SetPriority(TIM2_IRQn, 0, 0);
+    HAL_NVIC_SetPriority(TIM2_IRQn, IRQ_PRIORITY_TICK, 0);
     HAL_NVIC_EnableIRQ(TIM2_IRQn);
   /* USER CODE BEGIN TIM2_MspInit 1 */
 
@@ -117,6 +117,8 @@
 /* #define VECT_TAB_SRAM */
 #define VECT_TAB_OFFSET  0x0 /*!< Vector Table base offset field.
                                   This value must be a multiple of 0x200. */
+extern uint32_t __Vectors[];    /*!< From the startup file, the image runs from the bootloader or one of the
+                                  application slots and relocates to its own table. */
 /**
   * @}
   */
@@ -202,7 +204,7 @@ void SystemInit(void)
 #ifdef VECT_TAB_SRAM
   SCB->VTOR = SRAM_BASE | VECT_TAB_OFFSET; /* Vector Table Relocation in Internal SRAM */
 #else
-  SCB->VTOR = FLASH_BASE | VECT_TAB_OFFSET; /* Vector Table Relocation in Internal FLASH */
+  SCB->VTOR = (uint32_t)(uintptr_t)__Vectors; /* Vector Table Relocation in Internal FLASH, wherever this image is linked */
 #endif
 }
 
@@ -0,0 +1,14 @@
+#include "stm32f3xx_hal.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#define driverHWBootRAMStart								0x20000000							// Initial stack pointers of a valid image point in here
+#define driverHWBootRAMEnd									0x20010000
+
+// Core side of booting an image from a flash slot: the independent watchdog that catches a new image hanging,
+// the vector table of the running image, reset and the jump from the bootloader into an image.
+void driverHWBootWatchdogStart(uint32_t milliseconds);
+void driverHWBootWatchdogKick(void);
+uint32_t driverHWBootRunningImage(void);
+void driverHWBootReset(void);
+void driverHWBootJump(uint32_t image);
@@ -2,8 +2,19 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#define driverHWECATTickTimerPrescaler							143							// TIM2 runs from PLLx2 (144MHz), 1MHz into counter
+#define driverHWECATTickTimerDefaultTickPeriod			100							// Compare callback period in us when a tick function is bound
+
 bool driverHWECATTickTimerInit(void);
 void driverHWECATTickTimerBindTickFunction(void(*callback)(void));
+void driverHWECATTickTimerSetTickPeriod(uint32_t periodMicroseconds);
 void driverHWECATTickTimerReset(void);
 void driverHWECATTickTimerInterruptEnable(bool newState);
+void driverHWECATTickTimerSetWakeup(uint32_t delayMicroseconds);
+void driverHWECATTickTimerCancelWakeup(void);
+void driverHWECATTickTimerBindAlarmFunction(void(*callback)(void));
+void driverHWECATTickTimerSetAlarmAt(uint32_t compare);
+void driverHWECATTickTimerCancelAlarm(void);
 uint32_t driverHWECATTickTimerGetTimerValue(void);
+uint32_t driverHWECATTickTimerGetWorstLatency(void);
+void driverHWECATTickTimerResetWorstLatency(void);
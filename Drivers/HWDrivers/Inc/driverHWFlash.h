@@ -0,0 +1,14 @@
+#include "stm32f3xx_hal.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#define driverHWFlashBase										0x08000000							// STM32F303RE, one bank of 512kB
+#define driverHWFlashSize										0x00080000
+#define driverHWFlashPageSize								0x800										// Erase unit, bytes
+#define driverHWFlashErasedHalfWord					0xFFFF
+
+// Erase and program stall the core until the flash is done (~20ms per page, ~50us per half word), code runs from
+// the same bank. Addresses are absolute, programming takes whole half words.
+bool driverHWFlashErasePage(uint32_t address);
+bool driverHWFlashProgram(uint32_t address, const uint8_t *data, uint32_t length);
+const uint8_t *driverHWFlashRead(uint32_t address);
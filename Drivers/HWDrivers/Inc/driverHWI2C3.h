@@ -1,9 +1,20 @@
 #include "stm32f3xx_hal.h"
 #include "stdbool.h"
 #include "stdlib.h"
+#include "modTrace.h"
 
 #define driverHWI2C3DefaultTimout										100
 
+typedef enum {
+	I2C3_IDLE = 0,																													// Last transfer acknowledged, or none yet
+	I2C3_BUSY,																															// Started, the interrupts are still moving it
+	I2C3_ERROR																															// NACK, arbitration or bus error, traced
+} driverHWI2C3StatusTypedef;
+
 void driverHWI2C3Init(void);
 bool driverHWI2C3ReadWrite(uint16_t DevAddress, bool readWrite, uint8_t *pData, uint16_t Size);
 bool driverHWI2C3Read(uint16_t DevAddress, uint8_t *pData, uint16_t Size);
+bool driverHWI2C3WriteStart(uint16_t DevAddress, uint8_t *pData, uint16_t Size);
+bool driverHWI2C3ReadStart(uint16_t DevAddress, uint8_t *pData, uint16_t Size);
+driverHWI2C3StatusTypedef driverHWI2C3GetStatus(void);
+void driverHWI2C3Recover(void);
@@ -9,3 +9,4 @@ void driverHWLANInterruptSYNC1BindFunction(void(*callback)(void));
 void driverHWLANInterruptDisableAll(void);
 void driverHWLANInterruptEnableAll(void);
 void driverHWLANInterruptEnable(uint16_t GPIO_Pin,bool newState);
+uint32_t driverHWLANInterruptGetWorstHandlerTime(void);
@@ -33,17 +33,26 @@ typedef enum
 	STAT_BLINKSHORT,
 	STAT_BLINKLONG,	
 	STAT_ON,
-	STAT_OFF
+	STAT_OFF,
+	STAT_FLICKER,																										// ETG.1300 indicator patterns
+	STAT_BLINKING,
+	STAT_SINGLE_FLASH,
+	STAT_DOUBLE_FLASH
 } STATStateTypedef;
 
 typedef struct {
 	STATStateTypedef 	State;
 	uint32_t					Count;
+	STATStateTypedef	Output;																				// Level currently on the pin
+	uint32_t					NextEdge;																			// us timestamp of the next due edge
+	bool							EdgePending;
+	uint8_t						Phase;																				// Step within a multi step pattern
 } STATStatusStruct;
 
 
 // Public functions
 void driverHWStatusInit(void);
 void driverHWSetOutput(STATIDTypedef LEDType,STATStateTypedef State);
+void driverHWSetOutputs(uint32_t setMask, uint32_t resetMask);
 
 #endif
@@ -99,6 +99,7 @@ extern USBD_CDC_ItfTypeDef  USBD_Interface_fops_FS;
 uint8_t CDC_Transmit_FS(uint8_t* Buf, uint16_t Len);
 
 /* USER CODE BEGIN EXPORTED_FUNCTIONS */
+void CDC_ReceiveEvent_FS(void (*eventFunctionPointer)(uint8_t *data, uint32_t length));
 /* USER CODE END EXPORTED_FUNCTIONS */
 /**
   * @}
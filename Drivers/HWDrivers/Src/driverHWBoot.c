@@ -0,0 +1,52 @@
+#include "driverHWBoot.h"
+
+#define driverHWBootWatchdogPrescaler				IWDG_PR_PR_2										// LSI/64, ~1.6ms per count at 40kHz
+#define driverHWBootWatchdogCountsPerSecond	625
+#define driverHWBootWatchdogMaxReload				0x0FFF
+
+// Once started the IWDG only stops with a reset, from then on the image has to kick it.
+void driverHWBootWatchdogStart(uint32_t milliseconds) {
+	uint32_t reload = (milliseconds*driverHWBootWatchdogCountsPerSecond)/1000;
+
+	if(reload > driverHWBootWatchdogMaxReload)
+		reload = driverHWBootWatchdogMaxReload;
+
+	IWDG->KR = 0xCCCC;																															// Start, this also turns the LSI on
+	IWDG->KR = 0x5555;																															// Unlock PR and RLR
+	IWDG->PR = driverHWBootWatchdogPrescaler;
+	IWDG->RLR = reload;
+	while(IWDG->SR);																																// Both written into the LSI domain
+	IWDG->KR = 0xAAAA;
+}
+
+// Harmless while the watchdog is not running.
+void driverHWBootWatchdogKick(void) {
+	IWDG->KR = 0xAAAA;
+}
+
+uint32_t driverHWBootRunningImage(void) {
+	return SCB->VTOR;																																// Every image points it at its own vector table
+}
+
+void driverHWBootReset(void) {
+	NVIC_SystemReset();
+}
+
+// Leaves the core as it comes out of reset as far as the image can tell: no interrupts pending or enabled, SysTick
+// off, stack and vector table of the image. The bootloader never leaves the reset clock, so RCC needs no undoing.
+void driverHWBootJump(uint32_t image) {
+	const uint32_t *vectors = (const uint32_t *)(uintptr_t)image;
+
+	__disable_irq();
+	SysTick->CTRL = 0;
+	SysTick->VAL = 0;
+	for(uint8_t n = 0; n < sizeof(NVIC->ICER)/sizeof(NVIC->ICER[0]); n++) {
+		NVIC->ICER[n] = 0xFFFFFFFF;
+		NVIC->ICPR[n] = 0xFFFFFFFF;
+	}
+
+	SCB->VTOR = image;
+	__set_MSP(vectors[0]);
+	__enable_irq();
+	((void (*)(void))(uintptr_t)vectors[1])();
+}
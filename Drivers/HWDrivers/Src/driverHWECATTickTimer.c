@@ -1,25 +1,37 @@
 #include "driverHWECATTickTimer.h"
 
 void (*driverHWECATTickTimercallBackTickFunction)(void);
+void (*driverHWECATTickTimercallBackAlarmFunction)(void);
 
 TIM_HandleTypeDef driverHWECATTickTimerTIM2;
-uint32_t driverHWECATTick;
+uint32_t driverHWECATTickTimerTickPeriod;
 bool driverHWECATTickTimerInterruptActive;
+bool driverHWECATTickTimerInitialized = false;
+uint32_t driverHWECATTickTimerWorstLatency = 0;
+
+static void driverHWECATTickTimerMeasureLatency(uint32_t compare);
+
+static void driverHWECATTickTimerUpdateCompare(void);
 
 bool driverHWECATTickTimerInit(void) {
+	if(driverHWECATTickTimerInitialized)
+		return false;
+
   TIM_ClockConfigTypeDef sClockSourceConfig;
   TIM_MasterConfigTypeDef sMasterConfig;
 
+	driverHWECATTickTimercallBackTickFunction = 0;														// Point callback to nothing
+	driverHWECATTickTimercallBackAlarmFunction = 0;
+	driverHWECATTickTimerInterruptActive = false;
+	driverHWECATTickTimerTickPeriod = driverHWECATTickTimerDefaultTickPeriod;
+
   driverHWECATTickTimerTIM2.Instance = TIM2;
-  driverHWECATTickTimerTIM2.Init.Prescaler = 71; 														// 1MHz into counter.
+  driverHWECATTickTimerTIM2.Init.Prescaler = driverHWECATTickTimerPrescaler; 	// 1MHz into counter.
   driverHWECATTickTimerTIM2.Init.CounterMode = TIM_COUNTERMODE_UP;
-  driverHWECATTickTimerTIM2.Init.Period = 199; 															// 10kHz ISR calls.
-  driverHWECATTickTimerTIM2.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1; 		// clock devision doesn't work?
-  if (HAL_TIM_Base_Init(&driverHWECATTickTimerTIM2) != HAL_OK) 							// <-- Global interrupt enable is in here
+  driverHWECATTickTimerTIM2.Init.Period = 0xFFFFFFFF; 												// Free running over the full 32 bit range, no update ISR.
+  driverHWECATTickTimerTIM2.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+  if (HAL_TIM_Base_Init(&driverHWECATTickTimerTIM2) != HAL_OK)
     while(true);
-	
-  if (HAL_TIM_Base_Start_IT(&driverHWECATTickTimerTIM2) != HAL_OK) 					// <-- Start the timer
-    while(true);	
 
   sClockSourceConfig.ClockSource = TIM_CLOCKSOURCE_INTERNAL;
   if (HAL_TIM_ConfigClockSource(&driverHWECATTickTimerTIM2, &sClockSourceConfig) != HAL_OK)
@@ -29,43 +41,142 @@ bool driverHWECATTickTimerInit(void) {
   sMasterConfig.MasterSlaveMode = TIM_MASTERSLAVEMODE_DISABLE;
   if (HAL_TIMEx_MasterConfigSynchronization(&driverHWECATTickTimerTIM2, &sMasterConfig) != HAL_OK)
     while(true);
-	
+
+  if (HAL_TIM_Base_Start(&driverHWECATTickTimerTIM2) != HAL_OK) 							// <-- Start the timer, without interrupts
+    while(true);
+
 	driverHWECATTickTimerReset();
-	driverHWECATTickTimercallBackTickFunction = 0;														// Point callback to nothing
-	driverHWECATTickTimerInterruptActive = false;
-	
+	driverHWECATTickTimerInitialized = true;
+
 	return false;
 }
 
 void driverHWECATTickTimerBindTickFunction(void(*callback)(void)) {
 	driverHWECATTickTimercallBackTickFunction = callback;
+	driverHWECATTickTimerUpdateCompare();
+}
+
+void driverHWECATTickTimerSetTickPeriod(uint32_t periodMicroseconds) {
+	driverHWECATTickTimerTickPeriod = periodMicroseconds ? periodMicroseconds : 1;
+	driverHWECATTickTimerUpdateCompare();
 }
 
 void driverHWECATTickTimerReset(void) {
-	driverHWECATTick = 0;
+	if(!driverHWECATTickTimerTIM2.Instance)
+		return;
+
+	__HAL_TIM_SET_COUNTER(&driverHWECATTickTimerTIM2,0);
+	driverHWECATTickTimerUpdateCompare();																			// Re-arm relative to the new count
 }
 
 uint32_t driverHWECATTickTimerGetTimerValue (void) {
-	return driverHWECATTick; // <-- return timer value
+	if(!driverHWECATTickTimerTIM2.Instance)
+		return 0;
+
+	return driverHWECATTickTimerTIM2.Instance->CNT; 													// <-- return timer value in us
+}
+
+// One shot compare on channel 2, only used to wake the core from WFI. The flag is left to the caller, the ISR just disarms.
+void driverHWECATTickTimerSetWakeup(uint32_t delayMicroseconds) {
+	if(!driverHWECATTickTimerTIM2.Instance)
+		return;
+
+	__HAL_TIM_SET_COMPARE(&driverHWECATTickTimerTIM2,TIM_CHANNEL_2,driverHWECATTickTimerTIM2.Instance->CNT + delayMicroseconds);
+	__HAL_TIM_CLEAR_IT(&driverHWECATTickTimerTIM2,TIM_IT_CC2);
+	__HAL_TIM_ENABLE_IT(&driverHWECATTickTimerTIM2,TIM_IT_CC2);
+}
+
+void driverHWECATTickTimerCancelWakeup(void) {
+	if(!driverHWECATTickTimerTIM2.Instance)
+		return;
+
+	__HAL_TIM_DISABLE_IT(&driverHWECATTickTimerTIM2,TIM_IT_CC2);
+	__HAL_TIM_CLEAR_IT(&driverHWECATTickTimerTIM2,TIM_IT_CC2);
+}
+
+// One shot compare on channel 3 with a callback, lets a module sleep until its next deadline instead of polling. The
+// deadline is a counter value, so it is on the same clock as modDelayGetMicroseconds.
+void driverHWECATTickTimerBindAlarmFunction(void(*callback)(void)) {
+	driverHWECATTickTimercallBackAlarmFunction = callback;
+}
+
+void driverHWECATTickTimerSetAlarmAt(uint32_t compare) {
+	if(!driverHWECATTickTimerTIM2.Instance)
+		return;
+
+	__HAL_TIM_SET_COMPARE(&driverHWECATTickTimerTIM2,TIM_CHANNEL_3,compare);
+	__HAL_TIM_CLEAR_IT(&driverHWECATTickTimerTIM2,TIM_IT_CC3);
+	__HAL_TIM_ENABLE_IT(&driverHWECATTickTimerTIM2,TIM_IT_CC3);
+
+	if((int32_t)(compare - driverHWECATTickTimerTIM2.Instance->CNT) <= 0)
+		driverHWECATTickTimerTIM2.Instance->EGR = TIM_EGR_CC3G;						// Already passed, the match would only come after a wrap
+}
+
+void driverHWECATTickTimerCancelAlarm(void) {
+	if(!driverHWECATTickTimerTIM2.Instance)
+		return;
+
+	__HAL_TIM_DISABLE_IT(&driverHWECATTickTimerTIM2,TIM_IT_CC3);
+	__HAL_TIM_CLEAR_IT(&driverHWECATTickTimerTIM2,TIM_IT_CC3);
 }
 
 void driverHWECATTickTimerInterruptEnable(bool newState) {
 	driverHWECATTickTimerInterruptActive = newState;
+	driverHWECATTickTimerUpdateCompare();
 }
 
-void TIM2_IRQHandler(void) {
-  HAL_TIM_IRQHandler(&driverHWECATTickTimerTIM2);
+// The compare interrupt is only armed while a tick function is bound and enabled, otherwise TIM2 never interrupts.
+static void driverHWECATTickTimerUpdateCompare(void) {
+	if(!driverHWECATTickTimerTIM2.Instance)
+		return;
+
+	if(driverHWECATTickTimercallBackTickFunction && driverHWECATTickTimerInterruptActive) {
+		if(!__HAL_TIM_GET_IT_SOURCE(&driverHWECATTickTimerTIM2,TIM_IT_CC1)) {
+			__HAL_TIM_SET_COMPARE(&driverHWECATTickTimerTIM2,TIM_CHANNEL_1,driverHWECATTickTimerTIM2.Instance->CNT + driverHWECATTickTimerTickPeriod);
+			__HAL_TIM_CLEAR_IT(&driverHWECATTickTimerTIM2,TIM_IT_CC1);
+			__HAL_TIM_ENABLE_IT(&driverHWECATTickTimerTIM2,TIM_IT_CC1);
+		}
+	}else{
+		__HAL_TIM_DISABLE_IT(&driverHWECATTickTimerTIM2,TIM_IT_CC1);
+		__HAL_TIM_CLEAR_IT(&driverHWECATTickTimerTIM2,TIM_IT_CC1);
+	}
 }
 
-void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim) {
-	// Check soures of Interrupt
-	if(driverHWECATTickTimerInterruptActive){		
-		if(driverHWECATTickTimercallBackTickFunction && driverHWECATTickTimerInterruptActive)
+void TIM2_IRQHandler(void) {
+	if(__HAL_TIM_GET_FLAG(&driverHWECATTickTimerTIM2,TIM_FLAG_CC1) && __HAL_TIM_GET_IT_SOURCE(&driverHWECATTickTimerTIM2,TIM_IT_CC1)) {
+		__HAL_TIM_CLEAR_IT(&driverHWECATTickTimerTIM2,TIM_IT_CC1);
+		driverHWECATTickTimerMeasureLatency(driverHWECATTickTimerTIM2.Instance->CCR1);
+		driverHWECATTickTimerTIM2.Instance->CCR1 += driverHWECATTickTimerTickPeriod;	// Next compare, phase locked to the free running count
+
+		if(driverHWECATTickTimercallBackTickFunction)
 			driverHWECATTickTimercallBackTickFunction();
 	}
-	
-	driverHWECATTick++;
+
+	if(__HAL_TIM_GET_FLAG(&driverHWECATTickTimerTIM2,TIM_FLAG_CC2) && __HAL_TIM_GET_IT_SOURCE(&driverHWECATTickTimerTIM2,TIM_IT_CC2)) {
+		driverHWECATTickTimerMeasureLatency(driverHWECATTickTimerTIM2.Instance->CCR2);
+		driverHWECATTickTimerCancelWakeup();																		// Wakeup is one shot, leaving the ISR is all that is needed
+	}
+
+	if(__HAL_TIM_GET_FLAG(&driverHWECATTickTimerTIM2,TIM_FLAG_CC3) && __HAL_TIM_GET_IT_SOURCE(&driverHWECATTickTimerTIM2,TIM_IT_CC3)) {
+		driverHWECATTickTimerMeasureLatency(driverHWECATTickTimerTIM2.Instance->CCR3);
+		driverHWECATTickTimerCancelAlarm();																			// One shot, the callback re-arms when it needs to
+
+		if(driverHWECATTickTimercallBackAlarmFunction)
+			driverHWECATTickTimercallBackAlarmFunction();
+	}
 }
-	
 
+uint32_t driverHWECATTickTimerGetWorstLatency(void) {
+	return driverHWECATTickTimerWorstLatency;
+}
 
+void driverHWECATTickTimerResetWorstLatency(void) {
+	driverHWECATTickTimerWorstLatency = 0;
+}
+
+// The compare match time is known exactly, so count minus compare is the entry latency of the tick level in us.
+static void driverHWECATTickTimerMeasureLatency(uint32_t compare) {
+	uint32_t latency = driverHWECATTickTimerTIM2.Instance->CNT - compare;
+	if(latency > driverHWECATTickTimerWorstLatency)
+		driverHWECATTickTimerWorstLatency = latency;
+}
@@ -0,0 +1,41 @@
+#include "driverHWFlash.h"
+
+bool driverHWFlashErasePage(uint32_t address) {
+	FLASH_EraseInitTypeDef eraseInit;
+	uint32_t pageError = 0;
+	HAL_StatusTypeDef halReturnStatus;
+
+	if((address < driverHWFlashBase) || (address >= driverHWFlashBase + driverHWFlashSize) || (address % driverHWFlashPageSize))
+		return false;
+
+	eraseInit.TypeErase = FLASH_TYPEERASE_PAGES;
+	eraseInit.PageAddress = address;
+	eraseInit.NbPages = 1;
+
+	HAL_FLASH_Unlock();
+	halReturnStatus = HAL_FLASHEx_Erase(&eraseInit,&pageError);
+	HAL_FLASH_Lock();
+
+	return (halReturnStatus == HAL_OK);
+}
+
+bool driverHWFlashProgram(uint32_t address, const uint8_t *data, uint32_t length) {
+	HAL_StatusTypeDef halReturnStatus = HAL_OK;
+
+	if((address % 2) || (length % 2) || (address < driverHWFlashBase) || (address + length > driverHWFlashBase + driverHWFlashSize))
+		return false;
+
+	HAL_FLASH_Unlock();
+	for(uint32_t offset = 0; (offset < length) && (halReturnStatus == HAL_OK); offset += 2) {
+		uint16_t halfWord = data[offset] | (data[offset + 1] << 8);
+		if(halfWord != driverHWFlashErasedHalfWord)																		// Already there after the erase, saves ~50us each
+			halReturnStatus = HAL_FLASH_Program(FLASH_TYPEPROGRAM_HALFWORD,address + offset,halfWord);
+	}
+	HAL_FLASH_Lock();
+
+	return (halReturnStatus == HAL_OK);
+}
+
+const uint8_t *driverHWFlashRead(uint32_t address) {
+	return (const uint8_t *)(uintptr_t)address;																								// Memory mapped
+}
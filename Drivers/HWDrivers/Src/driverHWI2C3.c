@@ -1,6 +1,7 @@
 #include "driverHWI2C3.h"
 
 I2C_HandleTypeDef driverHWI2C3Handle;
+uint16_t driverHWI2C3TransferAddress;																				// Of the interrupt driven transfer, for the trace
 
 void driverHWI2C3Init(void) {	
 	__HAL_RCC_GPIOC_CLK_ENABLE(); // everything else is handled in the HAL driver
@@ -24,14 +25,61 @@ void driverHWI2C3Init(void) {
 
 bool driverHWI2C3ReadWrite(uint16_t DevAddress, bool readWrite, uint8_t *pData, uint16_t Size) {
 	uint16_t addresRW = (DevAddress << 1) | readWrite;
-	return (HAL_I2C_Master_Transmit(&driverHWI2C3Handle,addresRW,pData,Size,driverHWI2C3DefaultTimout) == HAL_OK);
+	HAL_StatusTypeDef status = HAL_I2C_Master_Transmit(&driverHWI2C3Handle,addresRW,pData,Size,driverHWI2C3DefaultTimout);
+	if(status != HAL_OK)
+		modTraceEvent(TRACE_I2C_ERROR,((uint32_t)addresRW << 16) | status,HAL_I2C_GetError(&driverHWI2C3Handle));
+	return (status == HAL_OK);
 };
 
 bool driverHWI2C3Read(uint16_t DevAddress, uint8_t *pData, uint16_t Size) {
 	uint16_t addresRW = (DevAddress << 1) | 0x01; // Read bit high
-	return (HAL_I2C_Master_Receive(&driverHWI2C3Handle,addresRW,pData,Size,driverHWI2C3DefaultTimout) == HAL_OK);
+	HAL_StatusTypeDef status = HAL_I2C_Master_Receive(&driverHWI2C3Handle,addresRW,pData,Size,driverHWI2C3DefaultTimout);
+	if(status != HAL_OK)
+		modTraceEvent(TRACE_I2C_ERROR,((uint32_t)addresRW << 16) | status,HAL_I2C_GetError(&driverHWI2C3Handle));
+	return (status == HAL_OK);
 };
 
+// Interrupt driven transfers, these only start them. pData has to stay valid until driverHWI2C3GetStatus is no longer
+// busy, the caller polls that from a later task release instead of waiting here.
+bool driverHWI2C3WriteStart(uint16_t DevAddress, uint8_t *pData, uint16_t Size) {
+	driverHWI2C3TransferAddress = DevAddress << 1;
+	HAL_StatusTypeDef status = HAL_I2C_Master_Transmit_IT(&driverHWI2C3Handle,driverHWI2C3TransferAddress,pData,Size);
+	if(status != HAL_OK)
+		modTraceEvent(TRACE_I2C_ERROR,((uint32_t)driverHWI2C3TransferAddress << 16) | status,HAL_I2C_GetError(&driverHWI2C3Handle));
+	return (status == HAL_OK);
+}
+
+bool driverHWI2C3ReadStart(uint16_t DevAddress, uint8_t *pData, uint16_t Size) {
+	driverHWI2C3TransferAddress = (DevAddress << 1) | 0x01; // Read bit high
+	HAL_StatusTypeDef status = HAL_I2C_Master_Receive_IT(&driverHWI2C3Handle,driverHWI2C3TransferAddress,pData,Size);
+	if(status != HAL_OK)
+		modTraceEvent(TRACE_I2C_ERROR,((uint32_t)driverHWI2C3TransferAddress << 16) | status,HAL_I2C_GetError(&driverHWI2C3Handle));
+	return (status == HAL_OK);
+}
 
+driverHWI2C3StatusTypedef driverHWI2C3GetStatus(void) {
+	if(HAL_I2C_GetState(&driverHWI2C3Handle) != HAL_I2C_STATE_READY)
+		return I2C3_BUSY;
 
+	return (HAL_I2C_GetError(&driverHWI2C3Handle) == HAL_I2C_ERROR_NONE) ? I2C3_IDLE : I2C3_ERROR;
+}
+
+// A transfer that never finishes, e.g. SDA held low by a half unplugged nunchuck, is dropped with the peripheral.
+void driverHWI2C3Recover(void) {
+	modTraceEvent(TRACE_I2C_ERROR,((uint32_t)driverHWI2C3TransferAddress << 16) | HAL_TIMEOUT,HAL_I2C_GetError(&driverHWI2C3Handle));
+	HAL_I2C_DeInit(&driverHWI2C3Handle);
+	driverHWI2C3Init();
+}
 
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c) {
+	if(hi2c == &driverHWI2C3Handle)
+		modTraceEvent(TRACE_I2C_ERROR,((uint32_t)driverHWI2C3TransferAddress << 16) | HAL_ERROR,HAL_I2C_GetError(hi2c));
+}
+
+void I2C3_EV_IRQHandler(void) {
+	HAL_I2C_EV_IRQHandler(&driverHWI2C3Handle);
+}
+
+void I2C3_ER_IRQHandler(void) {
+	HAL_I2C_ER_IRQHandler(&driverHWI2C3Handle);
+}
@@ -5,6 +5,9 @@ void (*driverHWLANInterruptcallBackSYNC0Function)(void);
 void (*driverHWLANInterruptcallBackSYNC1Function)(void);
 bool driverHWLANInterruptcallBackIRQActive, driverHWLANInterruptcallBackSYNC0Active, driverHWLANInterruptcallBackSYNC1Active;
 bool driverHWLANInterruptInitialized = false;
+uint32_t driverHWLANInterruptWorstHandlerCycles = 0;															// Longest sync level handler, blocks every lower level
+
+static void driverHWLANInterruptMeasureHandler(uint32_t entryCycles);
 
 void driverHWLANInterruptInit(void) {
 	if(!driverHWLANInterruptInitialized) {
@@ -15,9 +18,9 @@ void driverHWLANInterruptInit(void) {
 		GPIO_InitStruct.Pull = GPIO_PULLUP;
 		HAL_GPIO_Init(GPIOB, &GPIO_InitStruct);
 		
-		HAL_NVIC_SetPriority(EXTI15_10_IRQn, 0x0F, 0x00); 														// IRQ is on PB13, SYNC1 is on PB14, lowest priority interrupt
+		HAL_NVIC_SetPriority(EXTI15_10_IRQn, IRQ_PRIORITY_SYNC, 0x00); 								// IRQ is on PB13, SYNC0 is on PB14, highest priority interrupt
 		HAL_NVIC_EnableIRQ(EXTI15_10_IRQn);
-		HAL_NVIC_SetPriority(EXTI0_IRQn, 0x0F, 0x00); 																// SYNC0 is on PB0, lowest priority interrupt
+		HAL_NVIC_SetPriority(EXTI0_IRQn, IRQ_PRIORITY_SYNC, 0x00); 										// SYNC1 is on PB0
 		HAL_NVIC_EnableIRQ(EXTI0_IRQn);
 		
 		driverHWLANInterruptcallBackIRQFunction = 0;																	// Init pointers to nothing
@@ -72,16 +75,30 @@ void driverHWLANInterruptEnable(uint16_t GPIO_Pin,bool newState) {
 	}
 }
 
+uint32_t driverHWLANInterruptGetWorstHandlerTime(void) {
+	return driverHWLANInterruptWorstHandlerCycles/(SystemCoreClock/1000000);				// us
+}
+
 void EXTI0_IRQHandler(void) {
+	uint32_t entryCycles = DWT->CYCCNT;
 	if(__HAL_GPIO_EXTI_GET_IT(LAN_SYNC1_Pin) != RESET)														// Detect on what input line
     HAL_GPIO_EXTI_IRQHandler(LAN_SYNC1_Pin);	
+	driverHWLANInterruptMeasureHandler(entryCycles);
 }
 
 void EXTI15_10_IRQHandler(void) {																								// An interrupt accured at any input from 10 to 15
+	uint32_t entryCycles = DWT->CYCCNT;
+	if(__HAL_GPIO_EXTI_GET_IT(LAN_SYNC0_Pin) != RESET)														// SYNC0 first, it is the reason this vector sits at the sync level
+    HAL_GPIO_EXTI_IRQHandler(LAN_SYNC0_Pin);	
 	if(__HAL_GPIO_EXTI_GET_IT(LAN_IRQ_Pin) != RESET)															// Detect on what input line
     HAL_GPIO_EXTI_IRQHandler(LAN_IRQ_Pin);
-	if(__HAL_GPIO_EXTI_GET_IT(LAN_SYNC0_Pin) != RESET)														// Detect on what input line
-    HAL_GPIO_EXTI_IRQHandler(LAN_SYNC0_Pin);	
+	driverHWLANInterruptMeasureHandler(entryCycles);
+}
+
+static void driverHWLANInterruptMeasureHandler(uint32_t entryCycles) {
+	uint32_t handlerCycles = DWT->CYCCNT - entryCycles;
+	if(handlerCycles > driverHWLANInterruptWorstHandlerCycles)
+		driverHWLANInterruptWorstHandlerCycles = handlerCycles;
 }
 
 void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin) {																// An interrupt accured at any input from 5 to 9, find and call the appropriate 
@@ -28,3 +28,34 @@ void driverHWStatusInit(void) {
 void driverHWSetOutput(STATIDTypedef LEDType,STATStateTypedef State) {
 	HAL_GPIO_WritePin(STATPorts[LEDType].Port,STATPorts[LEDType].Pin,(GPIO_PinState)State); // Set desired pin to desired state
 }
+
+// Masks hold one bit per STATIDTypedef, all changes on a port are written with a single BSRR store.
+void driverHWSetOutputs(uint32_t setMask, uint32_t resetMask) {
+	GPIO_TypeDef *ports[NoOfSTATs];
+	uint32_t portBSRR[NoOfSTATs];
+	uint8_t noOfPorts = 0;
+	uint8_t STATPointer, portPointer;
+	
+	for(STATPointer = 0; STATPointer < NoOfSTATs; STATPointer++) {
+		uint32_t STATMask = 1 << STATPointer;
+		if(!((setMask | resetMask) & STATMask))
+			continue;
+		
+		for(portPointer = 0; portPointer < noOfPorts; portPointer++) {
+			if(ports[portPointer] == STATPorts[STATPointer].Port)
+				break;
+		}
+		if(portPointer == noOfPorts) {
+			ports[noOfPorts] = STATPorts[STATPointer].Port;
+			portBSRR[noOfPorts++] = 0;
+		}
+		
+		if(setMask & STATMask)
+			portBSRR[portPointer] |= STATPorts[STATPointer].Pin;											// Set has priority over reset in BSRR
+		else
+			portBSRR[portPointer] |= STATPorts[STATPointer].Pin << 16;
+	}
+	
+	for(portPointer = 0; portPointer < noOfPorts; portPointer++)
+		ports[portPointer]->BSRR = portBSRR[portPointer];
+}
@@ -59,7 +59,7 @@
 /* USER CODE BEGIN PRIVATE_DEFINES */
 /* Define size for the receive and transmit buffer over CDC */
 /* It's up to user to redefine and/or remove those define */
-#define APP_RX_DATA_SIZE  4
+#define APP_RX_DATA_SIZE  CDC_DATA_FS_MAX_PACKET_SIZE  /* A whole OUT packet is written here */
 #define APP_TX_DATA_SIZE  4
 /* USER CODE END PRIVATE_DEFINES */
 /**
@@ -88,6 +88,7 @@ uint8_t UserRxBufferFS[APP_RX_DATA_SIZE];
 uint8_t UserTxBufferFS[APP_TX_DATA_SIZE];
 
 /* USER CODE BEGIN PRIVATE_VARIABLES */
+void (*CDC_ReceiveEventFunctionPointer_FS)(uint8_t *data, uint32_t length);
 /* USER CODE END PRIVATE_VARIABLES */
 
 /**
@@ -250,6 +251,8 @@ static int8_t CDC_Control_FS  (uint8_t cmd, uint8_t* pbuf, uint16_t length)
 static int8_t CDC_Receive_FS (uint8_t* Buf, uint32_t *Len)
 {
   /* USER CODE BEGIN 6 */
+  if (CDC_ReceiveEventFunctionPointer_FS)
+    CDC_ReceiveEventFunctionPointer_FS(Buf, *Len);
   USBD_CDC_SetRxBuffer(&hUsbDeviceFS, &Buf[0]);
   USBD_CDC_ReceivePacket(&hUsbDeviceFS);
   return (USBD_OK);
@@ -272,6 +275,9 @@ uint8_t CDC_Transmit_FS(uint8_t* Buf, uint16_t Len)
   uint8_t result = USBD_OK;
   /* USER CODE BEGIN 7 */ 
   USBD_CDC_HandleTypeDef *hcdc = (USBD_CDC_HandleTypeDef*)hUsbDeviceFS.pClassData;
+  if (hcdc == NULL){
+    return USBD_FAIL;                                                   /* Not configured by a host yet */
+  }
   if (hcdc->TxState != 0){
     return USBD_BUSY;
   }
@@ -282,6 +288,11 @@ uint8_t CDC_Transmit_FS(uint8_t* Buf, uint16_t Len)
 }
 
 /* USER CODE BEGIN PRIVATE_FUNCTIONS_IMPLEMENTATION */
+/* Called from the USB interrupt with every packet received, the buffer is reused once it returns */
+void CDC_ReceiveEvent_FS(void (*eventFunctionPointer)(uint8_t *data, uint32_t length))
+{
+  CDC_ReceiveEventFunctionPointer_FS = eventFunctionPointer;
+}
 /* USER CODE END PRIVATE_FUNCTIONS_IMPLEMENTATION */
 
 /**
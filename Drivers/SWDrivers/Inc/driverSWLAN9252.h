@@ -7,6 +7,7 @@
 #include "driverHWSPI1.h"
 #include "driverHWECATTickTimer.h"
 #include "driverHWLANInterrupt.h"
+#include "modDelay.h"
 
 ///////////////////////////////////////////////////////////////////////////////
 //9252 HW DEFINES
@@ -43,7 +44,7 @@
 #define HBI_INDEXED_PRAM_READ_WRITE_FIFO    0x18
 
 #define PRAM_RW_ABORT_MASK      (1 << 30)
-#define PRAM_RW_BUSY_32B        (1 << 31)
+#define PRAM_RW_BUSY_32B        (1UL << 31)
 #define PRAM_RW_BUSY_8B         (1 << 7)
 #define PRAM_SET_READ           (1 << 6)
 #define PRAM_SET_WRITE          0
@@ -77,19 +78,66 @@
 #define ESC_WRITE_BYTE 		0x80
 #define ESC_READ_BYTE 		0xC0
 #define ESC_CSR_BUSY		0x80
+#define ESC_CSR_BUSY_32B	0x80000000
 
 #define LAN9252_BYTE_ORDER_REG          0x64
 #define LAN9252_CSR_INT_CONF            0x54
 #define LAN9252_CSR_INT_EN              0x5C
 #define LAN9252_CSR_INT_STS             0x58
 
+#define LAN9252_IRQ_CFG_IRQ_EN          (1 << 8)
+#define LAN9252_IRQ_CFG_IRQ_POL_HIGH    (1 << 4)
+#define LAN9252_IRQ_CFG_IRQ_PUSH_PULL   (1 << 0)
+#define LAN9252_INT_EN_ECAT_EV          (1 << 0)
+
 #define ADDRESS_AUTO_INCREMENT 0x40
 
+#define driverSWLAN9252PollTimeout				200																	// us, CSR and PRAM commands normally finish within a few polls
+#define driverSWLAN9252PollSpins					4																		// Immediate re-reads before backing off
+#define driverSWLAN9252PollBackoffMin			1																		// us
+#define driverSWLAN9252PollBackoffMax			16																	// us
+
+typedef enum {
+	PDI_OK = 0,
+	PDI_TIMEOUT																																		// The ESC did not finish a command within the poll timeout
+} PDI_StatusTypeDef;
+
+// PDI accounting, split by register class and by the stack part that issued the access
+typedef enum {
+	PDI_CLASS_CSR = 0,																														// ESC registers through CSR_CMD, and LAN9252 system CSRs
+	PDI_CLASS_PRAM,																																// Process RAM through the PRAM FIFOs (>= 0x1000)
+	PDI_CLASSES
+} PDI_ClassTypeDef;
+
+typedef enum {
+	PDI_CALLER_OTHER = 0,																													// Init, IRQ setup
+	PDI_CALLER_STATE,																															// AL state machine
+	PDI_CALLER_MAILBOX,																														// Mailbox, CoE, FoE
+	PDI_CALLER_PDO,																																// Process data
+	PDI_CALLERS
+} PDI_CallerTypeDef;
+
+typedef struct {
+	uint32_t Transactions;																												// Register or PRAM accesses
+	uint32_t Bytes;																																// SPI bytes on the wire
+	uint32_t CSCycles;																														// SPI chip select cycles
+	uint32_t BusyPolls;																														// Command register polls that found the ESC busy
+	uint32_t Time;																																// us spent inside the accesses
+	uint32_t TimeRemainder;																												// Cycles not yet folded into Time
+} PDI_AccountingStruct;
+
+typedef struct {
+	uint32_t Polls;																																// Command register waits
+	uint32_t Timeouts;																														// Waits that gave up
+	uint32_t PollTime;																														// us spent waiting beyond the first read
+	uint32_t WorstPollTime;																												// Longest single wait in us
+} PDI_PollStatisticsStruct;
+
 void PDI_Init(void);
-void SPIWritePDRamRegister(uint8_t *WriteBuffer, uint16_t Address, uint16_t Count);
-void SPIReadPDRamRegister(uint8_t *ReadBuffer, uint16_t Address, uint16_t Count);
-void SPIReadRegUsingCSR(uint8_t *ReadBuffer, uint16_t Address, uint8_t Count);
-void SPIWriteRegUsingCSR( uint8_t *WriteBuffer, uint16_t Address, uint8_t Count);
+PDI_StatusTypeDef SPIWritePDRamRegister(uint8_t *WriteBuffer, uint16_t Address, uint16_t Count);
+PDI_StatusTypeDef SPIReadPDRamRegister(uint8_t *ReadBuffer, uint16_t Address, uint16_t Count);
+PDI_StatusTypeDef SPIReadRegUsingCSR(uint8_t *ReadBuffer, uint16_t Address, uint8_t Count);
+PDI_StatusTypeDef SPIWriteRegUsingCSR( uint8_t *WriteBuffer, uint16_t Address, uint8_t Count);
 void SPIWriteDWord (uint16_t Address, uint32_t Val);
 uint32_t SPIReadDWord (uint16_t Address);
 void SPIWriteBurstMode (uint32_t Val);
@@ -97,14 +145,15 @@ uint32_t SPIReadBurstMode (void);
 void SPIWriteByte(uint8_t data);
 void SPISendAddr (uint16_t Address);
 void SPIWriteBytes(uint16_t Address, uint8_t *Val, uint8_t nLenght);
-void PDIReadReg(uint8_t *ReadBuffer, uint16_t Address, uint16_t Count);
-void PDIWriteReg(uint8_t *WriteBuffer, uint16_t Address, uint16_t Count);
-uint16_t PDIReadAlEventReg(void);
+PDI_StatusTypeDef PDIReadReg(uint8_t *ReadBuffer, uint16_t Address, uint16_t Count);
+PDI_StatusTypeDef PDIWriteReg(uint8_t *WriteBuffer, uint16_t Address, uint16_t Count);
+PDI_StatusTypeDef PDIReadAlEventReg(uint16_t *eventRegister);
 uint32_t PDIReadLAN9252DirectReg(uint16_t Address);
 void PDIWriteLAN9252DirectReg(uint32_t Val, uint16_t Address);
 uint32_t PDI_GetTimer(void);
 void PDI_ClearTimer(void);
-void PDI_UpdateLED(uint8_t RunLed,uint8_t ErrLed);
+void PDI_UpdateLED(uint8_t alStatus, uint16_t alError);
+void PDI_BindLEDUpdate(void (*callbackFunction)(uint8_t alStatus, uint16_t alError));
 void PDI_Init_Timer_Interrupt(void);
 void PDI_Init_IRQ_Interrupt(void);
 void PDI_Init_SYNC_Interrupts(void);
@@ -115,6 +164,16 @@ void PDI_BindISR_SYNC1(void (*callbackFunction)(void));
 void PDI_Enable_Global_interrupt(void);
 void PDI_Restore_Global_Interrupt(uint32_t int_sts);
 uint32_t PDI_Disable_Global_Interrupt(void);
+uint32_t PDI_GetWorstLockTime(void);
+PDI_CallerTypeDef PDI_SetCaller(PDI_CallerTypeDef caller);
+const PDI_AccountingStruct *PDI_GetClassAccounting(PDI_ClassTypeDef pdiClass);
+const PDI_AccountingStruct *PDI_GetCallerAccounting(PDI_CallerTypeDef caller);
+void PDI_ResetAccounting(void);
+const PDI_PollStatisticsStruct *PDI_GetPollStatistics(void);
+
+extern PDI_AccountingStruct driverSWLAN9252ClassAccounting[PDI_CLASSES];								// Exported through CoE
+extern PDI_AccountingStruct driverSWLAN9252CallerAccounting[PDI_CALLERS];
+extern PDI_PollStatisticsStruct driverSWLAN9252PollStatistics;
 
 #endif	/* __DRIVERSWLAN9252_H */
 
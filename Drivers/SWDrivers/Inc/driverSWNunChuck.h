@@ -7,6 +7,16 @@
 
 #define NUNCHUCK_ADDRESS 0x52         			// NunChuck Address
 #define driverNunChuckInterval 10					  // GetSensorData interval in ms
+#define driverNunChuckCommandDelay 1000			// Settle time between I2C commands in us
+#define driverNunChuckIDDelay 10000					// Settle time before reading the ID in us
+#define driverNunChuckTransferTimeout 5000		// us for one transfer, the longest takes ~1.5ms at 100kHz
+
+typedef enum {
+	NUNCHUCK_IDLE = 0,
+	NUNCHUCK_BUSY,																	// Poll again on a later release
+	NUNCHUCK_DONE,
+	NUNCHUCK_FAILED																	// Not acknowledged or stuck, nothing decoded after that
+} driverSWNunChuckStatusTypedef;
 
 typedef struct {
 	uint16_t accelero0GX;
@@ -33,9 +43,8 @@ typedef struct {
 	bool buttonZ;	
 } driverSWNunChuckSensorDataStruct;
 
-bool driverSWNunChuckInit(void);
-bool driverSWNunChuckGetID(uint64_t *IDPointer);
-bool driverSWNunChuckGetCalibrationData(driverSWNunChuckCalibrationDataStruct *dataPointer);
-bool driverSWNunChuckGetSensorData(driverSWNunChuckSensorDataStruct *dataPointer);
+driverSWNunChuckStatusTypedef driverSWNunChuckConnect(driverSWNunChuckCalibrationDataStruct *calibration, uint64_t *ID);
+driverSWNunChuckStatusTypedef driverSWNunChuckGetSensorData(driverSWNunChuckSensorDataStruct *dataPointer);
+driverSWNunChuckStatusTypedef driverSWNunChuckPoll(void);
 
 #endif
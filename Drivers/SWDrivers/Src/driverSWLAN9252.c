@@ -5,21 +5,41 @@ void (*driverSWLAN9252IRQHandler)(void);
 void (*driverSWLAN9252SYNC0Handler)(void);
 void (*driverSWLAN9252SYNC1Handler)(void);
 
-volatile uint8_t RunLedje;
-volatile uint8_t ErrorLedje;
+void (*driverSWLAN9252LEDHandler)(uint8_t alStatus, uint16_t alError);
+
+uint32_t driverSWLAN9252LockStart;
+uint32_t driverSWLAN9252WorstLockCycles = 0;																		// Longest time the PDI level was held off
+uint8_t driverSWLAN9252LockDepth = 0;
+uint32_t driverSWLAN9252LockBase;																								// BASEPRI the outermost lock was taken at
+volatile bool driverSWLAN9252CommandWaiting = false;																// A CSR or PRAM command is in flight with the lock let go
+
+PDI_AccountingStruct driverSWLAN9252ClassAccounting[PDI_CLASSES];
+PDI_AccountingStruct driverSWLAN9252CallerAccounting[PDI_CALLERS];
+PDI_ClassTypeDef driverSWLAN9252Class = PDI_CLASS_CSR;														// What the SPI helpers are counted against
+PDI_CallerTypeDef driverSWLAN9252Caller = PDI_CALLER_OTHER;
+PDI_PollStatisticsStruct driverSWLAN9252PollStatistics;
+
+static void driverSWLAN9252Count(uint32_t bytes, uint32_t csCycles, uint32_t busyPolls);
+static PDI_StatusTypeDef driverSWLAN9252Poll(uint16_t address, uint32_t mask, uint32_t expected, uint32_t *value);
+static void driverSWLAN9252Backoff(uint32_t microseconds);
+static uint32_t driverSWLAN9252AccountStart(PDI_ClassTypeDef pdiClass);
+static void driverSWLAN9252AccountEnd(uint32_t startCycles);
 
 void PDI_Init(void) {
 	driverHWSPI1Init(); 
+	driverHWECATTickTimerInit();																									// Free running 1MHz PDI timer, no interrupt load
 	
 	driverSWLAN9252TimerHandler = 0;																							// Init to point to nothing
 	driverSWLAN9252IRQHandler = 0;
 	driverSWLAN9252SYNC0Handler = 0;
 	driverSWLAN9252SYNC1Handler = 0;
+	driverSWLAN9252LEDHandler = 0;
 }
 
-void SPIWritePDRamRegister(uint8_t *WriteBuffer, uint16_t Address, uint16_t Count) {
+PDI_StatusTypeDef SPIWritePDRamRegister(uint8_t *WriteBuffer, uint16_t Address, uint16_t Count) {
 	UINT64_VAL param32_1 = {0};
 	uint8_t i = 0,nlength, nBytePosition,nWrtSpcAvlCount;
+	uint32_t commandRegister;
 
 	/*Reset or Abort any previous commands.*/
 	param32_1.Val = PRAM_RW_ABORT_MASK;                                                
@@ -28,9 +48,8 @@ void SPIWritePDRamRegister(uint8_t *WriteBuffer, uint16_t Address, uint16_t Coun
 
 	/*Make sure there is no previous write is pending
 	(PRAM Write Busy) bit is a 0 */
-	do{
-		param32_1.Val = SPIReadDWord (PRAM_WRITE_CMD_REG);
-	}while((param32_1.v[3] & PRAM_RW_BUSY_8B));
+	if(driverSWLAN9252Poll(PRAM_WRITE_CMD_REG,PRAM_RW_BUSY_32B,0,&commandRegister) != PDI_OK)
+		return PDI_TIMEOUT;
 
 	/*Write Address and Length Register (ECAT_PRAM_WR_ADDR_LEN) with the
 	starting uint8_t address and length) and write to the EtherCAT Process RAM Write Command Register (ECAT_PRAM_WR_CMD) with the  PRAM Write Busy
@@ -43,11 +62,13 @@ void SPIWritePDRamRegister(uint8_t *WriteBuffer, uint16_t Address, uint16_t Coun
   SPIWriteBytes (PRAM_WRITE_ADDR_LEN_REG, (uint8_t*)&param32_1.Val,8); // TODO: check if this works
 
 	/*Read PRAM write Data Available (PRAM_READ_AVAIL) bit is set*/
-	do {
-		param32_1.Val = SPIReadDWord (PRAM_WRITE_CMD_REG);
-	}while(!(param32_1.v[0] & IS_PRAM_SPACE_AVBL_MASK));
+	if(driverSWLAN9252Poll(PRAM_WRITE_CMD_REG,IS_PRAM_SPACE_AVBL_MASK,IS_PRAM_SPACE_AVBL_MASK,&commandRegister) != PDI_OK) {
+		SPIWriteDWord(PRAM_WRITE_CMD_REG,PRAM_RW_ABORT_MASK);													// Do not leave the command pending for the next access
+		return PDI_TIMEOUT;
+	}
 
 	/*Check write data available count*/
+	param32_1.Val = commandRegister;
 	nWrtSpcAvlCount = param32_1.v[1] & PRAM_SPACE_AVBL_COUNT_MASK;
 
 	/*Write data to Write FIFO */ 
@@ -66,6 +87,7 @@ void SPIWritePDRamRegister(uint8_t *WriteBuffer, uint16_t Address, uint16_t Coun
 	i+=nlength;
 
 	driverHWSPI1SetCS(GPIO_PIN_RESET);
+	driverSWLAN9252Count(0,1,0);
 	SPIWriteByte(CMD_SERIAL_WRITE);																								// Auto increment mode
 	SPISendAddr(PRAM_WRITE_FIFO_REG);																							// Write Command	
 
@@ -81,12 +103,14 @@ void SPIWritePDRamRegister(uint8_t *WriteBuffer, uint16_t Address, uint16_t Coun
 	}
 
 	driverHWSPI1SetCS(GPIO_PIN_SET);
+	return PDI_OK;
 }
 
-void SPIReadPDRamRegister(uint8_t *ReadBuffer, uint16_t Address, uint16_t Count) {
+PDI_StatusTypeDef SPIReadPDRamRegister(uint8_t *ReadBuffer, uint16_t Address, uint16_t Count) {
 	UINT64_VAL param32_1 = {0};
 	uint8_t i = 0,nlength, nBytePosition;
 	uint8_t nReadSpaceAvblCount;
+	uint32_t commandRegister;
 
 	// Reset/Abort any previous commands.
 	param32_1.Val = PRAM_RW_ABORT_MASK;                                                 
@@ -94,9 +118,8 @@ void SPIReadPDRamRegister(uint8_t *ReadBuffer, uint16_t Address, uint16_t Count)
 	SPIWriteDWord(PRAM_READ_CMD_REG, param32_1.Val);
 
 	/*The host should not modify this field unless the PRAM Read Busy (PRAM_READ_BUSY) bit is a 0.*/
-	do{
-			param32_1.Val = SPIReadDWord (PRAM_READ_CMD_REG);
-	}while((param32_1.v[3] & PRAM_RW_BUSY_8B));
+	if(driverSWLAN9252Poll(PRAM_READ_CMD_REG,PRAM_RW_BUSY_32B,0,&commandRegister) != PDI_OK)
+		return PDI_TIMEOUT;
 
 	/*Write Address and Length Register (PRAM_READ_ADDR_LEN) with the
 	starting uint8_t address and length) and Set PRAM Read Busy (PRAM_READ_BUSY) bit(-EtherCAT Process RAM Read Command Register)
@@ -109,10 +132,12 @@ void SPIReadPDRamRegister(uint8_t *ReadBuffer, uint16_t Address, uint16_t Count)
 	SPIWriteBytes(PRAM_READ_ADDR_LEN_REG, (uint8_t*)&param32_1.Val,8);   
 
 	/*Read PRAM Read Data Available (PRAM_READ_AVAIL) bit is set*/
-	do {
-			param32_1.Val = SPIReadDWord (PRAM_READ_CMD_REG);
-	}while(!(param32_1.v[0] & IS_PRAM_SPACE_AVBL_MASK));
+	if(driverSWLAN9252Poll(PRAM_READ_CMD_REG,IS_PRAM_SPACE_AVBL_MASK,IS_PRAM_SPACE_AVBL_MASK,&commandRegister) != PDI_OK) {
+		SPIWriteDWord(PRAM_READ_CMD_REG,PRAM_RW_ABORT_MASK);														// Do not leave the command pending for the next access
+		return PDI_TIMEOUT;
+	}
 
+	param32_1.Val = commandRegister;
 	nReadSpaceAvblCount = param32_1.v[1] & PRAM_SPACE_AVBL_COUNT_MASK;
 
 	/*Fifo registers are aliased address. In indexed it will read indexed data reg 0x04, but it will point to reg 0
@@ -129,6 +154,7 @@ void SPIReadPDRamRegister(uint8_t *ReadBuffer, uint16_t Address, uint16_t Count)
 	i+=nlength;
 
 	driverHWSPI1SetCS(GPIO_PIN_RESET);																						//Lets do it in auto increment mode
+	driverSWLAN9252Count(0,1,0);
 	SPIWriteByte(CMD_FAST_READ);																									// Write Command	
 	SPISendAddr(PRAM_READ_FIFO_REG);
 	SPIWriteByte(CMD_FAST_READ_DUMMY);																						// Dummy Byte	
@@ -145,9 +171,10 @@ void SPIReadPDRamRegister(uint8_t *ReadBuffer, uint16_t Address, uint16_t Count)
 	}
 
 	driverHWSPI1SetCS(GPIO_PIN_SET);
+	return PDI_OK;
 }
 
-void SPIReadRegUsingCSR(uint8_t *ReadBuffer, uint16_t Address, uint8_t Count) {
+PDI_StatusTypeDef SPIReadRegUsingCSR(uint8_t *ReadBuffer, uint16_t Address, uint8_t Count) {
 	UINT32_VAL param32_1 = {0};
 	uint8_t i = 0;
 	UINT16_VAL wAddr;
@@ -160,17 +187,18 @@ void SPIReadRegUsingCSR(uint8_t *ReadBuffer, uint16_t Address, uint8_t Count) {
 
 	SPIWriteDWord(ESC_CSR_CMD_REG, param32_1.Val);
 
-	do {
-		param32_1.Val = SPIReadDWord (ESC_CSR_CMD_REG);
-	}while(param32_1.v[3] & ESC_CSR_BUSY);
+	if(driverSWLAN9252Poll(ESC_CSR_CMD_REG,ESC_CSR_BUSY_32B,0,&param32_1.Val) != PDI_OK)
+		return PDI_TIMEOUT;																													// Buffer left untouched
 
 	param32_1.Val = SPIReadDWord(ESC_CSR_DATA_REG);
 
 	for(i=0;i<Count;i++)
 		ReadBuffer[i] = param32_1.v[i];
+
+	return PDI_OK;
 }
 
-void SPIWriteRegUsingCSR( uint8_t *WriteBuffer, uint16_t Address, uint8_t Count) {
+PDI_StatusTypeDef SPIWriteRegUsingCSR( uint8_t *WriteBuffer, uint16_t Address, uint8_t Count) {
 	UINT32_VAL param32_1 = {0};
 	uint8_t i = 0;
 	UINT16_VAL wAddr;
@@ -188,9 +216,7 @@ void SPIWriteRegUsingCSR( uint8_t *WriteBuffer, uint16_t Address, uint8_t Count)
 
 	SPIWriteDWord (0x304, param32_1.Val);
 	
-	do {
-			param32_1.Val = SPIReadDWord (0x304);
-	}while(param32_1.v[3] & ESC_CSR_BUSY);
+	return driverSWLAN9252Poll(ESC_CSR_CMD_REG,ESC_CSR_BUSY_32B,0,&param32_1.Val);
 }
 
 void SPIWriteDWord(uint16_t Address, uint32_t Val) { // Checked, OK
@@ -205,6 +231,7 @@ void SPIWriteDWord(uint16_t Address, uint32_t Val) { // Checked, OK
 	driverHWSPI1SetCS(GPIO_PIN_RESET);				// CS Low
 	driverHWSPI1Write(writeBytes,7);
 	driverHWSPI1SetCS(GPIO_PIN_SET);					// CS Hight
+	driverSWLAN9252Count(7,1,0);
 }
 
 uint32_t SPIReadDWord (uint16_t Address) { 	// Checked, OK
@@ -217,6 +244,7 @@ uint32_t SPIReadDWord (uint16_t Address) { 	// Checked, OK
 	driverHWSPI1SetCS(GPIO_PIN_RESET);				// CS Low
 	driverHWSPI1WriteRead(writeBytes, 3,(uint8_t *)&dwResult, 4);
 	driverHWSPI1SetCS(GPIO_PIN_SET);					// CS Hight
+	driverSWLAN9252Count(7,1,0);
 
 	return dwResult.Val;
 }
@@ -228,6 +256,7 @@ void SPIWriteBurstMode(uint32_t Val) {			// Checked, OK
 	//Write the Bytes
 	uint8_t writeBytes[4] = {dwData.byte.LB, dwData.byte.HB, dwData.byte.UB, dwData.byte.MB};
 	driverHWSPI1Write(writeBytes,4);
+	driverSWLAN9252Count(4,0,0);
 }
 
 uint32_t SPIReadBurstMode(void) {						// Checked, OK
@@ -236,6 +265,7 @@ uint32_t SPIReadBurstMode(void) {						// Checked, OK
 	memset(readBytes,0x00,4);
 	
 	driverHWSPI1WriteRead(NULL,0x00,readBytes,4);
+	driverSWLAN9252Count(4,0,0);
 	
 	//Read Bytes
 	dwResult.byte.LB = readBytes[0];
@@ -248,6 +278,7 @@ uint32_t SPIReadBurstMode(void) {						// Checked, OK
 
 void SPIWriteByte(uint8_t data) {						// Checked, OK
 	driverHWSPI1WriteSingleByte(data);
+	driverSWLAN9252Count(1,0,0);
 }
 
 
@@ -257,6 +288,7 @@ void SPISendAddr(uint16_t Address) {				// Checked, OK
 	uint8_t writeBytes[2] = {wAddr.byte.HB, wAddr.byte.LB};
 	
 	driverHWSPI1Write(writeBytes,2);
+	driverSWLAN9252Count(2,0,0);
 }
 
 void SPIWriteBytes(uint16_t Address, uint8_t *Val, uint8_t nLenght) { // Checked, OK
@@ -271,52 +303,88 @@ void SPIWriteBytes(uint16_t Address, uint8_t *Val, uint8_t nLenght) { // Checked
 	driverHWSPI1Write(writeAddresBytes,3);	
 	driverHWSPI1Write(dwData,nLenght);
 	driverHWSPI1SetCS(GPIO_PIN_SET);					// CS High
+	driverSWLAN9252Count(3+nLenght,1,0);
 }
 
-void PDIReadReg(uint8_t *ReadBuffer, uint16_t Address, uint16_t Count) {
+// Every PDI access is one multi step SPI sequence, it runs under the ESC access lock so an ISR cannot interleave.
+PDI_StatusTypeDef PDIReadReg(uint8_t *ReadBuffer, uint16_t Address, uint16_t Count) {
+	PDI_StatusTypeDef status;
+	if(driverSWLAN9252CommandWaiting)
+		return PDI_TIMEOUT;																													// Came in during a back-off, the ESC is mid command
+	uint32_t int_sts = PDI_Disable_Global_Interrupt();
+	uint32_t startCycles = driverSWLAN9252AccountStart((Address >= 0x1000) ? PDI_CLASS_PRAM : PDI_CLASS_CSR);
 	if (Address >= 0x1000)
-	 SPIReadPDRamRegister(ReadBuffer, Address,Count);
+	 status = SPIReadPDRamRegister(ReadBuffer, Address,Count);
 	else
-	 SPIReadRegUsingCSR(ReadBuffer, Address,Count);
+	 status = SPIReadRegUsingCSR(ReadBuffer, Address,Count);
+	driverSWLAN9252AccountEnd(startCycles);
+	PDI_Restore_Global_Interrupt(int_sts);
+	return status;
 }
 
-void PDIWriteReg(uint8_t *WriteBuffer, uint16_t Address, uint16_t Count) {	
+PDI_StatusTypeDef PDIWriteReg(uint8_t *WriteBuffer, uint16_t Address, uint16_t Count) {	
+	PDI_StatusTypeDef status;
+	if(driverSWLAN9252CommandWaiting)
+		return PDI_TIMEOUT;
+	uint32_t int_sts = PDI_Disable_Global_Interrupt();
+	uint32_t startCycles = driverSWLAN9252AccountStart((Address >= 0x1000) ? PDI_CLASS_PRAM : PDI_CLASS_CSR);
 	if (Address >= 0x1000)
-		SPIWritePDRamRegister(WriteBuffer, Address,Count);
+		status = SPIWritePDRamRegister(WriteBuffer, Address,Count);
 	else
-		SPIWriteRegUsingCSR(WriteBuffer, Address,Count); 
+		status = SPIWriteRegUsingCSR(WriteBuffer, Address,Count); 
+	driverSWLAN9252AccountEnd(startCycles);
+	PDI_Restore_Global_Interrupt(int_sts);
+	return status;
 }
 
-uint16_t PDIReadAlEventReg(void) {
-	uint16_t eventRegister;
+PDI_StatusTypeDef PDIReadAlEventReg(uint16_t *eventRegister) {
+	PDI_StatusTypeDef status;
+	if(driverSWLAN9252CommandWaiting)
+		return PDI_TIMEOUT;
 	// Read even register
-	SPIReadRegUsingCSR((uint8_t *)&eventRegister,0x220, 2);
+	uint32_t int_sts = PDI_Disable_Global_Interrupt();
+	uint32_t startCycles = driverSWLAN9252AccountStart(PDI_CLASS_CSR);
+	status = SPIReadRegUsingCSR((uint8_t *)eventRegister,0x220, 2);
+	driverSWLAN9252AccountEnd(startCycles);
+	PDI_Restore_Global_Interrupt(int_sts);
 	
-	return eventRegister;
+	return status;
 }
 
 uint32_t PDIReadLAN9252DirectReg(uint16_t Address) {   
 	uint32_t data;
+	uint32_t int_sts = PDI_Disable_Global_Interrupt();
+	uint32_t startCycles = driverSWLAN9252AccountStart(PDI_CLASS_CSR);
 	data = SPIReadDWord (Address);
+	driverSWLAN9252AccountEnd(startCycles);
+	PDI_Restore_Global_Interrupt(int_sts);
 	return data;
 }
 
 void PDIWriteLAN9252DirectReg(uint32_t Val, uint16_t Address) {
+	uint32_t int_sts = PDI_Disable_Global_Interrupt();
+	uint32_t startCycles = driverSWLAN9252AccountStart(PDI_CLASS_CSR);
   SPIWriteDWord (Address, Val);
+	driverSWLAN9252AccountEnd(startCycles);
+	PDI_Restore_Global_Interrupt(int_sts);
 }
 
 uint32_t PDI_GetTimer(void) {
-	return driverHWECATTickTimerGetTimerValue();
+	return driverHWECATTickTimerGetTimerValue();																	// Timer value in us
 }
 
 void PDI_ClearTimer(void) {
-	driverHWECATTickTimerReset();
+	// TIM2 is also the modDelay time base, clearing it would move every deadline. Callers only take differences.
+}
+
+void PDI_UpdateLED(uint8_t alStatus, uint16_t alError) {	
+	// The ESC drives its own RUN LED, the bound handler mirrors RUN and adds ERR on the status outputs
+	if(driverSWLAN9252LEDHandler)
+		driverSWLAN9252LEDHandler(alStatus,alError);
 }
 
-void PDI_UpdateLED(uint8_t RunLed,uint8_t ErrLed) {	
-	RunLedje = RunLed;
-	ErrorLedje = ErrLed;
-	// Update the LED's - RUN LED is already on the ESC - Error LED maybe in future version?
+void PDI_BindLEDUpdate(void (*callbackFunction)(uint8_t alStatus, uint16_t alError)) {
+	driverSWLAN9252LEDHandler = callbackFunction;
 }
 
 void PDI_Enable_Global_interrupt(void) {
@@ -334,6 +402,9 @@ void PDI_Init_Timer_Interrupt(void) {
 }
 
 void PDI_Init_IRQ_Interrupt(void) {
+	PDIWriteLAN9252DirectReg(LAN9252_IRQ_CFG_IRQ_EN | LAN9252_IRQ_CFG_IRQ_PUSH_PULL,LAN9252_CSR_INT_CONF);	// Active low push pull, matches the falling edge EXTI
+	PDIWriteLAN9252DirectReg(LAN9252_INT_EN_ECAT_EV,LAN9252_CSR_INT_EN);										// Forward the ESC AL event request to IRQ
+	
 	driverHWLANInterruptInit();
 	driverHWLANInterruptIRQBindFunction(driverSWLAN9252IRQHandler);
 	driverHWLANInterruptEnable(LAN_IRQ_Pin,true);
@@ -363,20 +434,153 @@ void PDI_BindISR_SYNC1(void (*callbackFunction)(void)) {
 	driverSWLAN9252SYNC0Handler = callbackFunction;
 }
 
+// ESC access lock: raise BASEPRI to the PDI level so ISRs that may access the ESC are held off (not dropped) while the
+// sync level keeps running. Nests, int_sts is the BASEPRI to return to.
 void PDI_Restore_Global_Interrupt(uint32_t int_sts) {
-	// For now only manage ASIC specific interrupts
-	driverHWECATTickTimerInterruptEnable(true);
-	driverHWLANInterruptEnable(LAN_IRQ_Pin,true);
-	driverHWLANInterruptEnable(LAN_SYNC0_Pin,true);
-	driverHWLANInterruptEnable(LAN_SYNC1_Pin,true);
+	driverSWLAN9252LockDepth--;
+	if(!int_sts) {																																// Outermost lock, account the hold time
+		uint32_t lockCycles = DWT->CYCCNT - driverSWLAN9252LockStart;
+		if(lockCycles > driverSWLAN9252WorstLockCycles)
+			driverSWLAN9252WorstLockCycles = lockCycles;
+	}
+	__set_BASEPRI(int_sts);
 }
 
 uint32_t PDI_Disable_Global_Interrupt(void) {
-	// For now only manage ASIC specific interrupts
-	driverHWECATTickTimerInterruptEnable(false);
-	driverHWLANInterruptEnable(LAN_IRQ_Pin,false);
-	driverHWLANInterruptEnable(LAN_SYNC0_Pin,false);
-	driverHWLANInterruptEnable(LAN_SYNC1_Pin,false);
-	return 0; // Return the configuration
+	uint32_t int_sts = __get_BASEPRI();
+	__set_BASEPRI_MAX(IRQ_PRIORITY_TO_BASEPRI(IRQ_PRIORITY_PDI));
+	if(!driverSWLAN9252LockDepth++)
+		driverSWLAN9252LockBase = int_sts;
+	if(!int_sts)
+		driverSWLAN9252LockStart = DWT->CYCCNT;
+	return int_sts; // Return the configuration
+}
+
+uint32_t PDI_GetWorstLockTime(void) {
+	return driverSWLAN9252WorstLockCycles/(SystemCoreClock/1000000);							// Worst added latency for the PDI level and below in us
+}
+
+
+// The caller is set by the task that runs a part of the stack, returns the previous one so it can be restored.
+PDI_CallerTypeDef PDI_SetCaller(PDI_CallerTypeDef caller) {
+	PDI_CallerTypeDef previousCaller = driverSWLAN9252Caller;
+	if(caller < PDI_CALLERS)
+		driverSWLAN9252Caller = caller;
+	return previousCaller;
+}
+
+const PDI_AccountingStruct *PDI_GetClassAccounting(PDI_ClassTypeDef pdiClass) {
+	return (pdiClass < PDI_CLASSES) ? &driverSWLAN9252ClassAccounting[pdiClass] : NULL;
+}
+
+const PDI_AccountingStruct *PDI_GetCallerAccounting(PDI_CallerTypeDef caller) {
+	return (caller < PDI_CALLERS) ? &driverSWLAN9252CallerAccounting[caller] : NULL;
 }
 
+void PDI_ResetAccounting(void) {
+	uint32_t int_sts = PDI_Disable_Global_Interrupt();
+	memset(driverSWLAN9252ClassAccounting,0,sizeof(driverSWLAN9252ClassAccounting));
+	memset(driverSWLAN9252CallerAccounting,0,sizeof(driverSWLAN9252CallerAccounting));
+	memset(&driverSWLAN9252PollStatistics,0,sizeof(driverSWLAN9252PollStatistics));
+	PDI_Restore_Global_Interrupt(int_sts);
+}
+
+const PDI_PollStatisticsStruct *PDI_GetPollStatistics(void) {
+	return &driverSWLAN9252PollStatistics;
+}
+
+// Waits for (register & mask) == expected. The first read is free of timing overhead, it is what almost every access
+// sees. After that a few immediate re-reads, then polls spaced by a back-off that doubles up to the maximum, all bounded
+// by the poll deadline. The back-off waits with the lock let go, see driverSWLAN9252Backoff. The expiry is sampled before each read so a late wake up still gets one last look at the ESC.
+static PDI_StatusTypeDef driverSWLAN9252Poll(uint16_t address, uint32_t mask, uint32_t expected, uint32_t *value) {
+	uint32_t polls = 0;
+	uint32_t backoff = driverSWLAN9252PollBackoffMin;
+	uint32_t startTime, deadline;
+	bool expired;
+
+	*value = SPIReadDWord(address);
+	driverSWLAN9252PollStatistics.Polls++;
+	if((*value & mask) == expected)
+		return PDI_OK;
+
+	startTime = modDelayGetMicroseconds();
+	deadline = startTime + driverSWLAN9252PollTimeout;
+
+	do {
+		driverSWLAN9252Count(0,0,1);
+
+		if(++polls > driverSWLAN9252PollSpins) {
+			int32_t remaining = modDelayDeadlineRemaining(deadline);
+			driverSWLAN9252Backoff((remaining > 0 && (uint32_t)remaining < backoff) ? (uint32_t)remaining : backoff);
+			if(backoff < driverSWLAN9252PollBackoffMax)
+				backoff <<= 1;
+		}
+
+		expired = modDelayDeadlineExpired(deadline);
+		*value = SPIReadDWord(address);
+	} while(((*value & mask) != expected) && !expired);
+
+	uint32_t pollTime = modDelayGetMicroseconds() - startTime;
+	driverSWLAN9252PollStatistics.PollTime += pollTime;
+	if(pollTime > driverSWLAN9252PollStatistics.WorstPollTime)
+		driverSWLAN9252PollStatistics.WorstPollTime = pollTime;
+
+	if((*value & mask) != expected) {
+		driverSWLAN9252PollStatistics.Timeouts++;
+		return PDI_TIMEOUT;
+	}
+
+	return PDI_OK;
+}
+
+// A slow ESC must not hold off the levels below the PDI one (TIM2, SysTick, I2C, USB) for the whole poll, so the
+// outermost lock is let go while waiting and taken again for the next read. The command stays in flight meanwhile, an
+// ISR that wants the ESC in between gets PDI_TIMEOUT rather than issue its own over it. Within an outer lock the
+// caller asked for the levels to stay masked, the wait then runs locked.
+static void driverSWLAN9252Backoff(uint32_t microseconds) {
+	uint32_t deadline = modDelayDeadlineSet(microseconds);
+	bool release = (driverSWLAN9252LockDepth == 1);
+
+	if(release) {
+		driverSWLAN9252CommandWaiting = true;
+		PDI_Restore_Global_Interrupt(driverSWLAN9252LockBase);
+	}
+	while(!modDelayDeadlineExpired(deadline));
+	if(release) {
+		PDI_Disable_Global_Interrupt();
+		driverSWLAN9252CommandWaiting = false;
+	}
+}
+
+// Counted twice on purpose, once per register class and once per caller, so both views are plain sums over the wire.
+static void driverSWLAN9252Count(uint32_t bytes, uint32_t csCycles, uint32_t busyPolls) {
+	PDI_AccountingStruct *classAccounting = &driverSWLAN9252ClassAccounting[driverSWLAN9252Class];
+	PDI_AccountingStruct *callerAccounting = &driverSWLAN9252CallerAccounting[driverSWLAN9252Caller];
+
+	classAccounting->Bytes += bytes;
+	classAccounting->CSCycles += csCycles;
+	classAccounting->BusyPolls += busyPolls;
+	callerAccounting->Bytes += bytes;
+	callerAccounting->CSCycles += csCycles;
+	callerAccounting->BusyPolls += busyPolls;
+}
+
+static uint32_t driverSWLAN9252AccountStart(PDI_ClassTypeDef pdiClass) {
+	driverSWLAN9252Class = pdiClass;
+	return DWT->CYCCNT;
+}
+
+static void driverSWLAN9252AccountTime(PDI_AccountingStruct *accounting, uint32_t cycles, uint32_t cyclesPerMicrosecond) {
+	cycles += accounting->TimeRemainder;
+	accounting->Transactions++;
+	accounting->Time += cycles / cyclesPerMicrosecond;
+	accounting->TimeRemainder = cycles % cyclesPerMicrosecond;
+}
+
+static void driverSWLAN9252AccountEnd(uint32_t startCycles) {
+	uint32_t cycles = DWT->CYCCNT - startCycles;
+	uint32_t cyclesPerMicrosecond = SystemCoreClock/1000000;
+
+	driverSWLAN9252AccountTime(&driverSWLAN9252ClassAccounting[driverSWLAN9252Class],cycles,cyclesPerMicrosecond);
+	driverSWLAN9252AccountTime(&driverSWLAN9252CallerAccounting[driverSWLAN9252Caller],cycles,cyclesPerMicrosecond);
+}
@@ -2,94 +2,167 @@
 
 // https://github.com/infusion/Fritzing/blob/master/Wii-Nunchuk/Nunchuk.h
 
-uint32_t driverNunChuckInitDelayLastTick = 0;
+// The nunchuck needs its settle time between two commands. Instead of waiting for it here, a sequence of commands is
+// a list of steps: every driverSWNunChuckPoll collects the transfer in flight and starts the next one once its delay
+// has passed, so a caller running every driverNunChuckCommandDelay never blocks on the bus.
 
-bool driverSWNunChuckInit(void) {
+typedef enum {
+	NUNCHUCK_STEP_WRITE = 0,																												// Data is sent, the first byte sets the register pointer
+	NUNCHUCK_STEP_READ																															// From the register pointer on
+} driverSWNunChuckStepTypedef;
+
+typedef struct {
+	driverSWNunChuckStepTypedef Type;
+	uint8_t Data[2];																																// Written, or the register it reads for the decode
+	uint8_t Size;
+	uint32_t Delay;																																	// us after the previous command started
+} driverSWNunChuckStepStruct;
+
+static const driverSWNunChuckStepStruct driverSWNunChuckConnectSteps[] = {
+	{NUNCHUCK_STEP_WRITE,{0xF0,0x55},2,driverNunChuckCommandDelay},												// Unencrypted init
+	{NUNCHUCK_STEP_WRITE,{0xFB,0x00},2,driverNunChuckCommandDelay},
+	{NUNCHUCK_STEP_WRITE,{0x20},1,driverNunChuckCommandDelay},																// Calibration data
+	{NUNCHUCK_STEP_READ,{0x20},14,driverNunChuckCommandDelay},
+	{NUNCHUCK_STEP_WRITE,{0xFA},1,driverNunChuckIDDelay},																		// Identification
+	{NUNCHUCK_STEP_READ,{0xFA},6,driverNunChuckCommandDelay}
+};
+
+static const driverSWNunChuckStepStruct driverSWNunChuckSensorSteps[] = {
+	{NUNCHUCK_STEP_READ,{0x00},6,driverNunChuckCommandDelay},																// Sensor data, the pointer was left at 0x00
+	{NUNCHUCK_STEP_WRITE,{0x00},1,driverNunChuckCommandDelay}																	// Reset data pointer, also starts the next conversion
+};
+
+static const driverSWNunChuckStepStruct *driverSWNunChuckSteps = NULL;
+static uint8_t driverSWNunChuckStepCount = 0;
+static uint8_t driverSWNunChuckStep = 0;																						// Next one to start
+static bool driverSWNunChuckTransferActive = false;
+static uint32_t driverSWNunChuckCommandTime = 0;																		// us, start of the last command
+static uint8_t driverSWNunChuckBuffer[14];																					// Filled by the interrupt driven read
+static driverSWNunChuckCalibrationDataStruct *driverSWNunChuckCalibrationPointer;
+static uint64_t *driverSWNunChuckIDPointer;
+static driverSWNunChuckSensorDataStruct *driverSWNunChuckSensorPointer;
+static driverSWNunChuckStatusTypedef driverSWNunChuckStatus = NUNCHUCK_IDLE;
+
+static void driverSWNunChuckDecode(const driverSWNunChuckStepStruct *step);
+static driverSWNunChuckStatusTypedef driverSWNunChuckStart(const driverSWNunChuckStepStruct *steps, uint8_t count);
+
+driverSWNunChuckStatusTypedef driverSWNunChuckConnect(driverSWNunChuckCalibrationDataStruct *calibration, uint64_t *ID) {
+	if(driverSWNunChuckTransferActive)
+		driverHWI2C3Recover();																												// A new nunchuck, the old transfer is of no use
+	driverSWNunChuckTransferActive = false;
 	driverHWI2C3Init();
-	driverNunChuckInitDelayLastTick = HAL_GetTick();
-	
-	while(!modDelayTick1ms(&driverNunChuckInitDelayLastTick,1));
-	uint8_t writeData[2] = {0xF0,0x55};
-	driverHWI2C3ReadWrite(NUNCHUCK_ADDRESS,false,writeData,2);
-	
-	while(!modDelayTick1ms(&driverNunChuckInitDelayLastTick,1));
-	writeData[0] = 0xFB;
-	writeData[1] = 0x00;
-	driverHWI2C3ReadWrite(NUNCHUCK_ADDRESS,false,writeData,2);
-	
-	return false;
+
+	driverSWNunChuckCalibrationPointer = calibration;
+	driverSWNunChuckIDPointer = ID;
+	*ID = 0;																																				// Not the one of the previous nunchuck
+	driverSWNunChuckCommandTime = modDelayGetMicroseconds();
+	return driverSWNunChuckStart(driverSWNunChuckConnectSteps,sizeof(driverSWNunChuckConnectSteps)/sizeof(driverSWNunChuckConnectSteps[0]));
 }
 
-bool driverSWNunChuckSetAddressPointer(uint8_t address) {
-	uint8_t writeData[2] = {address};
-	return driverHWI2C3ReadWrite(NUNCHUCK_ADDRESS,false,writeData,1);
+driverSWNunChuckStatusTypedef driverSWNunChuckGetSensorData(driverSWNunChuckSensorDataStruct *dataPointer) {
+	driverSWNunChuckSensorPointer = dataPointer;
+	return driverSWNunChuckStart(driverSWNunChuckSensorSteps,sizeof(driverSWNunChuckSensorSteps)/sizeof(driverSWNunChuckSensorSteps[0]));
 }
 
-bool driverSWNunChuckGetID(uint64_t *IDPointer) {
-	uint8_t readData[6];
-	uint8_t offsetPointer;
-	bool returnVal = true;
-
-	while(!modDelayTick1ms(&driverNunChuckInitDelayLastTick,10));
-	returnVal &= driverSWNunChuckSetAddressPointer(0xFA);																			// Read the ID data
-	
-	while(!modDelayTick1ms(&driverNunChuckInitDelayLastTick,1));
-	returnVal &= driverHWI2C3Read(NUNCHUCK_ADDRESS,(uint8_t *)readData,6);
-	
-	for(offsetPointer = 0; offsetPointer < 6 ; offsetPointer++)
-		*IDPointer |= ((uint64_t)readData[offsetPointer] << ((5-offsetPointer)*8));
-	
-	return returnVal;
+// Advances the sequence by at most one command, the data of a read is decoded once it is in.
+driverSWNunChuckStatusTypedef driverSWNunChuckPoll(void) {
+	if(driverSWNunChuckStatus != NUNCHUCK_BUSY)
+		return driverSWNunChuckStatus;
+
+	if(driverSWNunChuckTransferActive) {
+		switch(driverHWI2C3GetStatus()) {
+			case I2C3_BUSY:
+				if((modDelayGetMicroseconds() - driverSWNunChuckCommandTime) < driverNunChuckTransferTimeout)
+					return NUNCHUCK_BUSY;
+				driverHWI2C3Recover();
+				driverSWNunChuckTransferActive = false;
+				driverSWNunChuckStatus = NUNCHUCK_FAILED;
+				return driverSWNunChuckStatus;
+			case I2C3_ERROR:
+				driverSWNunChuckTransferActive = false;
+				driverSWNunChuckStatus = NUNCHUCK_FAILED;
+				return driverSWNunChuckStatus;
+			default:
+				break;
+		}
+
+		driverSWNunChuckTransferActive = false;
+		driverSWNunChuckDecode(&driverSWNunChuckSteps[driverSWNunChuckStep - 1]);
+	}
+
+	if(driverSWNunChuckStep >= driverSWNunChuckStepCount) {
+		driverSWNunChuckStatus = NUNCHUCK_DONE;
+		return driverSWNunChuckStatus;
+	}
+
+	const driverSWNunChuckStepStruct *step = &driverSWNunChuckSteps[driverSWNunChuckStep];
+	if((modDelayGetMicroseconds() - driverSWNunChuckCommandTime) < step->Delay)
+		return NUNCHUCK_BUSY;
+
+	driverSWNunChuckCommandTime = modDelayGetMicroseconds();
+	if(step->Type == NUNCHUCK_STEP_WRITE) {
+		memcpy(driverSWNunChuckBuffer,step->Data,step->Size);
+		driverSWNunChuckTransferActive = driverHWI2C3WriteStart(NUNCHUCK_ADDRESS,driverSWNunChuckBuffer,step->Size);
+	}else{
+		driverSWNunChuckTransferActive = driverHWI2C3ReadStart(NUNCHUCK_ADDRESS,driverSWNunChuckBuffer,step->Size);
+	}
+
+	if(!driverSWNunChuckTransferActive) {
+		driverSWNunChuckStatus = NUNCHUCK_FAILED;
+		return driverSWNunChuckStatus;
+	}
+
+	driverSWNunChuckStep++;
+	return NUNCHUCK_BUSY;
 }
 
-bool driverSWNunChuckGetCalibrationData(driverSWNunChuckCalibrationDataStruct *dataPointer) {
-  uint8_t calibrationData[16];
-	bool returnVal = true;
-	
-	while(!modDelayTick1ms(&driverNunChuckInitDelayLastTick,1));
-	returnVal &= driverSWNunChuckSetAddressPointer(0x20);
-	
-	while(!modDelayTick1ms(&driverNunChuckInitDelayLastTick,1));
-	returnVal &= driverHWI2C3Read(NUNCHUCK_ADDRESS,(uint8_t *)calibrationData,14);						// Read the calibration data
-	
-	dataPointer->accelero0GX = ((calibrationData[0]) << 2) + (((calibrationData[3]) >> 2) & 0x03);
-	dataPointer->accelero0GY = ((calibrationData[1]) << 2) + (((calibrationData[3]) >> 2) & 0x03);
-	dataPointer->accelero0GZ = ((calibrationData[2]) << 2) + (((calibrationData[3]) >> 2) & 0x03);
-
-	dataPointer->accelero1GX = ((calibrationData[4]) << 2) + (((calibrationData[7]) >> 2) & 0x03);
-	dataPointer->accelero1GY = ((calibrationData[5]) << 2) + (((calibrationData[7]) >> 2) & 0x03);
-	dataPointer->accelero1GZ = ((calibrationData[6]) << 2) + (((calibrationData[7]) >> 2) & 0x03);
-	
-	dataPointer->joystickXMax    = calibrationData[8];
-	dataPointer->joystickXMin    = calibrationData[9];
-	dataPointer->joystickXCenter = calibrationData[10];
-
-	dataPointer->joystickYMax    = calibrationData[11];
-	dataPointer->joystickYMin    = calibrationData[12];
-	dataPointer->joystickYCenter = calibrationData[13];	
-	
-	return returnVal;
+static driverSWNunChuckStatusTypedef driverSWNunChuckStart(const driverSWNunChuckStepStruct *steps, uint8_t count) {
+	driverSWNunChuckSteps = steps;
+	driverSWNunChuckStepCount = count;
+	driverSWNunChuckStep = 0;
+	driverSWNunChuckStatus = NUNCHUCK_BUSY;
+
+	return driverSWNunChuckPoll();
 }
 
-bool driverSWNunChuckGetSensorData(driverSWNunChuckSensorDataStruct *dataPointer) {
-	uint8_t readData[6];
-	bool returnVal = true;
-	
-	driverNunChuckInitDelayLastTick = HAL_GetTick();
-	while(!modDelayTick1ms(&driverNunChuckInitDelayLastTick,1)){};
-	returnVal &= driverHWI2C3Read(NUNCHUCK_ADDRESS,(uint8_t *)readData,6);	  // Read the data
-
-	driverNunChuckInitDelayLastTick = HAL_GetTick();
-	while(!modDelayTick1ms(&driverNunChuckInitDelayLastTick,1)){};
-	returnVal &= driverSWNunChuckSetAddressPointer(0x00);											// Reset data pointer
-
-	dataPointer->joystickX = readData[0];
-	dataPointer->joystickY = readData[1];
-	dataPointer->accelerometerX = ((readData[2]) << 2) + (((readData[5]) >> 2) & 0x03);
-	dataPointer->accelerometerY = ((readData[3]) << 2) + (((readData[5]) >> 4) & 0x03);
-	dataPointer->accelerometerZ = ((readData[4]) << 2) + (((readData[5]) >> 6) & 0x03);
-	dataPointer->buttonZ = (readData[5] & 0x01) ? false : true;
-	dataPointer->buttonC = (readData[5] & 0x02) ? false : true;
-	
-	return returnVal;
+static void driverSWNunChuckDecode(const driverSWNunChuckStepStruct *step) {
+	const uint8_t *readData = driverSWNunChuckBuffer;
+	uint8_t offsetPointer;
+
+	if(step->Type != NUNCHUCK_STEP_READ)
+		return;
+
+	switch(step->Data[0]) {
+		case 0x20:
+			driverSWNunChuckCalibrationPointer->accelero0GX = ((readData[0]) << 2) + (((readData[3]) >> 2) & 0x03);
+			driverSWNunChuckCalibrationPointer->accelero0GY = ((readData[1]) << 2) + (((readData[3]) >> 2) & 0x03);
+			driverSWNunChuckCalibrationPointer->accelero0GZ = ((readData[2]) << 2) + (((readData[3]) >> 2) & 0x03);
+
+			driverSWNunChuckCalibrationPointer->accelero1GX = ((readData[4]) << 2) + (((readData[7]) >> 2) & 0x03);
+			driverSWNunChuckCalibrationPointer->accelero1GY = ((readData[5]) << 2) + (((readData[7]) >> 2) & 0x03);
+			driverSWNunChuckCalibrationPointer->accelero1GZ = ((readData[6]) << 2) + (((readData[7]) >> 2) & 0x03);
+
+			driverSWNunChuckCalibrationPointer->joystickXMax    = readData[8];
+			driverSWNunChuckCalibrationPointer->joystickXMin    = readData[9];
+			driverSWNunChuckCalibrationPointer->joystickXCenter = readData[10];
+
+			driverSWNunChuckCalibrationPointer->joystickYMax    = readData[11];
+			driverSWNunChuckCalibrationPointer->joystickYMin    = readData[12];
+			driverSWNunChuckCalibrationPointer->joystickYCenter = readData[13];
+			break;
+		case 0xFA:
+			*driverSWNunChuckIDPointer = 0;
+			for(offsetPointer = 0; offsetPointer < 6 ; offsetPointer++)
+				*driverSWNunChuckIDPointer |= ((uint64_t)readData[offsetPointer] << ((5-offsetPointer)*8));
+			break;
+		default:
+			driverSWNunChuckSensorPointer->joystickX = readData[0];
+			driverSWNunChuckSensorPointer->joystickY = readData[1];
+			driverSWNunChuckSensorPointer->accelerometerX = ((readData[2]) << 2) + (((readData[5]) >> 2) & 0x03);
+			driverSWNunChuckSensorPointer->accelerometerY = ((readData[3]) << 2) + (((readData[5]) >> 4) & 0x03);
+			driverSWNunChuckSensorPointer->accelerometerZ = ((readData[4]) << 2) + (((readData[5]) >> 6) & 0x03);
+			driverSWNunChuckSensorPointer->buttonZ = (readData[5] & 0x01) ? false : true;
+			driverSWNunChuckSensorPointer->buttonC = (readData[5] & 0x02) ? false : true;
+			break;
+	}
 }
@@ -0,0 +1,690 @@
+#!/usr/bin/env python3
+"""Generates the object dictionary, the process data buffers and the ESI device entry from one description.
+
+DieBieSlave-NunChuck.esx is the description. From it this writes
+  Middlewares/SSC/Src/objectlist.c   name strings, _objd tables, SDOobjects and the SDO information responses
+  Middlewares/SSC/Inc/objectlist.h   packed PDO buffers, bit shadows and CC_STATIC_ASSERT layout checks
+  ESIEtherCAT/DieBieSlaves.xml       Profile, Sm, Pdo and Mailbox of the device with the same product code
+
+Besides what the SOES slave editor writes, a SubItem may carry <Data>, a C lvalue the entry reads and writes
+(counters living in other modules). <Include> at the top level names a header objectlist.c needs for those.
+An OCTET_STRING entry has no default to take its length from, it gives <BitSize> and always <Data>.
+<Backup>1</Backup> on a SubItem with <Data> puts it in objectlistParameters, the entries the parameter store keeps.
+PDO mapped variables are bound to the process data buffers automatically.
+
+  python3 ESIEtherCAT/esigen.py            regenerate
+  python3 ESIEtherCAT/esigen.py --check    exit 1 if a generated file differs from the tree
+"""
+
+import os
+import re
+import sys
+import xml.etree.ElementTree as ET
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+DESCRIPTION = os.path.join(ROOT, 'ESIEtherCAT', 'DieBieSlave-NunChuck.esx')
+OBJECTLIST_C = os.path.join(ROOT, 'Middlewares', 'SSC', 'Src', 'objectlist.c')
+OBJECTLIST_H = os.path.join(ROOT, 'Middlewares', 'SSC', 'Inc', 'objectlist.h')
+ESI = os.path.join(ROOT, 'ESIEtherCAT', 'DieBieSlaves.xml')
+
+READBUFFER = 'middleSOESReadBuffer'
+WRITEBUFFER = 'middleSOESWriteBuffer'
+SHADOW = 'middleSOESReadBufferBooleans'
+
+GENERATED = '// Generated by ESIEtherCAT/esigen.py from DieBieSlave-NunChuck.esx, edit the description and regenerate.\n'
+
+# Description type: CoE data type, bits, ESI type, C type
+TYPES = {
+	'BOOLEAN':    ('DTYPE_BOOLEAN', 1, 'BOOL', 'uint8_t'),
+	'INTEGER8':   ('DTYPE_INTEGER8', 8, 'SINT', 'int8_t'),
+	'INTEGER16':  ('DTYPE_INTEGER16', 16, 'INT', 'int16_t'),
+	'INTEGER32':  ('DTYPE_INTEGER32', 32, 'DINT', 'int32_t'),
+	'UNSIGNED8':  ('DTYPE_UNSIGNED8', 8, 'USINT', 'uint8_t'),
+	'UNSIGNED16': ('DTYPE_UNSIGNED16', 16, 'UINT', 'uint16_t'),
+	'UNSIGNED32': ('DTYPE_UNSIGNED32', 32, 'UDINT', 'uint32_t'),
+	'REAL32':     ('DTYPE_REAL32', 32, 'REAL', 'float'),
+	'OCTET_STRING': ('DTYPE_OCTET_STRING', None, 'OCTET_STRING', 'uint8_t'),
+}
+
+ACCESS = {'RO': 'ATYPE_RO', 'RW': 'ATYPE_RW', 'RWPRE': 'ATYPE_RWpre'}
+CATEGORY = {0x1000: 'm', 0x1008: 'o', 0x1009: 'o', 0x100A: 'o', 0x1010: 'o', 0x1011: 'o', 0x1018: 'm', 0x10F3: 'o'}
+
+# Values of the esc_coe.h constants, for the SDO information responses built here
+DTYPE_CODES = {'DTYPE_BOOLEAN': 0x0001, 'DTYPE_INTEGER8': 0x0002, 'DTYPE_INTEGER16': 0x0003, 'DTYPE_INTEGER32': 0x0004,
+	'DTYPE_UNSIGNED8': 0x0005, 'DTYPE_UNSIGNED16': 0x0006, 'DTYPE_UNSIGNED32': 0x0007, 'DTYPE_REAL32': 0x0008,
+	'DTYPE_VISIBLE_STRING': 0x0009, 'DTYPE_OCTET_STRING': 0x000A}
+ACCESS_CODES = {'ATYPE_RO': 0x07, 'ATYPE_RW': 0x3F, 'ATYPE_RWpre': 0x0F}
+OTYPE_CODES = {'OTYPE_VAR': 0x07, 'OTYPE_ARRAY': 0x08, 'OTYPE_RECORD': 0x09}
+COE_SDOINFORMATION = 0x8000																# CoE header, service in the upper 4 bits
+COE_GETODLISTRESPONSE = 0x02
+COE_GETODRESPONSE = 0x04
+COE_ENTRYDESCRIPTIONRESPONSE = 0x06
+COE_VALUEINFO = 0x07																			# Access, object and mappable, what SDO_geted always sent
+MBXHSIZE = 6
+
+
+class DescriptionError(Exception):
+	pass
+
+
+def number(text):
+	return int(text.strip(), 0)
+
+
+def esiNumber(text):
+	text = text.strip()
+	return '#x' + text[2:] if text.lower().startswith('0x') else text
+
+
+def cName(name):
+	return re.sub(r'\W', '_', name)
+
+
+class Entry:
+	def __init__(self, element, subindex):
+		self.subindex = subindex
+		self.name = element.findtext('Name')
+		self.type = element.findtext('DataType')
+		self.default = element.findtext('DefaultValue') or '0'
+		self.access = (element.findtext('Access') or 'RO').upper()
+		self.variable = element.findtext('Variable')
+		self.data = element.findtext('Data')
+		self.bitSize = element.findtext('BitSize')
+		self.backup = (element.findtext('Backup') or '0').strip() in ('1', 'true')
+		if self.access not in ACCESS:
+			raise DescriptionError('%s: unknown access %s' % (self.name, self.access))
+		if self.isOctetString() and (not self.bitSize or not self.data):
+			raise DescriptionError('%s: an OCTET_STRING needs BitSize and Data' % self.name)
+		if self.backup and (not self.data or self.access == 'RO'):
+			raise DescriptionError('%s: a Backup entry needs Data and write access' % self.name)
+
+	def isString(self):
+		return self.type == 'VISIBLE_STRING'
+
+	def isOctetString(self):
+		return self.type == 'OCTET_STRING'
+
+	def bits(self):
+		if self.isString():
+			return len(self.default)*8
+		if self.isOctetString():
+			return number(self.bitSize)
+		if self.type not in TYPES:
+			raise DescriptionError('%s: unsupported data type %s' % (self.name, self.type))
+		return TYPES[self.type][1]
+
+	def esiType(self):
+		if self.isOctetString():
+			return 'OCTET_STRING(%d)' % (self.bits()//8)
+		return 'STRING(%d)' % len(self.default) if self.isString() else TYPES[self.type][2]
+
+
+class Item:
+	def __init__(self, element):
+		self.index = number(element.findtext('Index'))
+		self.name = element.findtext('Name')
+		self.objectType = element.findtext('DataType')
+		self.variable = element.findtext('Variable')
+		self.variableType = element.findtext('VariableType')
+		if self.objectType in ('RECORD', 'ARRAY'):
+			self.entries = [Entry(sub, n) for n, sub in enumerate(element.findall('SubItem'))]
+			if not self.entries or number(self.entries[0].default) != len(self.entries) - 1:
+				raise DescriptionError('0x%04X: Number of Elements does not match the sub items' % self.index)
+		else:
+			entry = Entry(element, 0)
+			entry.type = self.objectType
+			self.entries = [entry]
+
+	def isVar(self):
+		return self.objectType not in ('RECORD', 'ARRAY')
+
+
+class Pdo:
+	def __init__(self, element, direction, dictionary):
+		self.index = number(element.findtext('Index'))
+		self.name = element.findtext('Name')
+		self.container = element.findtext('Container') or self.name
+		self.direction = direction
+		self.entries = []																			# (item, entry) or (None, pad bits)
+		for entry in element.findall('Entry'):
+			if entry.get('padBits'):
+				self.entries.append((None, int(entry.get('padBits'))))
+				continue
+			index = number(entry.findtext('Index'))
+			subindex = number(entry.findtext('SubIndex'))
+			if index not in dictionary or subindex >= len(dictionary[index].entries):
+				raise DescriptionError('PDO 0x%04X maps missing object 0x%04X:%d' % (self.index, index, subindex))
+			self.entries.append((dictionary[index], dictionary[index].entries[subindex]))
+
+	def bits(self):
+		return sum(entry.bits() if item else entry for item, entry in self.entries)
+
+	def mapping(self):
+		for item, entry in self.entries:
+			if item:
+				yield (item.index << 16) | (entry.subindex << 8) | entry.bits()
+			else:
+				yield entry
+
+
+class Description:
+	def __init__(self, path):
+		root = ET.parse(path).getroot()
+		self.name = root.findtext('Name')
+		self.productCode = number(root.get('productCode'))
+		self.sms = [(sm.text, sm.get('ControlByte'), sm.get('StartAddress'), sm.get('DefaultSize')) for sm in root.findall('Sm')]
+		mailbox = root.find('Mailbox')
+		self.mailbox = dict(mailbox.attrib) if mailbox is not None else {}
+		standard = mailbox.find('Standard') if mailbox is not None else None
+		self.mailboxSize = number(standard.get('Length')) if standard is not None else 0
+		self.includes = [include.text.strip() for include in root.findall('Include')]
+
+		self.items = [Item(element) for element in root.find('Dictionary').findall('Item')]
+		self.items.sort(key=lambda item: item.index)
+		self.dictionary = {item.index: item for item in self.items}
+		if len(self.dictionary) != len(self.items):
+			raise DescriptionError('duplicate object index')
+
+		self.rxPdos = [Pdo(element, 'Output', self.dictionary) for element in root.findall('RxPdo')]
+		self.txPdos = [Pdo(element, 'Input', self.dictionary) for element in root.findall('TxPdo')]
+		if not self.rxPdos or not self.txPdos:
+			raise DescriptionError('the buffers need at least one RxPdo and one TxPdo')
+		self.check()
+
+	def check(self):
+		# Mapping and assignment objects are written by the editor next to the Pdo sections, they must agree
+		for assignment, pdos in ((0x1C12, self.rxPdos), (0x1C13, self.txPdos)):
+			self.checkValues(assignment, [pdo.index for pdo in pdos])
+			for pdo in pdos:
+				self.checkValues(pdo.index, list(pdo.mapping()))
+
+		shadows = set()
+		for pdo in self.rxPdos + self.txPdos:
+			position = 0
+			for item, entry in pdo.entries:
+				bits = entry.bits() if item else entry
+				if item and bits >= 8 and (position % 8 or bits % 8):
+					raise DescriptionError('PDO 0x%04X: %s does not start on a byte' % (pdo.index, entry.name))
+				if item and bits == 1:
+					if entry.variable in shadows:
+						raise DescriptionError('bit variable %s is mapped twice' % entry.variable)
+					shadows.add(entry.variable)
+				position += bits
+			if position % 8:
+				raise DescriptionError('PDO 0x%04X is not padded to whole bytes' % pdo.index)
+
+	def checkValues(self, index, values):
+		if index not in self.dictionary:
+			raise DescriptionError('object 0x%04X is missing from the dictionary' % index)
+		entries = self.dictionary[index].entries
+		if [number(entry.default) for entry in entries] != [len(values)] + values:
+			raise DescriptionError('object 0x%04X does not match its Pdo section' % index)
+
+	def pdoOf(self, item):
+		for pdo in self.rxPdos + self.txPdos:
+			for mapped, entry in pdo.entries:
+				if mapped is item:
+					return pdo
+		return None
+
+	def backups(self):
+		return [(item, entry) for item in self.items for entry in item.entries if entry.backup]
+
+	def bytes(self, pdos):
+		return sum(pdo.bits() for pdo in pdos)//8
+
+
+def cData(description, item, entry):
+	if entry.data:
+		return '&' + entry.data
+	if entry.isString():
+		return '"%s"' % entry.default
+	pdo = description.pdoOf(item)
+	if pdo is None or entry.subindex == 0 or not entry.variable:
+		return 'NULL'
+	if entry.bits() == 1:
+		return '&%s.%s' % (SHADOW, cName(entry.variable))
+	buffer = READBUFFER if pdo.direction == 'Input' else WRITEBUFFER
+	cast = '(void*)' if entry.bits() > 8 else ''														# Packed members, no alignment promised
+	return '%s&%s.%s.%s' % (cast, buffer, cName(pdo.container), cName(entry.variable))
+
+
+def generateSource(description):
+	lines = [GENERATED, '#include "objectlist.h"\n', '#include "middleSOES.h"\n']
+	lines += ['#include "%s"\n' % include for include in description.includes]
+	lines.append('\n')
+
+	for item in description.items:
+		lines.append('static const char acName%04X[] = "%s";\n' % (item.index, item.name))
+		if item.isVar():
+			lines.append('static const char acName%04X_0[] = "%s";\n' % (item.index, item.name))
+		else:
+			for entry in item.entries:
+				lines.append('static const char acName%04X_%02X[] = "%s";\n' % (item.index, entry.subindex, entry.name))
+
+	lines.append('\n')
+	for item in description.items:
+		lines.append('const _objd SDO%04X[] =\n{\n' % item.index)
+		for entry in item.entries:
+			subindex = '0x0' if item.isVar() else '0x%02X' % entry.subindex
+			name = 'acName%04X_0' % item.index if item.isVar() else 'acName%04X_%02X' % (item.index, entry.subindex)
+			dtype = 'DTYPE_VISIBLE_STRING' if entry.isString() else TYPES[entry.type][0]
+			value = '0' if entry.isString() or entry.data else entry.default
+			lines.append('  {%s, %s, %d, %s, %s, %s, %s},\n' % (subindex, dtype, entry.bits(), ACCESS[entry.access], name, value,
+				cData(description, item, entry)))
+		lines.append('};\n')
+
+	lines.append('\nconst _objectlist SDOobjects[] =\n{\n')
+	for item in description.items:
+		otype = 'OTYPE_VAR' if item.isVar() else 'OTYPE_' + item.objectType
+		maxsub = 0 if item.isVar() else len(item.entries) - 1
+		lines.append('  {0x%04X, %s, %d, 0, acName%04X, SDO%04X},\n' % (item.index, otype, maxsub, item.index, item.index))
+	lines.append('  {0xffff, 0xff, 0xff, 0xff, NULL, NULL}\n};\n')
+
+	lines.append('\nconst objectlistParameterTypedef objectlistParameters[] =\n{\n')
+	for item, entry in description.backups():
+		lines.append('  {0x%06X, &%s, %d},\n' % ((item.index << 8) | entry.subindex, entry.data, (entry.bits() + 7)//8))
+	lines.append('};\n')
+	lines += generateInfo(description)
+
+	for direction, pdos, buffer in (('Tx', description.txPdos, READBUFFER), ('Rx', description.rxPdos, WRITEBUFFER)):
+		lines.append('\nvoid objectlist%sPDOShadowUpdate(void) {\n' % direction)
+		for pdo in pdos:
+			for item, entry in pdo.entries:
+				if item and entry.bits() == 1:
+					lines.append('\t%s.%s = %s.%s.%s;\n' % (SHADOW, cName(entry.variable), buffer, cName(pdo.container), cName(entry.variable)))
+		lines.append('}\n')
+
+	return ''.join(lines)
+
+
+def infoResponse(opcode, payload, fragmentsLeft=0, incomplete=False):
+	header = [COE_SDOINFORMATION & 0xFF, COE_SDOINFORMATION >> 8, opcode | (0x80 if incomplete else 0), 0, fragmentsLeft & 0xFF, fragmentsLeft >> 8]
+	return header + payload
+
+
+def le16(value):
+	return [value & 0xFF, value >> 8]
+
+
+def infoArray(name, data, comment):
+	lines = ['// %s\n' % comment, 'static const uint8_t %s[] =\n{\n' % name]
+	for start in range(0, len(data), 16):
+		lines.append('  ' + ' '.join('0x%02X,' % byte for byte in data[start:start + 16]) + '\n')
+	lines.append('};\n')
+	return lines
+
+
+# SDO Information answers are fixed by the dictionary, so they are built here the way esc_coe.c would and posted
+# as they are. Each _COEinfo is the mailbox data after the mailbox header, its length the header length field.
+def generateInfo(description):
+	if not description.mailboxSize:
+		raise DescriptionError('the Mailbox needs a Standard Length to size the SDO information responses')
+	dataSize = description.mailboxSize - MBXHSIZE
+	listSize = (description.mailboxSize - MBXHSIZE - 2 - 4 - 2) & 0xFFFE
+	perFragment = listSize >> 1
+	indexes = [item.index for item in description.items]
+	frags = (len(indexes)*2 + listSize - 1)//listSize
+
+	lines = ['\n#if MBXSIZE != %d\n' % description.mailboxSize,
+		'#error "The SDO information responses were built for a %d byte mailbox, regenerate"\n' % description.mailboxSize, '#endif\n\n']
+	fragments = []
+	lines += infoArray('SDOodcountdata', infoResponse(COE_GETODLISTRESPONSE, le16(0) + le16(len(indexes)) + le16(0)*4),
+		'Get OD list, number of objects')
+	for fragment in range(frags):
+		start = fragment*perFragment
+		end = min(start + perFragment, len(indexes))
+		payload = (le16(1) if not fragment else []) + sum((le16(index) for index in indexes[start:end]), [])
+		lines += infoArray('SDOodlist%d' % fragment, infoResponse(COE_GETODLISTRESPONSE, payload, frags - 1 - fragment, fragment < frags - 1),
+			'Get OD list, all objects, fragment %d' % fragment)
+		fragments.append('SDOodlist%d' % fragment)
+
+	for item in description.items:
+		otype = 'OTYPE_VAR' if item.isVar() else 'OTYPE_' + item.objectType
+		first = item.entries[0]
+		datatype = DTYPE_CODES['DTYPE_VISIBLE_STRING' if first.isString() else TYPES[first.type][0]] if item.isVar() else 0
+		maxsub = 0 if item.isVar() else len(item.entries) - 1
+		name = list(item.name.encode('ascii'))[:dataSize - 0x0C]
+		lines += infoArray('SDOod%04X' % item.index, infoResponse(COE_GETODRESPONSE, le16(item.index) + le16(datatype) + [maxsub,
+			OTYPE_CODES[otype]] + name), 'Object description 0x%04X' % item.index)
+		for entry in item.entries:
+			subindex = 0 if item.isVar() else entry.subindex
+			dtype = 'DTYPE_VISIBLE_STRING' if entry.isString() else TYPES[entry.type][0]
+			name = list((item.name if item.isVar() else entry.name).encode('ascii'))[:dataSize - 0x10]
+			lines += infoArray('SDOed%04X_%02X' % (item.index, subindex), infoResponse(COE_ENTRYDESCRIPTIONRESPONSE, le16(item.index) +
+				[subindex, COE_VALUEINFO] + le16(DTYPE_CODES[dtype]) + le16(entry.bits()) + le16(ACCESS_CODES[ACCESS[entry.access]]) + name),
+				'Entry description 0x%04X:%02X' % (item.index, subindex))
+
+	lines.append('\nconst _COEinfo SDOodcount = {sizeof(SDOodcountdata), SDOodcountdata};\n')
+	lines.append('const uint16_t SDOodlistfrags = %d;\n' % frags)
+	lines.append('const _COEinfo SDOodlist[] =\n{\n')
+	lines += ['  {sizeof(%s), %s},\n' % (fragment, fragment) for fragment in fragments]
+	lines.append('};\n')
+	for item in description.items:
+		lines.append('static const _COEinfo SDOed%04X[] =\n{\n' % item.index)
+		for entry in item.entries:
+			subindex = 0 if item.isVar() else entry.subindex
+			lines.append('  {sizeof(SDOed%04X_%02X), SDOed%04X_%02X},\n' % (item.index, subindex, item.index, subindex))
+		lines.append('};\n')
+	lines.append('\nconst _objectinfo SDOinfo[] =\n{\n')
+	for item in description.items:
+		lines.append('  {{sizeof(SDOod%04X), SDOod%04X}, SDOed%04X},\n' % (item.index, item.index, item.index))
+	lines.append('};\n')
+	return lines
+
+
+def generateBuffer(pdos, typedef):
+	lines = ['typedef struct CC_PACKED {\n']
+	for pdo in pdos:
+		lines.append('\tstruct CC_PACKED {\n')
+		pad = 0
+		for item, entry in pdo.entries:
+			if not item:
+				lines.append('\t\tuint8_t pad%d:%d;\n' % (pad, entry))
+				pad += 1
+			elif entry.bits() == 1:
+				lines.append('\t\tuint8_t %s:1;\n' % cName(entry.variable))
+			else:
+				lines.append('\t\t%s %s;\n' % (TYPES[entry.type][3], cName(entry.variable)))
+		lines.append('\t} %s;\n' % cName(pdo.container))
+	lines.append('} %s;\n\n' % typedef)
+	return lines
+
+
+def generateAsserts(pdos, typedef, size):
+	lines = ['CC_STATIC_ASSERT(sizeof(%s) == %s);\n' % (typedef, size)]
+	offset = 0
+	for pdo in pdos:
+		container = cName(pdo.container)
+		lines.append('CC_STATIC_ASSERT(offsetof(%s,%s) == %d);\n' % (typedef, container, offset//8))
+		lines.append('CC_STATIC_ASSERT(sizeof(((%s *)0)->%s) == %d);\n' % (typedef, container, pdo.bits()//8))
+		for item, entry in pdo.entries:
+			if item and entry.bits() >= 8:
+				lines.append('CC_STATIC_ASSERT(offsetof(%s,%s.%s) == %d);\n' % (typedef, container, cName(entry.variable), offset//8))
+			offset += entry.bits() if item else entry
+	return lines
+
+
+def generateHeader(description):
+	lines = [GENERATED, '#ifndef __OBJECTLIST_H\n', '#define __OBJECTLIST_H\n', '\n', '#include "esc_coe.h"\n', '#include <stddef.h>\n', '\n']
+	lines.append('#define objectlistRxPDOSize\t\t\t\t\t\t%d\t\t\t\t\t\t\t\t\t\t\t// SM2 bytes, the Outputs Sm DefaultSize in the ESI\n' % description.bytes(description.rxPdos))
+	lines.append('#define objectlistTxPDOSize\t\t\t\t\t\t%d\t\t\t\t\t\t\t\t\t\t\t// SM3 bytes, the Inputs Sm DefaultSize in the ESI\n\n' % description.bytes(description.txPdos))
+
+	lines += generateBuffer(description.txPdos, 'middleSOESReadbufferTypedef')
+
+	# Bit fields have no address, SDO access to them goes through a byte copy
+	lines.append('typedef struct {\n')
+	for pdo in description.txPdos + description.rxPdos:
+		for item, entry in pdo.entries:
+			if item and entry.bits() == 1:
+				lines.append('\tint8_t %s;\n' % cName(entry.variable))
+	lines.append('} middleSOESReadBufferBooleansTypedef;\n\n')
+
+	lines += generateBuffer(description.rxPdos, 'middleSOESWritebufferTypedef')
+
+	lines.append('// The buffers go to and from the SMs in one copy, so their layout must be the one declared in the ESI\n')
+	lines += generateAsserts(description.txPdos, 'middleSOESReadbufferTypedef', 'objectlistTxPDOSize')
+	lines += generateAsserts(description.rxPdos, 'middleSOESWritebufferTypedef', 'objectlistRxPDOSize')
+
+	lines.append('\nextern middleSOESReadbufferTypedef \t\t\t\t\tmiddleSOESReadBuffer;\n')
+	lines.append('extern middleSOESReadBufferBooleansTypedef\tmiddleSOESReadBufferBooleans;\n')
+	lines.append('extern middleSOESWritebufferTypedef \t\t\t\tmiddleSOESWriteBuffer;\n\n')
+	lines.append('// Entries flagged <Backup> in the description, what 0x1010 stores\n')
+	lines.append('typedef struct {\n\tuint32_t Key;\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t// Index << 8 | SubIndex\n')
+	lines.append('\tvoid *Data;\n\tuint16_t Size;\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t// Bytes\n')
+	lines.append('} objectlistParameterTypedef;\n\n')
+	lines.append('#define objectlistParameterCount\t\t\t\t%d\n' % len(description.backups()))
+	lines.append('extern const objectlistParameterTypedef objectlistParameters[];\n\n')
+	lines.append('void objectlistTxPDOShadowUpdate(void);\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t// Bit inputs to their SDO shadows, after the buffer changed\n')
+	lines.append('void objectlistRxPDOShadowUpdate(void);\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t// Bit outputs to their SDO shadows, after the buffer changed\n\n')
+	lines.append('#endif //__OBJECTLIST_H\n')
+	return ''.join(lines)
+
+
+class EsiWriter:
+	def __init__(self, indent):
+		self.lines = []
+		self.indent = indent
+
+	def open(self, tag, attributes=''):
+		self.lines.append('%s<%s%s>\n' % (' '*self.indent, tag, attributes))
+		self.indent += 2
+
+	def close(self, tag):
+		self.indent -= 2
+		self.lines.append('%s</%s>\n' % (' '*self.indent, tag))
+
+	def leaf(self, tag, text, attributes=''):
+		self.lines.append('%s<%s%s>%s</%s>\n' % (' '*self.indent, tag, attributes, escape(str(text)), tag))
+
+	def empty(self, tag, attributes=''):
+		self.lines.append('%s<%s%s/>\n' % (' '*self.indent, tag, attributes))
+
+
+def escape(text):
+	return text.replace('&', '&amp;').replace('<', '&lt;').replace('>', '&gt;')
+
+
+def esiSubItemLayout(item):
+	# Sub index 0 takes 16 bits, every further entry at least a byte
+	layout, offset = [], 16
+	for entry in item.entries[1:]:
+		layout.append((entry, offset))
+		offset += max(entry.bits(), 8)
+	return layout, offset
+
+
+def esiFlags(writer, access, pdo=None, category=None, backup=False):
+	writer.open('Flags')
+	writer.leaf('Access', 'ro' if access == 'RO' else 'rw')
+	if pdo:
+		writer.leaf('PdoMapping', 'T' if pdo.direction == 'Input' else 'R')
+	if category:
+		writer.leaf('Category', category)
+	if backup:
+		writer.leaf('Backup', 1)
+	writer.close('Flags')
+
+
+def generateEsi(description):
+	writer = EsiWriter(8)
+	writer.open('Profile')
+	writer.leaf('ProfileNo', '5001')
+	writer.leaf('AddInfo', '400')
+	writer.open('Dictionary')
+	writer.open('DataTypes')
+
+	baseTypes = {}
+	for item in description.items:
+		for entry in item.entries:
+			baseTypes[entry.esiType()] = entry.bits()
+
+	for item in description.items:
+		if item.isVar():
+			continue
+		pdo = description.pdoOf(item)
+		layout, size = esiSubItemLayout(item)
+		name = 'DT%04X' % item.index
+		if item.objectType == 'ARRAY':
+			element = item.entries[1]
+			writer.open('DataType')
+			writer.leaf('Name', name + 'ARR')
+			writer.leaf('BaseType', element.esiType())
+			writer.leaf('BitSize', (len(item.entries) - 1)*element.bits())
+			writer.open('ArrayInfo')
+			writer.leaf('LBound', 1)
+			writer.leaf('Elements', len(item.entries) - 1)
+			writer.close('ArrayInfo')
+			writer.close('DataType')
+			size = 16 + (len(item.entries) - 1)*element.bits()
+		writer.open('DataType')
+		writer.leaf('Name', name)
+		writer.leaf('BitSize', size)
+		writer.open('SubItem')
+		writer.leaf('SubIdx', 0)
+		writer.leaf('Name', item.entries[0].name)
+		writer.leaf('Type', 'USINT')
+		writer.leaf('BitSize', 8)
+		writer.leaf('BitOffs', 0)
+		esiFlags(writer, 'RO')
+		writer.close('SubItem')
+		if item.objectType == 'ARRAY':
+			writer.open('SubItem')
+			writer.leaf('Name', 'Elements')
+			writer.leaf('Type', name + 'ARR')
+			writer.leaf('BitSize', size - 16)
+			writer.leaf('BitOffs', 16)
+			esiFlags(writer, item.entries[1].access)
+			writer.close('SubItem')
+		else:
+			for entry, offset in layout:
+				writer.open('SubItem')
+				writer.leaf('SubIdx', entry.subindex)
+				writer.leaf('Name', entry.name)
+				writer.leaf('Type', entry.esiType())
+				writer.leaf('BitSize', entry.bits())
+				writer.leaf('BitOffs', offset)
+				esiFlags(writer, entry.access, pdo, backup=entry.backup)
+				writer.close('SubItem')
+		writer.close('DataType')
+
+	for name in sorted(baseTypes):
+		writer.open('DataType')
+		writer.leaf('Name', name)
+		writer.leaf('BitSize', baseTypes[name])
+		writer.close('DataType')
+	writer.close('DataTypes')
+
+	writer.open('Objects')
+	for item in description.items:
+		writer.open('Object')
+		writer.leaf('Index', '#x%04X' % item.index)
+		writer.leaf('Name', item.name)
+		if item.isVar():
+			entry = item.entries[0]
+			writer.leaf('Type', entry.esiType())
+			writer.leaf('BitSize', entry.bits())
+			writer.open('Info')
+			writer.leaf('DefaultString' if entry.isString() else 'DefaultValue', entry.default if entry.isString() else esiNumber(entry.default))
+			writer.close('Info')
+			esiFlags(writer, entry.access, category=CATEGORY.get(item.index), backup=entry.backup)
+		else:
+			writer.leaf('Type', 'DT%04X' % item.index)
+			writer.leaf('BitSize', esiSubItemLayout(item)[1] if item.objectType == 'RECORD' else 16 + (len(item.entries) - 1)*item.entries[1].bits())
+			writer.open('Info')
+			for entry in item.entries:
+				writer.open('SubItem')
+				writer.leaf('Name', entry.name)
+				if not entry.isOctetString():																		# Filled in at run time, nothing to default to
+					writer.open('Info')
+					writer.leaf('DefaultValue', esiNumber(entry.default))
+					writer.close('Info')
+				writer.close('SubItem')
+			writer.close('Info')
+			esiFlags(writer, 'RO', category=CATEGORY.get(item.index))
+		writer.close('Object')
+	writer.close('Objects')
+	writer.close('Dictionary')
+	writer.close('Profile')
+
+	writer.leaf('Fmmu', 'Outputs')
+	writer.leaf('Fmmu', 'Inputs')
+	writer.leaf('Fmmu', 'MBoxState')
+	for name, control, start, size in description.sms:
+		if name == 'Outputs':
+			size = description.bytes(description.rxPdos)
+		elif name == 'Inputs':
+			size = description.bytes(description.txPdos)
+		writer.leaf('Sm', name, ' ControlByte="%s" DefaultSize="%s" Enable="1" StartAddress="%s"' % (esiNumber(control), size, esiNumber(start)))
+
+	for tag, sm, pdos in (('RxPdo', 2, description.rxPdos), ('TxPdo', 3, description.txPdos)):
+		for pdo in pdos:
+			writer.open(tag, ' Fixed="true" Mandatory="true" Sm="%d"' % sm)
+			writer.leaf('Index', '#x%04X' % pdo.index)
+			writer.leaf('Name', pdo.name)
+			for item, entry in pdo.entries:
+				writer.open('Entry')
+				if item:
+					writer.leaf('Index', '#x%04X' % item.index)
+					writer.leaf('SubIndex', entry.subindex)
+					writer.leaf('BitLen', entry.bits())
+					writer.leaf('Name', entry.name)
+					writer.leaf('DataType', entry.esiType())
+				else:
+					writer.leaf('Index', 0)
+					writer.leaf('SubIndex', 0)
+					writer.leaf('BitLen', entry)
+				writer.close('Entry')
+			writer.close(tag)
+
+	writer.open('Mailbox')
+	if description.mailbox.get('EoE') == 'true':
+		writer.empty('EoE', ' IP="true" MAC="true"')
+	if description.mailbox.get('CoE') == 'true':
+		writer.empty('CoE', ' CompleteAccess="false" PdoUpload="true" SdoInfo="true"')
+	if description.mailbox.get('FoE') == 'true':
+		writer.empty('FoE')
+	writer.close('Mailbox')
+	return ''.join(writer.lines)
+
+
+def spliceEsi(description, text):
+	device = re.search(r'<Device\b[^>]*>\s*<Type ProductCode="#x%08X"' % description.productCode, text)
+	if not device:
+		raise DescriptionError('no device with product code 0x%08X in %s' % (description.productCode, ESI))
+	start = text.index('        <Profile>', device.start())
+	end = text.index('</Mailbox>\n', start) + len('</Mailbox>\n')
+	if text.find('</Device>', device.start()) < end:
+		raise DescriptionError('device 0x%08X has no Profile or Mailbox' % description.productCode)
+	return text[:start] + generateEsi(description) + text[end:]
+
+
+def checkEsiDevices(text):
+	# Devices not generated here still get their process data sizes checked
+	warnings = []
+	for device in ET.fromstring(text).iter('Device'):
+		name = device.findtext('Name')
+		for sm, tag, smName in ((2, 'RxPdo', 'Outputs'), (3, 'TxPdo', 'Inputs')):
+			bits = sum(int(entry.findtext('BitLen')) for pdo in device.findall(tag) if pdo.get('Sm') == str(sm)
+				for entry in pdo.findall('Entry'))
+			declared = [int(element.get('DefaultSize')) for element in device.findall('Sm') if element.text == smName]
+			if declared and declared[0]*8 != bits:
+				warnings.append('%s: %s Sm declares %d bytes, its PDOs take %d bits' % (name, smName, declared[0], bits))
+	return warnings
+
+
+def main():
+	check = '--check' in sys.argv[1:]
+	try:
+		description = Description(DESCRIPTION)
+		with open(ESI) as file:
+			esi = spliceEsi(description, file.read())
+	except (DescriptionError, ET.ParseError) as error:
+		sys.stderr.write('esigen: %s\n' % error)
+		return 2
+
+	for warning in checkEsiDevices(esi):
+		sys.stderr.write('esigen: warning: %s\n' % warning)
+
+	outputs = ((OBJECTLIST_C, generateSource(description)), (OBJECTLIST_H, generateHeader(description)), (ESI, esi))
+	stale = []
+	for path, content in outputs:
+		with open(path) as file:
+			current = file.read()
+		if current == content:
+			continue
+		stale.append(os.path.relpath(path, ROOT))
+		if not check:
+			with open(path, 'w') as file:
+				file.write(content)
+
+	if check and stale:
+		sys.stderr.write('esigen: out of date: %s\n' % ', '.join(stale))
+		return 1
+	for path in stale:
+		print('esigen: wrote %s' % path)
+	return 0
+
+
+if __name__ == '__main__':
+	sys.exit(main())
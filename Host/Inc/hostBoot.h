@@ -0,0 +1,16 @@
+#ifndef __HOSTBOOT_H
+#define __HOSTBOOT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Host side of driverHWBoot: which slot the host slave "runs" from, and the reset and watchdog requests of the
+// firmware, which the harness turns into a reboot through the bootloader logic.
+
+void hostBootSetRunningImage(uint32_t image);
+bool hostBootResetRequested(void);
+void hostBootClearReset(void);
+bool hostBootWatchdogRunning(void);
+uint32_t hostBootWatchdogKicks(void);
+
+#endif
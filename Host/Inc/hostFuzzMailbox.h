@@ -0,0 +1,27 @@
+#ifndef __HOSTFUZZMAILBOX_H
+#define __HOSTFUZZMAILBOX_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Mailbox fuzz target. Every input is a sequence of frames, each one a length byte followed by that many bytes of
+// raw mailbox (header included). The frames are written into SM0 from the wire side of the simulated LAN9252, so
+// they go through ESC_mbxprocess, CoE, FoE and the unsupported protocol path exactly as from a real master.
+// Each input starts from a fresh INIT to PREOP transition. The entry point is libFuzzer's, hostFuzzMain.c drives it
+// without libFuzzer.
+
+#define hostFuzzMailboxTaskRuns					8																			// Mailbox task runs per frame
+#define hostFuzzMailboxMaxFrames				64																		// Frames taken from one input
+
+typedef struct {
+	uint32_t Inputs;
+	uint32_t Frames;																											// Frames handed to the slave
+	uint32_t FramesRefused;																								// SM0 still full, frame dropped
+	uint32_t Responses;																										// Mailboxes the slave posted in SM1
+	uint32_t Stalls;																											// Inputs after which a plain SDO upload got no answer
+} hostFuzzMailboxStatisticsStruct;
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+const hostFuzzMailboxStatisticsStruct *hostFuzzMailboxGetStatistics(void);
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef __HOSTLAN9252_H
+#define __HOSTLAN9252_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Simulated LAN9252 for the host build. The PDI side is modelled at the SPI byte level so the real
+// driverSWLAN9252.c runs unmodified on top of it. The EtherCAT side is a plain memory interface for a
+// master stand-in. CSR space, process RAM, SyncManager buffer handling and the AL registers are modelled.
+
+#define hostLAN9252ESCMemorySize				0x3000							// Registers plus process RAM
+#define hostLAN9252FIFODepth						16									// DWORDs reported as available per poll
+#define hostLAN9252DefaultBusyPolls			1										// Command register reads that still report busy
+
+#define hostLAN9252IDRev								0x92520001
+#define hostLAN9252ByteOrder						0x87654321
+#define hostLAN9252DefaultALEventMask		0x00FFFF0F
+
+typedef struct {
+	uint32_t CSCycles;																										// SPI transactions, CS low to high
+	uint32_t SPIBytes;
+	uint32_t CSRReads;																										// ESC CSR commands
+	uint32_t CSRWrites;
+	uint32_t PRAMReads;																										// Process RAM FIFO commands
+	uint32_t PRAMWrites;
+	uint32_t BusyPolls;																										// Command register reads that returned busy or not available
+	uint32_t IRQs;																												// IRQ assertions
+} hostLAN9252StatisticsStruct;
+
+void hostLAN9252Reset(void);
+void hostLAN9252SetBusyPolls(uint32_t polls);
+
+// PDI (SPI) side, used by the host driverHWSPI1
+void hostLAN9252Select(bool selected);
+uint8_t hostLAN9252Transfer(uint8_t mosi);
+
+// EtherCAT side, used by the master stand-in. False is a zero working counter (mailbox not ready)
+bool hostLAN9252MasterRead(uint16_t address, void *buffer, uint16_t length);
+bool hostLAN9252MasterWrite(uint16_t address, const void *buffer, uint16_t length);
+uint32_t hostLAN9252GetALEvent(void);
+bool hostLAN9252IRQAsserted(void);
+void hostLAN9252BindIRQFunction(void (*callback)(void));
+
+const hostLAN9252StatisticsStruct *hostLAN9252GetStatistics(void);
+void hostLAN9252ResetStatistics(void);
+
+#endif
@@ -0,0 +1,100 @@
+#ifndef __HOSTMASTER_H
+#define __HOSTMASTER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config.h"
+
+// EtherCAT master stand-in for the host build. It talks to the simulated LAN9252 from the wire side: AL control,
+// SyncManager setup, cyclic SM2 outputs / SM3 inputs, CoE SDO uploads, downloads, SDO information and emergencies,
+// FoE reads and writes and EoE frames through the mailbox. It runs from the platform service points, so it keeps its
+// own cycle while the firmware is busy or asleep.
+
+#define hostMasterStateTimeout					1000000										// us a state transition may take
+#define hostMasterDefaultCycleTime			1000											// us
+#define hostMasterMailboxTypeCoE				0x03
+#define hostMasterCoEServiceSDORequest	0x02
+#define hostMasterCoEServiceSDOResponse	0x03
+#define hostMasterCoEServiceEmergency		0x01
+#define hostMasterCoEServiceSDOInformation	0x08
+#define hostMasterEmergencyQueue				8																// Emergencies received and not fetched yet
+#define hostMasterSDOUploadRequest			0x40
+#define hostMasterSDOAbort							0x80
+#define hostMasterSDODownloadRequest		0x20
+#define hostMasterSDODownloadResponse		0x60
+#define hostMasterSDOExpedited					0x02
+#define hostMasterSDOSizeIndicated			0x01
+#define hostMasterSDOInfoGetODList			0x01
+#define hostMasterSDOInfoGetOD					0x03
+#define hostMasterSDOInfoGetED					0x05
+#define hostMasterSDOInfoError					0x07
+#define hostMasterMailboxTypeFoE				0x04
+#define hostMasterFoEReadRequest				0x01
+#define hostMasterFoEWriteRequest				0x02
+#define hostMasterFoEData								0x03
+#define hostMasterFoEAck								0x04
+#define hostMasterFoEError							0x05
+#define hostMasterFoEHeaderSize					6
+#define hostMasterFoEDataSize						(MBX0_sml - 6 - hostMasterFoEHeaderSize)	// Payload of one data packet
+#define hostMasterMailboxTypeEoE				0x02
+#define hostMasterEoEFragment						0x00
+#define hostMasterEoEInitRequest				0x02
+#define hostMasterEoEInitResponse				0x03
+#define hostMasterEoELastFragment				0x0100
+#define hostMasterEoEHeaderSize					4
+#define hostMasterEoEDataSize						(MBX0_sml - 6 - hostMasterEoEHeaderSize)
+#define hostMasterEoEFragmentSize				(hostMasterEoEDataSize & ~31)			// Whole 32 byte blocks unless it is the last
+#define hostMasterEoEFrameSize					1514
+#define hostMasterEoEQueue							8																// Frames received and not fetched yet
+
+typedef struct {
+	uint32_t CycleTime;																										// us
+	uint32_t Cycles;
+	uint32_t MissedCycles;																								// Outputs of the previous cycle still unread by the slave
+	uint32_t LateCycles;																									// Master itself a full cycle behind
+	uint32_t WorstCycleJitter;																						// us
+	uint32_t Reactions;																										// Outputs picked up by the slave
+	uint64_t ReactionTimeTotal;																						// us
+	uint32_t WorstReactionTime;																						// us from SM2 write to the PDI reading it
+	uint32_t SDORequests;
+	uint32_t SDOResponses;
+	uint32_t SDOAborts;
+	uint64_t SDOTimeTotal;																								// us
+	uint32_t WorstSDOTime;																								// us from request to response read back
+	uint32_t MailboxRefused;																							// Zero working counter on a mailbox access
+	uint32_t FoEPackets;																									// Data packets acknowledged
+	uint32_t FoEBytes;
+	uint32_t FoEErrors;																										// Transfers the slave aborted or that timed out
+	uint32_t EoEFramesSent;
+	uint32_t EoEFramesReceived;
+	uint32_t EoEFragmentsSent;
+	uint32_t EoEFragmentsReceived;
+	uint32_t EoEDropped;																									// Out of order fragments or a full queue
+	uint32_t Emergencies;
+	uint32_t EmergenciesDropped;																					// Queue full
+} hostMasterStatisticsStruct;
+
+void hostMasterInit(void);
+void hostMasterRequestState(uint8_t state);
+bool hostMasterSetState(uint8_t state, uint32_t *transitionTime);
+uint8_t hostMasterGetState(void);
+void hostMasterStartCycle(uint32_t cycleTime, uint32_t sdoInterval);
+void hostMasterStopCycle(void);
+bool hostMasterMailboxSend(uint8_t type, const uint8_t *data, uint16_t length);
+bool hostMasterMailboxReceive(uint8_t *type, uint8_t *data, uint16_t *length);
+bool hostMasterSDOUploadStart(uint16_t index, uint8_t subIndex);
+bool hostMasterSDOUpload(uint16_t index, uint8_t subIndex, uint8_t *data, uint32_t size, uint32_t *length);
+bool hostMasterSDODownload(uint16_t index, uint8_t subIndex, const uint8_t *data, uint8_t length);
+bool hostMasterSDOInfo(uint8_t opcode, const uint8_t *data, uint16_t length, uint8_t *response, uint32_t size, uint32_t *received);
+bool hostMasterFoEWrite(const char *name, uint32_t password, const uint8_t *data, uint32_t length, uint32_t *transferTime);
+bool hostMasterFoERead(const char *name, uint32_t password, uint8_t *data, uint32_t size, uint32_t *length, uint32_t *transferTime);
+bool hostMasterEoESetIP(const uint8_t *mac, uint32_t ip, uint32_t subnet, uint16_t *result);
+bool hostMasterEoESend(const uint8_t *frame, uint16_t length);
+bool hostMasterEoEReceive(uint8_t *frame, uint16_t size, uint16_t *length, uint32_t timeout);
+bool hostMasterEmergencyReceive(uint16_t *errorCode, uint8_t *errorRegister, uint32_t timeout);
+void hostMasterSetOutputBits(uint8_t bits);
+void hostMasterPoll(void);
+const hostMasterStatisticsStruct *hostMasterGetStatistics(void);
+void hostMasterResetStatistics(void);
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef __HOSTNUNCHUCK_H
+#define __HOSTNUNCHUCK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Host side of the simulated nunchuck behind driverHWI2C3. At rest it always reports the same sample, in motion every
+// sensor read gets the next one of a repeatable pattern: the accelerometer swinging on two axes with a little noise,
+// the joystick sweeping and the C button pressed now and then. It can also be unplugged, then every transfer is NACKed,
+// and given calibration data that reads all 0xFF like the one of some clones. A drift moves the joystick rest centre
+// and the accelerometer Z reading, as temperature and wear do.
+
+#define hostNunChuckButtonInterval				400																	// Samples between button presses in motion
+#define hostNunChuckButtonLength					40																	// Samples a press lasts
+
+void hostNunChuckSetMotion(bool motion);
+void hostNunChuckSetConnected(bool connected);
+void hostNunChuckSetCalibrationValid(bool valid);
+void hostNunChuckSetDrift(int8_t joystick, int16_t accelerometerZ);
+
+#endif
@@ -0,0 +1,24 @@
+#ifndef __HOSTPLATFORM_H
+#define __HOSTPLATFORM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Host side of the HAL stand-in. There is no NVIC, pending "interrupts" (timer compares and the ESC IRQ pin) are
+// delivered from hostPlatformService(), which __WFI(), unmasking and the master stand-in call.
+
+#define hostPlatformCoreClock						72000000								// Matches HCLK on the target, DWT counts at this rate
+#define hostPlatformIdlePoll						10											// us between service passes while waiting for an interrupt
+#define hostPlatformIdleLimit						100000									// us, upper bound on one __WFI()
+
+uint64_t hostPlatformGetNanoseconds(void);
+uint32_t hostPlatformGetMicroseconds(void);
+bool hostPlatformService(void);
+void hostPlatformWaitForInterrupt(void);
+void hostPlatformBindExternalFunction(void (*function)(void));												// E.g. the master stand-in, runs at every service point
+
+// Interrupt sources, implemented by the host drivers. Return whether something is pending, deliver runs it.
+bool driverHWECATTickTimerService(bool deliver);
+bool driverHWLANInterruptService(bool deliver);
+
+#endif
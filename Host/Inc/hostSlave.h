@@ -0,0 +1,31 @@
+#ifndef __HOSTSLAVE_H
+#define __HOSTSLAVE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "modScheduler.h"
+#include "middleNunChuck.h"
+
+// The firmware main loop for the host build. Same module init and task set as Main/main.c, minus clocks and USB.
+// On top of that FoE gets a RAM backed file next to the firmware update, so the mailbox harnesses have a plain FoE
+// write target as well, and every sensor sample can be recorded to check the capture against. The slave starts from
+// application slot A of the simulated flash, reboots go through the bootloader's slot selection.
+
+#define hostSlaveFoEFileName					"host.bin"
+#define hostSlaveFoEFileSize					0x10000															// Bytes, a multiple of the buffer size
+#define hostSlaveFoEBufferSize				128																	// Bytes handed to the write hook at once
+
+bool hostSlaveInit(void);
+bool hostSlaveReboot(void);
+void hostSlaveStep(void);
+void hostSlaveRunFor(uint32_t microseconds);
+int8_t hostSlaveProcessDataTask(void);
+int8_t hostSlaveMailboxTask(void);
+int8_t hostSlaveSensorTask(void);
+const uint8_t *hostSlaveFoEFile(uint32_t *length);
+void hostSlaveFoEFileClear(void);
+void hostSlaveRecordSamples(middleNunChuckDataStruct *buffer, uint32_t size);
+uint32_t hostSlaveRecordedSamples(void);
+middleNunChuckDataStruct hostSlaveLatestSample(void);
+
+#endif
@@ -0,0 +1,129 @@
+#ifndef __HOST_STM32F3XX_HAL_H
+#define __HOST_STM32F3XX_HAL_H
+
+// Host stand-in for the STM32F3 HAL and CMSIS core. Only what the firmware sources in the host build touch is
+// modelled. Peripheral registers are plain memory, core registers are emulated in hostHAL.c.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#define __NVIC_PRIO_BITS						4
+
+typedef enum {
+	HAL_OK = 0x00,
+	HAL_ERROR = 0x01,
+	HAL_BUSY = 0x02,
+	HAL_TIMEOUT = 0x03
+} HAL_StatusTypeDef;
+
+typedef enum {
+	GPIO_PIN_RESET = 0,
+	GPIO_PIN_SET
+} GPIO_PinState;
+
+typedef struct {
+	volatile uint32_t MODER;
+	volatile uint32_t OTYPER;
+	volatile uint32_t OSPEEDR;
+	volatile uint32_t PUPDR;
+	volatile uint32_t IDR;
+	volatile uint32_t ODR;
+	volatile uint32_t BSRR;
+	volatile uint32_t LCKR;
+	volatile uint32_t AFR[2];
+	volatile uint32_t BRR;
+} GPIO_TypeDef;
+
+typedef struct {
+	uint32_t Pin;
+	uint32_t Mode;
+	uint32_t Pull;
+	uint32_t Speed;
+	uint32_t Alternate;
+} GPIO_InitTypeDef;
+
+typedef struct {
+	volatile uint32_t AHBENR;
+} RCC_TypeDef;
+
+typedef struct {
+	volatile uint32_t CTRL;
+	volatile uint32_t CYCCNT;
+} DWT_Type;
+
+typedef struct {
+	volatile uint32_t DEMCR;
+} CoreDebug_Type;
+
+extern GPIO_TypeDef hostGPIOA, hostGPIOB, hostGPIOC;
+extern RCC_TypeDef hostRCC;
+extern CoreDebug_Type hostCoreDebug;
+extern uint32_t SystemCoreClock;
+
+DWT_Type *hostDWT(void);																								// Refreshes CYCCNT from the host clock on every access, less the time spent in WFI
+
+#define GPIOA												(&hostGPIOA)
+#define GPIOB												(&hostGPIOB)
+#define GPIOC												(&hostGPIOC)
+#define RCC													(&hostRCC)
+#define DWT													(hostDWT())
+#define CoreDebug										(&hostCoreDebug)
+
+#define GPIO_PIN_0									((uint16_t)0x0001)
+#define GPIO_PIN_1									((uint16_t)0x0002)
+#define GPIO_PIN_2									((uint16_t)0x0004)
+#define GPIO_PIN_3									((uint16_t)0x0008)
+#define GPIO_PIN_4									((uint16_t)0x0010)
+#define GPIO_PIN_5									((uint16_t)0x0020)
+#define GPIO_PIN_6									((uint16_t)0x0040)
+#define GPIO_PIN_7									((uint16_t)0x0080)
+#define GPIO_PIN_8									((uint16_t)0x0100)
+#define GPIO_PIN_9									((uint16_t)0x0200)
+#define GPIO_PIN_10									((uint16_t)0x0400)
+#define GPIO_PIN_11									((uint16_t)0x0800)
+#define GPIO_PIN_12									((uint16_t)0x1000)
+#define GPIO_PIN_13									((uint16_t)0x2000)
+#define GPIO_PIN_14									((uint16_t)0x4000)
+#define GPIO_PIN_15									((uint16_t)0x8000)
+
+#define GPIO_MODE_OUTPUT_PP					0x00000001U
+#define GPIO_MODE_IT_FALLING				0x10210000U
+#define GPIO_NOPULL									0x00000000U
+#define GPIO_PULLUP									0x00000001U
+#define GPIO_SPEED_HIGH							0x00000003U
+
+#define RCC_AHBENR_GPIOAEN					(1U << 17)
+#define RCC_AHBENR_GPIOBEN					(1U << 18)
+#define RCC_AHBENR_GPIOCEN					(1U << 19)
+#define __HAL_RCC_GPIOA_CLK_ENABLE()	(RCC->AHBENR |= RCC_AHBENR_GPIOAEN)
+#define __HAL_RCC_GPIOB_CLK_ENABLE()	(RCC->AHBENR |= RCC_AHBENR_GPIOBEN)
+#define __HAL_RCC_GPIOC_CLK_ENABLE()	(RCC->AHBENR |= RCC_AHBENR_GPIOCEN)
+
+#define DWT_CTRL_CYCCNTENA_Msk			(1U << 0)
+#define CoreDebug_DEMCR_TRCENA_Msk	(1U << 24)
+
+void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init);
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState);
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+uint32_t HAL_GetTick(void);
+uint32_t HAL_RCC_GetHCLKFreq(void);
+
+// Core register access, interrupts do not exist on the host so masking only keeps the bookkeeping
+uint32_t __get_PRIMASK(void);
+void __set_PRIMASK(uint32_t priMask);
+void __disable_irq(void);
+void __enable_irq(void);
+uint32_t __get_BASEPRI(void);
+void __set_BASEPRI(uint32_t basePri);
+void __set_BASEPRI_MAX(uint32_t basePri);
+uint32_t __LDREXW(volatile uint32_t *addr);
+uint32_t __STREXW(uint32_t value, volatile uint32_t *addr);																// 0 when stored, always on the host
+#define __DSB()
+void hostPlatformWaitForInterrupt(void);
+#define __WFI()											hostPlatformWaitForInterrupt()
+
+#include "mxconstants.h"
+
+#endif
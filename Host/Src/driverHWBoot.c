@@ -0,0 +1,51 @@
+#include "driverHWBoot.h"
+#include "hostBoot.h"
+
+// Host build: nothing is jumped to or reset, the requests are recorded for the harness.
+
+static uint32_t driverHWBootImage = 0;
+static bool driverHWBootResetPending = false;
+static bool driverHWBootWatchdog = false;
+static uint32_t driverHWBootKicks = 0;
+
+void driverHWBootWatchdogStart(uint32_t milliseconds) {
+	driverHWBootWatchdog = true;
+}
+
+void driverHWBootWatchdogKick(void) {
+	driverHWBootKicks++;
+}
+
+uint32_t driverHWBootRunningImage(void) {
+	return driverHWBootImage;
+}
+
+void driverHWBootReset(void) {
+	driverHWBootResetPending = true;
+}
+
+void driverHWBootJump(uint32_t image) {
+	driverHWBootImage = image;
+}
+
+void hostBootSetRunningImage(uint32_t image) {
+	driverHWBootImage = image;
+}
+
+bool hostBootResetRequested(void) {
+	return driverHWBootResetPending;
+}
+
+// A reset also stops the watchdog, the bootloader starts it again for a trial boot.
+void hostBootClearReset(void) {
+	driverHWBootResetPending = false;
+	driverHWBootWatchdog = false;
+}
+
+bool hostBootWatchdogRunning(void) {
+	return driverHWBootWatchdog;
+}
+
+uint32_t hostBootWatchdogKicks(void) {
+	return driverHWBootKicks;
+}
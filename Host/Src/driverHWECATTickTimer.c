@@ -0,0 +1,141 @@
+#include "driverHWECATTickTimer.h"
+#include "hostPlatform.h"
+
+// Host build: TIM2 is the host monotonic clock in us. The three compare channels keep their target semantics, a due
+// compare is delivered from hostPlatformService() instead of the TIM2 vector.
+
+void (*driverHWECATTickTimercallBackTickFunction)(void);
+void (*driverHWECATTickTimercallBackAlarmFunction)(void);
+
+uint32_t driverHWECATTickTimerTickPeriod;
+bool driverHWECATTickTimerInterruptActive;
+bool driverHWECATTickTimerInitialized = false;
+uint32_t driverHWECATTickTimerWorstLatency = 0;
+uint32_t driverHWECATTickTimerOffset = 0;																				// Host clock at counter zero
+
+static bool driverHWECATTickTimerTickArmed, driverHWECATTickTimerWakeupArmed, driverHWECATTickTimerAlarmArmed;
+static uint32_t driverHWECATTickTimerTickCompare, driverHWECATTickTimerWakeupCompare, driverHWECATTickTimerAlarmCompare;
+
+static void driverHWECATTickTimerMeasureLatency(uint32_t compare);
+static void driverHWECATTickTimerUpdateCompare(void);
+
+bool driverHWECATTickTimerInit(void) {
+	if(driverHWECATTickTimerInitialized)
+		return false;
+
+	driverHWECATTickTimercallBackTickFunction = 0;
+	driverHWECATTickTimercallBackAlarmFunction = 0;
+	driverHWECATTickTimerInterruptActive = false;
+	driverHWECATTickTimerTickPeriod = driverHWECATTickTimerDefaultTickPeriod;
+	driverHWECATTickTimerTickArmed = driverHWECATTickTimerWakeupArmed = driverHWECATTickTimerAlarmArmed = false;
+
+	driverHWECATTickTimerReset();
+	driverHWECATTickTimerInitialized = true;
+
+	return false;
+}
+
+void driverHWECATTickTimerBindTickFunction(void(*callback)(void)) {
+	driverHWECATTickTimercallBackTickFunction = callback;
+	driverHWECATTickTimerUpdateCompare();
+}
+
+void driverHWECATTickTimerSetTickPeriod(uint32_t periodMicroseconds) {
+	driverHWECATTickTimerTickPeriod = periodMicroseconds ? periodMicroseconds : 1;
+	driverHWECATTickTimerUpdateCompare();
+}
+
+void driverHWECATTickTimerReset(void) {
+	driverHWECATTickTimerOffset = hostPlatformGetMicroseconds();
+	driverHWECATTickTimerUpdateCompare();
+}
+
+uint32_t driverHWECATTickTimerGetTimerValue (void) {
+	return hostPlatformGetMicroseconds() - driverHWECATTickTimerOffset;
+}
+
+void driverHWECATTickTimerSetWakeup(uint32_t delayMicroseconds) {
+	driverHWECATTickTimerWakeupCompare = driverHWECATTickTimerGetTimerValue() + delayMicroseconds;
+	driverHWECATTickTimerWakeupArmed = true;
+}
+
+void driverHWECATTickTimerCancelWakeup(void) {
+	driverHWECATTickTimerWakeupArmed = false;
+}
+
+void driverHWECATTickTimerBindAlarmFunction(void(*callback)(void)) {
+	driverHWECATTickTimercallBackAlarmFunction = callback;
+}
+
+void driverHWECATTickTimerSetAlarmAt(uint32_t compare) {
+	driverHWECATTickTimerAlarmCompare = compare;																	// A passed compare is due on the next service
+	driverHWECATTickTimerAlarmArmed = true;
+}
+
+void driverHWECATTickTimerCancelAlarm(void) {
+	driverHWECATTickTimerAlarmArmed = false;
+}
+
+void driverHWECATTickTimerInterruptEnable(bool newState) {
+	driverHWECATTickTimerInterruptActive = newState;
+	driverHWECATTickTimerUpdateCompare();
+}
+
+static void driverHWECATTickTimerUpdateCompare(void) {
+	if(driverHWECATTickTimercallBackTickFunction && driverHWECATTickTimerInterruptActive) {
+		if(!driverHWECATTickTimerTickArmed) {
+			driverHWECATTickTimerTickCompare = driverHWECATTickTimerGetTimerValue() + driverHWECATTickTimerTickPeriod;
+			driverHWECATTickTimerTickArmed = true;
+		}
+	}else{
+		driverHWECATTickTimerTickArmed = false;
+	}
+}
+
+static bool driverHWECATTickTimerDue(bool armed, uint32_t compare) {
+	return armed && ((int32_t)(driverHWECATTickTimerGetTimerValue() - compare) >= 0);
+}
+
+bool driverHWECATTickTimerService(bool deliver) {
+	bool tickDue = driverHWECATTickTimerDue(driverHWECATTickTimerTickArmed,driverHWECATTickTimerTickCompare);
+	bool wakeupDue = driverHWECATTickTimerDue(driverHWECATTickTimerWakeupArmed,driverHWECATTickTimerWakeupCompare);
+	bool alarmDue = driverHWECATTickTimerDue(driverHWECATTickTimerAlarmArmed,driverHWECATTickTimerAlarmCompare);
+
+	if(!deliver)
+		return tickDue || wakeupDue || alarmDue;
+
+	if(tickDue) {
+		driverHWECATTickTimerMeasureLatency(driverHWECATTickTimerTickCompare);
+		driverHWECATTickTimerTickCompare += driverHWECATTickTimerTickPeriod;
+		if(driverHWECATTickTimercallBackTickFunction)
+			driverHWECATTickTimercallBackTickFunction();
+	}
+
+	if(wakeupDue) {
+		driverHWECATTickTimerMeasureLatency(driverHWECATTickTimerWakeupCompare);
+		driverHWECATTickTimerCancelWakeup();
+	}
+
+	if(alarmDue) {
+		driverHWECATTickTimerMeasureLatency(driverHWECATTickTimerAlarmCompare);
+		driverHWECATTickTimerCancelAlarm();
+		if(driverHWECATTickTimercallBackAlarmFunction)
+			driverHWECATTickTimercallBackAlarmFunction();
+	}
+
+	return tickDue || wakeupDue || alarmDue;
+}
+
+uint32_t driverHWECATTickTimerGetWorstLatency(void) {
+	return driverHWECATTickTimerWorstLatency;
+}
+
+void driverHWECATTickTimerResetWorstLatency(void) {
+	driverHWECATTickTimerWorstLatency = 0;
+}
+
+static void driverHWECATTickTimerMeasureLatency(uint32_t compare) {
+	uint32_t latency = driverHWECATTickTimerGetTimerValue() - compare;
+	if(latency > driverHWECATTickTimerWorstLatency)
+		driverHWECATTickTimerWorstLatency = latency;
+}
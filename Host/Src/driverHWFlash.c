@@ -0,0 +1,60 @@
+#include "driverHWFlash.h"
+#include "hostPlatform.h"
+
+// Host build: the flash is a RAM array. Erase and program hold the caller for the typical datasheet times, the
+// core stalls the same way on the target. Programming a half word that is not erased fails like PGERR does.
+
+#define driverHWFlashEraseTime							20000										// us per page
+#define driverHWFlashProgramTime						50											// us per half word
+
+static uint8_t driverHWFlashMemory[driverHWFlashSize];
+static bool driverHWFlashInitialized = false;
+
+static void driverHWFlashStall(uint32_t microseconds) {
+	uint32_t start = hostPlatformGetMicroseconds();
+
+	while(hostPlatformGetMicroseconds() - start < microseconds);
+}
+
+static void driverHWFlashInit(void) {
+	if(!driverHWFlashInitialized) {
+		memset(driverHWFlashMemory,0xFF,sizeof(driverHWFlashMemory));
+		driverHWFlashInitialized = true;
+	}
+}
+
+bool driverHWFlashErasePage(uint32_t address) {
+	if((address < driverHWFlashBase) || (address >= driverHWFlashBase + driverHWFlashSize) || (address % driverHWFlashPageSize))
+		return false;
+
+	driverHWFlashInit();
+	driverHWFlashStall(driverHWFlashEraseTime);
+	memset(&driverHWFlashMemory[address - driverHWFlashBase],0xFF,driverHWFlashPageSize);
+	return true;
+}
+
+bool driverHWFlashProgram(uint32_t address, const uint8_t *data, uint32_t length) {
+	if((address % 2) || (length % 2) || (address < driverHWFlashBase) || (address + length > driverHWFlashBase + driverHWFlashSize))
+		return false;
+
+	driverHWFlashInit();
+	for(uint32_t offset = 0; offset < length; offset += 2) {
+		uint8_t *target = &driverHWFlashMemory[address - driverHWFlashBase + offset];
+		uint16_t halfWord = data[offset] | (data[offset + 1] << 8);
+		if(halfWord == driverHWFlashErasedHalfWord)
+			continue;
+		if(target[0] != 0xFF || target[1] != 0xFF)
+			return false;
+
+		driverHWFlashStall(driverHWFlashProgramTime);
+		target[0] = data[offset];
+		target[1] = data[offset + 1];
+	}
+
+	return true;
+}
+
+const uint8_t *driverHWFlashRead(uint32_t address) {
+	driverHWFlashInit();
+	return &driverHWFlashMemory[address - driverHWFlashBase];
+}
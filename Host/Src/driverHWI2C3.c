@@ -0,0 +1,155 @@
+#include "driverHWI2C3.h"
+#include "hostNunChuck.h"
+
+// Host build: I2C3 talks to a simulated nunchuck. It has the register pointer behaviour of the real part after the
+// unencrypted init (0xF0=0x55, 0xFB=0x00): 0x00 sensor data, 0x20 calibration, 0xFA identification.
+
+#define driverHWI2C3NunChuckAddress					0x52
+#define driverHWI2C3NunChuckRegisters				0x100
+#define driverHWI2C3ErrorAcknowledge				0x00000004												// HAL_I2C_ERROR_AF, traced like the target does
+
+static uint8_t driverHWI2C3NunChuckMemory[driverHWI2C3NunChuckRegisters];
+static uint8_t driverHWI2C3NunChuckPointer = 0;
+static bool driverHWI2C3NunChuckMotion = false;
+static uint32_t driverHWI2C3NunChuckSample = 0;
+static uint32_t driverHWI2C3NunChuckNoise = 1;
+static bool driverHWI2C3NunChuckConnected = true;
+static bool driverHWI2C3NunChuckCalibrationValid = true;
+static int8_t driverHWI2C3NunChuckJoystickDrift = 0;
+static int16_t driverHWI2C3NunChuckAccelerometerDrift = 0;
+static driverHWI2C3StatusTypedef driverHWI2C3Status = I2C3_IDLE;
+static const uint8_t driverHWI2C3NunChuckCalibration[14] = {0x80,0x80,0x80,0x00,0xB3,0xB3,0xB3,0x00,0xE0,0x20,0x80,0xE0,0x20,0x80};
+
+// Triangle wave between -amplitude and amplitude
+static int32_t driverHWI2C3NunChuckTriangle(uint32_t sample, uint32_t period, int32_t amplitude) {
+	int32_t phase = sample % period;
+	int32_t half = period/2;
+
+	return ((phase < half) ? phase : (int32_t)period - phase)*4*amplitude/(int32_t)period - amplitude;
+}
+
+static int32_t driverHWI2C3NunChuckRandom(int32_t range) {
+	driverHWI2C3NunChuckNoise = driverHWI2C3NunChuckNoise*1103515245 + 12345;
+	return (int32_t)((driverHWI2C3NunChuckNoise >> 16) % (2*range + 1)) - range;
+}
+
+// Raw sensor registers: joystick X/Y, accelerometer X/Y/Z bits 9..2, then the low bits and the inverted buttons.
+// The drift is added on the way in.
+static void driverHWI2C3NunChuckSet(int32_t joystickX, int32_t joystickY, const int32_t accelerometer[3], bool pressed) {
+	uint8_t *data = &driverHWI2C3NunChuckMemory[0x00];
+	int32_t value;
+
+	data[0] = joystickX + driverHWI2C3NunChuckJoystickDrift;
+	data[1] = joystickY + driverHWI2C3NunChuckJoystickDrift;
+	data[5] = pressed ? 0x01 : 0x03;																			// C only, Z stays released
+	for(uint8_t axis = 0; axis < 3; axis++) {
+		value = accelerometer[axis] + ((axis == 2) ? driverHWI2C3NunChuckAccelerometerDrift : 0);
+		data[2 + axis] = value >> 2;
+		data[5] |= (value & 0x03) << (2 + 2*axis);
+	}
+}
+
+// Joystick centered, 0g/0g/1g, no buttons
+static void driverHWI2C3NunChuckRest(void) {
+	static const int32_t accelerometer[3] = {512, 512, 716};
+
+	driverHWI2C3NunChuckSet(0x80,0x80,accelerometer,false);
+}
+
+static void driverHWI2C3NunChuckMove(void) {
+	uint32_t n = driverHWI2C3NunChuckSample++;
+	int32_t accelerometer[3] = {
+		512 + driverHWI2C3NunChuckTriangle(n,80,150) + driverHWI2C3NunChuckRandom(2),
+		512 + driverHWI2C3NunChuckTriangle(n + 20,120,100) + driverHWI2C3NunChuckRandom(2),
+		716 + driverHWI2C3NunChuckRandom(1)
+	};
+	bool pressed = (n % hostNunChuckButtonInterval) < hostNunChuckButtonLength;
+
+	driverHWI2C3NunChuckSet(0x80 + driverHWI2C3NunChuckTriangle(n,200,100),0x80,accelerometer,pressed);
+}
+
+void hostNunChuckSetMotion(bool motion) {
+	driverHWI2C3NunChuckMotion = motion;
+	driverHWI2C3NunChuckSample = 0;
+	driverHWI2C3NunChuckNoise = 1;
+}
+
+void hostNunChuckSetConnected(bool connected) {
+	driverHWI2C3NunChuckConnected = connected;
+}
+
+// Also part of the nunchuck. Back at rest, with the joystick centre and the accelerometer Z 0g moved by the drift.
+void hostNunChuckSetDrift(int8_t joystick, int16_t accelerometerZ) {
+	driverHWI2C3NunChuckJoystickDrift = joystick;
+	driverHWI2C3NunChuckAccelerometerDrift = accelerometerZ;
+	driverHWI2C3NunChuckRest();
+}
+
+// Part of the nunchuck, so it survives driverHWI2C3Init
+void hostNunChuckSetCalibrationValid(bool valid) {
+	driverHWI2C3NunChuckCalibrationValid = valid;
+	if(valid)
+		memcpy(&driverHWI2C3NunChuckMemory[0x20],driverHWI2C3NunChuckCalibration,sizeof(driverHWI2C3NunChuckCalibration));
+	else
+		memset(&driverHWI2C3NunChuckMemory[0x20],0xFF,sizeof(driverHWI2C3NunChuckCalibration));
+}
+
+void driverHWI2C3Init(void) {
+	static const uint8_t identification[6] = {0x00,0x00,0xA4,0x20,0x00,0x00};
+
+	memset(driverHWI2C3NunChuckMemory,0,sizeof(driverHWI2C3NunChuckMemory));
+	driverHWI2C3NunChuckRest();
+	hostNunChuckSetCalibrationValid(driverHWI2C3NunChuckCalibrationValid);
+	memcpy(&driverHWI2C3NunChuckMemory[0xFA],identification,sizeof(identification));
+	driverHWI2C3NunChuckPointer = 0;
+	driverHWI2C3Status = I2C3_IDLE;
+}
+
+bool driverHWI2C3ReadWrite(uint16_t DevAddress, bool readWrite, uint8_t *pData, uint16_t Size) {
+	if(DevAddress != driverHWI2C3NunChuckAddress || !driverHWI2C3NunChuckConnected || !Size) {
+		modTraceEvent(TRACE_I2C_ERROR,((uint32_t)((DevAddress << 1) | readWrite) << 16) | HAL_ERROR,driverHWI2C3ErrorAcknowledge);
+		return false;																																// NACK
+	}
+
+	if(readWrite)
+		return driverHWI2C3Read(DevAddress,pData,Size);
+
+	driverHWI2C3NunChuckPointer = pData[0];																				// First byte sets the pointer, the rest is written from there
+	if(driverHWI2C3NunChuckMotion && Size == 1 && driverHWI2C3NunChuckPointer == 0x00)
+		driverHWI2C3NunChuckMove();																								// A sensor read starts
+	for(uint16_t byte = 1; byte < Size; byte++)
+		driverHWI2C3NunChuckMemory[(uint8_t)(driverHWI2C3NunChuckPointer + byte - 1)] = pData[byte];
+
+	return true;
+};
+
+bool driverHWI2C3Read(uint16_t DevAddress, uint8_t *pData, uint16_t Size) {
+	if(DevAddress != driverHWI2C3NunChuckAddress || !driverHWI2C3NunChuckConnected) {
+		modTraceEvent(TRACE_I2C_ERROR,((uint32_t)((DevAddress << 1) | 0x01) << 16) | HAL_ERROR,driverHWI2C3ErrorAcknowledge);
+		return false;
+	}
+
+	for(uint16_t byte = 0; byte < Size; byte++)
+		pData[byte] = driverHWI2C3NunChuckMemory[driverHWI2C3NunChuckPointer++];
+
+	return true;
+};
+
+// The interrupt driven transfers are over by the time they return here, the caller still sees them through the status.
+bool driverHWI2C3WriteStart(uint16_t DevAddress, uint8_t *pData, uint16_t Size) {
+	driverHWI2C3Status = driverHWI2C3ReadWrite(DevAddress,false,pData,Size) ? I2C3_IDLE : I2C3_ERROR;
+	return true;
+}
+
+bool driverHWI2C3ReadStart(uint16_t DevAddress, uint8_t *pData, uint16_t Size) {
+	driverHWI2C3Status = driverHWI2C3Read(DevAddress,pData,Size) ? I2C3_IDLE : I2C3_ERROR;
+	return true;
+}
+
+driverHWI2C3StatusTypedef driverHWI2C3GetStatus(void) {
+	return driverHWI2C3Status;
+}
+
+void driverHWI2C3Recover(void) {
+	driverHWI2C3Status = I2C3_IDLE;
+}
@@ -0,0 +1,96 @@
+#include "driverHWLANInterrupt.h"
+#include "hostLAN9252.h"
+#include "hostPlatform.h"
+
+// Host build: the ESC IRQ pin comes from the simulated LAN9252. Like the falling edge EXTI on the target only the
+// assert edge is latched, it is delivered from hostPlatformService(). SYNC0/1 are not modelled (no DC in the model).
+
+void (*driverHWLANInterruptcallBackIRQFunction)(void);
+void (*driverHWLANInterruptcallBackSYNC0Function)(void);
+void (*driverHWLANInterruptcallBackSYNC1Function)(void);
+bool driverHWLANInterruptcallBackIRQActive, driverHWLANInterruptcallBackSYNC0Active, driverHWLANInterruptcallBackSYNC1Active;
+bool driverHWLANInterruptInitialized = false;
+volatile bool driverHWLANInterruptIRQPending = false;
+uint32_t driverHWLANInterruptWorstHandlerCycles = 0;
+
+static void driverHWLANInterruptEdge(void) {
+	driverHWLANInterruptIRQPending = true;																				// EXTI pending flag
+}
+
+void driverHWLANInterruptInit(void) {
+	if(!driverHWLANInterruptInitialized) {
+		driverHWLANInterruptcallBackIRQFunction = 0;
+		driverHWLANInterruptcallBackSYNC0Function = 0;
+		driverHWLANInterruptcallBackSYNC1Function = 0;
+
+		driverHWLANInterruptcallBackIRQActive = false;
+		driverHWLANInterruptcallBackSYNC0Active = false;
+		driverHWLANInterruptcallBackSYNC1Active = false;
+		driverHWLANInterruptIRQPending = false;
+
+		hostLAN9252BindIRQFunction(&driverHWLANInterruptEdge);
+		driverHWLANInterruptInitialized = true;
+	}
+}
+
+void driverHWLANInterruptIRQBindFunction(void(*callback)(void)) {
+	driverHWLANInterruptcallBackIRQFunction = callback;
+}
+
+void driverHWLANInterruptSYNC0BindFunction(void(*callback)(void)) {
+	driverHWLANInterruptcallBackSYNC0Function = callback;
+}
+
+void driverHWLANInterruptSYNC1BindFunction(void(*callback)(void)) {
+	driverHWLANInterruptcallBackSYNC1Function = callback;
+}
+
+void driverHWLANInterruptDisableAll(void) {
+	driverHWLANInterruptEnable(LAN_IRQ_Pin,false);
+	driverHWLANInterruptEnable(LAN_SYNC0_Pin,false);
+	driverHWLANInterruptEnable(LAN_SYNC1_Pin,false);
+}
+
+void driverHWLANInterruptEnableAll(void) {
+	driverHWLANInterruptEnable(LAN_IRQ_Pin,true);
+	driverHWLANInterruptEnable(LAN_SYNC0_Pin,true);
+	driverHWLANInterruptEnable(LAN_SYNC1_Pin,true);
+}
+
+void driverHWLANInterruptEnable(uint16_t GPIO_Pin,bool newState) {
+	switch(GPIO_Pin) {
+		case LAN_IRQ_Pin:
+			driverHWLANInterruptcallBackIRQActive = newState;
+			break;
+		case LAN_SYNC0_Pin:
+			driverHWLANInterruptcallBackSYNC0Active = newState;
+			break;
+		case LAN_SYNC1_Pin:
+			driverHWLANInterruptcallBackSYNC1Active = newState;
+			break;
+		default:
+			break;
+	}
+}
+
+uint32_t driverHWLANInterruptGetWorstHandlerTime(void) {
+	return driverHWLANInterruptWorstHandlerCycles/(SystemCoreClock/1000000);				// us
+}
+
+bool driverHWLANInterruptService(bool deliver) {
+	if(!driverHWLANInterruptIRQPending)
+		return false;
+
+	if(deliver) {
+		uint32_t entryCycles = DWT->CYCCNT;
+		driverHWLANInterruptIRQPending = false;
+		if(driverHWLANInterruptcallBackIRQFunction && driverHWLANInterruptcallBackIRQActive)
+			driverHWLANInterruptcallBackIRQFunction();
+
+		uint32_t handlerCycles = DWT->CYCCNT - entryCycles;
+		if(handlerCycles > driverHWLANInterruptWorstHandlerCycles)
+			driverHWLANInterruptWorstHandlerCycles = handlerCycles;
+	}
+
+	return true;
+}
@@ -0,0 +1,35 @@
+#include "driverHWSPI1.h"
+#include "hostLAN9252.h"
+
+// Host build: SPI1 is wired straight to the simulated LAN9252, byte for byte.
+
+void driverHWSPI1Init(void) {
+	hostLAN9252Select(false);
+}
+
+bool driverHWSPI1Write(uint8_t *writeBuffer, uint8_t noOfBytesToWrite) {
+	for(uint8_t byte = 0; byte < noOfBytesToWrite; byte++)
+		hostLAN9252Transfer(writeBuffer[byte]);
+
+	return true;
+}
+
+bool driverHWSPI1WriteSingleByte(uint8_t data) {
+	hostLAN9252Transfer(data);
+
+	return true;
+}
+
+bool driverHWSPI1WriteRead(uint8_t *writeBuffer, uint8_t noOfBytesToWrite, uint8_t *readBuffer, uint8_t noOfBytesToRead) {
+	for(uint8_t byte = 0; byte < noOfBytesToWrite; byte++)
+		hostLAN9252Transfer(writeBuffer[byte]);
+
+	for(uint8_t byte = 0; byte < noOfBytesToRead; byte++)
+		readBuffer[byte] = hostLAN9252Transfer(0xFF);
+
+	return true;
+}
+
+void driverHWSPI1SetCS(GPIO_PinState PinState) {
+	hostLAN9252Select(PinState == GPIO_PIN_RESET);																// CS is active low
+}
@@ -0,0 +1,107 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "hostSlave.h"
+#include "hostMaster.h"
+#include "hostLAN9252.h"
+#include "hostPlatform.h"
+#include "middleSOES.h"
+
+// Cycle level benchmark: the master stand-in takes the slave to OP, then runs process data at a fixed cycle time
+// with SDO uploads interleaved. Usage: diebieslave_bench [cycle time us] [cycles] [SDO every n cycles] [ESC busy polls]
+// [sleep when idle]. The core clock, and DWT with it, stops in WFI like on the target; running the same cycles with
+// the scheduler spinning instead (sleep 0) gives the reference for the latency.
+
+#define hostBenchmarkDefaultCycles				5000
+#define hostBenchmarkDefaultSDOInterval		10
+#define hostBenchmarkIdleTime							1000000															// us in PREOP without master traffic
+
+static bool hostBenchmarkState(const char *name, uint8_t state) {
+	uint32_t transitionTime = 0;
+
+	if(!hostMasterSetState(state,&transitionTime)) {
+		printf("%-7s failed, AL status 0x%02X\n",name,hostMasterGetState());
+		return false;
+	}
+
+	printf("%-7s reached in %lu us\n",name,(unsigned long)transitionTime);
+	return true;
+}
+
+int main(int argc, char **argv) {
+	uint32_t cycleTime = (argc > 1) ? (uint32_t)strtoul(argv[1],NULL,0) : hostMasterDefaultCycleTime;
+	uint32_t cycles = (argc > 2) ? (uint32_t)strtoul(argv[2],NULL,0) : hostBenchmarkDefaultCycles;
+	uint32_t sdoInterval = (argc > 3) ? (uint32_t)strtoul(argv[3],NULL,0) : hostBenchmarkDefaultSDOInterval;
+	uint32_t busyPolls = (argc > 4) ? (uint32_t)strtoul(argv[4],NULL,0) : hostLAN9252DefaultBusyPolls;
+	bool sleep = (argc > 5) ? (strtoul(argv[5],NULL,0) != 0) : modSchedulerSleepWhenIdle;
+
+	if(!hostSlaveInit()) {
+		printf("Slave did not come up\n");
+		return EXIT_FAILURE;
+	}
+	hostMasterInit();
+
+	modSchedulerSetSleepWhenIdle(sleep);
+	if(!hostBenchmarkState("PREOP",ESCpreop))
+		return EXIT_FAILURE;
+
+	// Without events the slave should leave the ESC alone, only the slow fallback poll is left. Asleep the core is not
+	// clocked, the time base has to keep counting all the same.
+	const modSchedulerIdleStruct *idle = modSchedulerGetIdle();
+	hostLAN9252ResetStatistics();
+	modSchedulerResetStatistics();
+	uint32_t idleStart = modDelayGetMicroseconds(), idleCycles = DWT->CYCCNT;
+	hostSlaveRunFor(hostBenchmarkIdleTime);
+	idleCycles = DWT->CYCCNT - idleCycles;
+	printf("  Idle: %lu SPI transactions in %lu ms, %lu us asleep in %lu sleeps, core clocked %lu us\n",
+		(unsigned long)hostLAN9252GetStatistics()->CSCycles,(unsigned long)((modDelayGetMicroseconds() - idleStart)/1000),
+		(unsigned long)idle->SleepTime,(unsigned long)idle->SleepCount,(unsigned long)(idleCycles/(hostPlatformCoreClock/1000000)));
+
+	if(!hostBenchmarkState("SAFEOP",ESCsafeop) || !hostBenchmarkState("OP",ESCop))
+		return EXIT_FAILURE;
+
+	hostLAN9252ResetStatistics();
+	modSchedulerResetStatistics();
+	hostMasterResetStatistics();
+	PDI_ResetAccounting();
+	hostLAN9252SetBusyPolls(busyPolls);																						// After boot, a slow ESC only during the measured cycles
+	hostMasterStartCycle(cycleTime,sdoInterval);
+
+	const hostMasterStatisticsStruct *master = hostMasterGetStatistics();
+	while(master->Cycles < cycles)
+		hostSlaveStep();
+
+	hostMasterStopCycle();
+
+	const hostLAN9252StatisticsStruct *spi = hostLAN9252GetStatistics();
+	const modSchedulerTaskStruct *processData = modSchedulerGetTask(hostSlaveProcessDataTask());
+	const modSchedulerTaskStruct *mailbox = modSchedulerGetTask(hostSlaveMailboxTask());
+	uint32_t escRuns = processData->RunCount + mailbox->RunCount;
+
+	printf("\n%lu cycles of %lu us, AL status 0x%02X\n",(unsigned long)master->Cycles,(unsigned long)master->CycleTime,hostMasterGetState());
+	printf("  Reaction (SM2 write to PDI read): avg %.1f us, worst %lu us\n",
+		master->Reactions ? (double)master->ReactionTimeTotal/master->Reactions : 0.0,(unsigned long)master->WorstReactionTime);
+	printf("  Missed cycles %lu, late master cycles %lu, worst master jitter %lu us\n",
+		(unsigned long)master->MissedCycles,(unsigned long)master->LateCycles,(unsigned long)master->WorstCycleJitter);
+	printf("  SDO: %lu requests, %lu responses, %lu aborts, avg %.1f us, worst %lu us, %lu refused\n",
+		(unsigned long)master->SDORequests,(unsigned long)master->SDOResponses,(unsigned long)master->SDOAborts,
+		master->SDOResponses ? (double)master->SDOTimeTotal/master->SDOResponses : 0.0,(unsigned long)master->WorstSDOTime,(unsigned long)master->MailboxRefused);
+	printf("  SPI: %lu transactions, %lu bytes, %lu busy polls\n",(unsigned long)spi->CSCycles,(unsigned long)spi->SPIBytes,(unsigned long)spi->BusyPolls);
+	printf("  SPI transactions per cycle %.1f, per ESC task run %.1f (PDO %lu runs, mailbox %lu runs)\n",
+		master->Cycles ? (double)spi->CSCycles/master->Cycles : 0.0,escRuns ? (double)spi->CSCycles/escRuns : 0.0,
+		(unsigned long)processData->RunCount,(unsigned long)mailbox->RunCount);
+	static const char *callerNames[PDI_CALLERS] = {"other","state","mailbox","PDO"};
+	for(uint8_t caller = 0; caller < PDI_CALLERS; caller++) {
+		const PDI_AccountingStruct *accounting = PDI_GetCallerAccounting((PDI_CallerTypeDef)caller);
+		printf("  PDI %-8s %7lu accesses %8lu bytes %7lu CS %6lu busy polls %7lu us\n",callerNames[caller],(unsigned long)accounting->Transactions,
+			(unsigned long)accounting->Bytes,(unsigned long)accounting->CSCycles,(unsigned long)accounting->BusyPolls,(unsigned long)accounting->Time);
+	}
+	const PDI_PollStatisticsStruct *poll = PDI_GetPollStatistics();
+	printf("  PDI waits %lu, %lu timed out, %lu us waiting, worst wait %lu us\n",(unsigned long)poll->Polls,(unsigned long)poll->Timeouts,
+		(unsigned long)poll->PollTime,(unsigned long)poll->WorstPollTime);
+	printf("  PDO task worst exec %lu us, worst release latency %lu us\n",
+		(unsigned long)processData->WorstExecutionTime,(unsigned long)processData->WorstReleaseLatency);
+	printf("  %s: %lu sleeps, %lu us asleep, %lu wakeups by a trigger, worst wake latency %lu us\n",sleep ? "Sleep" : "Spin",
+		(unsigned long)idle->SleepCount,(unsigned long)idle->SleepTime,(unsigned long)idle->WakeCount,(unsigned long)idle->WorstWakeLatency);
+
+	return (hostMasterGetState() == ESCop) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,126 @@
+#include "hostFuzzMailbox.h"
+#include "hostSlave.h"
+#include "hostMaster.h"
+#include "hostLAN9252.h"
+#include "hostPlatform.h"
+#include "middleSOES.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+hostFuzzMailboxStatisticsStruct hostFuzzMailboxStatistics;
+bool hostFuzzMailboxInitialized = false;
+
+// The ESC IRQ the master access raised is taken first, as it would be on the target, the task only reads the AL event
+// register after one.
+static void hostFuzzMailboxTask(void) {
+	hostPlatformService();
+	middleSOESMailboxTask();
+}
+
+// Runs the mailbox task directly instead of through the scheduler, so a frame costs the same no matter how the host
+// clock moves and an input always replays the same way. Whatever the slave posts is read back to free SM1.
+static void hostFuzzMailboxRun(void) {
+	uint8_t mailbox[MBX1_sml];
+
+	for(uint8_t run = 0; run < hostFuzzMailboxTaskRuns; run++) {
+		hostFuzzMailboxTask();
+		if(hostLAN9252MasterRead(MBX1_sma,mailbox,sizeof(mailbox)))
+			hostFuzzMailboxStatistics.Responses++;
+	}
+}
+
+static void hostFuzzMailboxFrame(const uint8_t *frame, uint8_t length) {
+	uint8_t mailbox[MBX0_sml];
+
+	memset(mailbox,0,sizeof(mailbox));
+	memcpy(mailbox,frame,(length > sizeof(mailbox)) ? sizeof(mailbox) : length);
+
+	if(!hostLAN9252MasterWrite(MBX0_sma,mailbox,sizeof(mailbox))) {
+		hostFuzzMailboxRun();
+		if(!hostLAN9252MasterWrite(MBX0_sma,mailbox,sizeof(mailbox))) {
+			hostFuzzMailboxStatistics.FramesRefused++;
+			return;
+		}
+	}
+
+	hostFuzzMailboxStatistics.Frames++;
+	hostFuzzMailboxRun();
+}
+
+// Same as hostMasterSetState, but with the mailbox task run directly instead of waiting for its release.
+static bool hostFuzzMailboxState(uint8_t state) {
+	hostMasterRequestState(state);
+	for(uint8_t run = 0; run < hostFuzzMailboxTaskRuns; run++) {
+		hostFuzzMailboxTask();
+		if(hostMasterGetState() == state)
+			return true;
+	}
+
+	return false;
+}
+
+// After the input the slave must still answer a plain expedited upload of the device type.
+static bool hostFuzzMailboxAlive(void) {
+	static const uint8_t request[16] = {10, 0, 0, 0, 0, 0x03, 0x00, hostMasterCoEServiceSDORequest << 4, hostMasterSDOUploadRequest, 0x00, 0x10, 0x00};
+	uint8_t mailbox[MBX1_sml];
+
+	hostFuzzMailboxRun();																													// Let a segmented transfer left over run out
+	for(uint8_t counter = 1; counter <= 2; counter++) {																// Two counters, one of them differs from the last frame
+		uint8_t frame[sizeof(request)];
+		memcpy(frame,request,sizeof(request));
+		frame[5] |= counter << 4;
+
+		memset(mailbox,0,sizeof(mailbox));
+		memcpy(mailbox,frame,sizeof(frame));
+		if(!hostLAN9252MasterWrite(MBX0_sma,mailbox,sizeof(mailbox)))
+			continue;
+
+		for(uint8_t run = 0; run < hostFuzzMailboxTaskRuns; run++) {
+			hostFuzzMailboxTask();
+			if(hostLAN9252MasterRead(MBX1_sma,mailbox,sizeof(mailbox)) && (mailbox[5] & 0x0F) == hostMasterMailboxTypeCoE &&
+				(mailbox[7] >> 4) == hostMasterCoEServiceSDOResponse)
+				return true;
+		}
+	}
+
+	return false;
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+	if(!hostFuzzMailboxInitialized) {
+		if(!hostSlaveInit()) {
+			fprintf(stderr,"Slave did not come up\n");
+			abort();
+		}
+		hostMasterInit();
+		hostFuzzMailboxInitialized = true;
+	}
+
+	// INIT stops the mailbox and drops any transfer in progress, PREOP starts it again
+	if(!hostFuzzMailboxState(ESCinit) || !hostFuzzMailboxState(ESCpreop)) {
+		fprintf(stderr,"Slave did not return to PREOP, AL status 0x%02X\n",hostMasterGetState());
+		abort();
+	}
+
+	hostFuzzMailboxStatistics.Inputs++;
+
+	size_t position = 0;
+	for(uint8_t frames = 0; frames < hostFuzzMailboxMaxFrames && position < size; frames++) {
+		uint8_t length = data[position++];
+		if(length > size - position)
+			length = size - position;
+
+		hostFuzzMailboxFrame(&data[position],length);
+		position += length;
+	}
+
+	if(!hostFuzzMailboxAlive())
+		hostFuzzMailboxStatistics.Stalls++;
+
+	return 0;
+}
+
+const hostFuzzMailboxStatisticsStruct *hostFuzzMailboxGetStatistics(void) {
+	return &hostFuzzMailboxStatistics;
+}
@@ -0,0 +1,108 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hostFuzzMailbox.h"
+#include "hostSlave.h"
+#include "hostMaster.h"
+#include "esc.h"
+
+// Stand alone driver for the mailbox fuzz target, for builds without libFuzzer. It replays the given input files
+// (crash reproducers or a corpus), or with -random generates inputs: mostly well formed CoE and FoE headers with
+// random contents, so the runs get past the header checks. Usage:
+//   diebieslave_fuzz_mailbox [input files]
+//   diebieslave_fuzz_mailbox -random [runs] [seed]
+
+#define hostFuzzMainDefaultRuns					10000
+#define hostFuzzMainMaxInput						1024
+
+static uint32_t hostFuzzMainRandomState = 1;
+
+static uint32_t hostFuzzMainRandom(void) {
+	hostFuzzMainRandomState ^= hostFuzzMainRandomState << 13;																		// xorshift32
+	hostFuzzMainRandomState ^= hostFuzzMainRandomState >> 17;
+	hostFuzzMainRandomState ^= hostFuzzMainRandomState << 5;
+	return hostFuzzMainRandomState;
+}
+
+static uint8_t hostFuzzMainFrame(uint8_t *frame) {
+	uint8_t length = 6 + hostFuzzMainRandom() % (MBX0_sml - 6 + 1);
+	uint8_t choice = hostFuzzMainRandom() % 10;
+
+	for(uint8_t i = 0; i < length; i++)
+		frame[i] = hostFuzzMainRandom();
+
+	uint16_t headerLength = (hostFuzzMainRandom() % 8) ? (length - 6) : (uint16_t)hostFuzzMainRandom();		// Mostly consistent
+	frame[0] = headerLength & 0xFF;
+	frame[1] = headerLength >> 8;
+
+	if(choice < 5) {
+		frame[5] = (frame[5] & 0x70) | hostMasterMailboxTypeCoE;
+		if(length > 7 && (hostFuzzMainRandom() % 4))
+			frame[7] = (hostFuzzMainRandom() % 2) ? (hostMasterCoEServiceSDORequest << 4) : (0x08 << 4);		// SDO or SDO information
+	}else if(choice < 8) {
+		frame[5] = (frame[5] & 0x70) | hostMasterMailboxTypeFoE;
+		if(length > 6)
+			frame[6] = 1 + hostFuzzMainRandom() % 6;																								// RRQ .. BUSY
+		if(length > 11 && (hostFuzzMainRandom() % 2)) {
+			uint32_t packet = hostFuzzMainRandom() % 4;
+			memcpy(&frame[8],&packet,sizeof(packet));
+		}
+		if(length >= 12 + sizeof(hostSlaveFoEFileName) - 1 && frame[6] == hostMasterFoEWriteRequest && (hostFuzzMainRandom() % 2))
+			memcpy(&frame[12],hostSlaveFoEFileName,sizeof(hostSlaveFoEFileName) - 1);
+	}
+
+	return length;
+}
+
+static size_t hostFuzzMainInput(uint8_t *input) {
+	uint8_t frames = 1 + hostFuzzMainRandom() % 8;
+	size_t size = 0;
+
+	while(frames-- && size + 1 + MBX0_sml <= hostFuzzMainMaxInput) {
+		uint8_t length = hostFuzzMainFrame(&input[size + 1]);
+		input[size] = length;
+		size += 1 + length;
+	}
+
+	return size;
+}
+
+static bool hostFuzzMainReplay(const char *path) {
+	static uint8_t input[hostFuzzMainMaxInput*64];
+	FILE *file = fopen(path,"rb");
+
+	if(!file) {
+		fprintf(stderr,"Cannot open %s\n",path);
+		return false;
+	}
+
+	size_t size = fread(input,1,sizeof(input),file);
+	fclose(file);
+	LLVMFuzzerTestOneInput(input,size);
+	return true;
+}
+
+int main(int argc, char **argv) {
+	bool ok = true;
+
+	if(argc > 1 && !strcmp(argv[1],"-random")) {
+		uint32_t runs = (argc > 2) ? (uint32_t)strtoul(argv[2],NULL,0) : hostFuzzMainDefaultRuns;
+		uint8_t input[hostFuzzMainMaxInput];
+
+		hostFuzzMainRandomState = (argc > 3) ? (uint32_t)strtoul(argv[3],NULL,0) : 1;
+		if(!hostFuzzMainRandomState)
+			hostFuzzMainRandomState = 1;
+
+		for(uint32_t run = 0; run < runs; run++)
+			LLVMFuzzerTestOneInput(input,hostFuzzMainInput(input));
+	}else{
+		for(int arg = 1; arg < argc; arg++)
+			ok = hostFuzzMainReplay(argv[arg]) && ok;
+	}
+
+	const hostFuzzMailboxStatisticsStruct *statistics = hostFuzzMailboxGetStatistics();
+	printf("%lu inputs, %lu frames (%lu refused), %lu responses, %lu inputs left the mailbox stalled\n",(unsigned long)statistics->Inputs,
+		(unsigned long)statistics->Frames,(unsigned long)statistics->FramesRefused,(unsigned long)statistics->Responses,(unsigned long)statistics->Stalls);
+
+	return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,173 @@
+#include "stm32f3xx_hal.h"
+#include "hostPlatform.h"
+#include <time.h>
+
+GPIO_TypeDef hostGPIOA, hostGPIOB, hostGPIOC;
+RCC_TypeDef hostRCC;
+CoreDebug_Type hostCoreDebug;
+uint32_t SystemCoreClock = hostPlatformCoreClock;
+
+static DWT_Type hostDWTRegisters;
+static uint64_t hostDWTSleptNanoseconds = 0;																		// The core clock stops in WFI, CYCCNT with it
+static uint64_t hostPlatformEpoch;
+static bool hostPlatformEpochSet = false;
+static uint32_t hostPRIMASK = 0;
+static uint32_t hostBASEPRI = 0;
+static void (*hostPlatformExternalFunction)(void) = 0;
+
+uint64_t hostPlatformGetNanoseconds(void) {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC,&now);
+	uint64_t nanoseconds = (uint64_t)now.tv_sec*1000000000ULL + (uint64_t)now.tv_nsec;
+
+	if(!hostPlatformEpochSet) {																										// Time starts at zero like it does after reset
+		hostPlatformEpoch = nanoseconds;
+		hostPlatformEpochSet = true;
+	}
+
+	return nanoseconds - hostPlatformEpoch;
+}
+
+uint32_t hostPlatformGetMicroseconds(void) {
+	return (uint32_t)(hostPlatformGetNanoseconds()/1000);
+}
+
+void hostPlatformBindExternalFunction(void (*function)(void)) {
+	hostPlatformExternalFunction = function;
+}
+
+// The world outside the MCU keeps running whatever the core masks, it only must not re-enter itself.
+static void hostPlatformRunExternal(void) {
+	static bool hostPlatformInExternal = false;
+
+	if(!hostPlatformExternalFunction || hostPlatformInExternal)
+		return;
+
+	hostPlatformInExternal = true;
+	hostPlatformExternalFunction();
+	hostPlatformInExternal = false;
+}
+
+// Delivers what the current PRIMASK and BASEPRI let through. Unmasking calls this too, so a pending interrupt runs
+// the moment it is allowed to, as it would on the core.
+bool hostPlatformService(void) {
+	static bool hostPlatformInService = false;
+	bool delivered = false;
+
+	hostPlatformRunExternal();
+
+	if(hostPRIMASK || hostPlatformInService)
+		return false;
+
+	hostPlatformInService = true;
+	if(!hostBASEPRI || hostBASEPRI > IRQ_PRIORITY_TO_BASEPRI(IRQ_PRIORITY_SYNC))
+		delivered |= driverHWLANInterruptService(true);
+	if(!hostBASEPRI || hostBASEPRI > IRQ_PRIORITY_TO_BASEPRI(IRQ_PRIORITY_TICK))
+		delivered |= driverHWECATTickTimerService(true);
+	hostPlatformInService = false;
+
+	return delivered;
+}
+
+// Returns once something is pending, masked or not, like WFI does. Delivery follows when the mask is dropped.
+void hostPlatformWaitForInterrupt(void) {
+	uint64_t sleepStart = hostPlatformGetNanoseconds();
+	uint32_t start = hostPlatformGetMicroseconds();
+	struct timespec poll = {0,hostPlatformIdlePoll*1000};
+	bool pending;
+
+	while(true) {
+		hostPlatformRunExternal();
+		pending = driverHWLANInterruptService(false) || driverHWECATTickTimerService(false);
+		if(pending || (hostPlatformGetMicroseconds() - start >= hostPlatformIdleLimit))
+			break;
+		if(!hostPlatformExternalFunction)																						// Spin while something external needs the time
+			nanosleep(&poll,NULL);
+	}
+
+	hostDWTSleptNanoseconds += hostPlatformGetNanoseconds() - sleepStart;
+	if(pending)
+		hostPlatformService();
+}
+
+DWT_Type *hostDWT(void) {
+	if(hostDWTRegisters.CTRL & DWT_CTRL_CYCCNTENA_Msk)
+		hostDWTRegisters.CYCCNT = (uint32_t)((hostPlatformGetNanoseconds() - hostDWTSleptNanoseconds)*(hostPlatformCoreClock/1000000)/1000);
+	return &hostDWTRegisters;
+}
+
+void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init) {
+	for(uint8_t pin = 0; pin < 16; pin++) {
+		if(GPIO_Init->Pin & (1 << pin)) {
+			GPIOx->MODER &= ~(0x03UL << (pin*2));
+			GPIOx->MODER |= (GPIO_Init->Mode & 0x03UL) << (pin*2);
+			if(GPIO_Init->Pull == GPIO_PULLUP)
+				GPIOx->IDR |= (1 << pin);
+		}
+	}
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState) {
+	if(PinState == GPIO_PIN_SET)
+		GPIOx->ODR |= GPIO_Pin;
+	else
+		GPIOx->ODR &= ~GPIO_Pin;
+}
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin) {
+	return (GPIOx->IDR & GPIO_Pin) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+uint32_t HAL_GetTick(void) {
+	return (uint32_t)(hostPlatformGetNanoseconds()/1000000);
+}
+
+uint32_t HAL_RCC_GetHCLKFreq(void) {
+	return SystemCoreClock;
+}
+
+uint32_t __get_PRIMASK(void) {
+	return hostPRIMASK;
+}
+
+void __set_PRIMASK(uint32_t priMask) {
+	hostPRIMASK = priMask;
+	if(!priMask)
+		hostPlatformService();
+}
+
+void __disable_irq(void) {
+	hostPRIMASK = 1;
+}
+
+void __enable_irq(void) {
+	hostPRIMASK = 0;
+	hostPlatformService();
+}
+
+uint32_t __get_BASEPRI(void) {
+	return hostBASEPRI;
+}
+
+void __set_BASEPRI(uint32_t basePri) {
+	uint32_t previous = hostBASEPRI;
+	hostBASEPRI = basePri & 0xFF;
+	if(!hostBASEPRI || (previous && hostBASEPRI > previous))											// Lowered, let pending work in
+		hostPlatformService();
+}
+
+void __set_BASEPRI_MAX(uint32_t basePri) {
+	basePri &= 0xFF;
+	if(basePri && (!hostBASEPRI || basePri < hostBASEPRI))												// Only ever raises the masking level
+		hostBASEPRI = basePri;
+}
+
+// Nothing can interrupt between the pair on the host, so the exclusive store never fails
+uint32_t __LDREXW(volatile uint32_t *addr) {
+	return *addr;
+}
+
+uint32_t __STREXW(uint32_t value, volatile uint32_t *addr) {
+	*addr = value;
+	return 0;
+}
@@ -0,0 +1,580 @@
+#include "hostLAN9252.h"
+#include "hostPlatform.h"
+#include <string.h>
+
+// SPI commands
+#define hostLAN9252CommandSerialWrite					0x02
+#define hostLAN9252CommandSerialRead					0x03
+#define hostLAN9252CommandFastRead						0x0B
+#define hostLAN9252AddressAutoIncrement				0x4000
+
+// LAN9252 system registers, seen directly on SPI
+#define hostLAN9252RegisterReadFIFOEnd				0x0020					// 0x00-0x1F all alias the PRAM read FIFO
+#define hostLAN9252RegisterWriteFIFOEnd				0x0040					// 0x20-0x3F all alias the PRAM write FIFO
+#define hostLAN9252RegisterIDRev							0x0050
+#define hostLAN9252RegisterIRQConfig					0x0054
+#define hostLAN9252RegisterInterruptStatus		0x0058
+#define hostLAN9252RegisterInterruptEnable		0x005C
+#define hostLAN9252RegisterByteOrder					0x0064
+#define hostLAN9252RegisterHardwareConfig			0x0074
+#define hostLAN9252RegisterCSRData						0x0300
+#define hostLAN9252RegisterCSRCommand					0x0304
+#define hostLAN9252RegisterPRAMReadAddress		0x0308
+#define hostLAN9252RegisterPRAMReadCommand		0x030C
+#define hostLAN9252RegisterPRAMWriteAddress		0x0310
+#define hostLAN9252RegisterPRAMWriteCommand		0x0314
+
+#define hostLAN9252CommandBusy								(1UL << 31)
+#define hostLAN9252CSRCommandRead							(1UL << 30)
+#define hostLAN9252PRAMAbort									(1UL << 30)
+#define hostLAN9252PRAMAvailable							(1UL << 0)
+#define hostLAN9252HardwareConfigReady				(1UL << 27)
+#define hostLAN9252IRQConfigEnable						(1UL << 8)
+#define hostLAN9252InterruptECATEvent					(1UL << 0)
+
+// ESC core registers behind the CSR and PRAM interface
+#define hostLAN9252ESCDLStatus								0x0110
+#define hostLAN9252ESCALControl								0x0120
+#define hostLAN9252ESCALEventMask							0x0204
+#define hostLAN9252ESCALEvent									0x0220
+#define hostLAN9252ESCWatchdogStatus					0x0440
+#define hostLAN9252ESCSyncManager							0x0800
+#define hostLAN9252ESCLocalTime								0x0910
+
+#define hostLAN9252SyncManagers								8
+#define hostLAN9252SMLength										2								// Offsets inside one 8 byte SyncManager channel
+#define hostLAN9252SMControl									4
+#define hostLAN9252SMStatus										5
+#define hostLAN9252SMActivate									6
+#define hostLAN9252SMPDIControl								7
+#define hostLAN9252SMModeMailbox							0x02
+#define hostLAN9252SMModeMask									0x03
+#define hostLAN9252SMDirectionECATWrite				0x04
+#define hostLAN9252SMDirectionMask						0x0C
+#define hostLAN9252SMStatusIntWrite						0x01
+#define hostLAN9252SMStatusIntRead						0x02
+#define hostLAN9252SMStatusMailboxFull				0x08
+
+#define hostLAN9252EventControl								0x0001
+#define hostLAN9252EventSMChange							0x0010
+#define hostLAN9252EventSM(n)									(1UL << (8 + (n)))
+
+typedef enum {
+	hostLAN9252PhaseCommand = 0,
+	hostLAN9252PhaseAddressHigh,
+	hostLAN9252PhaseAddressLow,
+	hostLAN9252PhaseDummy,
+	hostLAN9252PhaseData
+} hostLAN9252PhaseEnum;
+
+typedef struct {
+	bool Active;
+	uint16_t Address;
+	uint16_t Length;
+	uint32_t Count;																												// DWORDs in the transfer
+	uint32_t Index;																												// DWORDs moved through the FIFO so far
+	uint32_t PollsLeft;
+	uint32_t Data[hostLAN9252ESCMemorySize/4 + 1];
+} hostLAN9252PRAMStruct;
+
+static uint8_t hostLAN9252ESC[hostLAN9252ESCMemorySize];
+static hostLAN9252PRAMStruct hostLAN9252PRAMRead;
+static hostLAN9252PRAMStruct hostLAN9252PRAMWrite;
+static uint32_t hostLAN9252PRAMReadAddressLength;
+static uint32_t hostLAN9252PRAMWriteAddressLength;
+static uint32_t hostLAN9252CSRData;
+static uint32_t hostLAN9252CSRCommand;
+static uint32_t hostLAN9252CSRPollsLeft;
+static uint32_t hostLAN9252IRQConfig;
+static uint32_t hostLAN9252InterruptEnable;
+static uint32_t hostLAN9252BusyPolls = hostLAN9252DefaultBusyPolls;
+static bool hostLAN9252IRQLine;
+static hostLAN9252StatisticsStruct hostLAN9252Statistics;
+static void (*hostLAN9252IRQFunction)(void);
+
+static bool hostLAN9252Selected;
+static hostLAN9252PhaseEnum hostLAN9252Phase;
+static uint8_t hostLAN9252Command;
+static uint16_t hostLAN9252Address;
+static bool hostLAN9252Increment;
+static uint8_t hostLAN9252DummyLeft;
+static uint32_t hostLAN9252Latch;
+static uint8_t hostLAN9252LatchMask;
+
+static uint32_t hostLAN9252ReadDirect(uint16_t address);
+static void hostLAN9252WriteDirect(uint16_t address, uint32_t value);
+static uint8_t hostLAN9252PDIReadByte(uint16_t address);
+static void hostLAN9252PDIWriteByte(uint16_t address, uint8_t value);
+
+static uint32_t hostLAN9252Get32(uint16_t address) {
+	return (uint32_t)hostLAN9252ESC[address] | ((uint32_t)hostLAN9252ESC[address+1] << 8) | ((uint32_t)hostLAN9252ESC[address+2] << 16) | ((uint32_t)hostLAN9252ESC[address+3] << 24);
+}
+
+static void hostLAN9252Set32(uint16_t address, uint32_t value) {
+	for(uint8_t byte = 0; byte < 4; byte++)
+		hostLAN9252ESC[address+byte] = (uint8_t)(value >> (byte*8));
+}
+
+// The IRQ pin follows the masked AL event level, the callback is only given the assert edge.
+static void hostLAN9252UpdateIRQ(void) {
+	uint32_t pending = hostLAN9252Get32(hostLAN9252ESCALEvent) & hostLAN9252Get32(hostLAN9252ESCALEventMask);
+	bool line = (hostLAN9252IRQConfig & hostLAN9252IRQConfigEnable) && (hostLAN9252InterruptEnable & hostLAN9252InterruptECATEvent) && pending;
+
+	if(line && !hostLAN9252IRQLine) {
+		hostLAN9252Statistics.IRQs++;
+		hostLAN9252IRQLine = true;
+		if(hostLAN9252IRQFunction)
+			hostLAN9252IRQFunction();
+	}
+
+	hostLAN9252IRQLine = line;
+}
+
+static void hostLAN9252SetEvent(uint32_t mask) {
+	hostLAN9252Set32(hostLAN9252ESCALEvent,hostLAN9252Get32(hostLAN9252ESCALEvent) | mask);
+	hostLAN9252UpdateIRQ();
+}
+
+static void hostLAN9252ClearEvent(uint32_t mask) {
+	hostLAN9252Set32(hostLAN9252ESCALEvent,hostLAN9252Get32(hostLAN9252ESCALEvent) & ~mask);
+	hostLAN9252UpdateIRQ();
+}
+
+static uint8_t *hostLAN9252SM(uint8_t n) {
+	return &hostLAN9252ESC[hostLAN9252ESCSyncManager + (n << 3)];
+}
+
+// A SyncManager only guards its buffer while enabled by the master and not deactivated by the PDI.
+static int8_t hostLAN9252FindSM(uint16_t address, uint16_t *end) {
+	for(uint8_t n = 0; n < hostLAN9252SyncManagers; n++) {
+		uint8_t *sm = hostLAN9252SM(n);
+		uint16_t start = sm[0] | (sm[1] << 8);
+		uint16_t length = sm[hostLAN9252SMLength] | (sm[hostLAN9252SMLength+1] << 8);
+
+		if(!(sm[hostLAN9252SMActivate] & 0x01) || (sm[hostLAN9252SMPDIControl] & 0x01) || !length)
+			continue;
+
+		if(address >= start && address < start + length) {
+			*end = start + length - 1;
+			return n;
+		}
+	}
+
+	return -1;
+}
+
+static bool hostLAN9252SMIsMailbox(uint8_t n) {
+	return (hostLAN9252SM(n)[hostLAN9252SMControl] & hostLAN9252SMModeMask) == hostLAN9252SMModeMailbox;
+}
+
+static bool hostLAN9252SMIsECATWrite(uint8_t n) {
+	return (hostLAN9252SM(n)[hostLAN9252SMControl] & hostLAN9252SMDirectionMask) == hostLAN9252SMDirectionECATWrite;
+}
+
+void hostLAN9252Reset(void) {
+	memset(hostLAN9252ESC,0,sizeof(hostLAN9252ESC));
+	memset(&hostLAN9252PRAMRead,0,sizeof(hostLAN9252PRAMRead));
+	memset(&hostLAN9252PRAMWrite,0,sizeof(hostLAN9252PRAMWrite));
+	hostLAN9252PRAMReadAddressLength = 0;
+	hostLAN9252PRAMWriteAddressLength = 0;
+	hostLAN9252CSRData = 0;
+	hostLAN9252CSRCommand = 0;
+	hostLAN9252CSRPollsLeft = 0;
+	hostLAN9252IRQConfig = 0;
+	hostLAN9252InterruptEnable = 0;
+	hostLAN9252IRQLine = false;
+	hostLAN9252Selected = false;
+
+	hostLAN9252ESC[hostLAN9252ESCDLStatus] = 0x01;																// PDI operational, EEPROM loaded
+	hostLAN9252ESC[hostLAN9252ESCWatchdogStatus] = 0x01;													// Process data watchdog active or disabled
+	hostLAN9252Set32(hostLAN9252ESCALEventMask,hostLAN9252DefaultALEventMask);
+	hostLAN9252ESC[0x0130] = 0x01;																								// AL status INIT
+
+	hostLAN9252ResetStatistics();
+}
+
+void hostLAN9252SetBusyPolls(uint32_t polls) {
+	hostLAN9252BusyPolls = polls;
+}
+
+void hostLAN9252Select(bool selected) {
+	if(selected && !hostLAN9252Selected) {
+		hostLAN9252Phase = hostLAN9252PhaseCommand;
+		hostLAN9252LatchMask = 0;
+	}
+
+	if(!selected && hostLAN9252Selected) {
+		if(hostLAN9252Command == hostLAN9252CommandSerialWrite && hostLAN9252LatchMask)	// Partial DWORD is committed on CS release
+			hostLAN9252WriteDirect(hostLAN9252Address & ~3,hostLAN9252Latch);
+		hostLAN9252Statistics.CSCycles++;
+	}
+
+	hostLAN9252Selected = selected;
+}
+
+uint8_t hostLAN9252Transfer(uint8_t mosi) {
+	uint8_t miso = 0xFF;
+
+	if(!hostLAN9252Selected)
+		return miso;
+
+	hostLAN9252Statistics.SPIBytes++;
+
+	switch(hostLAN9252Phase) {
+		case hostLAN9252PhaseCommand:
+			hostLAN9252Command = mosi;
+			hostLAN9252Phase = hostLAN9252PhaseAddressHigh;
+			break;
+		case hostLAN9252PhaseAddressHigh:
+			hostLAN9252Address = mosi << 8;
+			hostLAN9252Phase = hostLAN9252PhaseAddressLow;
+			break;
+		case hostLAN9252PhaseAddressLow:
+			hostLAN9252Address |= mosi;
+			hostLAN9252Increment = (hostLAN9252Address & hostLAN9252AddressAutoIncrement) != 0;
+			hostLAN9252Address &= 0x3FFF;
+			hostLAN9252DummyLeft = (hostLAN9252Command == hostLAN9252CommandFastRead) ? 1 : 0;
+			hostLAN9252Phase = hostLAN9252DummyLeft ? hostLAN9252PhaseDummy : hostLAN9252PhaseData;
+			break;
+		case hostLAN9252PhaseDummy:
+			if(!--hostLAN9252DummyLeft)
+				hostLAN9252Phase = hostLAN9252PhaseData;
+			break;
+		case hostLAN9252PhaseData: {
+			uint8_t lane = hostLAN9252Address & 3;
+			uint16_t dword = hostLAN9252Address & ~3;
+
+			if(hostLAN9252Command == hostLAN9252CommandSerialRead || hostLAN9252Command == hostLAN9252CommandFastRead) {
+				if(!lane || !hostLAN9252LatchMask) {																		// Registers are latched a full DWORD at a time
+					hostLAN9252Latch = hostLAN9252ReadDirect(dword);
+					hostLAN9252LatchMask = 0x0F;
+				}
+				miso = (uint8_t)(hostLAN9252Latch >> (lane*8));
+			}else if(hostLAN9252Command == hostLAN9252CommandSerialWrite) {
+				if(!hostLAN9252LatchMask)
+					hostLAN9252Latch = 0;
+				hostLAN9252Latch = (hostLAN9252Latch & ~(0xFFUL << (lane*8))) | ((uint32_t)mosi << (lane*8));
+				hostLAN9252LatchMask |= 1 << lane;
+				if(lane == 3) {
+					hostLAN9252WriteDirect(dword,hostLAN9252Latch);
+					hostLAN9252LatchMask = 0;
+				}
+			}
+
+			if(lane == 3 && !hostLAN9252Increment)																		// Without auto increment the access stays on one DWORD
+				hostLAN9252Address = dword;
+			else
+				hostLAN9252Address++;
+			if(hostLAN9252Command != hostLAN9252CommandSerialWrite && lane == 3)
+				hostLAN9252LatchMask = 0;
+			break;
+		}
+	}
+
+	return miso;
+}
+
+static void hostLAN9252StartPRAM(hostLAN9252PRAMStruct *pram, uint32_t addressLength) {
+	pram->Active = true;
+	pram->Address = addressLength & 0xFFFF;
+	pram->Length = addressLength >> 16;
+	pram->Count = ((pram->Address & 3) + pram->Length + 3)/4;
+	pram->Index = 0;
+	pram->PollsLeft = hostLAN9252BusyPolls;
+	memset(pram->Data,0,pram->Count*4);
+}
+
+static uint32_t hostLAN9252PRAMCommandStatus(hostLAN9252PRAMStruct *pram) {
+	if(!pram->Active)
+		return 0;
+
+	if(pram->PollsLeft) {																													// FIFO not filled yet
+		pram->PollsLeft--;
+		hostLAN9252Statistics.BusyPolls++;
+		return hostLAN9252CommandBusy;
+	}
+
+	uint32_t remaining = pram->Count - pram->Index;
+	if(remaining > hostLAN9252FIFODepth)
+		remaining = hostLAN9252FIFODepth;
+
+	return hostLAN9252CommandBusy | (remaining << 8) | (remaining ? hostLAN9252PRAMAvailable : 0);
+}
+
+static uint32_t hostLAN9252ReadDirect(uint16_t address) {
+	if(address < hostLAN9252RegisterReadFIFOEnd) {
+		if(!hostLAN9252PRAMRead.Active || hostLAN9252PRAMRead.Index >= hostLAN9252PRAMRead.Count)
+			return 0;
+
+		uint32_t value = hostLAN9252PRAMRead.Data[hostLAN9252PRAMRead.Index++];
+		if(hostLAN9252PRAMRead.Index == hostLAN9252PRAMRead.Count)
+			hostLAN9252PRAMRead.Active = false;
+		return value;
+	}
+
+	switch(address) {
+		case hostLAN9252RegisterIDRev:
+			return hostLAN9252IDRev;
+		case hostLAN9252RegisterIRQConfig:
+			return hostLAN9252IRQConfig;
+		case hostLAN9252RegisterInterruptStatus:
+			return (hostLAN9252Get32(hostLAN9252ESCALEvent) & hostLAN9252Get32(hostLAN9252ESCALEventMask)) ? hostLAN9252InterruptECATEvent : 0;
+		case hostLAN9252RegisterInterruptEnable:
+			return hostLAN9252InterruptEnable;
+		case hostLAN9252RegisterByteOrder:
+			return hostLAN9252ByteOrder;
+		case hostLAN9252RegisterHardwareConfig:
+			return hostLAN9252HardwareConfigReady;
+		case hostLAN9252RegisterCSRData:
+			return hostLAN9252CSRData;
+		case hostLAN9252RegisterCSRCommand:
+			if(hostLAN9252CSRPollsLeft) {
+				hostLAN9252CSRPollsLeft--;
+				hostLAN9252Statistics.BusyPolls++;
+				return hostLAN9252CSRCommand | hostLAN9252CommandBusy;
+			}
+			return hostLAN9252CSRCommand & ~hostLAN9252CommandBusy;
+		case hostLAN9252RegisterPRAMReadAddress:
+			return hostLAN9252PRAMReadAddressLength;
+		case hostLAN9252RegisterPRAMReadCommand:
+			return hostLAN9252PRAMCommandStatus(&hostLAN9252PRAMRead);
+		case hostLAN9252RegisterPRAMWriteAddress:
+			return hostLAN9252PRAMWriteAddressLength;
+		case hostLAN9252RegisterPRAMWriteCommand:
+			return hostLAN9252PRAMCommandStatus(&hostLAN9252PRAMWrite);
+		default:
+			return 0;
+	}
+}
+
+static void hostLAN9252WriteDirect(uint16_t address, uint32_t value) {
+	if(address >= hostLAN9252RegisterReadFIFOEnd && address < hostLAN9252RegisterWriteFIFOEnd) {
+		if(!hostLAN9252PRAMWrite.Active || hostLAN9252PRAMWrite.Index >= hostLAN9252PRAMWrite.Count)
+			return;
+
+		hostLAN9252PRAMWrite.Data[hostLAN9252PRAMWrite.Index++] = value;
+		if(hostLAN9252PRAMWrite.Index == hostLAN9252PRAMWrite.Count) {							// Last DWORD in, move it to process RAM
+			uint8_t *data = (uint8_t *)hostLAN9252PRAMWrite.Data + (hostLAN9252PRAMWrite.Address & 3);
+			for(uint16_t byte = 0; byte < hostLAN9252PRAMWrite.Length; byte++)
+				hostLAN9252PDIWriteByte(hostLAN9252PRAMWrite.Address + byte,data[byte]);
+			hostLAN9252PRAMWrite.Active = false;
+		}
+		return;
+	}
+
+	switch(address) {
+		case hostLAN9252RegisterIRQConfig:
+			hostLAN9252IRQConfig = value;
+			hostLAN9252UpdateIRQ();
+			break;
+		case hostLAN9252RegisterInterruptEnable:
+			hostLAN9252InterruptEnable = value;
+			hostLAN9252UpdateIRQ();
+			break;
+		case hostLAN9252RegisterCSRData:
+			hostLAN9252CSRData = value;
+			break;
+		case hostLAN9252RegisterCSRCommand: {
+			if(!(value & hostLAN9252CommandBusy))
+				break;
+
+			uint16_t escAddress = value & 0xFFFF;
+			uint8_t size = (value >> 16) & 0x07;
+			hostLAN9252CSRCommand = value;
+			hostLAN9252CSRPollsLeft = hostLAN9252BusyPolls;
+
+			if(value & hostLAN9252CSRCommandRead) {
+				hostLAN9252Statistics.CSRReads++;
+				hostLAN9252CSRData = 0;
+				for(uint8_t byte = 0; byte < size && byte < 4; byte++)
+					hostLAN9252CSRData |= (uint32_t)hostLAN9252PDIReadByte(escAddress + byte) << (byte*8);
+			}else{
+				hostLAN9252Statistics.CSRWrites++;
+				for(uint8_t byte = 0; byte < size && byte < 4; byte++)
+					hostLAN9252PDIWriteByte(escAddress + byte,(uint8_t)(hostLAN9252CSRData >> (byte*8)));
+			}
+			break;
+		}
+		case hostLAN9252RegisterPRAMReadAddress:
+			hostLAN9252PRAMReadAddressLength = value;
+			break;
+		case hostLAN9252RegisterPRAMReadCommand:
+			if(value & hostLAN9252PRAMAbort) {
+				hostLAN9252PRAMRead.Active = false;
+			}else if(value & hostLAN9252CommandBusy) {																// Snapshot the range with PDI side effects, then stream it
+				hostLAN9252Statistics.PRAMReads++;
+				hostLAN9252StartPRAM(&hostLAN9252PRAMRead,hostLAN9252PRAMReadAddressLength);
+				uint8_t *data = (uint8_t *)hostLAN9252PRAMRead.Data + (hostLAN9252PRAMRead.Address & 3);
+				for(uint16_t byte = 0; byte < hostLAN9252PRAMRead.Length; byte++)
+					data[byte] = hostLAN9252PDIReadByte(hostLAN9252PRAMRead.Address + byte);
+			}
+			break;
+		case hostLAN9252RegisterPRAMWriteAddress:
+			hostLAN9252PRAMWriteAddressLength = value;
+			break;
+		case hostLAN9252RegisterPRAMWriteCommand:
+			if(value & hostLAN9252PRAMAbort) {
+				hostLAN9252PRAMWrite.Active = false;
+			}else if(value & hostLAN9252CommandBusy) {
+				hostLAN9252Statistics.PRAMWrites++;
+				hostLAN9252StartPRAM(&hostLAN9252PRAMWrite,hostLAN9252PRAMWriteAddressLength);
+			}
+			break;
+		default:
+			break;
+	}
+}
+
+// PDI side ESC access. SyncManager buffers follow the ESC rules: any PDI access to a buffer clears its event and
+// interrupt flag, the last byte hands a mailbox over to the other side.
+static uint8_t hostLAN9252PDIReadByte(uint16_t address) {
+	if(address >= hostLAN9252ESCMemorySize)
+		return 0;
+
+	if(address == hostLAN9252ESCALControl) {
+		hostLAN9252ClearEvent(hostLAN9252EventControl);
+	}else if(address >= hostLAN9252ESCSyncManager && address < hostLAN9252ESCSyncManager + (hostLAN9252SyncManagers << 3)) {
+		if((address & 0x07) == hostLAN9252SMActivate)
+			hostLAN9252ClearEvent(hostLAN9252EventSMChange);
+	}else if(address == hostLAN9252ESCLocalTime) {
+		uint64_t localTime = hostPlatformGetNanoseconds();
+		for(uint8_t byte = 0; byte < 8; byte++)
+			hostLAN9252ESC[hostLAN9252ESCLocalTime + byte] = (uint8_t)(localTime >> (byte*8));
+	}
+
+	uint16_t end;
+	int8_t n = hostLAN9252FindSM(address,&end);
+	if(n >= 0 && hostLAN9252SMIsECATWrite(n)) {
+		uint8_t *sm = hostLAN9252SM(n);
+		sm[hostLAN9252SMStatus] &= ~hostLAN9252SMStatusIntWrite;
+		if(address == end && hostLAN9252SMIsMailbox(n))
+			sm[hostLAN9252SMStatus] &= ~hostLAN9252SMStatusMailboxFull;
+		hostLAN9252ClearEvent(hostLAN9252EventSM(n));
+	}
+
+	return hostLAN9252ESC[address];
+}
+
+static void hostLAN9252PDIWriteByte(uint16_t address, uint8_t value) {
+	if(address >= hostLAN9252ESCMemorySize)
+		return;
+
+	if(address >= hostLAN9252ESCALEvent && address < hostLAN9252ESCALEvent + 4)							// Read only for the PDI
+		return;
+
+	hostLAN9252ESC[address] = value;
+
+	if(address == hostLAN9252ESCALEventMask || address == hostLAN9252ESCALEventMask + 1)
+		hostLAN9252UpdateIRQ();
+
+	if(address >= hostLAN9252ESCSyncManager && address < hostLAN9252ESCSyncManager + (hostLAN9252SyncManagers << 3)) {
+		if((address & 0x07) == hostLAN9252SMPDIControl && (value & 0x01))					// PDI deactivation resets the buffer state
+			hostLAN9252ESC[(address & ~0x07) + hostLAN9252SMStatus] = 0;
+		return;
+	}
+
+	uint16_t end;
+	int8_t n = hostLAN9252FindSM(address,&end);
+	if(n >= 0 && !hostLAN9252SMIsECATWrite(n)) {
+		uint8_t *sm = hostLAN9252SM(n);
+		sm[hostLAN9252SMStatus] &= ~hostLAN9252SMStatusIntRead;
+		if(address == end && hostLAN9252SMIsMailbox(n))
+			sm[hostLAN9252SMStatus] |= hostLAN9252SMStatusMailboxFull;
+		hostLAN9252ClearEvent(hostLAN9252EventSM(n));
+	}
+}
+
+// EtherCAT side. A mailbox refuses access while it belongs to the PDI, the caller sees that as a zero working counter.
+bool hostLAN9252MasterRead(uint16_t address, void *buffer, uint16_t length) {
+	uint8_t *data = (uint8_t *)buffer;
+	uint16_t end;
+	int8_t n = hostLAN9252FindSM(address,&end);
+
+	if(address + length > hostLAN9252ESCMemorySize)
+		return false;
+
+	if(n >= 0 && !hostLAN9252SMIsECATWrite(n) && hostLAN9252SMIsMailbox(n) && !(hostLAN9252SM(n)[hostLAN9252SMStatus] & hostLAN9252SMStatusMailboxFull))
+		return false;
+
+	if(address <= hostLAN9252ESCLocalTime && address + length > hostLAN9252ESCLocalTime) {
+		uint64_t localTime = hostPlatformGetNanoseconds();
+		for(uint8_t byte = 0; byte < 8; byte++)
+			hostLAN9252ESC[hostLAN9252ESCLocalTime + byte] = (uint8_t)(localTime >> (byte*8));
+	}
+
+	memcpy(data,&hostLAN9252ESC[address],length);
+
+	if(n >= 0 && !hostLAN9252SMIsECATWrite(n) && address + length > end) {
+		uint8_t *sm = hostLAN9252SM(n);
+		sm[hostLAN9252SMStatus] &= ~hostLAN9252SMStatusMailboxFull;
+		sm[hostLAN9252SMStatus] |= hostLAN9252SMStatusIntRead;
+		hostLAN9252SetEvent(hostLAN9252EventSM(n));
+	}
+
+	return true;
+}
+
+bool hostLAN9252MasterWrite(uint16_t address, const void *buffer, uint16_t length) {
+	const uint8_t *data = (const uint8_t *)buffer;
+	uint16_t end;
+	int8_t n = hostLAN9252FindSM(address,&end);
+
+	if(address + length > hostLAN9252ESCMemorySize)
+		return false;
+
+	if(n >= 0 && hostLAN9252SMIsECATWrite(n) && hostLAN9252SMIsMailbox(n) && (hostLAN9252SM(n)[hostLAN9252SMStatus] & hostLAN9252SMStatusMailboxFull))
+		return false;
+
+	for(uint16_t byte = 0; byte < length; byte++) {
+		uint16_t target = address + byte;
+
+		if(target >= hostLAN9252ESCALEvent && target < hostLAN9252ESCALEvent + 4)
+			continue;
+		if(target >= hostLAN9252ESCSyncManager && target < hostLAN9252ESCSyncManager + (hostLAN9252SyncManagers << 3)) {
+			uint8_t offset = target & 0x07;
+			if(offset == hostLAN9252SMStatus || offset == hostLAN9252SMPDIControl)		// Owned by the ESC and the PDI
+				continue;
+			if(offset == hostLAN9252SMActivate) {
+				if(!(data[byte] & 0x01))
+					hostLAN9252ESC[(target & ~0x07) + hostLAN9252SMStatus] = 0;
+				hostLAN9252ESC[target] = data[byte];
+				hostLAN9252SetEvent(hostLAN9252EventSMChange);
+				continue;
+			}
+		}
+		hostLAN9252ESC[target] = data[byte];
+	}
+
+	if(address <= hostLAN9252ESCALControl && address + length > hostLAN9252ESCALControl)
+		hostLAN9252SetEvent(hostLAN9252EventControl);
+
+	if(n >= 0 && hostLAN9252SMIsECATWrite(n) && address + length > end) {
+		uint8_t *sm = hostLAN9252SM(n);
+		if(hostLAN9252SMIsMailbox(n))
+			sm[hostLAN9252SMStatus] |= hostLAN9252SMStatusMailboxFull;
+		sm[hostLAN9252SMStatus] |= hostLAN9252SMStatusIntWrite;
+		hostLAN9252SetEvent(hostLAN9252EventSM(n));
+	}
+
+	return true;
+}
+
+uint32_t hostLAN9252GetALEvent(void) {
+	return hostLAN9252Get32(hostLAN9252ESCALEvent);
+}
+
+bool hostLAN9252IRQAsserted(void) {
+	return hostLAN9252IRQLine;
+}
+
+void hostLAN9252BindIRQFunction(void (*callback)(void)) {
+	hostLAN9252IRQFunction = callback;
+}
+
+const hostLAN9252StatisticsStruct *hostLAN9252GetStatistics(void) {
+	return &hostLAN9252Statistics;
+}
+
+void hostLAN9252ResetStatistics(void) {
+	memset(&hostLAN9252Statistics,0,sizeof(hostLAN9252Statistics));
+}
@@ -0,0 +1,1133 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hostSlave.h"
+#include "hostMaster.h"
+#include "hostLAN9252.h"
+#include "hostPlatform.h"
+#include "hostBoot.h"
+#include "hostNunChuck.h"
+#include "middleSOES.h"
+#include "middleFirmwareUpdate.h"
+#include "middleCapture.h"
+#include "middleTrace.h"
+#include "middleNetwork.h"
+#include "middleTelemetry.h"
+#include "middleDiagnosis.h"
+#include "middleParameter.h"
+#include "middleCalibration.h"
+
+// Mailbox throughput in PREOP, no process data running: back to back SDO uploads, a browse of the object dictionary
+// with SDO information and an FoE write of a file into the host RAM file. A sample capture triggered over the process
+// data in OP, read back with FoE and checked against every sample the sensor task produced. The event trace of all that
+// plus one refused SDO upload, read back with FoE. ARP, ping and the UDP telemetry over EoE. The nunchuck unplugged and
+// given bad calibration data, each fault and its recovery expected as a CoE emergency and found in the diagnosis
+// history. Then firmware updates in BOOT through the bootloader logic: one confirmed in OP, one rolled back because it
+// never got there, one with a bad CRC. Before those the parameter store: settings saved with 0x1010 survive a reset,
+// records written in OP wait in RAM for PREOP, the journal compacts with the settings kept and 0x1011 brings the
+// defaults back. A user calibration captured and
+// written over 0x8001 for a nunchuck with bad calibration data, in use from the first sample after a reset. Tracking
+// that learns a drift of the joystick centre and the accelerometer bias at rest, but nothing in motion.
+// Usage: diebieslave_mbxbench [SDO requests] [FoE bytes] [image bytes]
+
+#define hostMailboxBenchmarkDefaultRequests		200
+#define hostMailboxBenchmarkDefaultFoEBytes		16384
+#define hostMailboxBenchmarkDefaultImageBytes	65536
+#define hostMailboxBenchmarkMinimumImage			8																	// The two vectors the bootloader checks
+#define hostMailboxBenchmarkResetHandler			0x1C1
+#define hostMailboxBenchmarkVersion						0x00000300
+#define hostMailboxBenchmarkResetTimeout			100000														// us the slave gets to reset after BOOT
+#define hostMailboxBenchmarkConfirmTime				10000															// us in OP for the trial to be confirmed
+#define hostMailboxBenchmarkCaptureHistory		1000000														// us of motion before the trigger
+#define hostMailboxBenchmarkCaptureTimeout		((middleCaptureDefaultPostTrigger + 1000)*1000)		// us
+#define hostMailboxBenchmarkCaptureBit				0x02															// CaptureTrigger in the outputs
+#define hostMailboxBenchmarkRecordingSize			100000														// Samples
+#define hostMailboxBenchmarkRawSampleSize			13																// Bytes, the sample and a 32 bit timestamp
+#define hostMailboxBenchmarkSDOIndex					0x1018
+#define hostMailboxBenchmarkSDOSubIndex				0x01
+#define hostMailboxBenchmarkBrowseSize				1024															// Bytes, longest SDO information response
+#define hostMailboxBenchmarkTraceSDOIndex			0x5FFF														// Not in the object dictionary
+#define hostMailboxBenchmarkTraceAbortCode		0x06020000												// Object does not exist
+#define hostMailboxBenchmarkHostIP						0xC0A80A01												// 192.168.10.1, the master side
+#define hostMailboxBenchmarkSlaveIP						0xC0A80A02
+#define hostMailboxBenchmarkSubnet						0xFFFFFF00
+#define hostMailboxBenchmarkHostPort					40000
+#define hostMailboxBenchmarkEchoBytes					200																// Echo payload, spans a few fragments
+#define hostMailboxBenchmarkTelemetryPeriod		50																// ms
+#define hostMailboxBenchmarkTelemetryTime			1000000														// us subscribed
+#define hostMailboxBenchmarkEoETimeout				200000														// us for an answer
+#define hostMailboxBenchmarkEmergencyTimeout	1000000														// us for an emergency, the sensor retries every 500ms
+#define hostMailboxBenchmarkParameterTimeout	1000000														// us for queued records to reach flash
+#define hostMailboxBenchmarkParameterKey			(middleCalibrationKey + middleCalibrationKeyMask + 1)	// No module uses it
+#define hostMailboxBenchmarkParameterRecords	1000															// Most filler records written
+#define hostMailboxBenchmarkParameterSpacing	3000															// us between filler records, ~2 task runs each
+#define hostMailboxBenchmarkThreshold					12345
+#define hostMailboxBenchmarkMeasureInterval		20000															// us
+#define hostMailboxBenchmarkNunChuckID				0x0000A4200000ULL
+#define hostMailboxBenchmarkCalibrationTimeout	1000000														// us for a capture
+#define hostMailboxBenchmarkRangeTime					2100000														// us of motion, a whole joystick sweep
+#define hostMailboxBenchmarkZ1g								614																// Stored in place of 716, rest reads 2g
+#define hostMailboxBenchmarkCalibrationSamples	16
+#define hostMailboxBenchmarkTrackingTime			4000000														// us, a dozen tracking windows
+#define hostMailboxBenchmarkJoystickDrift			6																	// counts
+#define hostMailboxBenchmarkAccelerometerDrift	20																// counts, ~0.1g
+
+static bool hostMailboxBenchmarkSDO(uint32_t requests) {
+	const hostMasterStatisticsStruct *master = hostMasterGetStatistics();
+	uint32_t start = hostPlatformGetMicroseconds();
+	uint32_t lastProgress = start;
+	uint32_t responses = 0;
+
+	hostMasterResetStatistics();
+	hostLAN9252ResetStatistics();
+
+	while(master->SDOResponses < requests) {
+		hostMasterSDOUploadStart(hostMailboxBenchmarkSDOIndex,hostMailboxBenchmarkSDOSubIndex);				// Refused while one is still pending
+		hostSlaveStep();
+
+		uint32_t now = hostPlatformGetMicroseconds();
+		if(master->SDOResponses != responses) {
+			responses = master->SDOResponses;
+			lastProgress = now;
+		}else if(now - lastProgress > hostMasterStateTimeout) {
+			printf("SDO: stalled after %lu responses\n",(unsigned long)responses);
+			return false;
+		}
+	}
+
+	uint32_t elapsed = hostPlatformGetMicroseconds() - start;
+	const hostLAN9252StatisticsStruct *spi = hostLAN9252GetStatistics();
+
+	printf("SDO: %lu uploads of 0x%04X:%02X in %lu us, %.0f requests/s\n",(unsigned long)master->SDOResponses,hostMailboxBenchmarkSDOIndex,
+		hostMailboxBenchmarkSDOSubIndex,(unsigned long)elapsed,elapsed ? master->SDOResponses*1e6/elapsed : 0.0);
+	printf("  round trip avg %.1f us, worst %lu us, %lu aborts, %lu refused\n",(double)master->SDOTimeTotal/master->SDOResponses,
+		(unsigned long)master->WorstSDOTime,(unsigned long)master->SDOAborts,(unsigned long)master->MailboxRefused);
+	printf("  SPI per request: %.1f transactions, %.1f bytes\n",(double)spi->CSCycles/master->SDOResponses,(double)spi->SPIBytes/master->SDOResponses);
+
+	return !master->SDOAborts;
+}
+
+// What a configuration tool does on start-up: the object list, then the description of every object and every entry,
+// each one checked against the object dictionary the firmware was built with.
+static bool hostMailboxBenchmarkBrowse(void) {
+	const hostMasterStatisticsStruct *master = hostMasterGetStatistics();
+	uint8_t request[4], response[hostMailboxBenchmarkBrowseSize];
+	uint32_t received, objects = 0, entries = 0;
+	uint32_t start = hostPlatformGetMicroseconds();
+	bool ok;
+
+	hostMasterResetStatistics();
+	hostLAN9252ResetStatistics();
+
+	while(SDOobjects[objects].index != 0xFFFF)
+		objects++;
+
+	request[0] = 0x00;																																		// Number of objects per list
+	request[1] = 0x00;
+	ok = hostMasterSDOInfo(hostMasterSDOInfoGetODList,request,2,response,sizeof(response),&received) && (received == 12) &&
+		(response[2] | (response[3] << 8)) == objects;
+
+	request[0] = 0x01;																																		// All objects
+	ok = ok && hostMasterSDOInfo(hostMasterSDOInfoGetODList,request,2,response,sizeof(response),&received) && (received == 2 + objects*2);
+	for(uint32_t n = 0; ok && n < objects; n++)
+		ok = (response[2 + n*2] | (response[3 + n*2] << 8)) == SDOobjects[n].index;
+	if(!ok)
+		printf("  object list wrong\n");
+
+	for(uint32_t n = 0; ok && n < objects; n++) {
+		const _objectlist *object = &SDOobjects[n];
+
+		request[0] = object->index & 0xFF;
+		request[1] = object->index >> 8;
+		ok = hostMasterSDOInfo(hostMasterSDOInfoGetOD,request,2,response,sizeof(response),&received) && (received == 6 + strlen(object->name)) &&
+			(response[0] | (response[1] << 8)) == object->index && response[4] == object->maxsub && response[5] == object->objtype &&
+			!memcmp(&response[6],object->name,received - 6);
+		if(ok && object->objtype == OTYPE_VAR)
+			ok = (response[2] | (response[3] << 8)) == object->objdesc->datatype;
+
+		for(uint16_t subIndex = 0; ok && subIndex <= object->maxsub; subIndex++) {
+			const _objd *entry = &object->objdesc[subIndex];
+
+			request[2] = subIndex;
+			request[3] = 0;
+			ok = hostMasterSDOInfo(hostMasterSDOInfoGetED,request,4,response,sizeof(response),&received) && (received == 10 + strlen(entry->name)) &&
+				response[2] == subIndex && (response[4] | (response[5] << 8)) == entry->datatype &&
+				(response[6] | (response[7] << 8)) == entry->bitlength && (response[8] | (response[9] << 8)) == entry->access &&
+				!memcmp(&response[10],entry->name,received - 10);
+			entries++;
+		}
+		if(!ok)
+			printf("  description of 0x%04X wrong\n",object->index);
+	}
+
+	request[0] = 0x00;
+	request[1] = 0x10;
+	request[2] = 0x01;
+	ok = ok && !hostMasterSDOInfo(hostMasterSDOInfoGetED,request,4,response,sizeof(response),&received);											// 0x1000 has no subindex 1
+
+	uint32_t elapsed = hostPlatformGetMicroseconds() - start;
+	const hostLAN9252StatisticsStruct *spi = hostLAN9252GetStatistics();
+
+	printf("Browse: %lu objects and %lu entries %s in %lu requests, %lu responses, %lu us, %.1f us per request\n",(unsigned long)objects,
+		(unsigned long)entries,ok ? "described" : "NOT described",(unsigned long)master->SDORequests,(unsigned long)master->SDOResponses,
+		(unsigned long)elapsed,master->SDORequests ? (double)elapsed/master->SDORequests : 0.0);
+	printf("  SPI per request: %.1f transactions, %.1f bytes\n",master->SDORequests ? (double)spi->CSCycles/master->SDORequests : 0.0,
+		master->SDORequests ? (double)spi->SPIBytes/master->SDORequests : 0.0);
+
+	return ok;
+}
+
+static bool hostMailboxBenchmarkFoE(uint32_t bytes) {
+	const hostMasterStatisticsStruct *master = hostMasterGetStatistics();
+	uint8_t *file = malloc(bytes ? bytes : 1);
+	uint32_t transferTime = 0;
+	uint32_t written = 0;
+
+	for(uint32_t i = 0; i < bytes; i++)
+		file[i] = (uint8_t)(i*7 + (i >> 8));
+
+	hostSlaveFoEFileClear();
+	hostMasterResetStatistics();
+	hostLAN9252ResetStatistics();
+
+	bool ok = hostMasterFoEWrite(hostSlaveFoEFileName,0,file,bytes,&transferTime);
+	const uint8_t *image = hostSlaveFoEFile(&written);
+	if(ok && (written < bytes || memcmp(image,file,bytes)))
+		ok = false;
+
+	const hostLAN9252StatisticsStruct *spi = hostLAN9252GetStatistics();
+	if(ok) {
+		printf("FoE: %lu bytes in %lu packets, %lu us, %.0f bytes/s\n",(unsigned long)master->FoEBytes,(unsigned long)master->FoEPackets,
+			(unsigned long)transferTime,transferTime ? master->FoEBytes*1e6/transferTime : 0.0);
+		printf("  SPI per packet: %.1f transactions, %.1f bytes\n",master->FoEPackets ? (double)spi->CSCycles/master->FoEPackets : 0.0,
+			master->FoEPackets ? (double)spi->SPIBytes/master->FoEPackets : 0.0);
+	}else{
+		printf("FoE: write of %lu bytes failed after %lu packets, %lu bytes in the file\n",(unsigned long)bytes,(unsigned long)master->FoEPackets,
+			(unsigned long)written);
+	}
+
+	free(file);
+	return ok;
+}
+
+static uint32_t hostMailboxBenchmarkVarint(const uint8_t **in) {
+	uint32_t value = 0;
+	uint8_t shift = 0;
+
+	do {
+		value |= (uint32_t)(**in & 0x7F) << shift;
+		shift += 7;
+	} while(*(*in)++ & 0x80);
+
+	return value;
+}
+
+static int32_t hostMailboxBenchmarkZigZag(const uint8_t **in) {
+	uint32_t value = hostMailboxBenchmarkVarint(in);
+	return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+}
+
+// Decodes capture.bin as the header of middleCapture.h describes it and compares every sample to the recording.
+static bool hostMailboxBenchmarkCaptureCheck(const uint8_t *file, uint32_t length, const middleNunChuckDataStruct *recording,
+	uint32_t *samples, uint32_t *averagePeriod) {
+	middleCaptureHeaderStruct header;
+	uint32_t sample = 0, mismatches = 0, firstTime = 0, lastTime = 0;
+
+	memcpy(&header,file,sizeof(header));
+	if(header.Magic != middleCaptureMagic || header.Format != middleCaptureFormat ||
+		length != sizeof(header) + header.Blocks*header.BlockSize || header.TriggerSample >= header.Samples)
+		return false;
+
+	for(uint16_t n = 0; n < header.Blocks; n++) {
+		const uint8_t *block = &file[sizeof(header) + n*header.BlockSize];
+		middleCaptureBlockHeaderStruct blockHeader;
+		int32_t value[5];
+		uint8_t flags;
+
+		memcpy(&blockHeader,block,sizeof(blockHeader));
+		const uint8_t *in = &block[sizeof(blockHeader)];
+		const uint8_t *end = &block[blockHeader.Length];
+		uint32_t time = blockHeader.Time;
+		uint32_t period = blockHeader.Period;
+		int16_t accelerometer;
+
+		value[0] = (int8_t)in[0];
+		value[1] = (int8_t)in[1];
+		for(uint8_t axis = 0; axis < 3; axis++) {
+			memcpy(&accelerometer,&in[2 + 2*axis],sizeof(accelerometer));
+			value[2 + axis] = accelerometer;
+		}
+		flags = in[8];
+		in += 9;
+
+		for(uint16_t record = 0; record < blockHeader.Samples; record++) {
+			if(record) {
+				uint8_t mask = *in++;
+				if(mask & middleCaptureDeltaPeriod)
+					period += hostMailboxBenchmarkZigZag(&in);
+				time += period;
+				for(uint8_t field = 0; field < 5; field++)
+					if(mask & (1 << field))
+						value[field] += hostMailboxBenchmarkZigZag(&in);
+				if(mask & middleCaptureDeltaFlags)
+					flags = *in++;
+			}
+
+			const middleNunChuckDataStruct *expected = &recording[header.FirstSequence + sample];
+			uint8_t expectedFlags = (expected->buttonC ? middleCaptureFlagButtonC : 0) | (expected->buttonZ ? middleCaptureFlagButtonZ : 0) |
+				(expected->dataValid ? middleCaptureFlagDataValid : 0);
+			if(value[0] != expected->joystickX || value[1] != expected->joystickY || value[2] != expected->accelerometerX ||
+				value[3] != expected->accelerometerY || value[4] != expected->accelerometerZ || flags != expectedFlags)
+				mismatches++;
+
+			if(!sample)
+				firstTime = time;
+			lastTime = time;
+			sample++;
+		}
+		if(in != end)
+			return false;
+	}
+
+	*samples = sample;
+	*averagePeriod = (sample > 1) ? (lastTime - firstTime)/(sample - 1) : 0;
+	return !mismatches && sample == header.Samples;
+}
+
+static bool hostMailboxBenchmarkCapture(const middleNunChuckDataStruct *recording) {
+	const hostMasterStatisticsStruct *master = hostMasterGetStatistics();
+	const middleCaptureStatusStruct *capture = middleCaptureGetStatus();
+	uint32_t size = sizeof(middleCaptureHeaderStruct) + middleCaptureBlocks*middleCaptureBlockSize;
+	uint8_t *file = malloc(size);
+	uint32_t length = 0, transferTime = 0, samples = 0, period = 0;
+	bool ok;
+
+	// History with the nunchuck moving, then the master sets the trigger bit and waits for the post trigger part
+	hostNunChuckSetMotion(true);
+	hostMasterStartCycle(hostMasterDefaultCycleTime,0);
+	ok = hostMasterSetState(ESCsafeop,NULL) && hostMasterSetState(ESCop,NULL);
+	hostSlaveRunFor(hostMailboxBenchmarkCaptureHistory);
+	hostMasterSetOutputBits(hostMailboxBenchmarkCaptureBit);
+	uint32_t deadline = modDelayDeadlineSet(hostMailboxBenchmarkCaptureTimeout);
+	while(capture->State != CAPTURE_DONE && !modDelayDeadlineExpired(deadline))
+		hostSlaveStep();
+	hostMasterSetOutputBits(0);
+	ok = ok && hostMasterSetState(ESCpreop,NULL);
+	hostMasterStopCycle();
+	hostNunChuckSetMotion(false);
+
+	if(!ok || capture->State != CAPTURE_DONE || capture->TriggerSource != middleCaptureTriggerRxPDO) {
+		printf("Capture: not triggered, state %u, AL status 0x%02X\n",capture->State,hostMasterGetState());
+		free(file);
+		return false;
+	}
+
+	hostMasterResetStatistics();
+	ok = hostMasterFoERead(middleCaptureFileName,middleCaptureFilePassword,file,size,&length,&transferTime);
+	ok = ok && (length == capture->Bytes) && (hostSlaveRecordedSamples() <= hostMailboxBenchmarkRecordingSize);
+	ok = ok && hostMailboxBenchmarkCaptureCheck(file,length,recording,&samples,&period);
+	free(file);
+
+	printf("Capture: %lu samples over %lu ms, %lu bytes read in %lu packets, %lu us, %.0f bytes/s, %s\n",(unsigned long)capture->Samples,
+		(unsigned long)capture->Duration/1000,(unsigned long)length,(unsigned long)master->FoEPackets,(unsigned long)transferTime,
+		transferTime ? length*1e6/transferTime : 0.0,ok ? "matches the sensor" : "does NOT match the sensor");
+	printf("  %.2f bytes per sample (raw %u), period %lu us, %lu blocks dropped before the trigger\n",
+		samples ? (double)(length - sizeof(middleCaptureHeaderStruct))/samples : 0.0,hostMailboxBenchmarkRawSampleSize,(unsigned long)period,
+		(unsigned long)capture->BlocksDropped);
+
+	return ok;
+}
+
+static bool hostMailboxBenchmarkTrace(void) {
+	const hostMasterStatisticsStruct *master = hostMasterGetStatistics();
+	uint32_t size = sizeof(modTraceHeaderStruct) + modTraceRecords*sizeof(modTraceRecordStruct);
+	uint8_t *file = malloc(size);
+	uint32_t length = 0, transferTime = 0, skipped = 0, states = 0;
+	modTraceHeaderStruct header;
+	bool op = false, abort = false;
+
+	hostMasterResetStatistics();
+	uint32_t deadline = modDelayDeadlineSet(hostMasterStateTimeout);
+	while(!hostMasterSDOUploadStart(hostMailboxBenchmarkTraceSDOIndex,0) && !modDelayDeadlineExpired(deadline))
+		hostSlaveStep();																														// Mailbox still busy with the last transfer
+	while(!master->SDOResponses && !modDelayDeadlineExpired(deadline))
+		hostSlaveStep();
+
+	hostMasterResetStatistics();
+	bool ok = hostMasterFoERead(middleTraceFileName,middleTraceFilePassword,file,size,&length,&transferTime);
+	memcpy(&header,file,sizeof(header));
+	ok = ok && (length >= sizeof(header)) && (header.Magic == modTraceMagic) && (header.Format == modTraceFormat) &&
+		(header.RecordSize == sizeof(modTraceRecordStruct)) && (length == sizeof(header) + header.Records*header.RecordSize);
+
+	for(uint32_t index = 0; ok && index < header.Records; index++) {
+		modTraceRecordStruct record;
+		memcpy(&record,file + sizeof(header) + index*sizeof(record),sizeof(record));
+		if(record.Sequence != (uint16_t)(header.FirstSequence + index)) {
+			skipped++;																															// Overwritten while it was read
+			continue;
+		}
+
+		if(record.Event == TRACE_AL_STATUS) {
+			states++;
+			op |= ((record.Arg0 & ESCREG_AL_STATEMASK) == ESCop);
+		}else if(record.Event == TRACE_SDO_ABORT) {
+			abort |= (record.Arg0 == ((uint32_t)hostMailboxBenchmarkTraceSDOIndex << 8)) && (record.Arg1 == hostMailboxBenchmarkTraceAbortCode);
+		}
+	}
+	free(file);
+
+	ok = ok && op && abort;
+	printf("Trace: %lu records after %lu lost, %lu bytes read in %lu packets, %lu us, %lu state changes, %s\n",(unsigned long)header.Records,
+		(unsigned long)header.FirstSequence,(unsigned long)length,(unsigned long)master->FoEPackets,(unsigned long)transferTime,(unsigned long)states,
+		ok ? "OP and the SDO abort logged" : "events MISSING");
+	if(skipped)
+		printf("  %lu records overwritten while read\n",(unsigned long)skipped);
+
+	return ok;
+}
+
+static const uint8_t hostMailboxBenchmarkHostMAC[6] = {0x02, 0x00, 0x00, 0x00, 0x00, 0xFE};
+static const uint8_t hostMailboxBenchmarkSlaveMAC[6] = {0x02, 0xDB, 0x53, 0x00, 0x00, 0x10};
+
+static uint16_t hostMailboxBenchmarkGet16(const uint8_t *data) {
+	return (data[0] << 8) | data[1];
+}
+
+static void hostMailboxBenchmarkPut16(uint8_t *data, uint16_t value) {
+	data[0] = value >> 8;
+	data[1] = value & 0xFF;
+}
+
+static void hostMailboxBenchmarkPut32(uint8_t *data, uint32_t value) {
+	hostMailboxBenchmarkPut16(&data[0],value >> 16);
+	hostMailboxBenchmarkPut16(&data[2],value & 0xFFFF);
+}
+
+static uint16_t hostMailboxBenchmarkChecksum(uint32_t sum, const uint8_t *data, uint16_t length) {
+	for(uint16_t i = 0; i + 1 < length; i += 2)
+		sum += hostMailboxBenchmarkGet16(&data[i]);
+	if(length & 1)
+		sum += data[length - 1] << 8;
+	while(sum >> 16)
+		sum = (sum & 0xFFFF) + (sum >> 16);
+
+	return ~sum & 0xFFFF;
+}
+
+// Ethernet and IPv4 header from the master to the slave, returns where the protocol payload goes.
+static uint8_t *hostMailboxBenchmarkIPFrame(uint8_t *frame, uint8_t protocol, uint16_t payload) {
+	uint8_t *ip = &frame[14];
+
+	memcpy(&frame[0],hostMailboxBenchmarkSlaveMAC,6);
+	memcpy(&frame[6],hostMailboxBenchmarkHostMAC,6);
+	hostMailboxBenchmarkPut16(&frame[12],0x0800);
+	memset(ip,0,20);
+	ip[0] = 0x45;
+	hostMailboxBenchmarkPut16(&ip[2],20 + payload);
+	ip[8] = 64;
+	ip[9] = protocol;
+	hostMailboxBenchmarkPut32(&ip[12],hostMailboxBenchmarkHostIP);
+	hostMailboxBenchmarkPut32(&ip[16],hostMailboxBenchmarkSlaveIP);
+	hostMailboxBenchmarkPut16(&ip[10],hostMailboxBenchmarkChecksum(0,ip,20));
+
+	return &ip[20];
+}
+
+// Checks a frame from the slave is IPv4 of the protocol to us with good checksums, returns the protocol payload.
+static const uint8_t *hostMailboxBenchmarkIPCheck(const uint8_t *frame, uint16_t length, uint8_t protocol, uint16_t *payload) {
+	const uint8_t *ip = &frame[14];
+
+	if(length < 34 || memcmp(&frame[0],hostMailboxBenchmarkHostMAC,6) || memcmp(&frame[6],hostMailboxBenchmarkSlaveMAC,6) ||
+		hostMailboxBenchmarkGet16(&frame[12]) != 0x0800 || ip[0] != 0x45 || ip[9] != protocol || hostMailboxBenchmarkChecksum(0,ip,20))
+		return NULL;
+
+	uint16_t total = hostMailboxBenchmarkGet16(&ip[2]);
+	if(total < 20 || 14 + total > length)
+		return NULL;
+
+	*payload = total - 20;
+	return &ip[20];
+}
+
+static bool hostMailboxBenchmarkUDPSend(const uint8_t *data, uint16_t length) {
+	uint8_t frame[hostMasterEoEFrameSize];
+	uint8_t *udp = hostMailboxBenchmarkIPFrame(frame,17,8 + length);
+	uint32_t pseudo = (hostMailboxBenchmarkHostIP >> 16) + (hostMailboxBenchmarkHostIP & 0xFFFF) + (hostMailboxBenchmarkSlaveIP >> 16) +
+		(hostMailboxBenchmarkSlaveIP & 0xFFFF) + 17 + 8 + length;
+
+	hostMailboxBenchmarkPut16(&udp[0],hostMailboxBenchmarkHostPort);
+	hostMailboxBenchmarkPut16(&udp[2],middleTelemetryPort);
+	hostMailboxBenchmarkPut16(&udp[4],8 + length);
+	hostMailboxBenchmarkPut16(&udp[6],0);
+	memcpy(&udp[8],data,length);
+	hostMailboxBenchmarkPut16(&udp[6],hostMailboxBenchmarkChecksum(pseudo,udp,8 + length));
+
+	return hostMasterEoESend(frame,14 + 20 + 8 + length);
+}
+
+// Next datagram to the master's port, checksums verified. Anything else in between counts as bad.
+static const uint8_t *hostMailboxBenchmarkUDPReceive(uint8_t *frame, uint16_t *length, uint32_t timeout, uint32_t *bad) {
+	uint16_t received, payload;
+	const uint8_t *udp;
+
+	while(hostMasterEoEReceive(frame,hostMasterEoEFrameSize,&received,timeout)) {
+		udp = hostMailboxBenchmarkIPCheck(frame,received,17,&payload);
+		uint32_t pseudo = (hostMailboxBenchmarkSlaveIP >> 16) + (hostMailboxBenchmarkSlaveIP & 0xFFFF) + (hostMailboxBenchmarkHostIP >> 16) +
+			(hostMailboxBenchmarkHostIP & 0xFFFF) + 17 + payload;
+		if(udp && payload >= 8 && hostMailboxBenchmarkGet16(&udp[0]) == middleTelemetryPort &&
+			hostMailboxBenchmarkGet16(&udp[2]) == hostMailboxBenchmarkHostPort && hostMailboxBenchmarkGet16(&udp[4]) == payload &&
+			!hostMailboxBenchmarkChecksum(pseudo,udp,payload)) {
+			*length = payload - 8;
+			return &udp[8];
+		}
+		(*bad)++;
+	}
+
+	return NULL;
+}
+
+// Telemetry request and its answer, pushes arriving in between are skipped.
+static bool hostMailboxBenchmarkTelemetryRequest(uint8_t type, uint8_t sequence, const void *body, uint16_t bodyLength,
+	middleTelemetryResponseStruct *response, uint32_t *bad) {
+	middleTelemetryHeaderStruct header = {middleTelemetryMagic, type, sequence};
+	uint8_t request[sizeof(header) + 8], frame[hostMasterEoEFrameSize];
+	const uint8_t *data;
+	uint16_t length;
+
+	memcpy(request,&header,sizeof(header));
+	memcpy(&request[sizeof(header)],body,bodyLength);
+	if(!hostMailboxBenchmarkUDPSend(request,sizeof(header) + bodyLength))
+		return false;
+
+	while((data = hostMailboxBenchmarkUDPReceive(frame,&length,hostMailboxBenchmarkEoETimeout,bad)) != NULL) {
+		memcpy(&header,data,sizeof(header));
+		if(header.Type == (type | middleTelemetryResponse) && header.Sequence == sequence && length == sizeof(header) + sizeof(*response)) {
+			memcpy(response,&data[sizeof(header)],sizeof(*response));
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static bool hostMailboxBenchmarkEoE(const middleNunChuckDataStruct *recording) {
+	const hostMasterStatisticsStruct *master = hostMasterGetStatistics();
+	uint8_t frame[hostMasterEoEFrameSize];
+	uint16_t length, result = 0xFFFF, payload;
+	uint32_t bad = 0, start;
+	middleTelemetryResponseStruct response;
+	bool arp = false, echo = false, ping, subscribed, unsubscribed, samplesMatch = true;
+	uint32_t samples = 0, gaps = 0, profiles = 0, traces = 0, traceRecords = 0;
+	uint32_t nextSample = 0;
+
+	hostMasterResetStatistics();
+	hostNunChuckSetMotion(true);
+	bool ok = hostMasterEoESetIP(hostMailboxBenchmarkSlaveMAC,hostMailboxBenchmarkSlaveIP,hostMailboxBenchmarkSubnet,&result) && !result;
+
+	// Who has the slave's address, broadcast
+	memset(&frame[0],0xFF,6);
+	memcpy(&frame[6],hostMailboxBenchmarkHostMAC,6);
+	hostMailboxBenchmarkPut16(&frame[12],0x0806);
+	hostMailboxBenchmarkPut16(&frame[14],1);
+	hostMailboxBenchmarkPut16(&frame[16],0x0800);
+	frame[18] = 6;
+	frame[19] = 4;
+	hostMailboxBenchmarkPut16(&frame[20],1);
+	memcpy(&frame[22],hostMailboxBenchmarkHostMAC,6);
+	hostMailboxBenchmarkPut32(&frame[28],hostMailboxBenchmarkHostIP);
+	memset(&frame[32],0,6);
+	hostMailboxBenchmarkPut32(&frame[38],hostMailboxBenchmarkSlaveIP);
+	if(ok && hostMasterEoESend(frame,42) && hostMasterEoEReceive(frame,sizeof(frame),&length,hostMailboxBenchmarkEoETimeout))
+		arp = length >= 42 && hostMailboxBenchmarkGet16(&frame[12]) == 0x0806 && hostMailboxBenchmarkGet16(&frame[20]) == 2 &&
+			!memcmp(&frame[22],hostMailboxBenchmarkSlaveMAC,6);
+
+	// Echo long enough to be fragmented both ways
+	uint8_t *icmp = hostMailboxBenchmarkIPFrame(frame,1,8 + hostMailboxBenchmarkEchoBytes);
+	uint8_t echoData[8 + hostMailboxBenchmarkEchoBytes];
+	memset(icmp,0,8);
+	icmp[0] = 8;
+	hostMailboxBenchmarkPut16(&icmp[4],0x1234);
+	hostMailboxBenchmarkPut16(&icmp[6],1);
+	for(uint16_t i = 0; i < hostMailboxBenchmarkEchoBytes; i++)
+		icmp[8 + i] = (uint8_t)(i*3);
+	hostMailboxBenchmarkPut16(&icmp[2],hostMailboxBenchmarkChecksum(0,icmp,8 + hostMailboxBenchmarkEchoBytes));
+	memcpy(echoData,icmp,sizeof(echoData));
+	if(ok && hostMasterEoESend(frame,14 + 20 + sizeof(echoData)) && hostMasterEoEReceive(frame,sizeof(frame),&length,hostMailboxBenchmarkEoETimeout)) {
+		const uint8_t *reply = hostMailboxBenchmarkIPCheck(frame,length,1,&payload);
+		echo = reply && payload == sizeof(echoData) && reply[0] == 0 && !hostMailboxBenchmarkChecksum(0,reply,payload) &&
+			!memcmp(&reply[4],&echoData[4],sizeof(echoData) - 4);
+	}
+
+	ping = ok && hostMailboxBenchmarkTelemetryRequest(TELEMETRY_PING,1,NULL,0,&response,&bad) && response.Result == TELEMETRY_OK;
+
+	// Every stream for a while, the samples have to follow on and match the sensor
+	middleTelemetrySubscribeStruct subscribe = {middleTelemetryStreams, 0, hostMailboxBenchmarkTelemetryPeriod};
+	subscribed = ok && hostMailboxBenchmarkTelemetryRequest(TELEMETRY_SUBSCRIBE,2,&subscribe,sizeof(subscribe),&response,&bad) &&
+		response.Result == TELEMETRY_OK && response.Streams == middleTelemetryStreams;
+	start = hostPlatformGetMicroseconds();
+	while(subscribed && hostPlatformGetMicroseconds() - start < hostMailboxBenchmarkTelemetryTime) {
+		const uint8_t *data = hostMailboxBenchmarkUDPReceive(frame,&length,hostMailboxBenchmarkEoETimeout,&bad);
+		middleTelemetryHeaderStruct header;
+		if(!data)
+			break;
+		memcpy(&header,data,sizeof(header));
+		data += sizeof(header);
+		length -= sizeof(header);
+
+		if(header.Type == TELEMETRY_SAMPLES) {
+			middleTelemetrySamplesStruct block;
+			memcpy(&block,data,sizeof(block));
+			if(samples && block.FirstSequence != nextSample)
+				gaps++;
+			for(uint16_t i = 0; i < block.Count; i++) {
+				middleTelemetrySampleStruct sample;
+				memcpy(&sample,data + sizeof(block) + i*sizeof(sample),sizeof(sample));
+				uint32_t sequence = block.FirstSequence + i;
+				if(sequence >= hostSlaveRecordedSamples() || sequence >= hostMailboxBenchmarkRecordingSize)
+					continue;
+				const middleNunChuckDataStruct *expected = &recording[sequence];
+				samplesMatch &= (sample.JoyStickX == expected->joystickX) && (sample.JoyStickY == expected->joystickY) &&
+					(sample.AcceleroMeter[0] == expected->accelerometerX) && (sample.AcceleroMeter[1] == expected->accelerometerY) &&
+					(sample.AcceleroMeter[2] == expected->accelerometerZ);
+			}
+			samples += block.Count;
+			nextSample = block.FirstSequence + block.Count;
+		}else if(header.Type == TELEMETRY_PROFILE) {
+			middleTelemetryProfileStruct profile;
+			memcpy(&profile,data,sizeof(profile));
+			profiles += (length == sizeof(profile) + profile.Tasks*sizeof(middleTelemetryTaskStruct)) && profile.Tasks;
+		}else if(header.Type == TELEMETRY_TRACE) {
+			middleTelemetryTraceStruct trace;
+			memcpy(&trace,data,sizeof(trace));
+			traces += (length == sizeof(trace) + trace.Records*sizeof(modTraceRecordStruct));
+			traceRecords += trace.Records;
+		}
+	}
+
+	unsubscribed = subscribed && hostMailboxBenchmarkTelemetryRequest(TELEMETRY_UNSUBSCRIBE,3,NULL,0,&response,&bad) &&
+		response.Result == TELEMETRY_OK && !response.Streams;
+	while(unsubscribed && hostMailboxBenchmarkUDPReceive(frame,&length,hostMailboxBenchmarkEoETimeout,&bad))
+		;																																							// Pushes already on their way are fine, but they have to stop
+	hostNunChuckSetMotion(false);
+
+	ok = ok && arp && echo && ping && unsubscribed && samples && samplesMatch && !gaps && profiles && traces && !bad;
+	printf("EoE: IP set %s, ARP %s, %u byte echo %s, telemetry PING %s, SUBSCRIBE %s, UNSUBSCRIBE %s\n",!result ? "ok" : "FAILED",
+		arp ? "answered" : "MISSING",hostMailboxBenchmarkEchoBytes,echo ? "returned" : "MISSING",ping ? "ok" : "FAILED",
+		subscribed ? "ok" : "FAILED",unsubscribed ? "ok" : "FAILED");
+	printf("  %lu samples %s with %lu gaps, %lu profiles, %lu trace pushes with %lu records, %lu bad frames\n",(unsigned long)samples,
+		samplesMatch ? "matching the sensor" : "NOT matching the sensor",(unsigned long)gaps,(unsigned long)profiles,(unsigned long)traces,
+		(unsigned long)traceRecords,(unsigned long)bad);
+	printf("  %lu frames out in %lu fragments, %lu in from %lu fragments, %lu dropped\n",(unsigned long)master->EoEFramesSent,
+		(unsigned long)master->EoEFragmentsSent,(unsigned long)master->EoEFramesReceived,(unsigned long)master->EoEFragmentsReceived,
+		(unsigned long)master->EoEDropped);
+
+	return ok;
+}
+
+typedef struct {
+	uint16_t ErrorCode;
+	uint8_t ErrorRegister;
+} hostMailboxBenchmarkEmergencyStruct;
+
+// Waits for the emergencies expected after a sensor fault came or went, in order. Returns the us until the first one.
+static bool hostMailboxBenchmarkEmergencyExpect(const hostMailboxBenchmarkEmergencyStruct *expected, uint8_t count, uint32_t *latency) {
+	uint32_t start = hostPlatformGetMicroseconds();
+	uint16_t errorCode;
+	uint8_t errorRegister;
+
+	for(uint8_t n = 0; n < count; n++) {
+		if(!hostMasterEmergencyReceive(&errorCode,&errorRegister,hostMailboxBenchmarkEmergencyTimeout)) {
+			printf("  emergency 0x%04X missing\n",expected[n].ErrorCode);
+			return false;
+		}
+		if(!n)
+			*latency = hostPlatformGetMicroseconds() - start;
+		if(errorCode != expected[n].ErrorCode || errorRegister != expected[n].ErrorRegister) {
+			printf("  emergency 0x%04X register 0x%02X, expected 0x%04X register 0x%02X\n",errorCode,errorRegister,expected[n].ErrorCode,
+				expected[n].ErrorRegister);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// Unplugged, plugged back with clone calibration data, unplugged again and back with good data.
+static bool hostMailboxBenchmarkEmergency(void) {
+	static const hostMailboxBenchmarkEmergencyStruct unplugged[] = {{middleSOESEmergencySensorCommunication,0x81}};
+	static const hostMailboxBenchmarkEmergencyStruct badCalibration[] = {{middleSOESEmergencyErrorReset,0x00},{middleSOESEmergencySensorCalibration,0x21}};
+	static const hostMailboxBenchmarkEmergencyStruct unpluggedAgain[] = {{middleSOESEmergencySensorCommunication,0xA1}};
+	static const hostMailboxBenchmarkEmergencyStruct recovered[] = {{middleSOESEmergencyErrorReset,0x21},{middleSOESEmergencyErrorReset,0x00}};
+	const hostMasterStatisticsStruct *master = hostMasterGetStatistics();
+	const middleSOESEmergencyStatusStruct *emergencies = middleSOESEmergencyGetStatus();
+	uint32_t latency = 0, worstLatency = 0;
+	uint32_t received = master->Emergencies;
+	bool ok;
+
+	hostNunChuckSetConnected(false);
+	ok = hostMailboxBenchmarkEmergencyExpect(unplugged,1,&latency);
+	worstLatency = latency;
+	hostNunChuckSetCalibrationValid(false);
+	hostNunChuckSetConnected(true);
+	ok = ok && hostMailboxBenchmarkEmergencyExpect(badCalibration,2,&latency);
+	worstLatency = (latency > worstLatency) ? latency : worstLatency;
+	hostNunChuckSetConnected(false);
+	ok = ok && hostMailboxBenchmarkEmergencyExpect(unpluggedAgain,1,&latency);
+	worstLatency = (latency > worstLatency) ? latency : worstLatency;
+	hostNunChuckSetCalibrationValid(true);
+	hostNunChuckSetConnected(true);
+	ok = ok && hostMailboxBenchmarkEmergencyExpect(recovered,2,&latency);
+	worstLatency = (latency > worstLatency) ? latency : worstLatency;
+	hostNunChuckSetConnected(true);																									// Back to normal after a failure too
+	hostNunChuckSetCalibrationValid(true);
+
+	printf("Emergency: unplug, bad calibration and recovery %s, worst %lu us after the fault, %lu received, %lu sent, %lu merged, %lu dropped\n",
+		ok ? "reported" : "NOT reported",(unsigned long)worstLatency,(unsigned long)(master->Emergencies - received),(unsigned long)emergencies->Sent,
+		(unsigned long)emergencies->Merged,(unsigned long)emergencies->Dropped);
+
+	return ok;
+}
+
+typedef struct {
+	uint16_t ErrorCode;
+	uint8_t ErrorRegister;
+	uint16_t Type;
+} hostMailboxBenchmarkDiagnosisStruct;
+
+// The emergencies of the sensor faults are the newest messages in the diagnosis history, in order and time stamped.
+// Acknowledging the newest one leaves nothing new, acknowledging one that is not there is refused.
+static bool hostMailboxBenchmarkDiagnosis(void) {
+	static const hostMailboxBenchmarkDiagnosisStruct expected[] = {
+		{middleSOESEmergencySensorCommunication,0x81,middleDiagnosisTypeError},
+		{middleSOESEmergencyErrorReset,0x00,middleDiagnosisTypeInfo},
+		{middleSOESEmergencySensorCalibration,0x21,middleDiagnosisTypeWarning},
+		{middleSOESEmergencySensorCommunication,0xA1,middleDiagnosisTypeError},
+		{middleSOESEmergencyErrorReset,0x21,middleDiagnosisTypeInfo},
+		{middleSOESEmergencyErrorReset,0x00,middleDiagnosisTypeInfo}
+	};
+	const uint8_t count = sizeof(expected)/sizeof(expected[0]);
+	const middleDiagnosisStatusStruct *diagnosis = middleDiagnosisGetStatus();
+	uint8_t message[middleDiagnosisMessageSize];
+	uint8_t newest = 0, acknowledged, available = 1, invalid = middleDiagnosisFirstMessage + middleDiagnosisMessages;
+	uint64_t timeStamp, firstTime = 0, lastTime = 0;
+	uint32_t length;
+	bool ok;
+
+	ok = hostMasterSDOUpload(0x10F3,0x02,&newest,sizeof(newest),NULL) && (newest >= middleDiagnosisFirstMessage);
+	ok = ok && hostMasterSDOUpload(0x10F3,0x04,&available,sizeof(available),NULL) && available;
+
+	for(uint8_t n = 0; ok && n < count; n++) {
+		uint8_t slot = (newest - middleDiagnosisFirstMessage + middleDiagnosisMessages - (count - 1 - n)) % middleDiagnosisMessages;
+		const hostMailboxBenchmarkDiagnosisStruct *entry = &expected[n];
+
+		if(!hostMasterSDOUpload(0x10F3,middleDiagnosisFirstMessage + slot,message,sizeof(message),&length) || length != sizeof(message)) {
+			printf("  diagnosis message :%02X unreadable\n",middleDiagnosisFirstMessage + slot);
+			ok = false;
+			break;
+		}
+
+		uint32_t diagCode = message[0] | (message[1] << 8) | ((uint32_t)message[2] << 16) | ((uint32_t)message[3] << 24);
+		uint16_t flags = message[4] | (message[5] << 8);
+		uint16_t parameterFlags = message[16] | (message[17] << 8);
+		memcpy(&timeStamp,&message[8],sizeof(timeStamp));
+		if(diagCode != entry->ErrorCode || flags != (entry->Type | 0x0100) || parameterFlags != middleDiagnosisParameterUDINT ||
+			message[18] != entry->ErrorRegister || !timeStamp || timeStamp < lastTime) {
+			printf("  diagnosis message :%02X code 0x%08lX flags 0x%04X register 0x%02X, expected 0x%04X register 0x%02X\n",middleDiagnosisFirstMessage + slot,
+				(unsigned long)diagCode,flags,message[18],entry->ErrorCode,entry->ErrorRegister);
+			ok = false;
+			break;
+		}
+		if(!n)
+			firstTime = timeStamp;
+		lastTime = timeStamp;
+	}
+
+	ok = ok && hostMasterSDODownload(0x10F3,0x03,&newest,sizeof(newest));
+	ok = ok && hostMasterSDOUpload(0x10F3,0x04,&available,sizeof(available),NULL) && !available;
+	ok = ok && hostMasterSDODownload(0x10F3,0x03,&invalid,sizeof(invalid));															// Taken by the SDO server, undone by the history
+	ok = ok && hostMasterSDOUpload(0x10F3,0x03,&acknowledged,sizeof(acknowledged),NULL) && (acknowledged == newest);
+
+	printf("Diagnosis: emergencies %s in the history, newest at :%02X, %lu us from the first to the last, %lu stored, %lu lost\n",
+		ok ? "found" : "NOT found",newest,(unsigned long)((lastTime - firstTime)/1000),(unsigned long)diagnosis->Stored,(unsigned long)diagnosis->Lost);
+
+	return ok;
+}
+
+// An image as the bootloader expects it in the slot: initial stack pointer and a reset handler inside the slot.
+static uint8_t *hostMailboxBenchmarkImage(uint8_t slot, uint32_t bytes, uint32_t version, bool corrupt, uint32_t *length) {
+	uint8_t *file = malloc(sizeof(middleFirmwareUpdateHeaderStruct) + bytes);
+	uint8_t *image = &file[sizeof(middleFirmwareUpdateHeaderStruct)];
+	uint32_t vectors[2] = {driverHWBootRAMEnd, middleBootControlSlotAddress(slot) + hostMailboxBenchmarkResetHandler};
+	middleFirmwareUpdateHeaderStruct header;
+
+	for(uint32_t i = 0; i < bytes; i++)
+		image[i] = (uint8_t)(i*13 + (i >> 9) + version);
+	memcpy(image,vectors,sizeof(vectors));
+
+	header.Magic = middleFirmwareUpdateMagic;
+	header.Length = bytes;
+	header.Checksum = middleBootControlCRC(0,image,bytes) ^ (corrupt ? 1 : 0);
+	header.Version = version;
+	memcpy(file,&header,sizeof(header));
+
+	*length = sizeof(header) + bytes;
+	return file;
+}
+
+// Master side of an update: BOOT, the image through FoE, back to INIT. The slave resets itself once it leaves BOOT
+// with a verified image.
+static bool hostMailboxBenchmarkDownload(uint32_t bytes, uint32_t version, bool corrupt, bool report) {
+	const hostMasterStatisticsStruct *master = hostMasterGetStatistics();
+	const middleFirmwareUpdateStatusStruct *update = middleFirmwareUpdateGetStatus();
+	uint8_t target = update->RunningSlot ^ 1;
+	uint32_t transferTime = 0;
+	uint32_t length;
+	uint8_t *file = hostMailboxBenchmarkImage(target,bytes,version,corrupt,&length);
+
+	if(!hostMasterSetState(ESCinit,NULL) || !hostMasterSetState(ESCboot,NULL)) {
+		printf("Firmware: BOOT failed, AL status 0x%02X\n",hostMasterGetState());
+		free(file);
+		return false;
+	}
+
+	hostMasterResetStatistics();
+	bool ok = hostMasterFoEWrite(middleFirmwareUpdateFileName,middleFirmwareUpdateFilePassword,file,length,&transferTime);
+	bool valid = (update->State == FIRMWARE_UPDATE_VALID);
+	free(file);
+
+	if(report) {
+		printf("Firmware: %lu bytes into slot %c in %lu packets, %lu us, %.0f bytes/s, %s\n",(unsigned long)length,'A' + target,
+			(unsigned long)master->FoEPackets,(unsigned long)transferTime,transferTime ? length*1e6/transferTime : 0.0,
+			(ok && valid) ? "verified" : "NOT verified");
+		printf("  %lu pages erased, %lu stalls, worst write %lu us, close and verify %lu us\n",(unsigned long)update->PagesErased,
+			(unsigned long)update->Stalls,(unsigned long)update->WorstWriteTime,(unsigned long)update->VerifyTime);
+	}
+
+	hostMasterRequestState(ESCinit);
+	uint32_t deadline = modDelayDeadlineSet(hostMailboxBenchmarkResetTimeout);
+	while(!hostBootResetRequested() && !modDelayDeadlineExpired(deadline))
+		hostSlaveStep();
+
+	if(corrupt) {
+		bool rejected = !ok && !valid && !hostBootResetRequested();
+		printf("Firmware with a bad CRC: %s\n",rejected ? "rejected, no reset" : "NOT rejected");
+		return rejected;
+	}
+
+	if(!hostBootResetRequested())
+		printf("Firmware: no reset after leaving BOOT\n");
+	return ok && valid && hostBootResetRequested();
+}
+
+static bool hostMailboxBenchmarkReboot(void) {
+	if(!hostSlaveReboot()) {
+		printf("Firmware: no bootable slot\n");
+		return false;
+	}
+
+	hostMasterInit();
+	return true;
+}
+
+// Runs the slave until the parameter store has nothing left to write, an erase it waits for included.
+static bool hostMailboxBenchmarkParameterWait(void) {
+	const middleParameterStatusStruct *parameter = middleParameterGetStatus();
+	uint32_t start = hostPlatformGetMicroseconds();
+
+	while((parameter->State == PARAMETER_WRITING || parameter->State == PARAMETER_WAITING) && hostPlatformGetMicroseconds() - start < hostMailboxBenchmarkParameterTimeout)
+		hostSlaveStep();
+
+	return (parameter->State == PARAMETER_IDLE);
+}
+
+static bool hostMailboxBenchmarkParameterReboot(void) {
+	return hostMailboxBenchmarkReboot() && hostMasterSetState(ESCpreop,NULL);
+}
+
+// A threshold and an interval saved with 0x1010 are back after a reset, a wrong signature is refused. Filler records
+// in OP stay queued until the queue refuses more, none goes to flash before the slave is back in PREOP. More of them
+// there compact the journal twice, the saved threshold carried along. "load" in 0x1011 voids it all with the next reset.
+static bool hostMailboxBenchmarkParameters(void) {
+	static const uint8_t save[4] = {'s', 'a', 'v', 'e'};
+	static const uint8_t load[4] = {'l', 'o', 'a', 'd'};
+	const middleParameterStatusStruct *parameter = middleParameterGetStatus();
+	uint16_t threshold = hostMailboxBenchmarkThreshold, compactions, records;
+	uint32_t interval = hostMailboxBenchmarkMeasureInterval, defaultInterval = middleNunChuckDefaultMeasureInterval*modDelayMicrosecondsPerMillisecond;
+	uint32_t aborts = hostMasterGetStatistics()->SDOAborts, start, storeTime = 0, fill = 0, value = 0;
+	bool refused, persisted, deferred = false, full = false, compacted = false, restored = false, ok;
+
+	refused = !hostMasterSDODownload(0x1010,0x01,load,sizeof(load)) && (hostMasterGetStatistics()->SDOAborts == aborts + 1);
+	ok = hostMasterSDODownload(0x2102,0x03,(const uint8_t *)&threshold,sizeof(threshold)) &&
+		hostMasterSDODownload(0x8000,0x01,(const uint8_t *)&interval,sizeof(interval));
+	start = hostPlatformGetMicroseconds();
+	ok = ok && hostMasterSDODownload(0x1010,0x01,save,sizeof(save)) && hostMailboxBenchmarkParameterWait();
+	storeTime = hostPlatformGetMicroseconds() - start;
+
+	threshold = 0;
+	interval = 0;
+	ok = ok && hostMailboxBenchmarkParameterReboot() && hostMasterSDOUpload(0x2102,0x03,(uint8_t *)&threshold,sizeof(threshold),NULL) &&
+		hostMasterSDOUpload(0x8000,0x01,(uint8_t *)&interval,sizeof(interval),NULL);
+	persisted = ok && (threshold == hostMailboxBenchmarkThreshold) && (interval == hostMailboxBenchmarkMeasureInterval);
+
+	compactions = parameter->Compactions;
+	records = parameter->Records;
+	hostMasterStartCycle(hostMasterDefaultCycleTime,0);
+	if(persisted && hostMasterSetState(ESCsafeop,NULL) && hostMasterSetState(ESCop,NULL)) {
+		while(fill < hostMailboxBenchmarkParameterRecords && middleParameterWrite(hostMailboxBenchmarkParameterKey,&fill,sizeof(fill))) {
+			hostSlaveRunFor(hostMailboxBenchmarkParameterSpacing);
+			fill++;
+		}
+		deferred = (fill < hostMailboxBenchmarkParameterRecords) && (parameter->State == PARAMETER_WAITING) &&
+			(parameter->Records == records) && (parameter->Compactions == compactions);
+
+		// A changed setting does not fit the full queue, the store is refused instead of confirmed
+		threshold = hostMailboxBenchmarkThreshold + 1;
+		aborts = hostMasterGetStatistics()->SDOAborts;
+		full = deferred && hostMasterSDODownload(0x2102,0x03,(const uint8_t *)&threshold,sizeof(threshold)) &&
+			!hostMasterSDODownload(0x1010,0x01,save,sizeof(save)) && (hostMasterGetStatistics()->SDOAborts == aborts + 1);
+		deferred = deferred && hostMasterSetState(ESCpreop,NULL) && hostMailboxBenchmarkParameterWait() &&
+			middleParameterRead(hostMailboxBenchmarkParameterKey,&value,sizeof(value)) && (value == fill - 1);
+	}
+	hostMasterStopCycle();
+
+	if(deferred) {
+		while(parameter->Compactions < compactions + 2 && fill < hostMailboxBenchmarkParameterRecords && middleParameterWrite(hostMailboxBenchmarkParameterKey,&fill,sizeof(fill))) {
+			hostSlaveRunFor(hostMailboxBenchmarkParameterSpacing);
+			fill++;
+		}
+		threshold = 0;
+		compacted = hostMailboxBenchmarkParameterWait() && (parameter->Compactions == compactions + 2) &&
+			middleParameterRead(hostMailboxBenchmarkParameterKey,&value,sizeof(value)) && (value == fill - 1) &&
+			middleParameterRead(0x210203,&threshold,sizeof(threshold)) && (threshold == hostMailboxBenchmarkThreshold);
+	}
+
+	if(compacted) {
+		ok = hostMasterSDODownload(0x8000,0x01,(const uint8_t *)&defaultInterval,sizeof(defaultInterval)) &&
+			hostMasterSDODownload(0x1011,0x01,load,sizeof(load)) && hostMailboxBenchmarkParameterWait() && hostMailboxBenchmarkParameterReboot();
+		restored = ok && hostMasterSDOUpload(0x2102,0x03,(uint8_t *)&threshold,sizeof(threshold),NULL) && (threshold == middleCaptureDefaultThreshold) &&
+			!middleParameterRead(hostMailboxBenchmarkParameterKey,&value,sizeof(value));
+	}
+
+	printf("Parameters: wrong signature %s, saved in %lu us and %s a reset, %lu filler records, writes in OP %s, store on a full queue %s, compaction %s, defaults %s\n",
+		refused ? "refused" : "NOT refused",(unsigned long)storeTime,persisted ? "kept over" : "NOT kept over",(unsigned long)fill,
+		deferred ? "deferred to PREOP" : "NOT deferred",full ? "refused" : "NOT refused",compacted ? "kept the settings" : "did NOT keep the settings",restored ? "restored" : "NOT restored");
+
+	return refused && persisted && deferred && full && compacted && restored;
+}
+
+// Writes a control to 0x8001:01 and runs the slave until a capture it started is done.
+static uint8_t hostMailboxBenchmarkCalibrationControl(uint8_t control) {
+	const middleCalibrationStatusStruct *calibration = middleCalibrationGetStatus();
+	uint32_t start = hostPlatformGetMicroseconds();
+
+	if(!hostMasterSDODownload(0x8001,0x01,&control,sizeof(control)))
+		return CALIBRATION_FAILED;
+	while(calibration->State == CALIBRATION_CAPTURING && hostPlatformGetMicroseconds() - start < hostMailboxBenchmarkCalibrationTimeout)
+		hostSlaveStep();
+
+	return calibration->State;
+}
+
+// The nunchuck plugged in with bad calibration data runs on nominal values. Lying flat is captured, standing on its
+// side cannot be at rest and makes the save fail, the values written instead and a joystick sweep in motion make it.
+// After a reset the stored calibration maps the first sample, Z at rest reads 2g with it. Forgetting it brings the
+// nominal values and their fault back, good calibration data then the factory one.
+static bool hostMailboxBenchmarkCalibration(void) {
+	static const hostMailboxBenchmarkEmergencyStruct unplugged[] = {{middleSOESEmergencySensorCommunication,0x81}};
+	static const hostMailboxBenchmarkEmergencyStruct badCalibration[] = {{middleSOESEmergencyErrorReset,0x00},{middleSOESEmergencySensorCalibration,0x21}};
+	static const hostMailboxBenchmarkEmergencyStruct calibrated[] = {{middleSOESEmergencyErrorReset,0x00}};
+	static const hostMailboxBenchmarkEmergencyStruct forgotten[] = {{middleSOESEmergencySensorCalibration,0x21}};
+	static const hostMailboxBenchmarkEmergencyStruct unpluggedAgain[] = {{middleSOESEmergencySensorCommunication,0xA1}};
+	static const hostMailboxBenchmarkEmergencyStruct recovered[] = {{middleSOESEmergencyErrorReset,0x21},{middleSOESEmergencyErrorReset,0x00}};
+	const middleCalibrationStatusStruct *calibration = middleCalibrationGetStatus();
+	middleNunChuckDataStruct recording[hostMailboxBenchmarkCalibrationSamples];
+	uint16_t x1g = 716, z0g = 512, z1g = hostMailboxBenchmarkZ1g;
+	uint8_t source = CALIBRATION_SOURCE_FACTORY, control = CALIBRATION_CONTROL_NONE;
+	uint32_t latency, first = hostMailboxBenchmarkCalibrationSamples;
+	uint64_t id = 0;
+	bool captured, refused = false, saved = false, kept = false, factory = false, ok;
+
+	hostNunChuckSetConnected(false);
+	ok = hostMailboxBenchmarkEmergencyExpect(unplugged,1,&latency);
+	hostNunChuckSetCalibrationValid(false);
+	hostNunChuckSetConnected(true);
+	ok = ok && hostMailboxBenchmarkEmergencyExpect(badCalibration,2,&latency);
+	ok = ok && hostMasterSDOUpload(0x8001,0x03,&source,sizeof(source),NULL) && (source == CALIBRATION_SOURCE_NOMINAL) &&
+		hostMasterSDOUpload(0x8001,0x04,(uint8_t *)&id,sizeof(id),NULL) && (id == hostMailboxBenchmarkNunChuckID);
+
+	captured = ok && (hostMailboxBenchmarkCalibrationControl(CALIBRATION_CONTROL_FLAT) == CALIBRATION_DONE) &&
+		(calibration->Values.accelero0GX == 512) && (calibration->Values.accelero0GY == 512) && (calibration->Values.accelero1GZ == 716) &&
+		(calibration->Values.joystickXCenter == 0x80) && (calibration->Values.joystickYCenter == 0x80);
+	if(captured) {
+		refused = (hostMailboxBenchmarkCalibrationControl(CALIBRATION_CONTROL_SIDE) == CALIBRATION_DONE) &&
+			(hostMailboxBenchmarkCalibrationControl(CALIBRATION_CONTROL_SAVE) == CALIBRATION_FAILED);
+
+		hostNunChuckSetMotion(true);
+		saved = hostMasterSDODownload(0x8001,0x08,(const uint8_t *)&x1g,sizeof(x1g)) && hostMasterSDODownload(0x8001,0x07,(const uint8_t *)&z0g,sizeof(z0g)) &&
+			hostMasterSDODownload(0x8001,0x0A,(const uint8_t *)&z1g,sizeof(z1g)) &&
+			(hostMailboxBenchmarkCalibrationControl(CALIBRATION_CONTROL_RANGE) == CALIBRATION_RANGE);
+		hostSlaveRunFor(hostMailboxBenchmarkRangeTime);
+		hostNunChuckSetMotion(false);
+		saved = saved && hostMasterSDODownload(0x8001,0x01,&control,sizeof(control)) && (calibration->State == CALIBRATION_DONE) &&
+			(calibration->Values.joystickXMin == 0x80 - 100) && (calibration->Values.joystickXMax == 0x80 + 100);
+		saved = saved && (hostMailboxBenchmarkCalibrationControl(CALIBRATION_CONTROL_SAVE) == CALIBRATION_DONE) &&
+			hostMailboxBenchmarkEmergencyExpect(calibrated,1,&latency) && hostMailboxBenchmarkParameterWait();
+	}
+
+	if(saved) {
+		hostSlaveRecordSamples(recording,hostMailboxBenchmarkCalibrationSamples);
+		kept = hostMailboxBenchmarkParameterReboot();
+		hostSlaveRunFor(hostMailboxBenchmarkCalibrationSamples*middleNunChuckDefaultMeasureInterval*modDelayMicrosecondsPerMillisecond);	// The nunchuck is connected meanwhile
+		kept = kept && hostMasterSDOUpload(0x8001,0x03,&source,sizeof(source),NULL) && (source == CALIBRATION_SOURCE_USER);
+		hostSlaveRecordSamples(NULL,0);
+		for(first = 0; first < hostMailboxBenchmarkCalibrationSamples && !recording[first].dataValid; first++);
+		kept = kept && (first < hostMailboxBenchmarkCalibrationSamples) && (recording[first].accelerometerZ == INT16_MAX);
+
+		factory = (hostMailboxBenchmarkCalibrationControl(CALIBRATION_CONTROL_FORGET) == CALIBRATION_DONE) &&
+			hostMailboxBenchmarkEmergencyExpect(forgotten,1,&latency) && (calibration->Source == CALIBRATION_SOURCE_NOMINAL);
+	}
+
+	hostNunChuckSetConnected(false);
+	ok = hostMailboxBenchmarkEmergencyExpect(unpluggedAgain,1,&latency) && ok;
+	hostNunChuckSetCalibrationValid(true);
+	hostNunChuckSetConnected(true);
+	ok = hostMailboxBenchmarkEmergencyExpect(recovered,2,&latency) && ok;
+	factory = factory && hostMailboxBenchmarkParameterWait() && (calibration->Source == CALIBRATION_SOURCE_FACTORY);
+
+	printf("Calibration: nunchuck %012llX on %s values, flat %s, implausible save %s, %s and in use from %s, factory %s\n",
+		(unsigned long long)id,ok ? "nominal" : "UNEXPECTED",captured ? "captured" : "NOT captured",refused ? "refused" : "NOT refused",
+		saved ? "saved" : "NOT saved",kept ? "the first sample after a reset" : "NOT the first sample after a reset",factory ? "back" : "NOT back");
+
+	return ok && captured && refused && saved && kept && factory;
+}
+
+static bool hostMailboxBenchmarkSameSample(const middleNunChuckDataStruct *a, const middleNunChuckDataStruct *b) {
+	return (a->joystickX == b->joystickX) && (a->joystickY == b->joystickY) && (a->accelerometerX == b->accelerometerX) &&
+		(a->accelerometerY == b->accelerometerY) && (a->accelerometerZ == b->accelerometerZ);
+}
+
+// In motion nothing counts as still. A drift at rest is learned and mapped away, the samples read as before it; with
+// tracking off the learned values are gone and the drift shows.
+static bool hostMailboxBenchmarkTracking(void) {
+	const middleCalibrationTrackingStruct *tracking = middleCalibrationGetTracking();
+	middleNunChuckDataStruct reference = hostSlaveLatestSample(), sample;
+	uint32_t updates = tracking->Updates, learnedUpdates = 0;
+	int8_t joystick[2] = {0, 0};
+	int16_t bias[3] = {0, 0, 0};
+	uint8_t enable = 0;
+	bool ignored, learned, corrected, off = false, ok;
+
+	hostNunChuckSetMotion(true);
+	hostSlaveRunFor(hostMailboxBenchmarkTrackingTime/2);
+	hostNunChuckSetMotion(false);
+	ignored = (tracking->Updates == updates) && !tracking->Still;
+
+	hostNunChuckSetDrift(hostMailboxBenchmarkJoystickDrift,hostMailboxBenchmarkAccelerometerDrift);
+	hostSlaveRunFor(hostMailboxBenchmarkTrackingTime);
+	learnedUpdates = tracking->Updates - updates;
+	ok = hostMasterSDOUpload(0x8002,0x04,(uint8_t *)&joystick[0],sizeof(joystick[0]),NULL) && hostMasterSDOUpload(0x8002,0x05,(uint8_t *)&joystick[1],sizeof(joystick[1]),NULL);
+	for(uint8_t axis = 0; ok && axis < 3; axis++)
+		ok = hostMasterSDOUpload(0x8002,0x06 + axis,(uint8_t *)&bias[axis],sizeof(bias[axis]),NULL);
+	learned = ok && (joystick[0] == hostMailboxBenchmarkJoystickDrift) && (joystick[1] == hostMailboxBenchmarkJoystickDrift) &&
+		!bias[0] && !bias[1] && (bias[2] == hostMailboxBenchmarkAccelerometerDrift);
+	sample = hostSlaveLatestSample();
+	corrected = sample.dataValid && hostMailboxBenchmarkSameSample(&sample,&reference);
+
+	if(hostMasterSDODownload(0x8002,0x01,&enable,sizeof(enable))) {
+		hostSlaveRunFor(middleNunChuckDefaultMeasureInterval*modDelayMicrosecondsPerMillisecond*2);
+		sample = hostSlaveLatestSample();
+		off = !tracking->JoystickXCenter && !tracking->AcceleroMeterZ && (sample.joystickX > reference.joystickX) &&
+			(sample.accelerometerZ > reference.accelerometerZ);
+	}
+	hostNunChuckSetDrift(0,0);
+	enable = 1;
+	ok = hostMasterSDODownload(0x8002,0x01,&enable,sizeof(enable)) && ok;
+
+	printf("Tracking: motion %s, drift of %d and %d counts learned as %d/%d and %d/%d/%d in %lu updates, samples %s, off %s\n",
+		ignored ? "ignored" : "NOT ignored",hostMailboxBenchmarkJoystickDrift,hostMailboxBenchmarkAccelerometerDrift,joystick[0],joystick[1],
+		bias[0],bias[1],bias[2],(unsigned long)learnedUpdates,corrected ? "as before the drift" : "NOT as before the drift",off ? "forgets it" : "does NOT forget it");
+
+	return ok && ignored && learned && corrected && off;
+}
+
+static bool hostMailboxBenchmarkFirmware(uint32_t bytes) {
+	const middleFirmwareUpdateStatusStruct *update = middleFirmwareUpdateGetStatus();
+	uint32_t start;
+	bool ok;
+
+	// A new image on trial, confirmed by reaching OP
+	uint8_t first = update->RunningSlot ^ 1;
+	if(!hostMailboxBenchmarkDownload(bytes,hostMailboxBenchmarkVersion,false,true))
+		return false;
+
+	start = hostPlatformGetMicroseconds();
+	if(!hostMailboxBenchmarkReboot())
+		return false;
+	ok = (update->RunningSlot == first) && (update->Trial == BOOT_TRIAL_BOOTED) && hostBootWatchdogRunning();
+	ok = ok && hostMasterSetState(ESCpreop,NULL) && hostMasterSetState(ESCsafeop,NULL) && hostMasterSetState(ESCop,NULL);
+	uint32_t downtime = hostPlatformGetMicroseconds() - start;
+	hostSlaveRunFor(hostMailboxBenchmarkConfirmTime);
+	ok = ok && (update->Trial == BOOT_TRIAL_NONE) && (update->RunningVersion == hostMailboxBenchmarkVersion);
+	printf("  reboot into slot %c on trial, OP after %lu us: %s\n",'A' + update->RunningSlot,(unsigned long)downtime,ok ? "confirmed" : "NOT confirmed");
+	if(!ok)
+		return false;
+
+	// The next one never gets to OP, the reset after it rolls back
+	if(!hostMailboxBenchmarkDownload(bytes,hostMailboxBenchmarkVersion + 1,false,false) || !hostMailboxBenchmarkReboot())
+		return false;
+	ok = (update->RunningSlot != first) && (update->Trial == BOOT_TRIAL_BOOTED);
+	ok = ok && hostMasterSetState(ESCpreop,NULL) && hostMailboxBenchmarkReboot();
+	ok = ok && (update->RunningSlot == first) && (update->Trial == BOOT_TRIAL_NONE) && (update->Rollbacks == 1) &&
+		(update->RunningVersion == hostMailboxBenchmarkVersion);
+	printf("Firmware without OP: %s to slot %c\n",ok ? "rolled back" : "NOT rolled back",'A' + update->RunningSlot);
+	if(!ok)
+		return false;
+
+	if(!hostMasterSetState(ESCpreop,NULL))
+		return false;
+	return hostMailboxBenchmarkDownload(bytes,hostMailboxBenchmarkVersion + 2,true,false);
+}
+
+int main(int argc, char **argv) {
+	uint32_t requests = (argc > 1) ? (uint32_t)strtoul(argv[1],NULL,0) : hostMailboxBenchmarkDefaultRequests;
+	uint32_t foeBytes = (argc > 2) ? (uint32_t)strtoul(argv[2],NULL,0) : hostMailboxBenchmarkDefaultFoEBytes;
+	uint32_t imageBytes = (argc > 3) ? (uint32_t)strtoul(argv[3],NULL,0) : hostMailboxBenchmarkDefaultImageBytes;
+
+	middleNunChuckDataStruct *recording = malloc(hostMailboxBenchmarkRecordingSize*sizeof(middleNunChuckDataStruct));
+	hostSlaveRecordSamples(recording,hostMailboxBenchmarkRecordingSize);
+
+	if(!hostSlaveInit()) {
+		printf("Slave did not come up\n");
+		return EXIT_FAILURE;
+	}
+	hostMasterInit();
+
+	if(!hostMasterSetState(ESCpreop,NULL)) {
+		printf("PREOP failed, AL status 0x%02X\n",hostMasterGetState());
+		return EXIT_FAILURE;
+	}
+
+	if(foeBytes > hostSlaveFoEFileSize)
+		foeBytes = hostSlaveFoEFileSize;
+	if(imageBytes > middleBootControlSlotSize)
+		imageBytes = middleBootControlSlotSize;
+	if(imageBytes < hostMailboxBenchmarkMinimumImage)
+		imageBytes = hostMailboxBenchmarkMinimumImage;
+
+	bool ok = hostMailboxBenchmarkSDO(requests);
+	ok = hostMailboxBenchmarkBrowse() && ok;
+	ok = hostMailboxBenchmarkFoE(foeBytes) && ok;
+	ok = hostMailboxBenchmarkCapture(recording) && ok;
+	ok = hostMailboxBenchmarkTrace() && ok;
+	ok = hostMailboxBenchmarkEoE(recording) && ok;
+	ok = hostMailboxBenchmarkEmergency() && ok;
+	ok = hostMailboxBenchmarkDiagnosis() && ok;
+	hostSlaveRecordSamples(NULL,0);
+	free(recording);
+	ok = hostMailboxBenchmarkParameters() && ok;
+	ok = hostMailboxBenchmarkCalibration() && ok;
+	ok = hostMailboxBenchmarkTracking() && ok;
+	ok = hostMailboxBenchmarkFirmware(imageBytes) && ok;
+
+	return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,45 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "hostSlave.h"
+#include "hostLAN9252.h"
+#include "hostPlatform.h"
+#include "middleSOES.h"
+
+// Boots the real firmware against the simulated LAN9252 and lets it idle in INIT. No master is attached, so this
+// shows the PDI cost of the stack on its own: SPI transactions per task run and the time spent asleep.
+
+#define hostMainDefaultRunTime				1000000																// us
+
+int main(int argc, char **argv) {
+	uint32_t runTime = (argc > 1) ? (uint32_t)strtoul(argv[1],NULL,0) : hostMainDefaultRunTime;
+
+	if(!hostSlaveInit()) {
+		printf("Slave did not come up\n");
+		return EXIT_FAILURE;
+	}
+	printf("Slave booted, AL status 0x%02X\n",ESCvar.ALstatus);
+
+	hostLAN9252ResetStatistics();
+	modSchedulerResetStatistics();
+	hostSlaveRunFor(runTime);
+
+	const hostLAN9252StatisticsStruct *spi = hostLAN9252GetStatistics();
+	const modSchedulerIdleStruct *idle = modSchedulerGetIdle();
+	uint32_t taskRuns = 0;
+
+	printf("Ran %lu us, AL status 0x%02X\n",(unsigned long)runTime,ESCvar.ALstatus);
+	for(int8_t handle = 0; modSchedulerGetTask(handle); handle++) {
+		const modSchedulerTaskStruct *task = modSchedulerGetTask(handle);
+		printf("  %-8s runs %6lu  worst exec %5lu us  worst latency %5lu us  misses %lu\n",task->Name,(unsigned long)task->RunCount,
+			(unsigned long)task->WorstExecutionTime,(unsigned long)task->WorstReleaseLatency,(unsigned long)task->DeadlineMisses);
+		taskRuns += task->RunCount;
+	}
+
+	printf("  SPI: %lu transactions, %lu bytes, %lu CSR, %lu PRAM, %lu busy polls\n",(unsigned long)spi->CSCycles,(unsigned long)spi->SPIBytes,
+		(unsigned long)(spi->CSRReads + spi->CSRWrites),(unsigned long)(spi->PRAMReads + spi->PRAMWrites),(unsigned long)spi->BusyPolls);
+	if(taskRuns)
+		printf("  SPI transactions per task run: %.1f\n",(double)spi->CSCycles/taskRuns);
+	printf("  Idle: %lu sleeps, %lu us asleep\n",(unsigned long)idle->SleepCount,(unsigned long)idle->SleepTime);
+
+	return EXIT_SUCCESS;
+}
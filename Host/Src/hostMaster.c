@@ -0,0 +1,742 @@
+#include "hostMaster.h"
+#include "hostLAN9252.h"
+#include "hostPlatform.h"
+#include "hostSlave.h"
+#include "esc.h"
+#include <string.h>
+
+#define hostMasterMailboxHeaderSize				6
+#define hostMasterEventSM2								(1UL << 10)
+
+typedef struct {
+	uint16_t Index;
+	uint8_t SubIndex;
+} hostMasterSDOObjectStruct;
+
+// Rotated through by the concurrent SDO traffic, a mix of constants and live process data
+static const hostMasterSDOObjectStruct hostMasterSDOObjects[] = {
+	{0x1000,0x00},
+	{0x1018,0x01},
+	{0x1018,0x02},
+	{0x6000,0x01},
+	{0x6000,0x03},
+	{0x2100,0x01}
+};
+
+hostMasterStatisticsStruct hostMasterStatistics;
+bool hostMasterCycleActive = false;
+uint32_t hostMasterSDOInterval = 0;
+uint32_t hostMasterNextCycle;
+uint32_t hostMasterOutputWriteTime;
+bool hostMasterOutputPending = false;
+uint32_t hostMasterSDOStartTime;
+bool hostMasterSDOPending = false;
+uint8_t hostMasterSDOObject = 0;
+uint8_t hostMasterMailboxCounter = 0;
+uint8_t hostMasterOutputs[MBXSIZE];
+uint8_t hostMasterOutputBits = 0;
+uint8_t hostMasterInputs[MBXSIZE];
+uint8_t hostMasterEoEFrame[hostMasterEoEFrameSize];																		// Being reassembled
+uint16_t hostMasterEoEPosition = 0;
+uint8_t hostMasterEoENextFragment = 0;
+bool hostMasterEoEDiscard = true;
+uint8_t hostMasterEoEFrameNumber = 0;
+int32_t hostMasterEoEInitResult = -1;																										// Of the last set IP request, -1 until answered
+uint8_t hostMasterEoEQueueFrames[hostMasterEoEQueue][hostMasterEoEFrameSize];
+uint16_t hostMasterEoEQueueLengths[hostMasterEoEQueue];
+uint8_t hostMasterEoEQueueHead = 0;
+uint8_t hostMasterEoEQueueCount = 0;
+uint16_t hostMasterEmergencyCodes[hostMasterEmergencyQueue];
+uint8_t hostMasterEmergencyRegisters[hostMasterEmergencyQueue];
+uint8_t hostMasterEmergencyHead = 0;
+uint8_t hostMasterEmergencyCount = 0;
+
+static void hostMasterWriteSM(uint8_t n, uint16_t start, uint16_t length, uint8_t control, uint8_t activate) {
+	uint8_t sm[8] = {start & 0xFF, start >> 8, length & 0xFF, length >> 8, control, 0, activate, 0};
+	hostLAN9252MasterWrite(ESCREG_SM0 + (n << 3),sm,sizeof(sm));
+}
+
+void hostMasterInit(void) {
+	hostMasterCycleActive = false;
+	hostMasterOutputPending = false;
+	hostMasterSDOPending = false;
+	hostMasterMailboxCounter = 0;
+	hostMasterEmergencyCount = 0;
+	hostMasterResetStatistics();
+	hostPlatformBindExternalFunction(&hostMasterPoll);
+}
+
+uint8_t hostMasterGetState(void) {
+	uint16_t alStatus = 0;
+	hostLAN9252MasterRead(ESCREG_ALSTATUS,&alStatus,sizeof(alStatus));
+	return alStatus & ESCREG_AL_STATEMASK;
+}
+
+// Sets up the SyncManagers the target state needs and requests it. The process data sizes are taken from the slave's
+// own mapping, a real master reads them from the ESI or over CoE.
+void hostMasterRequestState(uint8_t state) {
+	uint16_t alControl = state;
+
+	if(state == ESCboot) {
+		hostMasterWriteSM(0,MBX0_sma_b,MBX0_sml_b,MBX0_smc_b,0x01);
+		hostMasterWriteSM(1,MBX1_sma_b,MBX1_sml_b,MBX1_smc_b,0x01);
+	}else if(state >= ESCpreop) {
+		hostMasterWriteSM(0,MBX0_sma,MBX0_sml,MBX0_smc,0x01);
+		hostMasterWriteSM(1,MBX1_sma,MBX1_sml,MBX1_smc,0x01);
+	}
+	if(state >= ESCsafeop) {
+		hostMasterWriteSM(2,SM2_sma,SM2_sml,SM2_smc,SM2_act);
+		hostMasterWriteSM(3,SM3_sma,SM3_sml,SM3_smc,SM3_act);
+	}
+
+	hostLAN9252MasterWrite(ESCREG_ALCONTROL,&alControl,sizeof(alControl));
+}
+
+// Requests the state and runs the firmware until it answers.
+bool hostMasterSetState(uint8_t state, uint32_t *transitionTime) {
+	uint32_t start = hostPlatformGetMicroseconds();
+	hostMasterRequestState(state);
+
+	while(hostPlatformGetMicroseconds() - start < hostMasterStateTimeout) {
+		hostSlaveStep();
+		uint8_t alStatus = hostMasterGetState();
+		if(alStatus & ESCerror)
+			break;
+		if(alStatus == state) {
+			if(transitionTime)
+				*transitionTime = hostPlatformGetMicroseconds() - start;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void hostMasterStartCycle(uint32_t cycleTime, uint32_t sdoInterval) {
+	hostMasterStatistics.CycleTime = cycleTime ? cycleTime : hostMasterDefaultCycleTime;
+	hostMasterSDOInterval = sdoInterval;
+	hostMasterNextCycle = hostPlatformGetMicroseconds();
+	hostMasterOutputPending = false;
+	hostMasterCycleActive = true;
+}
+
+void hostMasterStopCycle(void) {
+	hostMasterCycleActive = false;
+}
+
+// The whole SM0 buffer is written so the last byte hands it to the slave. A full mailbox refuses the frame.
+bool hostMasterMailboxSend(uint8_t type, const uint8_t *data, uint16_t length) {
+	uint8_t mailbox[MBX0_sml];
+
+	if(length > MBX0_sml - hostMasterMailboxHeaderSize)
+		return false;
+
+	uint8_t counter = (hostMasterMailboxCounter % 7) + 1;																				// 1..7, 0 is reserved
+	memset(mailbox,0,sizeof(mailbox));
+	mailbox[0] = length & 0xFF;
+	mailbox[1] = length >> 8;
+	mailbox[5] = (counter << 4) | (type & 0x0F);
+	memcpy(&mailbox[hostMasterMailboxHeaderSize],data,length);
+
+	if(!hostLAN9252MasterWrite(MBX0_sma,mailbox,sizeof(mailbox))) {
+		hostMasterStatistics.MailboxRefused++;
+		return false;
+	}
+
+	hostMasterMailboxCounter = counter;																													// Only advances on a frame the slave got
+	return true;
+}
+
+bool hostMasterMailboxReceive(uint8_t *type, uint8_t *data, uint16_t *length) {
+	uint8_t mailbox[MBX1_sml];
+
+	if(!hostLAN9252MasterRead(MBX1_sma,mailbox,sizeof(mailbox)))												// Empty, nothing posted yet
+		return false;
+
+	uint16_t received = mailbox[0] | (mailbox[1] << 8);
+	if(received > MBX1_sml - hostMasterMailboxHeaderSize)
+		received = MBX1_sml - hostMasterMailboxHeaderSize;
+
+	*type = mailbox[5] & 0x0F;
+	memcpy(data,&mailbox[hostMasterMailboxHeaderSize],received);
+	*length = received;
+
+	if(*type == hostMasterMailboxTypeCoE && received >= 5 && (data[1] >> 4) == hostMasterCoEServiceEmergency) {				// Kept apart, whoever waits for a reply
+		hostMasterStatistics.Emergencies++;
+		if(hostMasterEmergencyCount == hostMasterEmergencyQueue) {
+			hostMasterStatistics.EmergenciesDropped++;
+			return false;
+		}
+		uint8_t slot = (hostMasterEmergencyHead + hostMasterEmergencyCount++) % hostMasterEmergencyQueue;
+		hostMasterEmergencyCodes[slot] = data[2] | (data[3] << 8);
+		hostMasterEmergencyRegisters[slot] = data[4];
+		return false;
+	}
+
+	return true;
+}
+
+// Runs the firmware until an emergency came in or the timeout passed.
+bool hostMasterEmergencyReceive(uint16_t *errorCode, uint8_t *errorRegister, uint32_t timeout) {
+	uint8_t type, data[MBX1_sml];
+	uint16_t length;
+	uint32_t start = hostPlatformGetMicroseconds();
+
+	while(!hostMasterEmergencyCount && hostPlatformGetMicroseconds() - start < timeout) {
+		hostSlaveStep();
+		hostMasterMailboxReceive(&type,data,&length);
+	}
+	if(!hostMasterEmergencyCount)
+		return false;
+
+	*errorCode = hostMasterEmergencyCodes[hostMasterEmergencyHead];
+	*errorRegister = hostMasterEmergencyRegisters[hostMasterEmergencyHead];
+	hostMasterEmergencyHead = (hostMasterEmergencyHead + 1) % hostMasterEmergencyQueue;
+	hostMasterEmergencyCount--;
+
+	return true;
+}
+
+bool hostMasterSDOUploadStart(uint16_t index, uint8_t subIndex) {
+	uint8_t request[10] = {0x00, hostMasterCoEServiceSDORequest << 4, hostMasterSDOUploadRequest, index & 0xFF, index >> 8, subIndex, 0, 0, 0, 0};
+
+	if(hostMasterSDOPending || !hostMasterMailboxSend(hostMasterMailboxTypeCoE,request,sizeof(request)))
+		return false;
+
+	hostMasterSDOPending = true;
+	hostMasterSDOStartTime = hostPlatformGetMicroseconds();
+	hostMasterStatistics.SDORequests++;
+
+	return true;
+}
+
+// Runs the firmware until the next SDO Information fragment comes in, an SDO Info Error fails it.
+static bool hostMasterSDOInfoWait(uint8_t *data, uint16_t *length) {
+	uint8_t type;
+	uint32_t start = hostPlatformGetMicroseconds();
+
+	while(hostPlatformGetMicroseconds() - start < hostMasterStateTimeout) {
+		hostSlaveStep();
+		if(!hostMasterMailboxReceive(&type,data,length) || type != hostMasterMailboxTypeCoE || *length < 6 ||
+			(data[1] >> 4) != hostMasterCoEServiceSDOInformation)
+			continue;
+
+		hostMasterStatistics.SDOResponses++;
+		if((data[2] & 0x7F) == hostMasterSDOInfoError) {
+			hostMasterStatistics.SDOAborts++;
+			return false;
+		}
+		return true;
+	}
+
+	return false;
+}
+
+// Runs the firmware until the slave answers an SDO request or aborts it. Only for requests outside the cycle, the
+// SDO poll does not take the response with no upload pending.
+static bool hostMasterSDOWait(uint8_t *data, uint16_t *length) {
+	uint8_t type;
+	uint32_t start = hostPlatformGetMicroseconds();
+
+	while(hostPlatformGetMicroseconds() - start < hostMasterStateTimeout) {
+		hostSlaveStep();
+		if(!hostMasterMailboxReceive(&type,data,length) || type != hostMasterMailboxTypeCoE || *length < 10)
+			continue;
+
+		hostMasterStatistics.SDOResponses++;
+		if((data[1] >> 4) == hostMasterCoEServiceSDORequest && data[2] == hostMasterSDOAbort) {
+			hostMasterStatistics.SDOAborts++;
+			return false;
+		}
+		if((data[1] >> 4) == hostMasterCoEServiceSDOResponse)
+			return true;
+	}
+
+	return false;
+}
+
+// Expedited or normal upload, a segmented one is not needed for anything in the dictionary that fits a mailbox.
+bool hostMasterSDOUpload(uint16_t index, uint8_t subIndex, uint8_t *data, uint32_t size, uint32_t *length) {
+	uint8_t request[10] = {0x00, hostMasterCoEServiceSDORequest << 4, hostMasterSDOUploadRequest, index & 0xFF, index >> 8, subIndex, 0, 0, 0, 0};
+	uint8_t response[MBX1_sml];
+	uint16_t received;
+	uint32_t bytes;
+
+	if(hostMasterSDOPending || !hostMasterMailboxSend(hostMasterMailboxTypeCoE,request,sizeof(request)))
+		return false;
+	hostMasterStatistics.SDORequests++;
+	if(!hostMasterSDOWait(response,&received) || response[3] != (index & 0xFF) || response[4] != (index >> 8) || response[5] != subIndex)
+		return false;
+
+	if(response[2] & hostMasterSDOExpedited) {
+		bytes = (response[2] & hostMasterSDOSizeIndicated) ? 4 - ((response[2] >> 2) & 0x03) : 4;
+		memcpy(data,&response[6],(bytes < size) ? bytes : size);
+	}else{
+		bytes = response[6] | (response[7] << 8) | ((uint32_t)response[8] << 16) | ((uint32_t)response[9] << 24);
+		if(bytes > received - 10u)
+			return false;																																			// Segmented
+		memcpy(data,&response[10],(bytes < size) ? bytes : size);
+	}
+
+	if(length)
+		*length = bytes;
+	return true;
+}
+
+// Expedited download of 1 to 4 bytes.
+bool hostMasterSDODownload(uint16_t index, uint8_t subIndex, const uint8_t *data, uint8_t length) {
+	uint8_t request[10] = {0x00, hostMasterCoEServiceSDORequest << 4, 0, index & 0xFF, index >> 8, subIndex, 0, 0, 0, 0};
+	uint8_t response[MBX1_sml];
+	uint16_t received;
+
+	if(!length || length > 4 || hostMasterSDOPending)
+		return false;
+
+	request[2] = hostMasterSDODownloadRequest | hostMasterSDOExpedited | hostMasterSDOSizeIndicated | ((4 - length) << 2);
+	memcpy(&request[6],data,length);
+	if(!hostMasterMailboxSend(hostMasterMailboxTypeCoE,request,sizeof(request)))
+		return false;
+	hostMasterStatistics.SDORequests++;
+
+	return hostMasterSDOWait(response,&received) && response[2] == hostMasterSDODownloadResponse;
+}
+
+// SDO Information request, the fragments of the response are put back together: the data after the info header of the
+// first one, then that of the following ones. An SDO Info Error or an abort fails it.
+bool hostMasterSDOInfo(uint8_t opcode, const uint8_t *data, uint16_t length, uint8_t *response, uint32_t size, uint32_t *received) {
+	uint8_t request[MBX0_sml];
+	uint8_t fragment[MBX1_sml];
+	uint16_t fragmentLength;
+	uint32_t offset = 0;
+	uint16_t fragmentsLeft;
+
+	if(hostMasterSDOPending || length > sizeof(request) - 6)
+		return false;
+
+	request[0] = 0x00;
+	request[1] = hostMasterCoEServiceSDOInformation << 4;
+	request[2] = opcode;
+	request[3] = 0;
+	request[4] = 0;
+	request[5] = 0;
+	memcpy(&request[6],data,length);
+	if(!hostMasterMailboxSend(hostMasterMailboxTypeCoE,request,6 + length))
+		return false;
+	hostMasterStatistics.SDORequests++;
+
+	do {
+		if(!hostMasterSDOInfoWait(fragment,&fragmentLength) || (fragment[2] & 0x7F) != opcode + 1)
+			return false;
+
+		uint16_t chunk = fragmentLength - 6;
+		if(offset < size)
+			memcpy(&response[offset],&fragment[6],(size - offset < chunk) ? (size - offset) : chunk);
+		offset += chunk;
+		fragmentsLeft = fragment[4] | (fragment[5] << 8);
+	} while(fragment[2] & 0x80);																																// Incomplete, more to come
+
+	if(fragmentsLeft)
+		return false;
+	if(received)
+		*received = offset;
+	return true;
+}
+
+// Runs the firmware until the slave answers the FoE packet or aborts, each packet gets the state timeout. The SDO poll only takes responses while an
+// upload is pending, so FoE answers are left for us.
+static bool hostMasterFoEWaitAck(uint32_t packet) {
+	uint8_t type, data[MBX1_sml];
+	uint16_t length;
+	uint32_t start = hostPlatformGetMicroseconds();
+
+	while(hostPlatformGetMicroseconds() - start < hostMasterStateTimeout) {
+		hostSlaveStep();
+		if(!hostMasterMailboxReceive(&type,data,&length) || type != hostMasterMailboxTypeFoE || length < hostMasterFoEHeaderSize)
+			continue;
+
+		uint32_t ackedPacket = data[2] | (data[3] << 8) | ((uint32_t)data[4] << 16) | ((uint32_t)data[5] << 24);
+		if(data[0] == hostMasterFoEAck && ackedPacket == packet)
+			return true;
+		if(data[0] == hostMasterFoEError)
+			return false;
+	}
+
+	return false;
+}
+
+static bool hostMasterFoESend(const uint8_t *data, uint16_t length) {
+	uint32_t start = hostPlatformGetMicroseconds();
+
+	while(hostPlatformGetMicroseconds() - start < hostMasterStateTimeout) {
+		if(hostMasterMailboxSend(hostMasterMailboxTypeFoE,data,length))
+			return true;
+		hostSlaveStep();																													// Previous frame not taken yet
+	}
+
+	return false;
+}
+
+// Write request, then data packets each acknowledged before the next. A last packet shorter than a full one closes
+// the file, an exact multiple is closed with an empty packet.
+bool hostMasterFoEWrite(const char *name, uint32_t password, const uint8_t *data, uint32_t length, uint32_t *transferTime) {
+	uint8_t packet[hostMasterFoEHeaderSize + hostMasterFoEDataSize];
+	uint16_t nameLength = strlen(name);
+	uint32_t start = hostPlatformGetMicroseconds();
+	uint32_t packetNumber = 0;
+	uint32_t offset = 0;
+	uint16_t chunk;
+
+	if(nameLength > hostMasterFoEDataSize)
+		return false;
+
+	packet[0] = hostMasterFoEWriteRequest;
+	packet[1] = 0;
+	memcpy(&packet[2],&password,sizeof(password));
+	memcpy(&packet[hostMasterFoEHeaderSize],name,nameLength);
+	if(!hostMasterFoESend(packet,hostMasterFoEHeaderSize + nameLength) || !hostMasterFoEWaitAck(packetNumber)) {
+		hostMasterStatistics.FoEErrors++;
+		return false;
+	}
+
+	do {
+		chunk = (length - offset > hostMasterFoEDataSize) ? hostMasterFoEDataSize : (length - offset);
+		packetNumber++;
+		packet[0] = hostMasterFoEData;
+		packet[1] = 0;
+		memcpy(&packet[2],&packetNumber,sizeof(packetNumber));
+		memcpy(&packet[hostMasterFoEHeaderSize],&data[offset],chunk);
+
+		if(!hostMasterFoESend(packet,hostMasterFoEHeaderSize + chunk) || !hostMasterFoEWaitAck(packetNumber)) {
+			hostMasterStatistics.FoEErrors++;
+			return false;
+		}
+
+		offset += chunk;
+		hostMasterStatistics.FoEPackets++;
+		hostMasterStatistics.FoEBytes += chunk;
+	} while(chunk == hostMasterFoEDataSize);
+
+	if(transferTime)
+		*transferTime = hostPlatformGetMicroseconds() - start;
+	return true;
+}
+
+// Runs the firmware until the slave sends the data packet or aborts.
+static bool hostMasterFoEWaitData(uint32_t packet, uint8_t *data, uint16_t *length) {
+	uint8_t type;
+	uint32_t start = hostPlatformGetMicroseconds();
+
+	while(hostPlatformGetMicroseconds() - start < hostMasterStateTimeout) {
+		hostSlaveStep();
+		if(!hostMasterMailboxReceive(&type,data,length) || type != hostMasterMailboxTypeFoE || *length < hostMasterFoEHeaderSize)
+			continue;
+
+		uint32_t dataPacket = data[2] | (data[3] << 8) | ((uint32_t)data[4] << 16) | ((uint32_t)data[5] << 24);
+		if(data[0] == hostMasterFoEData && dataPacket == packet)
+			return true;
+		if(data[0] == hostMasterFoEError)
+			return false;
+	}
+
+	return false;
+}
+
+// Read request, then data packets from the slave each acknowledged. A packet shorter than a full one is the last, the
+// file is cut at size bytes.
+bool hostMasterFoERead(const char *name, uint32_t password, uint8_t *data, uint32_t size, uint32_t *length, uint32_t *transferTime) {
+	uint8_t packet[MBX1_sml];
+	uint16_t nameLength = strlen(name);
+	uint16_t received;
+	uint32_t start = hostPlatformGetMicroseconds();
+	uint32_t packetNumber = 1;
+	uint32_t offset = 0;
+	uint16_t chunk;
+
+	if(nameLength > hostMasterFoEDataSize)
+		return false;
+
+	packet[0] = hostMasterFoEReadRequest;
+	packet[1] = 0;
+	memcpy(&packet[2],&password,sizeof(password));
+	memcpy(&packet[hostMasterFoEHeaderSize],name,nameLength);
+	if(!hostMasterFoESend(packet,hostMasterFoEHeaderSize + nameLength)) {
+		hostMasterStatistics.FoEErrors++;
+		return false;
+	}
+
+	do {
+		if(!hostMasterFoEWaitData(packetNumber,packet,&received)) {
+			hostMasterStatistics.FoEErrors++;
+			return false;
+		}
+
+		chunk = received - hostMasterFoEHeaderSize;
+		if(offset < size)
+			memcpy(&data[offset],&packet[hostMasterFoEHeaderSize],(size - offset < chunk) ? (size - offset) : chunk);
+		offset += chunk;
+		hostMasterStatistics.FoEPackets++;
+		hostMasterStatistics.FoEBytes += chunk;
+
+		packet[0] = hostMasterFoEAck;
+		packet[1] = 0;
+		memcpy(&packet[2],&packetNumber,sizeof(packetNumber));
+		if(!hostMasterFoESend(packet,hostMasterFoEHeaderSize)) {
+			hostMasterStatistics.FoEErrors++;
+			return false;
+		}
+		packetNumber++;
+	} while(chunk == hostMasterFoEDataSize);
+
+	if(length)
+		*length = offset;
+	if(transferTime)
+		*transferTime = hostPlatformGetMicroseconds() - start;
+	return true;
+}
+
+// One EoE mailbox from the slave: fragments are put back together into the receive queue, an init response is kept.
+static void hostMasterEoEHandle(const uint8_t *data, uint16_t length) {
+	if(length < hostMasterEoEHeaderSize)
+		return;
+
+	uint16_t frameInfo1 = data[0] | (data[1] << 8);
+	uint16_t frameInfo2 = data[2] | (data[3] << 8);
+	uint8_t fragment = frameInfo2 & 0x3F;
+	uint16_t offset = ((frameInfo2 >> 6) & 0x3F)*32;
+	uint16_t chunk = length - hostMasterEoEHeaderSize;
+
+	if((frameInfo1 & 0x0F) == hostMasterEoEInitResponse) {
+		hostMasterEoEInitResult = frameInfo2;
+		return;
+	}
+	if((frameInfo1 & 0x0F) != hostMasterEoEFragment)
+		return;
+
+	hostMasterStatistics.EoEFragmentsReceived++;
+	if(!fragment) {
+		if(!hostMasterEoEDiscard && hostMasterEoENextFragment)
+			hostMasterStatistics.EoEDropped++;																								// The last one never finished
+		hostMasterEoEPosition = 0;
+		hostMasterEoENextFragment = 0;
+		hostMasterEoEDiscard = false;
+	}else if(hostMasterEoEDiscard) {
+		return;
+	}else if(fragment != hostMasterEoENextFragment || offset != hostMasterEoEPosition) {
+		hostMasterEoEDiscard = true;
+		hostMasterStatistics.EoEDropped++;
+		return;
+	}
+
+	if(hostMasterEoEPosition + chunk > sizeof(hostMasterEoEFrame)) {
+		hostMasterEoEDiscard = true;
+		hostMasterStatistics.EoEDropped++;
+		return;
+	}
+	memcpy(&hostMasterEoEFrame[hostMasterEoEPosition],&data[hostMasterEoEHeaderSize],chunk);
+	hostMasterEoEPosition += chunk;
+	hostMasterEoENextFragment++;
+	if(!(frameInfo1 & hostMasterEoELastFragment))
+		return;
+
+	hostMasterEoEDiscard = true;
+	if(hostMasterEoEQueueCount == hostMasterEoEQueue) {
+		hostMasterStatistics.EoEDropped++;
+		return;
+	}
+	uint8_t slot = (hostMasterEoEQueueHead + hostMasterEoEQueueCount) % hostMasterEoEQueue;
+	memcpy(hostMasterEoEQueueFrames[slot],hostMasterEoEFrame,hostMasterEoEPosition);
+	hostMasterEoEQueueLengths[slot] = hostMasterEoEPosition;
+	hostMasterEoEQueueCount++;
+	hostMasterStatistics.EoEFramesReceived++;
+}
+
+// Runs the firmware one step and empties SM1. Anything but EoE is dropped, the EoE calls own the mailbox meanwhile.
+static void hostMasterEoEService(void) {
+	uint8_t type, data[MBX1_sml];
+	uint16_t length;
+
+	hostSlaveStep();
+	if(hostMasterMailboxReceive(&type,data,&length) && type == hostMasterMailboxTypeEoE)
+		hostMasterEoEHandle(data,length);
+}
+
+// The slave only takes a new frame once its outbox was read, so keep reading while waiting to send.
+static bool hostMasterEoEPost(const uint8_t *data, uint16_t length) {
+	uint32_t start = hostPlatformGetMicroseconds();
+
+	while(hostPlatformGetMicroseconds() - start < hostMasterStateTimeout) {
+		if(hostMasterMailboxSend(hostMasterMailboxTypeEoE,data,length))
+			return true;
+		hostMasterEoEService();
+	}
+
+	return false;
+}
+
+// Set IP parameter request with the MAC, address and subnet mask, waits for the slave's result code.
+bool hostMasterEoESetIP(const uint8_t *mac, uint32_t ip, uint32_t subnet, uint16_t *result) {
+	uint8_t request[hostMasterEoEHeaderSize + 4 + 6 + 4 + 4];
+	uint32_t flags = 0x07;																																			// MAC, IP and subnet included
+	uint32_t start = hostPlatformGetMicroseconds();
+
+	request[0] = hostMasterEoEInitRequest;
+	request[1] = hostMasterEoELastFragment >> 8;
+	request[2] = 0;
+	request[3] = 0;
+	memcpy(&request[4],&flags,sizeof(flags));
+	memcpy(&request[8],mac,6);
+	memcpy(&request[14],&ip,sizeof(ip));
+	memcpy(&request[18],&subnet,sizeof(subnet));
+
+	hostMasterEoEInitResult = -1;
+	if(!hostMasterEoEPost(request,sizeof(request)))
+		return false;
+	while(hostMasterEoEInitResult < 0 && hostPlatformGetMicroseconds() - start < hostMasterStateTimeout)
+		hostMasterEoEService();
+
+	if(result)
+		*result = (uint16_t)hostMasterEoEInitResult;
+	return hostMasterEoEInitResult >= 0;
+}
+
+// A frame in as many fragments as it takes. The first carries the complete size, the others their offset, in 32 byte blocks.
+bool hostMasterEoESend(const uint8_t *frame, uint16_t length) {
+	uint8_t fragment[hostMasterEoEHeaderSize + hostMasterEoEDataSize];
+	uint8_t frameNumber = hostMasterEoEFrameNumber = (hostMasterEoEFrameNumber + 1) & 0x0F;
+	uint16_t offset = 0;
+	uint8_t number = 0;
+
+	if(!length || length > hostMasterEoEFrameSize)
+		return false;
+
+	while(offset < length) {
+		uint16_t chunk = length - offset;
+		uint16_t frameInfo1 = hostMasterEoEFragment | hostMasterEoELastFragment;
+		if(chunk > hostMasterEoEDataSize) {
+			chunk = hostMasterEoEFragmentSize;
+			frameInfo1 = hostMasterEoEFragment;
+		}
+		uint16_t blocks = number ? offset/32 : (length + 31)/32;
+		uint16_t frameInfo2 = (number & 0x3F) | ((blocks & 0x3F) << 6) | (frameNumber << 12);
+
+		fragment[0] = frameInfo1 & 0xFF;
+		fragment[1] = frameInfo1 >> 8;
+		fragment[2] = frameInfo2 & 0xFF;
+		fragment[3] = frameInfo2 >> 8;
+		memcpy(&fragment[hostMasterEoEHeaderSize],&frame[offset],chunk);
+		if(!hostMasterEoEPost(fragment,hostMasterEoEHeaderSize + chunk))
+			return false;
+
+		offset += chunk;
+		number++;
+		hostMasterStatistics.EoEFragmentsSent++;
+	}
+
+	hostMasterStatistics.EoEFramesSent++;
+	return true;
+}
+
+// Next frame from the slave, running the firmware for up to timeout us until one is complete.
+bool hostMasterEoEReceive(uint8_t *frame, uint16_t size, uint16_t *length, uint32_t timeout) {
+	uint32_t start = hostPlatformGetMicroseconds();
+
+	while(!hostMasterEoEQueueCount && hostPlatformGetMicroseconds() - start < timeout)
+		hostMasterEoEService();
+	if(!hostMasterEoEQueueCount)
+		return false;
+
+	uint16_t received = hostMasterEoEQueueLengths[hostMasterEoEQueueHead];
+	memcpy(frame,hostMasterEoEQueueFrames[hostMasterEoEQueueHead],(received < size) ? received : size);
+	*length = received;
+	hostMasterEoEQueueHead = (hostMasterEoEQueueHead + 1) % hostMasterEoEQueue;
+	hostMasterEoEQueueCount--;
+
+	return true;
+}
+
+// Or'ed into the outputs of every cycle, next to the blinking debug LED.
+void hostMasterSetOutputBits(uint8_t bits) {
+	hostMasterOutputBits = bits;
+}
+
+static void hostMasterSDOPoll(uint32_t now) {
+	uint8_t type, data[MBX1_sml];
+	uint16_t length;
+
+	if(!hostMasterSDOPending || !hostMasterMailboxReceive(&type,data,&length))
+		return;
+
+	uint8_t service = (length >= 3) ? (data[1] >> 4) : 0;
+	if(type != hostMasterMailboxTypeCoE || length < 3 || !(service == hostMasterCoEServiceSDOResponse ||
+		(service == hostMasterCoEServiceSDORequest && data[2] == hostMasterSDOAbort)))										// An abort comes as a request
+		return;																																		// Not ours
+
+	uint32_t sdoTime = now - hostMasterSDOStartTime;
+	hostMasterSDOPending = false;
+	hostMasterStatistics.SDOResponses++;
+	hostMasterStatistics.SDOTimeTotal += sdoTime;
+	if(sdoTime > hostMasterStatistics.WorstSDOTime)
+		hostMasterStatistics.WorstSDOTime = sdoTime;
+	if(data[2] == hostMasterSDOAbort)
+		hostMasterStatistics.SDOAborts++;
+}
+
+// One bus cycle: check the previous outputs were taken, write fresh outputs, read inputs and maybe start an SDO.
+static void hostMasterCycle(uint32_t now) {
+	uint32_t jitter = now - hostMasterNextCycle;
+
+	hostMasterStatistics.Cycles++;
+	if(jitter > hostMasterStatistics.WorstCycleJitter)
+		hostMasterStatistics.WorstCycleJitter = jitter;
+
+	if(jitter >= hostMasterStatistics.CycleTime) {
+		hostMasterStatistics.LateCycles++;
+		hostMasterNextCycle = now + hostMasterStatistics.CycleTime;
+	}else{
+		hostMasterNextCycle += hostMasterStatistics.CycleTime;
+	}
+
+	if(hostMasterOutputPending)
+		hostMasterStatistics.MissedCycles++;
+
+	hostMasterOutputs[0] = ((hostMasterStatistics.Cycles >> 6) & 0x01) | hostMasterOutputBits;				// Blink the debug LED
+	hostLAN9252MasterWrite(SM2_sma,hostMasterOutputs,SM2_sml);
+	hostMasterOutputWriteTime = now;
+	hostMasterOutputPending = true;
+
+	hostLAN9252MasterRead(SM3_sma,hostMasterInputs,SM3_sml);
+
+	if(hostMasterSDOInterval && !(hostMasterStatistics.Cycles % hostMasterSDOInterval) && !hostMasterSDOPending) {
+		const hostMasterSDOObjectStruct *object = &hostMasterSDOObjects[hostMasterSDOObject];
+		if(hostMasterSDOUploadStart(object->Index,object->SubIndex))
+			hostMasterSDOObject = (hostMasterSDOObject + 1) % (sizeof(hostMasterSDOObjects)/sizeof(hostMasterSDOObjects[0]));
+	}
+}
+
+void hostMasterPoll(void) {
+	uint32_t now = hostPlatformGetMicroseconds();
+
+	if(hostMasterOutputPending && !(hostLAN9252GetALEvent() & hostMasterEventSM2)) {				// The PDI read the buffer
+		uint32_t reaction = now - hostMasterOutputWriteTime;
+		hostMasterOutputPending = false;
+		hostMasterStatistics.Reactions++;
+		hostMasterStatistics.ReactionTimeTotal += reaction;
+		if(reaction > hostMasterStatistics.WorstReactionTime)
+			hostMasterStatistics.WorstReactionTime = reaction;
+	}
+
+	hostMasterSDOPoll(now);
+
+	if(hostMasterCycleActive && (int32_t)(now - hostMasterNextCycle) >= 0)
+		hostMasterCycle(now);
+}
+
+const hostMasterStatisticsStruct *hostMasterGetStatistics(void) {
+	return &hostMasterStatistics;
+}
+
+void hostMasterResetStatistics(void) {
+	uint32_t cycleTime = hostMasterStatistics.CycleTime;
+	memset(&hostMasterStatistics,0,sizeof(hostMasterStatistics));
+	hostMasterStatistics.CycleTime = cycleTime;
+}
@@ -0,0 +1,241 @@
+#include "hostSlave.h"
+#include "hostLAN9252.h"
+#include "hostPlatform.h"
+#include "hostBoot.h"
+#include "modDelay.h"
+#include "modEffect.h"
+#include "modTrace.h"
+#include "middleSOES.h"
+#include "middleNunChuck.h"
+#include "middleFirmwareUpdate.h"
+#include "middleCapture.h"
+#include "middleTrace.h"
+#include "middleNetwork.h"
+#include "middleTelemetry.h"
+#include "middleDiagnosis.h"
+#include "middleParameter.h"
+#include "middleCalibration.h"
+
+#define hostSlaveSensorPeriod					driverNunChuckCommandDelay
+#define hostSlaveProcessDataBudget		100																	// us
+#define hostSlaveSensorBudget					500																	// us
+#define hostSlaveMailboxBudget				500																	// us
+#define hostSlaveFirmwareUpdateBudget	21000																// us, one page erase
+#define hostSlaveTraceBudget					200																	// us
+#define hostSlaveNetworkBudget				300																	// us
+#define hostSlaveParameterBudget			21000																// us, one page erase
+#define hostSlaveImageStack						driverHWBootRAMEnd
+#define hostSlaveImageReset						0x1C1																// Offset of the reset handler, thumb bit set
+
+middleNunChuckDataStruct hostSlaveNunChuckSensorDataStruct;
+uint8_t hostSlaveFoEImage[hostSlaveFoEFileSize];
+uint8_t hostSlaveFoEBuffer[hostSlaveFoEBufferSize];
+uint32_t hostSlaveFoEWritten = 0;
+middleNunChuckDataStruct *hostSlaveRecording = NULL;
+uint32_t hostSlaveRecordingSize = 0;
+uint32_t hostSlaveRecorded = 0;
+
+static uint32_t hostSlaveFoEWrite(foe_writefile_cfg_t *self, uint8_t *data, uint32_t length);
+
+foe_writefile_cfg_t hostSlaveFoEFiles[] = {
+	{hostSlaveFoEFileName, hostSlaveFoEFileSize, 0, 0, 0, &hostSlaveFoEWrite, NULL},
+	middleFirmwareUpdateFoEFile,
+	middleCaptureFoEFile,
+	middleTraceFoEFile
+};
+
+foe_cfg_t hostSlaveFoEConfig = {hostSlaveFoEBuffer, 0xFF, hostSlaveFoEBufferSize, sizeof(hostSlaveFoEFiles)/sizeof(hostSlaveFoEFiles[0]), hostSlaveFoEFiles};
+int8_t hostSlaveProcessDataTaskHandle = modSchedulerNoTask;
+int8_t hostSlaveMailboxTaskHandle = modSchedulerNoTask;
+int8_t hostSlaveSensorTaskHandle = modSchedulerNoTask;
+
+static void hostSlaveInstallImage(void);
+static void hostSlaveNunChuckDataEventHandler(middleNunChuckDataStruct newData);
+static void hostSlaveNunChuckFaultEventHandler(uint8_t fault, bool active);
+static void hostSlaveReadBufferUpdateHandler(void);
+static void hostSlaveESCEventHandler(void);
+static void hostSlaveObjectWriteHandler(uint16_t index, uint8_t subIndex);
+
+bool hostSlaveInit(void) {
+	hostLAN9252Reset();
+	hostSlaveInstallImage();
+
+	modDelayInit();
+	modTraceInit();
+	modEffectInit();
+	middleDiagnosisInit();
+	if(!middleSOESInit())
+		return false;																													// The model should always come up, do not retry forever
+	middleSOESReadBufferUpdateEvent(&hostSlaveReadBufferUpdateHandler);
+	middleSOESESCEvent(&hostSlaveESCEventHandler);
+	middleSOESObjectWriteEvent(&hostSlaveObjectWriteHandler);
+	middleSOESEmergencyEvent(&middleDiagnosisEmergency);
+	middleSOESALStatusCodeEvent(&middleDiagnosisALStatusCode);
+	middleFirmwareUpdateInit();
+	middleSOESFoEConfig(&hostSlaveFoEConfig,hostSlaveFoEFiles);
+	hostSlaveFoEFileClear();
+
+	middleParameterInit();																																		// Before the nunchuck, its calibration may be stored
+	middleCalibrationInit();
+	middleNunChuckInit();
+	middleNunChuckNewDataEvent(&hostSlaveNunChuckDataEventHandler);
+	middleNunChuckFaultEvent(&hostSlaveNunChuckFaultEventHandler);
+	middleCaptureInit();
+	hostSlaveRecorded = 0;
+	middleTraceInit();
+	middleNetworkInit();
+	middleTelemetryInit();
+	middleParameterObjectWriteEvent(&hostSlaveObjectWriteHandler);
+	middleParameterLoad();
+
+	modSchedulerInit();
+	hostSlaveProcessDataTaskHandle = modSchedulerAddPeriodicTask("PDO",&middleSOESProcessDataTask,0,middleSOESProcessDataPeriod,hostSlaveProcessDataBudget);
+	hostSlaveSensorTaskHandle = modSchedulerAddPeriodicTask("Sensor",&middleNunChuckTask,1,hostSlaveSensorPeriod,hostSlaveSensorBudget);
+	hostSlaveMailboxTaskHandle = modSchedulerAddPeriodicTask("Mailbox",&middleSOESMailboxTask,2,middleSOESMailboxPeriod,hostSlaveMailboxBudget);
+	modSchedulerAddPeriodicTask("Update",&middleFirmwareUpdateTask,3,middleFirmwareUpdatePeriod,hostSlaveFirmwareUpdateBudget);
+	modSchedulerAddPeriodicTask("Trace",&middleTraceTask,4,middleTracePeriod,hostSlaveTraceBudget);
+	modSchedulerAddPeriodicTask("Network",&middleNetworkTask,5,middleNetworkPeriod,hostSlaveNetworkBudget);
+	modSchedulerAddPeriodicTask("Parameter",&middleParameterTask,6,middleParameterPeriod,hostSlaveParameterBudget);
+	return true;
+}
+
+// Reset through the bootloader: it picks the slot, the slave then comes up from that slot.
+bool hostSlaveReboot(void) {
+	bool trial;
+
+	hostBootClearReset();
+	uint32_t image = middleBootControlSelect(&trial);
+	if(!image)
+		return false;
+	if(trial)
+		driverHWBootWatchdogStart(middleBootControlTrialWatchdog);
+	driverHWBootJump(image);
+
+	return hostSlaveInit();
+}
+
+// One pass of the firmware main loop, including the sleep when nothing is due.
+void hostSlaveStep(void) {
+	hostPlatformService();
+	modSchedulerTask();
+}
+
+void hostSlaveRunFor(uint32_t microseconds) {
+	uint32_t deadline = modDelayDeadlineSet(microseconds);
+
+	while(!modDelayDeadlineExpired(deadline))
+		hostSlaveStep();
+}
+
+int8_t hostSlaveProcessDataTask(void) {
+	return hostSlaveProcessDataTaskHandle;
+}
+
+int8_t hostSlaveMailboxTask(void) {
+	return hostSlaveMailboxTaskHandle;
+}
+
+int8_t hostSlaveSensorTask(void) {
+	return hostSlaveSensorTaskHandle;
+}
+
+// Bytes received so far, including the fill up to the last whole buffer.
+const uint8_t *hostSlaveFoEFile(uint32_t *length) {
+	if(length)
+		*length = hostSlaveFoEWritten;
+	return hostSlaveFoEImage;
+}
+
+// Keeps every sensor sample from the next start-up on, in the order the capture sees them.
+void hostSlaveRecordSamples(middleNunChuckDataStruct *buffer, uint32_t size) {
+	hostSlaveRecording = buffer;
+	hostSlaveRecordingSize = size;
+}
+
+// Samples since start-up, the buffer holds the first ones of them.
+uint32_t hostSlaveRecordedSamples(void) {
+	return hostSlaveRecorded;
+}
+
+// Latest sample the sensor task handed on, mapped with the calibration in use.
+middleNunChuckDataStruct hostSlaveLatestSample(void) {
+	return hostSlaveNunChuckSensorDataStruct;
+}
+
+void hostSlaveFoEFileClear(void) {
+	memset(hostSlaveFoEImage,0xFF,sizeof(hostSlaveFoEImage));
+	hostSlaveFoEWritten = 0;
+}
+
+static uint32_t hostSlaveFoEWrite(foe_writefile_cfg_t *self, uint8_t *data, uint32_t length) {
+	if(self->address_offset + length > hostSlaveFoEFileSize)
+		return 1;																																// Past the end, FoE aborts the transfer
+
+	memcpy(&hostSlaveFoEImage[self->address_offset],data,length);
+	hostSlaveFoEWritten = self->address_offset + length;
+	return 0;
+}
+
+// The first start finds an empty simulated flash. Put a vector table into slot A and run from there, as if a
+// debugger had flashed the firmware.
+static void hostSlaveInstallImage(void) {
+	uint32_t vectors[2] = {hostSlaveImageStack, middleBootControlSlotAddressA + hostSlaveImageReset};
+
+	if(driverHWBootRunningImage())
+		return;
+
+	if(!middleBootControlVectorsValid(0,driverHWFlashRead(middleBootControlSlotAddressA)))
+		driverHWFlashProgram(middleBootControlSlotAddressA,(const uint8_t *)vectors,sizeof(vectors));
+	hostBootSetRunningImage(middleBootControlSlotAddressA);
+}
+
+static void hostSlaveNunChuckDataEventHandler(middleNunChuckDataStruct newData) {
+	memcpy(&hostSlaveNunChuckSensorDataStruct,&newData,sizeof(middleNunChuckDataStruct));
+	middleCaptureSample(&newData);
+	middleTelemetrySample(&newData);
+	if(hostSlaveRecording && hostSlaveRecorded < hostSlaveRecordingSize)
+		hostSlaveRecording[hostSlaveRecorded] = newData;
+	hostSlaveRecorded++;
+}
+
+static void hostSlaveNunChuckFaultEventHandler(uint8_t fault, bool active) {
+	// Sensor faults become emergencies, the master no longer has to poll NunChuckDataValid for the cause
+	if(fault == middleNunChuckFaultCommunication)
+		middleSOESEmergency(active ? middleSOESEmergencySensorCommunication : middleSOESEmergencyErrorReset,middleSOESErrorRegisterManufacturer,EMERGENCY_PRIORITY_NORMAL,NULL);
+	else
+		middleSOESEmergency(active ? middleSOESEmergencySensorCalibration : middleSOESEmergencyErrorReset,middleSOESErrorRegisterDeviceProfile,EMERGENCY_PRIORITY_LOW,NULL);
+}
+
+static void hostSlaveObjectWriteHandler(uint16_t index, uint8_t subIndex) {
+	if(index == 0x2102)
+		middleCaptureControl();
+	else if(index == 0x10F3)
+		middleDiagnosisObjectWrite(subIndex);
+	else if(index == 0x1010)
+		middleParameterStore();
+	else if(index == 0x1011)
+		middleParameterRestoreDefaults();
+	else if(index == 0x8001 && subIndex == 1)
+		middleCalibrationControl();
+}
+
+static void hostSlaveESCEventHandler(void) {
+	modSchedulerTrigger(hostSlaveProcessDataTaskHandle);
+	modSchedulerTrigger(hostSlaveMailboxTaskHandle);
+}
+
+static void hostSlaveReadBufferUpdateHandler(void) {
+	middleCaptureExternalTrigger(middleSOESWriteBuffer.Digital_outputs.CaptureTrigger);
+
+	middleSOESReadBuffer.NunChuck.JoyStickX = hostSlaveNunChuckSensorDataStruct.joystickX;
+	middleSOESReadBuffer.NunChuck.JoyStickY = hostSlaveNunChuckSensorDataStruct.joystickY;
+
+	middleSOESReadBuffer.NunChuck.AcceleroMeterX = hostSlaveNunChuckSensorDataStruct.accelerometerX;
+	middleSOESReadBuffer.NunChuck.AcceleroMeterY = hostSlaveNunChuckSensorDataStruct.accelerometerY;
+	middleSOESReadBuffer.NunChuck.AcceleroMeterZ = hostSlaveNunChuckSensorDataStruct.accelerometerZ;
+
+	middleSOESReadBuffer.NunChuck.ButtonC = hostSlaveNunChuckSensorDataStruct.buttonC;
+	middleSOESReadBuffer.NunChuck.ButtonZ = hostSlaveNunChuckSensorDataStruct.buttonZ;
+
+	middleSOESReadBuffer.NunChuck.NunChuckDataValid = hostSlaveNunChuckSensorDataStruct.dataValid;
+}
@@ -1,42 +1,146 @@
 #include "stm32f3xx_hal.h"
 #include "usb_device.h"
+#include "usbd_cdc_if.h"
 #include "modDelay.h"
 #include "modEffect.h"
+#include "modScheduler.h"
+#include "modTrace.h"
 #include "middleSOES.h"
 #include "middleNunChuck.h"
+#include "middleFirmwareUpdate.h"
+#include "middleCapture.h"
+#include "middleTrace.h"
+#include "middleNetwork.h"
+#include "middleTelemetry.h"
+#include "middleDiagnosis.h"
+#include "middleParameter.h"
+#include "middleCalibration.h"
+
+#define mainSensorPeriod							driverNunChuckCommandDelay													// us, one I2C command per release
+#define mainProcessDataBudget					100																	// us
+#define mainSensorBudget							500																	// us
+#define mainMailboxBudget							500																	// us
+#define mainFirmwareUpdateBudget			21000																// us, one page erase
+#define mainTraceBudget								200																	// us
+#define mainNetworkBudget							300																	// us, one datagram built
+#define mainParameterBudget						21000																// us, one page erase
+#define mainFoEBufferSize							128																	// Bytes handed to the firmware update at once
 
 void SystemClock_Config(void);
 void Error_Handler(void);
 
 middleNunChuckDataStruct mainNunChuckSensorDataStruct;
+int8_t mainProcessDataTask = modSchedulerNoTask;
+int8_t mainMailboxTask = modSchedulerNoTask;
+uint8_t mainFoEBuffer[mainFoEBufferSize];
+foe_writefile_cfg_t mainFoEFiles[] = {
+	middleFirmwareUpdateFoEFile,
+	middleCaptureFoEFile,
+	middleTraceFoEFile
+};
+foe_cfg_t mainFoEConfig = {mainFoEBuffer, 0xFF, mainFoEBufferSize, sizeof(mainFoEFiles)/sizeof(mainFoEFiles[0]), mainFoEFiles};
 
 void newNunChuckDataEventHandler(middleNunChuckDataStruct newData);
+void newNunChuckFaultEventHandler(uint8_t fault, bool active);
 void newSOESReadBufferUpdateHandler(void);
+void newSOESESCEventHandler(void);
+void newSOESObjectWriteHandler(uint16_t index, uint8_t subIndex);
+bool mainTraceTransmit(uint8_t *data, uint16_t length);
 
 int main(void) {
   HAL_Init();
   SystemClock_Config();
 	
 	modDelayInit();
+	modTraceInit();																															// First, so the ESC coming up is in the trace
 	modEffectInit();
-	middleSOESInit();
+	middleDiagnosisInit();
+	while(!middleSOESInit())
+		modEffectChangeState(modIndicatorErrorLED,STAT_FLICKER);										// ESC did not come up, show a booting error and retry
+	modEffectChangeState(modIndicatorErrorLED,STAT_OFF);
 	middleSOESReadBufferUpdateEvent(&newSOESReadBufferUpdateHandler);
+	middleSOESESCEvent(&newSOESESCEventHandler);
+	middleSOESObjectWriteEvent(&newSOESObjectWriteHandler);
+	middleSOESEmergencyEvent(&middleDiagnosisEmergency);
+	middleSOESALStatusCodeEvent(&middleDiagnosisALStatusCode);
+	middleFirmwareUpdateInit();
+	middleSOESFoEConfig(&mainFoEConfig,mainFoEFiles);
 	
+	middleParameterInit();																																		// Before the nunchuck, its calibration may be stored
+	middleCalibrationInit();
 	middleNunChuckInit();
 	middleNunChuckNewDataEvent(&newNunChuckDataEventHandler);
+	middleNunChuckFaultEvent(&newNunChuckFaultEventHandler);
+	middleCaptureInit();
+	
+	middleTraceInit();
+	middleTraceStreamTransmitter(&mainTraceTransmit);
+	CDC_ReceiveEvent_FS(&middleTraceStreamReceive);
+	MX_USB_DEVICE_Init();
+	
+	middleNetworkInit();
+	middleTelemetryInit();
+	
+	// Last, the stored settings replace the defaults the modules just set
+	middleParameterObjectWriteEvent(&newSOESObjectWriteHandler);
+	middleParameterLoad();
+	
+	// Process data first, then the sensor feeding it and mailbox housekeeping, flash work for firmware updates, the trace
+	// export, the EoE network and stored settings last. LED effects run from their own timer alarm
+	modSchedulerInit();
+	mainProcessDataTask = modSchedulerAddPeriodicTask("PDO",&middleSOESProcessDataTask,0,middleSOESProcessDataPeriod,mainProcessDataBudget);
+	modSchedulerAddPeriodicTask("Sensor",&middleNunChuckTask,1,mainSensorPeriod,mainSensorBudget);
+	mainMailboxTask = modSchedulerAddPeriodicTask("Mailbox",&middleSOESMailboxTask,2,middleSOESMailboxPeriod,mainMailboxBudget);
+	modSchedulerAddPeriodicTask("Update",&middleFirmwareUpdateTask,3,middleFirmwareUpdatePeriod,mainFirmwareUpdateBudget);
+	modSchedulerAddPeriodicTask("Trace",&middleTraceTask,4,middleTracePeriod,mainTraceBudget);
+	modSchedulerAddPeriodicTask("Network",&middleNetworkTask,5,middleNetworkPeriod,mainNetworkBudget);
+	modSchedulerAddPeriodicTask("Parameter",&middleParameterTask,6,middleParameterPeriod,mainParameterBudget);
 	
   while(true) {
-		modEffectTask();
-		middleSOESTask();
-		middleNunChuckTask();
+		modSchedulerTask();
   }
 }
 
 void newNunChuckDataEventHandler(middleNunChuckDataStruct newData) {
 	memcpy(&mainNunChuckSensorDataStruct,&newData,sizeof(middleNunChuckDataStruct));
+	middleCaptureSample(&newData);																									// Every sample, not just the ones the PDO picks up
+	middleTelemetrySample(&newData);
+}
+
+void newNunChuckFaultEventHandler(uint8_t fault, bool active) {
+	// Sensor faults become emergencies, the master no longer has to poll NunChuckDataValid for the cause
+	if(fault == middleNunChuckFaultCommunication)
+		middleSOESEmergency(active ? middleSOESEmergencySensorCommunication : middleSOESEmergencyErrorReset,middleSOESErrorRegisterManufacturer,EMERGENCY_PRIORITY_NORMAL,NULL);
+	else
+		middleSOESEmergency(active ? middleSOESEmergencySensorCalibration : middleSOESEmergencyErrorReset,middleSOESErrorRegisterDeviceProfile,EMERGENCY_PRIORITY_LOW,NULL);
+}
+
+void newSOESESCEventHandler(void) {
+	// ESC IRQ or SYNC0, release the EtherCAT tasks
+	modSchedulerTrigger(mainProcessDataTask);
+	modSchedulerTrigger(mainMailboxTask);
+}
+
+void newSOESObjectWriteHandler(uint16_t index, uint8_t subIndex) {
+	if(index == 0x2102)
+		middleCaptureControl();
+	else if(index == 0x10F3)
+		middleDiagnosisObjectWrite(subIndex);
+	else if(index == 0x1010)
+		middleParameterStore();
+	else if(index == 0x1011)
+		middleParameterRestoreDefaults();
+	else if(index == 0x8001 && subIndex == 1)
+		middleCalibrationControl();
+}
+
+bool mainTraceTransmit(uint8_t *data, uint16_t length) {
+	return (CDC_Transmit_FS(data,length) == USBD_OK);
 }
 
 void newSOESReadBufferUpdateHandler(void) {
+	middleCaptureExternalTrigger(middleSOESWriteBuffer.Digital_outputs.CaptureTrigger);
+	
 	// Update the SOES readbuffer
 	middleSOESReadBuffer.NunChuck.JoyStickX = mainNunChuckSensorDataStruct.joystickX;
 	middleSOESReadBuffer.NunChuck.JoyStickY = mainNunChuckSensorDataStruct.joystickY;
@@ -94,7 +198,7 @@ void SystemClock_Config(void) {
   HAL_SYSTICK_CLKSourceConfig(SYSTICK_CLKSOURCE_HCLK);
 
   /* SysTick_IRQn interrupt configuration */
-  HAL_NVIC_SetPriority(SysTick_IRQn, 0, 0);
+  HAL_NVIC_SetPriority(SysTick_IRQn, IRQ_PRIORITY_TICK, 0);
 }
 
 
@@ -0,0 +1,67 @@
+#ifndef __MIDDLEBOOTCONTROL_H
+#define __MIDDLEBOOTCONTROL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "driverHWFlash.h"
+#include "driverHWBoot.h"
+
+// Flash layout and boot decision shared by the bootloader and the application. The application runs from one of
+// two slots, each image is linked for its own slot and executes in place. Updates always go into the other slot,
+// so a working image stays in flash until the new one proved itself by reaching OP. Which slot boots and whether
+// it is on trial is kept in a journal of records over two flash pages, the latest valid record wins.
+//
+//	0x08000000	Bootloader							24kB
+//	0x08006000	Boot control journal		 4kB
+//	0x08007000	Parameter journal			 4kB
+//	0x08008000	Slot A								 240kB
+//	0x08044000	Slot B								 240kB
+
+#define middleBootControlBootloaderAddress		0x08000000
+#define middleBootControlJournalAddress			0x08006000
+#define middleBootControlJournalPages				2
+#define middleBootControlSlotAddressA				0x08008000
+#define middleBootControlSlotAddressB				0x08044000
+#define middleBootControlSlotSize						0x0003C000
+#define middleBootControlSlots								2
+#define middleBootControlNoSlot							0xFF
+#define middleBootControlRecordMagic					0x4C544342												// "BCTL"
+#define middleBootControlLengthUnknown			0x00000000												// Image never recorded, e.g. programmed with a debugger
+#define middleBootControlLengthInvalid			0xFFFFFFFF												// Slot being overwritten or never completed
+#define middleBootControlTrialWatchdog				4000																// ms, a new image that hangs is reset and rolled back
+
+typedef enum {
+	BOOT_TRIAL_NONE = 0,																																// Active image confirmed
+	BOOT_TRIAL_PENDING,																																	// New image committed, not booted yet
+	BOOT_TRIAL_BOOTED																																		// New image booted, waiting for OP
+} middleBootControlTrialTypedef;
+
+typedef struct {
+	uint32_t Length;																																		// Bytes, or one of the two markers above
+	uint32_t Checksum;																																			// CRC-32 over Length bytes from the slot start
+	uint32_t Version;
+} middleBootControlImageStruct;
+
+typedef struct {
+	uint32_t Magic;
+	uint32_t Sequence;																																	// Highest valid one is the current record
+	uint8_t Active;																																			// Slot that boots
+	uint8_t Trial;																																			// middleBootControlTrialTypedef
+	uint16_t Rollbacks;
+	middleBootControlImageStruct Image[middleBootControlSlots];
+	uint32_t Checksum;																																			// Over everything above
+} middleBootControlRecordStruct;
+
+uint32_t middleBootControlSlotAddress(uint8_t slot);
+uint8_t middleBootControlSlotOf(uint32_t image);
+bool middleBootControlVectorsValid(uint8_t slot, const uint8_t *vectors);
+bool middleBootControlSlotBootable(const middleBootControlRecordStruct *record, uint8_t slot);
+void middleBootControlRead(middleBootControlRecordStruct *record);
+bool middleBootControlWrite(middleBootControlRecordStruct *record);
+uint32_t middleBootControlSelect(bool *trial);
+bool middleBootControlInvalidate(uint8_t slot);
+bool middleBootControlCommit(uint8_t slot, const middleBootControlImageStruct *image);
+bool middleBootControlConfirm(uint8_t slot);
+uint32_t middleBootControlCRC(uint32_t crc, const uint8_t *data, uint32_t length);
+
+#endif
@@ -0,0 +1,87 @@
+#ifndef __MIDDLECALIBRATION_H
+#define __MIDDLECALIBRATION_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "driverSWNunChuck.h"
+#include "middleParameter.h"
+
+// User calibration of the nunchuck (object 0x8001). Some controllers report garbage in their calibration bytes, a user
+// calibration stored for that controller then takes the place of them. Records are kept in the parameter journal
+// under a key folded from the 48 bit ID, with the whole ID inside, so a controller plugged in again is mapped with its
+// own values from the first sample on. Controls make the slave capture the values itself: lying flat gives the
+// joystick centre, 0g of X and Y and 1g of Z, standing on its side and on its nose 1g of X and of Y, and a recording
+// of the stick moved around takes its limits. The values can also be written directly, save checks and stores them.
+// On top of the calibration in use, tracking (object 0x8002) follows the drift of the joystick rest centre and of the
+// accelerometer 0g bias. Windows of samples with little variance count as still: a released stick moves its centre one
+// count towards the mean, the accelerometer bias takes a step that brings the measured gravity back to 1g. Only a bias
+// along gravity is observable that way, the bias of the axes across it waits for the nunchuck to be put down otherwise.
+//
+//	Key		middleCalibrationKey | (ID ^ ID >> 24) & 0xFFFFFF
+//	Data		ID u64, driverSWNunChuckCalibrationDataStruct; no data forgets the user calibration
+
+#define middleCalibrationKey									middleParameterKeyModule					// Up to 0x01FFFFFF
+#define middleCalibrationKeyMask							0x00FFFFFF
+#define middleCalibrationSamples							32																// Averaged per capture
+#define middleCalibrationTrackingWindow				32																// Samples per stillness decision, 320ms at 100Hz
+#define middleCalibrationTrackingVariance			4																	// counts^2 at most on every axis to be still
+#define middleCalibrationTrackingStickBand		12																// counts from the centre of a released stick, also the most learned
+#define middleCalibrationTrackingBiasLimit		64																// counts of 0g bias learned at most, ~0.3g
+#define middleCalibrationTrackingGravity			(1LL << 27)												// Q28, |a|^2 within 1g^2 +-50% to learn from
+
+typedef enum {
+	CALIBRATION_SOURCE_FACTORY = 0,																											// Read from the nunchuck
+	CALIBRATION_SOURCE_USER,																														// Stored for this nunchuck
+	CALIBRATION_SOURCE_NOMINAL																													// Neither usable, the part's nominal values
+} middleCalibrationSourceTypedef;
+
+typedef enum {
+	CALIBRATION_IDLE = 0,
+	CALIBRATION_CAPTURING,																															// Averaging samples for the control given
+	CALIBRATION_RANGE,																																	// Recording the joystick limits until the next control
+	CALIBRATION_DONE,																																		// Last control finished
+	CALIBRATION_FAILED																																	// Implausible values, no nunchuck or the store refused
+} middleCalibrationStateTypedef;
+
+typedef enum {
+	CALIBRATION_CONTROL_NONE = 0,																												// Stops a recording, leaves the values as they are
+	CALIBRATION_CONTROL_FLAT,																														// Z up, stick released
+	CALIBRATION_CONTROL_SIDE,																														// X up
+	CALIBRATION_CONTROL_NOSE,																														// Y up
+	CALIBRATION_CONTROL_RANGE,																													// Stick moved to every limit
+	CALIBRATION_CONTROL_SAVE,																														// Use Values for this nunchuck from now on
+	CALIBRATION_CONTROL_FORGET																													// Back to the factory calibration
+} middleCalibrationControlTypedef;
+
+typedef struct {
+	uint8_t Control;																																		// 0x8001:01, middleCalibrationControlTypedef
+	uint8_t State;																																			// middleCalibrationStateTypedef
+	uint8_t Source;																																			// middleCalibrationSourceTypedef, of the values in use
+	uint64_t ID;																																				// Of the nunchuck last connected
+	driverSWNunChuckCalibrationDataStruct Values;																				// Captured or written, in use after a save
+} middleCalibrationStatusStruct;
+
+// 0x8002, the learned values are added to the calibration in use
+typedef struct {
+	uint8_t Enable;																																			// Kept by the parameter store, off forgets what was learned
+	uint8_t Still;																																			// Last window
+	uint32_t Updates;																																		// Learned values changed since start-up
+	int8_t JoystickXCenter;																															// counts
+	int8_t JoystickYCenter;
+	int16_t AcceleroMeterX;																															// 0g bias, counts
+	int16_t AcceleroMeterY;
+	int16_t AcceleroMeterZ;
+} middleCalibrationTrackingStruct;
+
+extern middleCalibrationStatusStruct middleCalibrationStatus;
+extern middleCalibrationTrackingStruct middleCalibrationTracking;
+
+void middleCalibrationInit(void);
+uint8_t middleCalibrationSelect(uint64_t ID, driverSWNunChuckCalibrationDataStruct *calibration);
+bool middleCalibrationSample(const driverSWNunChuckSensorDataStruct *sample, driverSWNunChuckCalibrationDataStruct *calibration);
+void middleCalibrationControl(void);
+bool middleCalibrationPlausible(const driverSWNunChuckCalibrationDataStruct *calibration);
+const middleCalibrationStatusStruct *middleCalibrationGetStatus(void);
+const middleCalibrationTrackingStruct *middleCalibrationGetTracking(void);
+
+#endif
@@ -0,0 +1,113 @@
+#ifndef __MIDDLECAPTURE_H
+#define __MIDDLECAPTURE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "middleSOES.h"
+#include "middleNunChuck.h"
+
+// Triggered capture of every nunchuck sample into a RAM ring, downloaded as an FoE file instead of through the
+// cyclic process data. While armed the ring keeps the latest history; a trigger freezes what came before it and
+// records on for the post trigger time, or until the ring would have to give up the trigger itself.
+// The ring is made of fixed blocks. Each starts with an absolute keyframe sample, followed by delta records, so the
+// oldest block can be dropped whole and every block decodes on its own. A record is a mask of what changed, the
+// change of the sample period and the changed fields, all as zigzag varints: a nunchuck at rest costs one byte.
+//
+//	File		middleCaptureHeaderStruct, then the blocks oldest first, each middleCaptureBlockSize bytes
+//	Block		middleCaptureBlockHeaderStruct, keyframe, records up to Length
+//	Keyframe	JoyStickX i8, JoyStickY i8, AcceleroMeterX/Y/Z i16, flags u8 (middleCaptureFlag*)
+//	Record		mask u8 (middleCaptureDelta*), then for the bits set: the period change, the fields from JoyStickX to
+//				AcceleroMeterZ as zigzag varints of the difference to the previous sample, the absolute flags byte
+
+#define middleCaptureFileName									"capture.bin"
+#define middleCaptureFilePassword							0
+#define middleCaptureMagic										0x50414344												// "DCAP"
+#define middleCaptureFormat										1
+#define middleCaptureBlockSize								256																// Bytes
+#define middleCaptureBlocks										64																// 16kB, the whole CCM RAM on the target
+#define middleCaptureRAMAddress								0x10000000
+#define middleCaptureDefaultTriggers					(middleCaptureTriggerGesture | middleCaptureTriggerRxPDO)
+#define middleCaptureDefaultThreshold					24576															// 1.5g, 16384 per g
+#define middleCaptureDefaultPostTrigger				2000															// ms recorded after the trigger
+
+#define middleCaptureTriggerButtonC						0x01
+#define middleCaptureTriggerButtonZ						0x02
+#define middleCaptureTriggerGesture						0x04															// C and Z pressed together
+#define middleCaptureTriggerThreshold					0x08															// Any accelerometer axis beyond Threshold
+#define middleCaptureTriggerRxPDO							0x10															// CaptureTrigger output bit set by the master
+#define middleCaptureTriggerCommand						0x80															// Control written with CAPTURE_CONTROL_TRIGGER
+
+#define middleCaptureFlagButtonC							0x01
+#define middleCaptureFlagButtonZ							0x02
+#define middleCaptureFlagDataValid						0x04
+
+#define middleCaptureDeltaJoyStickX						0x01
+#define middleCaptureDeltaJoyStickY						0x02
+#define middleCaptureDeltaAcceleroMeterX			0x04
+#define middleCaptureDeltaAcceleroMeterY			0x08
+#define middleCaptureDeltaAcceleroMeterZ			0x10
+#define middleCaptureDeltaFlags								0x20
+#define middleCaptureDeltaPeriod							0x40															// Period in us differs from the previous one
+
+typedef enum {
+	CAPTURE_IDLE = 0,
+	CAPTURE_ARMED,																																			// Recording history, waiting for a trigger
+	CAPTURE_TRIGGERED,																																	// Recording the post trigger part
+	CAPTURE_DONE																																				// Frozen, capture.bin holds it
+} middleCaptureStateTypedef;
+
+typedef enum {
+	CAPTURE_CONTROL_NONE = 0,
+	CAPTURE_CONTROL_ARM,																																// Discards the ring and starts over
+	CAPTURE_CONTROL_TRIGGER,
+	CAPTURE_CONTROL_STOP
+} middleCaptureControlTypedef;
+
+typedef struct {
+	uint32_t Magic;
+	uint16_t Format;
+	uint16_t BlockSize;
+	uint16_t Blocks;																																		// Following this header
+	uint8_t TriggerSource;																															// middleCaptureTrigger* that fired
+	uint8_t Reserved;
+	uint32_t Samples;
+	uint32_t FirstSequence;																															// Samples since start-up before the first one in the file
+	uint32_t TriggerSample;																															// Index in the file of the sample that triggered
+	uint32_t TriggerTime;																																// us, same clock as the block times
+	uint32_t Period;																																		// us, sensor interval when captured
+} middleCaptureHeaderStruct;
+
+typedef struct {
+	uint32_t Time;																																			// us, of the keyframe
+	uint32_t Period;																																		// us, base for the first record's period change
+	uint16_t Samples;																																		// Keyframe included
+	uint16_t Length;																																		// Bytes used, this header included
+} middleCaptureBlockHeaderStruct;
+
+typedef struct {
+	uint8_t Control;																																		// middleCaptureControlTypedef, reads back 0 once done
+	uint8_t Triggers;																																		// middleCaptureTrigger* that may fire
+	uint16_t Threshold;
+	uint32_t PostTrigger;																																// ms
+	uint8_t State;																																			// middleCaptureStateTypedef
+	uint8_t TriggerSource;
+	uint32_t Samples;																																		// In the ring
+	uint32_t Bytes;																																			// Size of capture.bin once done
+	uint32_t Duration;																																	// us between the first and the last sample in the ring
+	uint32_t BlocksDropped;																															// Oldest history given up for newer samples
+} middleCaptureStatusStruct;
+
+// Entry for the FoE file table handed to middleSOESFoEConfig, read only
+#define middleCaptureFoEFile	{middleCaptureFileName, sizeof(middleCaptureHeaderStruct) + middleCaptureBlocks*middleCaptureBlockSize, 0, 0, \
+	middleCaptureFilePassword, NULL, NULL, &middleCaptureFoERead}
+
+extern middleCaptureStatusStruct middleCaptureStatus;
+
+void middleCaptureInit(void);
+void middleCaptureSample(const middleNunChuckDataStruct *data);
+void middleCaptureExternalTrigger(bool level);
+void middleCaptureControl(void);
+uint32_t middleCaptureFoERead(foe_writefile_cfg_t *self, uint32_t offset, uint8_t *data, uint32_t length);
+const middleCaptureStatusStruct *middleCaptureGetStatus(void);
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef __MIDDLEDIAGNOSIS_H
+#define __MIDDLEDIAGNOSIS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "middleSOES.h"
+
+// Diagnosis history (ETG.1020, object 0x10F3). Emergencies and AL status codes are kept as diagnosis messages in a
+// RAM ring, time stamped with the ESC system time, so a master can find out what happened after the fact. The
+// master reads NewestMessage and NewMessagesAvailable, fetches the messages it has not seen yet and writes the
+// subindex of the last one it handled to NewestAcknowledgedMessage; writing 0 there clears the history.
+// In overwrite mode (the default) the oldest message gives way to a new one. In acknowledge mode a ring full of
+// unacknowledged messages keeps them and discards the new ones. Either way middleDiagnosisFlagMessageLost is set.
+//
+//	Message		DiagCode u32, flags u16, TextID u16, TimeStamp u64 (ns), then per parameter: flags u16, value u32
+//	DiagCode	Upper word 0: CoE emergency error code, parameter the error register
+//				middleDiagnosisCodeALStatus: AL status code set, parameters the AL status code and AL status
+
+#define middleDiagnosisMessages								16
+#define middleDiagnosisParameters							2
+#define middleDiagnosisMessageSize						(16 + middleDiagnosisParameters*6)	// Bytes, room for every parameter
+#define middleDiagnosisFirstMessage						6																	// Subindex of the first message in 0x10F3
+
+#define middleDiagnosisCodeALStatus						0xF0000001												// Manufacturer specific range
+
+#define middleDiagnosisTypeInfo								0x0000
+#define middleDiagnosisTypeWarning						0x0001
+#define middleDiagnosisTypeError							0x0002
+#define middleDiagnosisParameterUDINT					0x0007														// Parameter flags, data type index
+
+// Flags (0x10F3:05)
+#define middleDiagnosisFlagEmergency					0x0001														// Send as emergency, not supported
+#define middleDiagnosisFlagDisableInfo				0x0002
+#define middleDiagnosisFlagDisableWarning			0x0004
+#define middleDiagnosisFlagDisableError				0x0008
+#define middleDiagnosisFlagAcknowledgeMode		0x0010
+#define middleDiagnosisFlagMessageLost				0x0020														// Read only, cleared once all are acknowledged
+#define middleDiagnosisFlagsWritable					(middleDiagnosisFlagDisableInfo | middleDiagnosisFlagDisableWarning | middleDiagnosisFlagDisableError | middleDiagnosisFlagAcknowledgeMode)
+
+typedef struct {
+	uint8_t NewestMessage;																															// Subindex, 0 while there are none
+	uint8_t NewestAcknowledgedMessage;																									// Subindex, written by the master
+	bool NewMessagesAvailable;
+	uint16_t Flags;																																			// middleDiagnosisFlag*
+	uint32_t Stored;																																		// Messages since start-up, the discarded ones included
+	uint32_t Lost;																																			// Overwritten before acknowledged or discarded
+} middleDiagnosisStatusStruct;
+
+extern middleDiagnosisStatusStruct middleDiagnosisStatus;
+extern uint8_t middleDiagnosisMessageBuffer[middleDiagnosisMessages][middleDiagnosisMessageSize];
+
+void middleDiagnosisInit(void);
+void middleDiagnosisEmergency(uint16_t errorCode, uint8_t errorRegister, middleSOESEmergencyPriorityTypedef priority);
+void middleDiagnosisALStatusCode(uint16_t statusCode, uint8_t status);
+void middleDiagnosisObjectWrite(uint8_t subIndex);
+const middleDiagnosisStatusStruct *middleDiagnosisGetStatus(void);
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef __MIDDLEFIRMWAREUPDATE_H
+#define __MIDDLEFIRMWAREUPDATE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "middleSOES.h"
+#include "middleBootControl.h"
+
+// FoE firmware download into the slot the application is not running from. The file is a header followed by the
+// image, the header carries the image CRC which is checked against the flash contents when FoE closes the file.
+// A verified image is committed to boot control and started on trial with the next reset, which the slave does by
+// itself when the master takes it from BOOT back to INIT. Reaching OP confirms it, anything else rolls back.
+// Received data is collected in two page buffers: while FoE fills one, the background task programs the other and
+// erases the pages ahead, so flash work overlaps the mailbox round trips instead of stalling them.
+
+#define middleFirmwareUpdateFileName					"app.bin"
+#define middleFirmwareUpdateFilePassword				0
+#define middleFirmwareUpdateMagic							0x46534244												// "DBSF"
+#define middleFirmwareUpdateEraseAhead					2																	// Pages kept erased beyond the one being filled
+#define middleFirmwareUpdateProgramSlice				64																// Bytes programmed per task run, ~1.6ms of stall
+#define middleFirmwareUpdatePeriod							1000															// us, background task period
+#define middleFirmwareUpdateTrialTimeout				120																// s a new image gets to reach OP
+
+typedef enum {
+	FIRMWARE_UPDATE_IDLE = 0,
+	FIRMWARE_UPDATE_RECEIVING,
+	FIRMWARE_UPDATE_VALID,																															// Verified and committed, boots with the next reset
+	FIRMWARE_UPDATE_FAILED
+} middleFirmwareUpdateStateTypedef;
+
+typedef struct {
+	uint32_t Magic;
+	uint32_t Length;																																		// Image bytes following the header
+	uint32_t Checksum;																																			// CRC-32 (IEEE 802.3) over those bytes
+	uint32_t Version;
+} middleFirmwareUpdateHeaderStruct;
+
+typedef struct {
+	uint8_t State;																																			// middleFirmwareUpdateStateTypedef
+	uint32_t Received;																																	// Bytes handed over by FoE
+	uint32_t Programmed;																																// Bytes written to flash
+	uint32_t PagesErased;
+	uint32_t Stalls;																																		// FoE had to wait for a page buffer
+	uint32_t WorstWriteTime;																														// us spent in one FoE write
+	uint32_t VerifyTime;																																// us for the last drain and CRC check
+	uint32_t Checksum;																																			// Computed over the downloaded image
+	uint32_t Version;																																		// Of the downloaded image, once verified
+	uint8_t RunningSlot;																																// 0 = A, 1 = B
+	uint32_t RunningVersion;																														// 0 when programmed with a debugger
+	uint8_t Trial;																																			// middleBootControlTrialTypedef
+	uint16_t Rollbacks;
+} middleFirmwareUpdateStatusStruct;
+
+// Entry for the FoE file table handed to middleSOESFoEConfig
+#define middleFirmwareUpdateFoEFile	{middleFirmwareUpdateFileName, sizeof(middleFirmwareUpdateHeaderStruct) + middleBootControlSlotSize, 0, 0, \
+	middleFirmwareUpdateFilePassword, &middleFirmwareUpdateFoEWrite, &middleFirmwareUpdateFoEClose}
+
+extern middleFirmwareUpdateStatusStruct middleFirmwareUpdateStatus;
+
+void middleFirmwareUpdateInit(void);
+void middleFirmwareUpdateTask(void);
+uint32_t middleFirmwareUpdateFoEWrite(foe_writefile_cfg_t *self, uint8_t *data, uint32_t length);
+uint32_t middleFirmwareUpdateFoEClose(foe_writefile_cfg_t *self, uint32_t length);
+const middleFirmwareUpdateStatusStruct *middleFirmwareUpdateGetStatus(void);
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef __MIDDLENETWORK_H
+#define __MIDDLENETWORK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "middleSOES.h"
+
+// Minimal IPv4 host on the Ethernet over EtherCAT port: ARP replies, ICMP echo and UDP, no IP options or fragments.
+// There is one static frame buffer each way. Received frames are handled in place when the mailbox completes them,
+// frames to send are built straight in the EoE transmit buffer. Addresses come from the master's set IP parameter
+// request, until then the slave keeps quiet. A reply that finds the transmit buffer busy waits in a small slot and
+// goes out from middleNetworkTask, before the transmit ready event lets the services send.
+//
+// IP addresses are handled as 32 bit values with the first octet in the most significant byte, like EoE passes them.
+
+#define middleNetworkFrameSize								1514															// Bytes, Ethernet without FCS
+#define middleNetworkMinimumFrameSize					60																// Shorter frames are padded
+#define middleNetworkDefaultMAC								{0x02, 0xDB, 0x53, 0x00, 0x00, 0x01}				// Locally administered, until the master sets one
+#define middleNetworkUDPPorts									4																	// Bound ports at most
+#define middleNetworkEchoDeferSize						256																// Bytes of an echo request kept while the buffer is busy
+#define middleNetworkTimeToLive								64
+#define middleNetworkPeriod										10000															// us
+
+#define middleNetworkEthernetHeaderSize				14
+#define middleNetworkIPHeaderSize							20
+#define middleNetworkUDPHeaderSize						8
+#define middleNetworkUDPPayloadOffset					(middleNetworkEthernetHeaderSize + middleNetworkIPHeaderSize + middleNetworkUDPHeaderSize)
+
+typedef struct {
+	uint8_t MAC[6];
+	uint32_t IP;
+	uint16_t Port;
+} middleNetworkEndpointStruct;
+
+typedef struct {
+	uint8_t MAC[6];
+	uint32_t IP;																																				// 0 until the master set one
+	uint32_t Subnet;
+	uint32_t Gateway;
+	uint32_t RxFrames;
+	uint32_t RxDropped;																																	// Not for us, malformed or bad checksum
+	uint32_t TxFrames;
+	uint32_t TxBusy;																																		// Replies given up, the buffer and the slot were taken
+	uint32_t ARPReplies;
+	uint32_t EchoReplies;
+	uint32_t UDPReceived;
+	uint32_t UDPUnreachable;																														// Datagrams to a port nobody bound
+	uint32_t UDPSent;
+} middleNetworkStatusStruct;
+
+typedef void (*middleNetworkUDPHandlerTypedef)(const middleNetworkEndpointStruct *from, const uint8_t *data, uint16_t length);
+
+void middleNetworkInit(void);
+void middleNetworkTask(void);
+bool middleNetworkUDPBind(uint16_t port, middleNetworkUDPHandlerTypedef handler);
+uint8_t *middleNetworkUDPPayload(uint16_t *capacity);
+bool middleNetworkUDPSend(const middleNetworkEndpointStruct *to, uint16_t sourcePort, uint16_t length);
+void middleNetworkTransmitReadyEvent(void (*eventFunctionPointer)(void));
+const middleNetworkStatusStruct *middleNetworkGetStatus(void);
+
+#endif
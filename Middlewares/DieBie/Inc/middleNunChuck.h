@@ -1,9 +1,15 @@
+#ifndef __MIDDLENUNCHUCK_H
+#define __MIDDLENUNCHUCK_H
+
 #include "driverSWNunChuck.h"
 #include <stdint.h>
 
 #define middleNunChuckDefaultMeasureInterval 10
 #define middleNunChuckErrortMeasureInterval 500
 
+// Faults reported through middleNunChuckFaultEvent, each once when it comes and once when it goes
+#define middleNunChuckFaultCommunication		0x01													// Sensor or calibration read failed on I2C
+#define middleNunChuckFaultCalibration			0x02													// Calibration implausible and none stored, nominal values used
 
 typedef struct {
 	int8_t joystickX;
@@ -17,8 +23,20 @@ typedef struct {
 	bool dataValid;
 } middleNunChuckDataStruct;
 
+// 0x8000, kept by the parameter store. The sensor task runs every driverNunChuckCommandDelay, one read takes two
+// of its releases and starts on the next one after the interval.
+typedef struct {
+	uint32_t MeasureInterval;																														// us between sensor reads
+} middleNunChuckSettingsStruct;
+
+extern middleNunChuckSettingsStruct middleNunChuckSettings;
+
 void middleNunChuckInit(void);
 void middleNunChuckTask(void);
 bool middleNunChuckDataValid(void);
 void middleNunChuckNewDataEvent(void (*eventFunctionPointer)(middleNunChuckDataStruct newData));
+void middleNunChuckFaultEvent(void (*eventFunctionPointer)(uint8_t fault, bool active));
 void middleNunChuckSetMeasureInterval(uint32_t delayInMS);
+void middleNunChuckSetMeasureIntervalMicroseconds(uint32_t delayInUS);
+
+#endif
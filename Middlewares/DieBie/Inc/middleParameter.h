@@ -0,0 +1,63 @@
+#ifndef __MIDDLEPARAMETER_H
+#define __MIDDLEPARAMETER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "middleSOES.h"
+#include "middleBootControl.h"
+
+// Parameter store (CiA 301 objects 0x1010 and 0x1011). Settings survive a reset in an append-only journal over two
+// flash pages: a record holds one value under its key, the latest valid record of a key wins. Writing "save" to
+// 0x1010:01 queues a record for every dictionary entry flagged <Backup> in the description whose value changed,
+// writing "load" to 0x1011:01 queues a marker that voids everything before it, the defaults apply after the next
+// reset. A full page is compacted into the other one, which gets its header last so a reset part way keeps the old
+// page. The background task programs a few bytes per run; flash work stalls the core, so with process data running
+// the records stay queued in RAM and go to flash once the slave is back out of SAFEOP and OP. Init finds the active page early, so modules can read their records while they start up; Load
+// then puts the stored dictionary values in place with one pass over it.
+//
+//	Page		Magic u32, Sequence u32, then records from offset 8
+//	Record		Key u32, Length u16, reserved u16, data padded to 4 bytes, CRC-32 over all of that
+//	Key			Index << 8 | SubIndex for dictionary entries, middleParameterKeyModule and up for module data
+
+#define middleParameterJournalAddress				0x08007000
+#define middleParameterJournalPages					2
+#define middleParameterPageMagic						0x4A504244												// "DBPJ"
+#define middleParameterKeyDefaults					0x00000000												// Restore marker, no object has index 0
+#define middleParameterKeyModule						0x01000000												// Above every dictionary key
+#define middleParameterKeyErased						0xFFFFFFFF
+#define middleParameterMaximumLength				64																// Data bytes in one record
+#define middleParameterQueueSize						1024															// Bytes of records on their way to flash
+#define middleParameterProgramSlice					8																	// Bytes programmed per task run, ~200us of stall
+#define middleParameterPeriod								1000															// us, background task period
+#define middleParameterOnCommand						0x00000001												// 0x1010:01 and 0x1011:01 read back
+
+typedef enum {
+	PARAMETER_IDLE = 0,
+	PARAMETER_WRITING,																																	// Records going to flash
+	PARAMETER_WAITING,																																	// Queued in SAFEOP or OP, flash work waits for INIT, PREOP or BOOT
+	PARAMETER_FAILED																																		// Flash error or more live data than a page holds
+} middleParameterStateTypedef;
+
+typedef struct {
+	uint32_t Save;																																			// 0x1010:01
+	uint32_t Restore;																																		// 0x1011:01
+	uint8_t State;																																			// middleParameterStateTypedef
+	uint16_t Records;																																		// Written since start-up
+	uint16_t Compactions;
+	uint16_t Free;																																			// Bytes left in the active page
+} middleParameterStatusStruct;
+
+extern middleParameterStatusStruct middleParameterStatus;
+
+void middleParameterInit(void);
+void middleParameterLoad(void);
+void middleParameterTask(void);
+void middleParameterObjectWriteEvent(void (*eventFunctionPointer)(uint16_t index, uint8_t subIndex));
+bool middleParameterCommandFits(uint16_t index);
+bool middleParameterStore(void);
+bool middleParameterRestoreDefaults(void);
+bool middleParameterWrite(uint32_t key, const void *data, uint16_t length);
+bool middleParameterRead(uint32_t key, void *data, uint16_t length);
+const middleParameterStatusStruct *middleParameterGetStatus(void);
+
+#endif
@@ -0,0 +1,122 @@
+#ifndef __MIDDLETELEMETRY_H
+#define __MIDDLETELEMETRY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "middleNetwork.h"
+#include "middleNunChuck.h"
+#include "modScheduler.h"
+#include "modTrace.h"
+
+// Telemetry over UDP on the EoE network. Requests to middleTelemetryPort are answered to the port they came from.
+// SUBSCRIBE makes the sender the subscriber, the one client the chosen streams are pushed to every Period, a
+// datagram per network task run until each stream has caught up. A new SUBSCRIBE replaces the old subscriber.
+// Every field is little endian, every datagram starts with middleTelemetryHeaderStruct.
+//
+//	PING, UNSUBSCRIBE		no body, answered with middleTelemetryResponseStruct
+//	SUBSCRIBE				middleTelemetrySubscribeStruct, answered with middleTelemetryResponseStruct
+//	SAMPLES					middleTelemetrySamplesStruct, then Count middleTelemetrySampleStruct
+//	PROFILE					middleTelemetryProfileStruct, then Tasks middleTelemetryTaskStruct
+//	TRACE					middleTelemetryTraceStruct, then Records modTraceRecordStruct as in trace.bin
+//
+// A response carries the request's Type | middleTelemetryResponse and Sequence, pushes count their own Sequence.
+
+#define middleTelemetryPort										5020
+#define middleTelemetryMagic									0x4C54														// "TL"
+#define middleTelemetryResponse								0x80
+#define middleTelemetryDefaultPeriod					100																// ms
+#define middleTelemetrySampleRecords					64																// Ring of samples not pushed yet
+#define middleTelemetrySamplesPerDatagram			32
+#define middleTelemetryTracePerDatagram				32
+
+#define middleTelemetryStreamSamples					0x01
+#define middleTelemetryStreamProfile					0x02
+#define middleTelemetryStreamTrace						0x04
+#define middleTelemetryStreams								(middleTelemetryStreamSamples | middleTelemetryStreamProfile | middleTelemetryStreamTrace)
+
+typedef enum {
+	TELEMETRY_PING = 0x01,
+	TELEMETRY_SUBSCRIBE,
+	TELEMETRY_UNSUBSCRIBE,
+	TELEMETRY_SAMPLES = 0x10,
+	TELEMETRY_PROFILE,
+	TELEMETRY_TRACE
+} middleTelemetryTypeTypedef;
+
+typedef enum {
+	TELEMETRY_OK = 0,
+	TELEMETRY_UNKNOWN_TYPE,
+	TELEMETRY_INVALID
+} middleTelemetryResultTypedef;
+
+typedef struct {
+	uint16_t Magic;
+	uint8_t Type;																																				// middleTelemetryTypeTypedef
+	uint8_t Sequence;
+} middleTelemetryHeaderStruct;
+
+typedef struct {
+	uint8_t Streams;																																		// middleTelemetryStream*
+	uint8_t Reserved;
+	uint16_t Period;																																		// ms, 0 for the default
+} middleTelemetrySubscribeStruct;
+
+typedef struct {
+	uint8_t Result;																																			// middleTelemetryResultTypedef
+	uint8_t Streams;																																		// Subscribed now
+	uint16_t Period;																																		// ms
+	uint32_t Uptime;																																		// us
+} middleTelemetryResponseStruct;
+
+typedef struct {
+	uint32_t FirstSequence;																															// Samples since start-up before the first one here
+	uint16_t Count;
+	uint16_t Dropped;																																		// Overwritten before they could be pushed
+} middleTelemetrySamplesStruct;
+
+typedef struct {
+	uint32_t Time;																																			// us
+	int16_t AcceleroMeter[3];
+	int8_t JoyStickX;
+	int8_t JoyStickY;
+	uint8_t Flags;																																			// middleCapture's flag bits
+	uint8_t Reserved;
+} middleTelemetrySampleStruct;
+
+typedef struct {
+	uint8_t Tasks;
+	uint8_t Reserved[3];
+	uint32_t SleepTime;																																	// us
+	uint32_t WakeCount;
+	uint32_t WorstWakeLatency;																													// us
+} middleTelemetryProfileStruct;
+
+typedef struct {
+	char Name[8];																																				// Zero padded, not terminated when all 8 are used
+	uint32_t RunCount;
+	uint32_t DeadlineMisses;
+	uint32_t BudgetOverruns;
+	uint32_t WorstExecutionTime;																												// us
+	uint32_t WorstReleaseLatency;																												// us
+} middleTelemetryTaskStruct;
+
+typedef struct {
+	uint32_t FirstSequence;																															// A gap to the last push means records were overwritten
+	uint16_t Records;
+	uint16_t TicksPerMicrosecond;																												// Of the record Time, modTraceTicksPerMicrosecond
+} middleTelemetryTraceStruct;
+
+typedef struct {
+	uint32_t Requests;
+	uint32_t Invalid;																																		// Wrong magic, type or size
+	uint32_t Pushes;
+	uint32_t SamplesDropped;
+	uint8_t Streams;
+	uint16_t Period;																																		// ms
+} middleTelemetryStatusStruct;
+
+void middleTelemetryInit(void);
+void middleTelemetrySample(const middleNunChuckDataStruct *data);
+const middleTelemetryStatusStruct *middleTelemetryGetStatus(void);
+
+#endif
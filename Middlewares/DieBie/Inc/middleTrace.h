@@ -0,0 +1,36 @@
+#ifndef __MIDDLETRACE_H
+#define __MIDDLETRACE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "middleSOES.h"
+#include "modTrace.h"
+
+// Export of the event trace ring in modTrace.h, as a read only FoE file and over the USB CDC port. A terminal sends
+// middleTraceStreamCommand and gets the same bytes trace.bin would hold at that moment. Each export works on its
+// own snapshot, so an FoE read and a USB dump can run at the same time.
+
+#define middleTraceFileName										"trace.bin"
+#define middleTraceFilePassword								0
+#define middleTracePeriod											10000															// us
+#define middleTraceStreamChunk								64																// Bytes, one CDC full speed packet
+#define middleTraceStreamCommand							'T'
+
+typedef struct {
+	uint32_t FoEReads;
+	uint32_t StreamDumps;
+	uint32_t StreamBytes;
+} middleTraceStatusStruct;
+
+// Entry for the FoE file table handed to middleSOESFoEConfig, read only
+#define middleTraceFoEFile	{middleTraceFileName, sizeof(modTraceHeaderStruct) + modTraceRecords*sizeof(modTraceRecordStruct), 0, 0, \
+	middleTraceFilePassword, NULL, NULL, &middleTraceFoERead}
+
+void middleTraceInit(void);
+void middleTraceTask(void);
+uint32_t middleTraceFoERead(foe_writefile_cfg_t *self, uint32_t offset, uint8_t *data, uint32_t length);
+void middleTraceStreamTransmitter(bool (*transmitFunctionPointer)(uint8_t *data, uint16_t length));
+void middleTraceStreamReceive(uint8_t *data, uint32_t length);
+const middleTraceStatusStruct *middleTraceGetStatus(void);
+
+#endif
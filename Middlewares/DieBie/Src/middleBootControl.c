@@ -0,0 +1,211 @@
+#include "middleBootControl.h"
+#include <string.h>
+#include <stddef.h>
+
+#define middleBootControlRecordsPerPage			(driverHWFlashPageSize/sizeof(middleBootControlRecordStruct))
+
+static const uint32_t middleBootControlCRCTable[16] = {
+	0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+	0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+};
+
+static const middleBootControlRecordStruct *middleBootControlRecordAt(uint8_t page, uint16_t position) {
+	return (const middleBootControlRecordStruct *)driverHWFlashRead(middleBootControlJournalAddress + page*driverHWFlashPageSize +
+		position*sizeof(middleBootControlRecordStruct));
+}
+
+static bool middleBootControlRecordValid(const middleBootControlRecordStruct *record) {
+	return (record->Magic == middleBootControlRecordMagic) &&
+		(record->Checksum == middleBootControlCRC(0,(const uint8_t *)record,offsetof(middleBootControlRecordStruct,Checksum)));
+}
+
+static bool middleBootControlRecordErased(const middleBootControlRecordStruct *record) {
+	const uint8_t *bytes = (const uint8_t *)record;
+
+	for(uint8_t n = 0; n < sizeof(middleBootControlRecordStruct); n++)
+		if(bytes[n] != 0xFF)
+			return false;
+
+	return true;
+}
+
+// A record cut short by a reset fails its CRC and is skipped, the one before it stays current.
+static const middleBootControlRecordStruct *middleBootControlLatest(uint8_t *page, uint16_t *position) {
+	const middleBootControlRecordStruct *latest = NULL;
+
+	for(uint8_t p = 0; p < middleBootControlJournalPages; p++) {
+		for(uint16_t n = 0; n < middleBootControlRecordsPerPage; n++) {
+			const middleBootControlRecordStruct *record = middleBootControlRecordAt(p,n);
+			if(middleBootControlRecordValid(record) && (!latest || record->Sequence > latest->Sequence)) {
+				latest = record;
+				*page = p;
+				*position = n;
+			}
+		}
+	}
+
+	return latest;
+}
+
+uint32_t middleBootControlSlotAddress(uint8_t slot) {
+	return slot ? middleBootControlSlotAddressB : middleBootControlSlotAddressA;
+}
+
+uint8_t middleBootControlSlotOf(uint32_t image) {
+	for(uint8_t slot = 0; slot < middleBootControlSlots; slot++)
+		if(image >= middleBootControlSlotAddress(slot) && image < middleBootControlSlotAddress(slot) + middleBootControlSlotSize)
+			return slot;
+
+	return middleBootControlNoSlot;
+}
+
+// An image linked for the other slot, or no image at all, would jump into nowhere.
+bool middleBootControlVectorsValid(uint8_t slot, const uint8_t *vectors) {
+	uint32_t stack, reset;
+
+	memcpy(&stack,&vectors[0],sizeof(stack));
+	memcpy(&reset,&vectors[4],sizeof(reset));
+
+	return (stack > driverHWBootRAMStart) && (stack <= driverHWBootRAMEnd) && (reset & 1) &&
+		(middleBootControlSlotOf(reset) == slot);
+}
+
+bool middleBootControlSlotBootable(const middleBootControlRecordStruct *record, uint8_t slot) {
+	const middleBootControlImageStruct *image = &record->Image[slot];
+	const uint8_t *start = driverHWFlashRead(middleBootControlSlotAddress(slot));
+
+	if(!middleBootControlVectorsValid(slot,start) || image->Length == middleBootControlLengthInvalid || image->Length > middleBootControlSlotSize)
+		return false;
+
+	return (image->Length == middleBootControlLengthUnknown) || (middleBootControlCRC(0,start,image->Length) == image->Checksum);
+}
+
+// Without any record yet slot A boots, as the debugger put it there.
+void middleBootControlRead(middleBootControlRecordStruct *record) {
+	uint8_t page;
+	uint16_t position;
+	const middleBootControlRecordStruct *latest = middleBootControlLatest(&page,&position);
+
+	if(latest) {
+		memcpy(record,latest,sizeof(middleBootControlRecordStruct));
+	}else{
+		memset(record,0,sizeof(middleBootControlRecordStruct));
+		record->Active = 0;
+		record->Trial = BOOT_TRIAL_NONE;
+	}
+}
+
+// Appends behind the current record. When its page is full the other page is erased and continued in, the current
+// record stays readable until the new one is complete.
+bool middleBootControlWrite(middleBootControlRecordStruct *record) {
+	uint8_t page = 0;
+	uint16_t position = 0;
+	const middleBootControlRecordStruct *latest = middleBootControlLatest(&page,&position);
+	uint16_t start = latest ? (position + 1) : 0;
+
+	record->Magic = middleBootControlRecordMagic;
+	record->Sequence = latest ? (latest->Sequence + 1) : 1;
+	record->Checksum = middleBootControlCRC(0,(const uint8_t *)record,offsetof(middleBootControlRecordStruct,Checksum));
+
+	for(uint16_t n = start; n < middleBootControlRecordsPerPage; n++) {
+		const middleBootControlRecordStruct *next = middleBootControlRecordAt(page,n);
+		if(middleBootControlRecordErased(next)) {
+			driverHWFlashProgram(middleBootControlJournalAddress + page*driverHWFlashPageSize + n*sizeof(middleBootControlRecordStruct),
+				(const uint8_t *)record,sizeof(middleBootControlRecordStruct));
+			return middleBootControlRecordValid(next);
+		}
+	}
+
+	page ^= 1;
+	if(!driverHWFlashErasePage(middleBootControlJournalAddress + page*driverHWFlashPageSize))
+		return false;
+	driverHWFlashProgram(middleBootControlJournalAddress + page*driverHWFlashPageSize,(const uint8_t *)record,sizeof(middleBootControlRecordStruct));
+	return middleBootControlRecordValid(middleBootControlRecordAt(page,0));
+}
+
+// Bootloader side. A committed image gets one boot on trial, the application confirms it once in OP. Finding it
+// still on trial at the next reset means it never got there: go back to the other slot.
+uint32_t middleBootControlSelect(bool *trial) {
+	middleBootControlRecordStruct record;
+
+	middleBootControlRead(&record);
+	*trial = false;
+
+	if(record.Trial == BOOT_TRIAL_PENDING && middleBootControlSlotBootable(&record,record.Active)) {
+		record.Trial = BOOT_TRIAL_BOOTED;
+		if(middleBootControlWrite(&record)) {
+			*trial = true;
+			return middleBootControlSlotAddress(record.Active);
+		}
+	}
+
+	if(record.Trial != BOOT_TRIAL_NONE) {
+		record.Active ^= 1;
+		record.Trial = BOOT_TRIAL_NONE;
+		record.Rollbacks++;
+		middleBootControlWrite(&record);
+	}
+
+	if(middleBootControlSlotBootable(&record,record.Active))
+		return middleBootControlSlotAddress(record.Active);
+
+	if(middleBootControlSlotBootable(&record,record.Active ^ 1)) {
+		record.Active ^= 1;
+		middleBootControlWrite(&record);
+		return middleBootControlSlotAddress(record.Active);
+	}
+
+	return 0;
+}
+
+// Before a slot is overwritten, so a download cut off halfway can never be booted or rolled back to.
+bool middleBootControlInvalidate(uint8_t slot) {
+	middleBootControlRecordStruct record;
+
+	middleBootControlRead(&record);
+	if(record.Image[slot].Length == middleBootControlLengthInvalid && record.Active != slot)
+		return true;
+
+	record.Image[slot].Length = middleBootControlLengthInvalid;
+	record.Image[slot].Checksum = 0;
+	record.Image[slot].Version = 0;
+	if(record.Active == slot) {
+		record.Active ^= 1;																																// Committed but not booted yet, the running image stays
+		record.Trial = BOOT_TRIAL_NONE;
+	}
+
+	return middleBootControlWrite(&record);
+}
+
+bool middleBootControlCommit(uint8_t slot, const middleBootControlImageStruct *image) {
+	middleBootControlRecordStruct record;
+
+	middleBootControlRead(&record);
+	record.Image[slot] = *image;
+	record.Active = slot;
+	record.Trial = BOOT_TRIAL_PENDING;
+
+	return middleBootControlWrite(&record);
+}
+
+bool middleBootControlConfirm(uint8_t slot) {
+	middleBootControlRecordStruct record;
+
+	middleBootControlRead(&record);
+	if(record.Trial == BOOT_TRIAL_NONE || record.Active != slot)
+		return true;
+
+	record.Trial = BOOT_TRIAL_NONE;
+	return middleBootControlWrite(&record);
+}
+
+uint32_t middleBootControlCRC(uint32_t crc, const uint8_t *data, uint32_t length) {
+	crc = ~crc;
+	while(length--) {
+		crc ^= *data++;
+		crc = (crc >> 4) ^ middleBootControlCRCTable[crc & 0x0F];															// Nibble table, 64 bytes of flash instead of 1kB
+		crc = (crc >> 4) ^ middleBootControlCRCTable[crc & 0x0F];
+	}
+
+	return ~crc;
+}
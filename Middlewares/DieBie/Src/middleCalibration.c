@@ -0,0 +1,348 @@
+#include "middleCalibration.h"
+#include <string.h>
+#include <stdlib.h>
+
+typedef struct {
+	uint64_t ID;																																				// Whole ID, the key is folded
+	driverSWNunChuckCalibrationDataStruct Calibration;
+} middleCalibrationRecordStruct;
+
+middleCalibrationStatusStruct middleCalibrationStatus;
+middleCalibrationTrackingStruct middleCalibrationTracking = {1};																	// Not reset by the re-inits
+static driverSWNunChuckCalibrationDataStruct middleCalibrationFactory;							// As read, plausible or not
+static driverSWNunChuckCalibrationDataStruct middleCalibrationBase;								// Selected, saved or forgotten
+static driverSWNunChuckCalibrationDataStruct middleCalibrationActive;							// Base and the learned values, handed to the sensor task
+static bool middleCalibrationSelected = false;																				// A nunchuck was read since start-up
+static bool middleCalibrationChanged = false;
+static uint8_t middleCalibrationCapture;																							// Control being captured
+static uint8_t middleCalibrationCount;
+static uint32_t middleCalibrationSum[5];																							// Joystick X and Y, accelerometer X, Y and Z
+static uint8_t middleCalibrationRange[4];																							// Joystick X min and max, Y min and max
+static uint8_t middleCalibrationWindow;
+static uint32_t middleCalibrationWindowSum[5];																				// Same order as the capture sums
+static uint32_t middleCalibrationWindowSquares[5];
+static int32_t middleCalibrationBias[3];																							// Learned 0g bias in 1/16 counts
+
+// Nominal calibration of the part, taken when neither the stored nor the factory one would map
+const driverSWNunChuckCalibrationDataStruct middleCalibrationNominal = {512,512,512,716,716,716,0xE0,0x20,0x80,0xE0,0x20,0x80};
+
+static uint32_t middleCalibrationRecordKey(uint64_t ID) {
+	return middleCalibrationKey | ((uint32_t)(ID ^ (ID >> 24)) & middleCalibrationKeyMask);
+}
+
+// Base with the learned values on top, as the sensor task maps with it.
+static void middleCalibrationApply(void) {
+	middleCalibrationActive = middleCalibrationBase;
+	middleCalibrationActive.joystickXCenter += middleCalibrationTracking.JoystickXCenter;
+	middleCalibrationActive.joystickYCenter += middleCalibrationTracking.JoystickYCenter;
+	middleCalibrationActive.accelero0GX += middleCalibrationTracking.AcceleroMeterX;
+	middleCalibrationActive.accelero1GX += middleCalibrationTracking.AcceleroMeterX;
+	middleCalibrationActive.accelero0GY += middleCalibrationTracking.AcceleroMeterY;
+	middleCalibrationActive.accelero1GY += middleCalibrationTracking.AcceleroMeterY;
+	middleCalibrationActive.accelero0GZ += middleCalibrationTracking.AcceleroMeterZ;
+	middleCalibrationActive.accelero1GZ += middleCalibrationTracking.AcceleroMeterZ;
+	middleCalibrationChanged = true;
+}
+
+static void middleCalibrationForgetLearned(void) {
+	memset(middleCalibrationBias,0,sizeof(middleCalibrationBias));
+	middleCalibrationTracking.JoystickXCenter = 0;
+	middleCalibrationTracking.JoystickYCenter = 0;
+	middleCalibrationTracking.AcceleroMeterX = 0;
+	middleCalibrationTracking.AcceleroMeterY = 0;
+	middleCalibrationTracking.AcceleroMeterZ = 0;
+	middleCalibrationWindow = 0;
+}
+
+// A new calibration was captured for what the nunchuck does now, what was learned on the old one no longer applies.
+static void middleCalibrationUse(const driverSWNunChuckCalibrationDataStruct *calibration, uint8_t source) {
+	middleCalibrationBase = *calibration;
+	middleCalibrationStatus.Values = *calibration;
+	middleCalibrationStatus.Source = source;
+	middleCalibrationForgetLearned();
+	middleCalibrationApply();
+}
+
+void middleCalibrationInit(void) {
+	memset(&middleCalibrationStatus,0,sizeof(middleCalibrationStatus));
+	middleCalibrationStatus.Source = CALIBRATION_SOURCE_NOMINAL;
+	middleCalibrationStatus.Values = middleCalibrationNominal;
+	middleCalibrationSelected = false;
+	middleCalibrationChanged = false;
+	middleCalibrationTracking.Still = false;
+	middleCalibrationTracking.Updates = 0;
+	middleCalibrationForgetLearned();
+}
+
+// Called with the factory calibration as soon as a nunchuck answered, replaces it with the one to map with.
+uint8_t middleCalibrationSelect(uint64_t ID, driverSWNunChuckCalibrationDataStruct *calibration) {
+	middleCalibrationRecordStruct record;
+
+	middleCalibrationFactory = *calibration;
+	if(middleParameterRead(middleCalibrationRecordKey(ID),&record,sizeof(record)) && record.ID == ID && middleCalibrationPlausible(&record.Calibration)) {
+		*calibration = record.Calibration;
+		middleCalibrationStatus.Source = CALIBRATION_SOURCE_USER;
+	}else if(middleCalibrationPlausible(calibration)) {
+		middleCalibrationStatus.Source = CALIBRATION_SOURCE_FACTORY;
+	}else{
+		*calibration = middleCalibrationNominal;
+		middleCalibrationStatus.Source = CALIBRATION_SOURCE_NOMINAL;
+	}
+
+	// The same nunchuck back keeps what was captured, written or learned for it so far
+	if(!middleCalibrationSelected || ID != middleCalibrationStatus.ID) {
+		middleCalibrationStatus.Values = *calibration;
+		if(middleCalibrationStatus.State == CALIBRATION_CAPTURING || middleCalibrationStatus.State == CALIBRATION_RANGE)
+			middleCalibrationStatus.State = CALIBRATION_IDLE;
+		middleCalibrationForgetLearned();
+	}
+	middleCalibrationStatus.ID = ID;
+	middleCalibrationSelected = true;
+	middleCalibrationWindow = 0;
+
+	middleCalibrationBase = *calibration;
+	middleCalibrationApply();
+	*calibration = middleCalibrationActive;
+	middleCalibrationChanged = false;
+
+	return middleCalibrationStatus.Source;
+}
+
+static void middleCalibrationCaptured(void) {
+	uint16_t average[5];
+
+	for(uint8_t n = 0; n < 5; n++)
+		average[n] = (middleCalibrationSum[n] + middleCalibrationSamples/2)/middleCalibrationSamples;
+
+	switch(middleCalibrationCapture) {
+		case CALIBRATION_CONTROL_FLAT:
+			middleCalibrationStatus.Values.joystickXCenter = average[0];
+			middleCalibrationStatus.Values.joystickYCenter = average[1];
+			middleCalibrationStatus.Values.accelero0GX = average[2];
+			middleCalibrationStatus.Values.accelero0GY = average[3];
+			middleCalibrationStatus.Values.accelero1GZ = average[4];
+			break;
+		case CALIBRATION_CONTROL_SIDE:
+			middleCalibrationStatus.Values.accelero1GX = average[2];
+			middleCalibrationStatus.Values.accelero0GZ = average[4];
+			break;
+		case CALIBRATION_CONTROL_NOSE:
+			middleCalibrationStatus.Values.accelero1GY = average[3];
+			break;
+		default:
+			break;
+	}
+
+	middleCalibrationStatus.State = CALIBRATION_DONE;
+}
+
+static int8_t middleCalibrationStep(int32_t mean, int32_t centre) {
+	return (mean > centre) - (mean < centre);
+}
+
+static int32_t middleCalibrationLimit(int32_t value, int32_t limit) {
+	return (value > limit) ? limit : ((value < -limit) ? -limit : value);
+}
+
+// End of a window. When it was still, a released stick moves the learned centres a count towards where it rests and
+// the bias takes a quarter of the gradient of (|a|^2 - 1g^2): half the error along gravity per window. Computed in
+// Q14 of g, the bias kept in 1/16 counts.
+static void middleCalibrationLearn(void) {
+	middleCalibrationTrackingStruct learned, previous;
+	const driverSWNunChuckCalibrationDataStruct *base = &middleCalibrationBase;
+	const uint16_t zero[3] = {base->accelero0GX, base->accelero0GY, base->accelero0GZ};
+	const uint16_t one[3] = {base->accelero1GX, base->accelero1GY, base->accelero1GZ};
+	int16_t *bias[3] = {&learned.AcceleroMeterX, &learned.AcceleroMeterY, &learned.AcceleroMeterZ};
+	int64_t d[3], magnitude = 0, error;
+	int32_t mean[5];
+
+	middleCalibrationTracking.Still = true;
+	for(uint8_t n = 0; n < 5; n++) {
+		mean[n] = (middleCalibrationWindowSum[n] + middleCalibrationTrackingWindow/2)/middleCalibrationTrackingWindow;
+		if((middleCalibrationWindowSquares[n] - middleCalibrationWindowSum[n]*middleCalibrationWindowSum[n]/middleCalibrationTrackingWindow)/
+			middleCalibrationTrackingWindow > middleCalibrationTrackingVariance)
+			middleCalibrationTracking.Still = false;
+	}
+	if(!middleCalibrationTracking.Still)
+		return;
+	learned = previous = middleCalibrationTracking;
+
+	if(abs(mean[0] - middleCalibrationActive.joystickXCenter) <= middleCalibrationTrackingStickBand &&
+		abs(mean[1] - middleCalibrationActive.joystickYCenter) <= middleCalibrationTrackingStickBand) {
+		learned.JoystickXCenter = middleCalibrationLimit(learned.JoystickXCenter + middleCalibrationStep(mean[0],middleCalibrationActive.joystickXCenter),middleCalibrationTrackingStickBand);
+		learned.JoystickYCenter = middleCalibrationLimit(learned.JoystickYCenter + middleCalibrationStep(mean[1],middleCalibrationActive.joystickYCenter),middleCalibrationTrackingStickBand);
+	}
+
+	for(uint8_t axis = 0; axis < 3; axis++) {
+		d[axis] = ((int64_t)(middleCalibrationWindowSum[2 + axis] << 4)/middleCalibrationTrackingWindow - (zero[axis] << 4) - middleCalibrationBias[axis])*1024/(one[axis] - zero[axis]);
+		magnitude += d[axis]*d[axis];
+	}
+	error = magnitude - (1LL << 28);
+	if(error < middleCalibrationTrackingGravity && error > -middleCalibrationTrackingGravity) {
+		for(uint8_t axis = 0; axis < 3; axis++) {
+			middleCalibrationBias[axis] = middleCalibrationLimit(middleCalibrationBias[axis] + error*d[axis]*(one[axis] - zero[axis])/(1LL << 40),middleCalibrationTrackingBiasLimit << 4);
+			*bias[axis] = (middleCalibrationBias[axis] + ((middleCalibrationBias[axis] < 0) ? -8 : 8))/16;
+		}
+	}
+
+	if(memcmp(&learned,&middleCalibrationTracking,sizeof(learned))) {
+		middleCalibrationTracking = learned;
+		middleCalibrationApply();
+		if(middleCalibrationPlausible(&middleCalibrationActive)) {
+			middleCalibrationTracking.Updates++;
+		}else{
+			middleCalibrationTracking = previous;																				// A stick centre up against its limit
+			middleCalibrationApply();
+		}
+	}
+}
+
+static void middleCalibrationTrack(const driverSWNunChuckSensorDataStruct *sample) {
+	const uint16_t values[5] = {sample->joystickX, sample->joystickY, sample->accelerometerX, sample->accelerometerY, sample->accelerometerZ};
+
+	if(!middleCalibrationWindow) {
+		memset(middleCalibrationWindowSum,0,sizeof(middleCalibrationWindowSum));
+		memset(middleCalibrationWindowSquares,0,sizeof(middleCalibrationWindowSquares));
+	}
+	for(uint8_t n = 0; n < 5; n++) {
+		middleCalibrationWindowSum[n] += values[n];
+		middleCalibrationWindowSquares[n] += (uint32_t)values[n]*values[n];
+	}
+	if(++middleCalibrationWindow >= middleCalibrationTrackingWindow) {
+		middleCalibrationWindow = 0;
+		middleCalibrationLearn();
+	}
+}
+
+// Every valid sample of the sensor task. True when calibration was replaced, by a saved or forgotten one or with newly
+// learned values; the sensor task maps the sample after this, never with half of an update.
+bool middleCalibrationSample(const driverSWNunChuckSensorDataStruct *sample, driverSWNunChuckCalibrationDataStruct *calibration) {
+	bool changed;
+
+	if(!middleCalibrationTracking.Enable && memcmp(&middleCalibrationActive,&middleCalibrationBase,sizeof(middleCalibrationBase))) {
+		middleCalibrationForgetLearned();
+		middleCalibrationApply();
+	}
+
+	if(middleCalibrationStatus.State == CALIBRATION_CAPTURING) {
+		middleCalibrationSum[0] += sample->joystickX;
+		middleCalibrationSum[1] += sample->joystickY;
+		middleCalibrationSum[2] += sample->accelerometerX;
+		middleCalibrationSum[3] += sample->accelerometerY;
+		middleCalibrationSum[4] += sample->accelerometerZ;
+		if(++middleCalibrationCount >= middleCalibrationSamples)
+			middleCalibrationCaptured();
+	}else if(middleCalibrationStatus.State == CALIBRATION_RANGE) {
+		if(sample->joystickX < middleCalibrationRange[0])
+			middleCalibrationRange[0] = sample->joystickX;
+		if(sample->joystickX > middleCalibrationRange[1])
+			middleCalibrationRange[1] = sample->joystickX;
+		if(sample->joystickY < middleCalibrationRange[2])
+			middleCalibrationRange[2] = sample->joystickY;
+		if(sample->joystickY > middleCalibrationRange[3])
+			middleCalibrationRange[3] = sample->joystickY;
+	}else if(middleCalibrationTracking.Enable) {
+		middleCalibrationTrack(sample);
+	}
+
+	changed = middleCalibrationChanged;
+	if(changed) {
+		*calibration = middleCalibrationActive;
+		middleCalibrationChanged = false;
+	}
+
+	return changed;
+}
+
+static bool middleCalibrationSave(void) {
+	middleCalibrationRecordStruct record;
+
+	memset(&record,0,sizeof(record));																								// Padding too, an unchanged save writes nothing
+	record.ID = middleCalibrationStatus.ID;
+	record.Calibration = middleCalibrationStatus.Values;
+	if(!middleCalibrationSelected || !middleCalibrationPlausible(&record.Calibration) ||
+		!middleParameterWrite(middleCalibrationRecordKey(record.ID),&record,sizeof(record)))
+		return false;
+
+	middleCalibrationUse(&record.Calibration,CALIBRATION_SOURCE_USER);
+	return true;
+}
+
+static bool middleCalibrationForget(void) {
+	middleCalibrationRecordStruct record;
+	uint32_t key = middleCalibrationRecordKey(middleCalibrationStatus.ID);
+
+	if(!middleCalibrationSelected)
+		return false;
+
+	// An empty record, only over one of this nunchuck
+	if(middleParameterRead(key,&record,sizeof(record)) && record.ID == middleCalibrationStatus.ID && !middleParameterWrite(key,&record,0))
+		return false;
+
+	if(middleCalibrationPlausible(&middleCalibrationFactory))
+		middleCalibrationUse(&middleCalibrationFactory,CALIBRATION_SOURCE_FACTORY);
+	else
+		middleCalibrationUse(&middleCalibrationNominal,CALIBRATION_SOURCE_NOMINAL);
+	return true;
+}
+
+// 0x8001:01 written. Any control ends a joystick recording, its limits are taken when the stick moved both ways.
+void middleCalibrationControl(void) {
+	bool recorded = (middleCalibrationStatus.State == CALIBRATION_RANGE);
+
+	if(recorded) {
+		if(middleCalibrationRange[0] < middleCalibrationRange[1]) {
+			middleCalibrationStatus.Values.joystickXMin = middleCalibrationRange[0];
+			middleCalibrationStatus.Values.joystickXMax = middleCalibrationRange[1];
+		}
+		if(middleCalibrationRange[2] < middleCalibrationRange[3]) {
+			middleCalibrationStatus.Values.joystickYMin = middleCalibrationRange[2];
+			middleCalibrationStatus.Values.joystickYMax = middleCalibrationRange[3];
+		}
+		middleCalibrationStatus.State = CALIBRATION_DONE;
+	}
+
+	switch(middleCalibrationStatus.Control) {
+		case CALIBRATION_CONTROL_FLAT:
+		case CALIBRATION_CONTROL_SIDE:
+		case CALIBRATION_CONTROL_NOSE:
+			memset(middleCalibrationSum,0,sizeof(middleCalibrationSum));
+			middleCalibrationCount = 0;
+			middleCalibrationCapture = middleCalibrationStatus.Control;
+			middleCalibrationStatus.State = middleCalibrationSelected ? CALIBRATION_CAPTURING : CALIBRATION_FAILED;
+			break;
+		case CALIBRATION_CONTROL_RANGE:
+			middleCalibrationRange[0] = middleCalibrationRange[2] = UINT8_MAX;
+			middleCalibrationRange[1] = middleCalibrationRange[3] = 0;
+			middleCalibrationStatus.State = middleCalibrationSelected ? CALIBRATION_RANGE : CALIBRATION_FAILED;
+			break;
+		case CALIBRATION_CONTROL_SAVE:
+			middleCalibrationStatus.State = middleCalibrationSave() ? CALIBRATION_DONE : CALIBRATION_FAILED;
+			break;
+		case CALIBRATION_CONTROL_FORGET:
+			middleCalibrationStatus.State = middleCalibrationForget() ? CALIBRATION_DONE : CALIBRATION_FAILED;
+			break;
+		default:
+			if(middleCalibrationStatus.State == CALIBRATION_CAPTURING)
+				middleCalibrationStatus.State = CALIBRATION_IDLE;																// Aborted
+			break;
+	}
+
+	middleCalibrationStatus.Control = CALIBRATION_CONTROL_NONE;
+}
+
+// 1g above 0g on every axis and the joystick center between its limits, otherwise the mapping divides by zero
+bool middleCalibrationPlausible(const driverSWNunChuckCalibrationDataStruct *calibration) {
+	return (calibration->accelero1GX > calibration->accelero0GX) && (calibration->accelero1GY > calibration->accelero0GY) &&
+		(calibration->accelero1GZ > calibration->accelero0GZ) &&
+		(calibration->joystickXMin < calibration->joystickXCenter) && (calibration->joystickXCenter < calibration->joystickXMax) &&
+		(calibration->joystickYMin < calibration->joystickYCenter) && (calibration->joystickYCenter < calibration->joystickYMax);
+}
+
+const middleCalibrationStatusStruct *middleCalibrationGetStatus(void) {
+	return &middleCalibrationStatus;
+}
+
+const middleCalibrationTrackingStruct *middleCalibrationGetTracking(void) {
+	return &middleCalibrationTracking;
+}
@@ -0,0 +1,316 @@
+#include "middleCapture.h"
+#include "modDelay.h"
+#include <string.h>
+
+#define middleCaptureKeyframeSize							9
+#define middleCaptureRecordMax								20																// Mask, period and every field at its widest
+
+typedef struct {
+	int8_t JoyStickX;
+	int8_t JoyStickY;
+	int16_t AcceleroMeter[3];
+	uint8_t Flags;
+} middleCaptureSampleStruct;
+
+// Nothing on the target uses the CCM RAM, and nothing here needs DMA
+#if defined(__ARMCC_VERSION) && (__ARMCC_VERSION < 6000000)
+static uint8_t middleCaptureRing[middleCaptureBlocks][middleCaptureBlockSize] __attribute__((at(middleCaptureRAMAddress), zero_init));
+#else
+static uint8_t middleCaptureRing[middleCaptureBlocks][middleCaptureBlockSize];
+#endif
+
+middleCaptureStatusStruct middleCaptureStatus;
+middleCaptureBlockHeaderStruct middleCaptureBlock;																		// Block being filled, copied into the ring as it grows
+middleCaptureSampleStruct middleCaptureLast;
+uint32_t middleCaptureLastTime;
+uint32_t middleCaptureLastPeriod;
+uint8_t middleCaptureHead;																														// Block being filled
+uint8_t middleCaptureCount;																														// Blocks in use, the head included
+uint8_t middleCaptureTriggerBlock;
+uint32_t middleCaptureSequence;																												// Samples seen since start-up
+uint32_t middleCaptureFirstSequence;																									// Of the oldest sample in the ring
+uint32_t middleCaptureTriggerSequence;
+uint32_t middleCaptureTriggerTime;
+uint32_t middleCaptureFirstTime;
+uint8_t middleCapturePreviousFlags;
+bool middleCaptureExternalLevel;
+bool middleCapturePending;																														// Trigger to apply with the next sample
+
+static uint8_t *middleCaptureVarint(uint8_t *out, uint32_t value) {
+	while(value >= 0x80) {
+		*out++ = (uint8_t)value | 0x80;
+		value >>= 7;
+	}
+	*out++ = (uint8_t)value;
+
+	return out;
+}
+
+static uint8_t *middleCaptureZigZag(uint8_t *out, int32_t value) {
+	return middleCaptureVarint(out,((uint32_t)value << 1) ^ (uint32_t)(value >> 31));
+}
+
+static void middleCaptureReset(void) {
+	middleCaptureHead = 0;
+	middleCaptureCount = 0;
+	middleCaptureBlock.Length = 0;
+	middleCaptureFirstSequence = middleCaptureSequence;
+	middleCaptureLastPeriod = 0;
+	middleCapturePending = false;
+	middleCaptureStatus.TriggerSource = 0;
+	middleCaptureStatus.Samples = 0;
+	middleCaptureStatus.Bytes = 0;
+	middleCaptureStatus.Duration = 0;
+	middleCaptureStatus.BlocksDropped = 0;
+}
+
+static void middleCaptureFire(uint8_t source) {
+	if(middleCaptureStatus.State == CAPTURE_ARMED && !middleCapturePending) {
+		middleCaptureStatus.TriggerSource = source;
+		middleCapturePending = true;
+	}
+}
+
+static void middleCaptureFinish(void) {
+	middleCaptureStatus.State = CAPTURE_DONE;
+	middleCaptureStatus.Bytes = sizeof(middleCaptureHeaderStruct) + middleCaptureCount*middleCaptureBlockSize;
+}
+
+static void middleCaptureTriggers(const middleCaptureSampleStruct *sample) {
+	uint8_t pressed = sample->Flags & ~middleCapturePreviousFlags;
+	uint8_t triggers = middleCaptureStatus.Triggers;
+	uint8_t chord = middleCaptureFlagButtonC | middleCaptureFlagButtonZ;
+
+	middleCapturePreviousFlags = sample->Flags;
+	if(!(sample->Flags & middleCaptureFlagDataValid))
+		return;
+
+	if((triggers & middleCaptureTriggerButtonC) && (pressed & middleCaptureFlagButtonC))
+		middleCaptureFire(middleCaptureTriggerButtonC);
+	if((triggers & middleCaptureTriggerButtonZ) && (pressed & middleCaptureFlagButtonZ))
+		middleCaptureFire(middleCaptureTriggerButtonZ);
+	if((triggers & middleCaptureTriggerGesture) && (pressed & chord) && ((sample->Flags & chord) == chord))
+		middleCaptureFire(middleCaptureTriggerGesture);
+
+	if(triggers & middleCaptureTriggerThreshold) {
+		for(uint8_t axis = 0; axis < 3; axis++) {
+			int32_t value = sample->AcceleroMeter[axis];
+			if(value > middleCaptureStatus.Threshold || -value > middleCaptureStatus.Threshold)
+				middleCaptureFire(middleCaptureTriggerThreshold);
+		}
+	}
+}
+
+// Starts the next block with the sample as its keyframe. A full ring drops its oldest block, unless that one holds
+// the trigger: then the capture is as long as it gets.
+static bool middleCaptureOpenBlock(const middleCaptureSampleStruct *sample, uint32_t time) {
+	uint8_t *block;
+
+	if(middleCaptureCount) {
+		uint8_t next = (middleCaptureHead + 1) % middleCaptureBlocks;
+		if(middleCaptureCount == middleCaptureBlocks) {
+			if(middleCaptureStatus.State == CAPTURE_TRIGGERED && next == middleCaptureTriggerBlock)
+				return false;
+
+			const middleCaptureBlockHeaderStruct *oldest = (const middleCaptureBlockHeaderStruct *)middleCaptureRing[next];
+			middleCaptureFirstSequence += oldest->Samples;
+			middleCaptureStatus.Samples -= oldest->Samples;
+			middleCaptureStatus.BlocksDropped++;
+			middleCaptureCount--;
+			memcpy(&middleCaptureFirstTime,middleCaptureRing[(next + 1) % middleCaptureBlocks],sizeof(middleCaptureFirstTime));
+		}
+		middleCaptureHead = next;
+	}
+	middleCaptureCount++;
+
+	block = middleCaptureRing[middleCaptureHead];
+	block[sizeof(middleCaptureBlockHeaderStruct) + 0] = (uint8_t)sample->JoyStickX;
+	block[sizeof(middleCaptureBlockHeaderStruct) + 1] = (uint8_t)sample->JoyStickY;
+	memcpy(&block[sizeof(middleCaptureBlockHeaderStruct) + 2],sample->AcceleroMeter,sizeof(sample->AcceleroMeter));
+	block[sizeof(middleCaptureBlockHeaderStruct) + 8] = sample->Flags;
+
+	middleCaptureBlock.Time = time;
+	middleCaptureBlock.Period = middleCaptureLastPeriod;
+	middleCaptureBlock.Samples = 1;
+	middleCaptureBlock.Length = sizeof(middleCaptureBlockHeaderStruct) + middleCaptureKeyframeSize;
+	memcpy(block,&middleCaptureBlock,sizeof(middleCaptureBlock));
+
+	return true;
+}
+
+static bool middleCaptureAppend(const middleCaptureSampleStruct *sample, uint32_t time) {
+	uint8_t record[middleCaptureRecordMax];
+	uint8_t *end = &record[1];
+	uint32_t period = time - middleCaptureLastTime;
+
+	if(!middleCaptureCount || !middleCaptureBlock.Length) {
+		middleCaptureFirstTime = time;
+		middleCaptureFirstSequence = middleCaptureSequence;
+		middleCaptureLastPeriod = 0;
+		return middleCaptureOpenBlock(sample,time);
+	}
+
+	record[0] = 0;
+	if(period != middleCaptureLastPeriod) {
+		record[0] |= middleCaptureDeltaPeriod;
+		end = middleCaptureZigZag(end,(int32_t)(period - middleCaptureLastPeriod));
+	}
+	if(sample->JoyStickX != middleCaptureLast.JoyStickX) {
+		record[0] |= middleCaptureDeltaJoyStickX;
+		end = middleCaptureZigZag(end,sample->JoyStickX - middleCaptureLast.JoyStickX);
+	}
+	if(sample->JoyStickY != middleCaptureLast.JoyStickY) {
+		record[0] |= middleCaptureDeltaJoyStickY;
+		end = middleCaptureZigZag(end,sample->JoyStickY - middleCaptureLast.JoyStickY);
+	}
+	for(uint8_t axis = 0; axis < 3; axis++) {
+		if(sample->AcceleroMeter[axis] != middleCaptureLast.AcceleroMeter[axis]) {
+			record[0] |= middleCaptureDeltaAcceleroMeterX << axis;
+			end = middleCaptureZigZag(end,sample->AcceleroMeter[axis] - middleCaptureLast.AcceleroMeter[axis]);
+		}
+	}
+	if(sample->Flags != middleCaptureLast.Flags) {
+		record[0] |= middleCaptureDeltaFlags;
+		*end++ = sample->Flags;
+	}
+
+	middleCaptureLastPeriod = period;
+	uint16_t length = end - record;
+	if(middleCaptureBlock.Length + length > middleCaptureBlockSize)
+		return middleCaptureOpenBlock(sample,time);
+
+	memcpy(&middleCaptureRing[middleCaptureHead][middleCaptureBlock.Length],record,length);
+	middleCaptureBlock.Length += length;
+	middleCaptureBlock.Samples++;
+	memcpy(middleCaptureRing[middleCaptureHead],&middleCaptureBlock,sizeof(middleCaptureBlock));
+
+	return true;
+}
+
+void middleCaptureInit(void) {
+	middleCaptureSequence = 0;
+	middleCaptureExternalLevel = false;
+	middleCapturePreviousFlags = 0;
+	middleCaptureStatus.Control = CAPTURE_CONTROL_NONE;
+	middleCaptureStatus.Triggers = middleCaptureDefaultTriggers;
+	middleCaptureStatus.Threshold = middleCaptureDefaultThreshold;
+	middleCaptureStatus.PostTrigger = middleCaptureDefaultPostTrigger;
+	middleCaptureReset();
+	middleCaptureStatus.State = CAPTURE_ARMED;																						// A gesture works without a master
+}
+
+// Every sensor sample, from the nunchuck data event.
+void middleCaptureSample(const middleNunChuckDataStruct *data) {
+	middleCaptureSampleStruct sample;
+	uint32_t time = modDelayGetMicroseconds();
+
+	sample.JoyStickX = data->joystickX;
+	sample.JoyStickY = data->joystickY;
+	sample.AcceleroMeter[0] = data->accelerometerX;
+	sample.AcceleroMeter[1] = data->accelerometerY;
+	sample.AcceleroMeter[2] = data->accelerometerZ;
+	sample.Flags = (data->buttonC ? middleCaptureFlagButtonC : 0) | (data->buttonZ ? middleCaptureFlagButtonZ : 0) |
+		(data->dataValid ? middleCaptureFlagDataValid : 0);
+
+	if(middleCaptureStatus.State == CAPTURE_ARMED)
+		middleCaptureTriggers(&sample);
+
+	if(middleCaptureStatus.State == CAPTURE_ARMED || middleCaptureStatus.State == CAPTURE_TRIGGERED) {
+		if(middleCaptureStatus.State == CAPTURE_TRIGGERED && (time - middleCaptureTriggerTime) >= middleCaptureStatus.PostTrigger*modDelayMicrosecondsPerMillisecond) {
+			middleCaptureFinish();
+		}else if(!middleCaptureAppend(&sample,time)) {
+			middleCaptureFinish();																														// Ring full back to the trigger
+		}else{
+			memcpy(&middleCaptureLast,&sample,sizeof(sample));
+			middleCaptureLastTime = time;
+			middleCaptureStatus.Samples++;
+			middleCaptureStatus.Duration = time - middleCaptureFirstTime;
+			if(middleCapturePending) {
+				middleCapturePending = false;
+				middleCaptureTriggerBlock = middleCaptureHead;
+				middleCaptureTriggerSequence = middleCaptureSequence;
+				middleCaptureTriggerTime = time;
+				middleCaptureStatus.State = CAPTURE_TRIGGERED;
+			}
+		}
+	}
+
+	middleCaptureSequence++;
+}
+
+// The CaptureTrigger output bit, fires on its rising edge.
+void middleCaptureExternalTrigger(bool level) {
+	if(level && !middleCaptureExternalLevel && (middleCaptureStatus.Triggers & middleCaptureTriggerRxPDO))
+		middleCaptureFire(middleCaptureTriggerRxPDO);
+	middleCaptureExternalLevel = level;
+}
+
+// Control was written over CoE.
+void middleCaptureControl(void) {
+	switch(middleCaptureStatus.Control) {
+		case CAPTURE_CONTROL_ARM:
+			middleCaptureReset();
+			middleCaptureStatus.State = CAPTURE_ARMED;
+			break;
+		case CAPTURE_CONTROL_TRIGGER:
+			middleCaptureFire(middleCaptureTriggerCommand);
+			break;
+		case CAPTURE_CONTROL_STOP:
+			if(middleCaptureStatus.State == CAPTURE_ARMED || middleCaptureStatus.State == CAPTURE_TRIGGERED)
+				middleCaptureFinish();																														// Keep what is there, it can still be read
+			break;
+		default:
+			break;
+	}
+
+	middleCaptureStatus.Control = CAPTURE_CONTROL_NONE;
+}
+
+// FoE read hook, copies from the ring straight into the outgoing mailbox. Until a capture is done the file is empty,
+// after that it stays as it is until the next arm.
+uint32_t middleCaptureFoERead(foe_writefile_cfg_t *self, uint32_t offset, uint8_t *data, uint32_t length) {
+	uint32_t copied = 0;
+
+	if(middleCaptureStatus.State != CAPTURE_DONE)
+		return 0;
+
+	if(offset < sizeof(middleCaptureHeaderStruct)) {
+		middleCaptureHeaderStruct header;
+		uint32_t chunk = sizeof(header) - offset;
+
+		header.Magic = middleCaptureMagic;
+		header.Format = middleCaptureFormat;
+		header.BlockSize = middleCaptureBlockSize;
+		header.Blocks = middleCaptureCount;
+		header.TriggerSource = middleCaptureStatus.TriggerSource;
+		header.Reserved = 0;
+		header.Samples = middleCaptureStatus.Samples;
+		header.FirstSequence = middleCaptureFirstSequence;
+		header.TriggerSample = middleCaptureStatus.TriggerSource ? (middleCaptureTriggerSequence - middleCaptureFirstSequence) : middleCaptureStatus.Samples;
+		header.TriggerTime = middleCaptureStatus.TriggerSource ? middleCaptureTriggerTime : middleCaptureLastTime;
+		header.Period = middleCaptureLastPeriod;
+
+		if(chunk > length)
+			chunk = length;
+		memcpy(data,(const uint8_t *)&header + offset,chunk);
+		copied = chunk;
+	}
+
+	while(copied < length && offset + copied < middleCaptureStatus.Bytes) {
+		uint32_t position = offset + copied - sizeof(middleCaptureHeaderStruct);
+		uint8_t oldest = (middleCaptureHead + middleCaptureBlocks + 1 - middleCaptureCount) % middleCaptureBlocks;
+		uint8_t block = (oldest + position/middleCaptureBlockSize) % middleCaptureBlocks;
+		uint32_t chunk = middleCaptureBlockSize - (position % middleCaptureBlockSize);
+
+		if(chunk > length - copied)
+			chunk = length - copied;
+		memcpy(&data[copied],&middleCaptureRing[block][position % middleCaptureBlockSize],chunk);
+		copied += chunk;
+	}
+
+	return copied;
+}
+
+const middleCaptureStatusStruct *middleCaptureGetStatus(void) {
+	return &middleCaptureStatus;
+}
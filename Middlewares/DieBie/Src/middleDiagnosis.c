@@ -0,0 +1,140 @@
+#include "middleDiagnosis.h"
+#include <string.h>
+
+middleDiagnosisStatusStruct middleDiagnosisStatus;
+uint8_t middleDiagnosisMessageBuffer[middleDiagnosisMessages][middleDiagnosisMessageSize];
+uint8_t middleDiagnosisNext;																													// Slot the next message goes to
+uint8_t middleDiagnosisCount;																													// Slots holding a message
+uint8_t middleDiagnosisUnread;																												// Newest messages not acknowledged yet
+uint8_t middleDiagnosisAcknowledged;																									// Last valid NewestAcknowledgedMessage
+bool middleDiagnosisMessageLost;
+
+// Messages are little endian like the rest of the object dictionary, whatever the CPU
+static uint8_t *middleDiagnosisPut(uint8_t *out, uint32_t value, uint8_t bytes) {
+	while(bytes--) {
+		*out++ = (uint8_t)value;
+		value >>= 8;
+	}
+
+	return out;
+}
+
+static void middleDiagnosisClear(void) {
+	memset(middleDiagnosisMessageBuffer,0,sizeof(middleDiagnosisMessageBuffer));
+	middleDiagnosisNext = 0;
+	middleDiagnosisCount = 0;
+	middleDiagnosisUnread = 0;
+	middleDiagnosisAcknowledged = 0;
+	middleDiagnosisMessageLost = false;
+	middleDiagnosisStatus.NewestMessage = 0;
+	middleDiagnosisStatus.NewestAcknowledgedMessage = 0;
+	middleDiagnosisStatus.NewMessagesAvailable = false;
+	middleDiagnosisStatus.Flags &= ~middleDiagnosisFlagMessageLost;
+}
+
+static void middleDiagnosisStore(uint32_t diagCode, uint16_t type, uint8_t parameters, const uint32_t *values) {
+	uint8_t timeStamp[8] = {0};
+	uint8_t *message;
+
+	if(middleDiagnosisStatus.Flags & (middleDiagnosisFlagDisableInfo << type))
+		return;
+
+	middleDiagnosisStatus.Stored++;
+
+	// The oldest message has not been acknowledged yet
+	if(middleDiagnosisUnread == middleDiagnosisMessages) {
+		middleDiagnosisStatus.Lost++;
+		middleDiagnosisMessageLost = true;
+		middleDiagnosisStatus.Flags |= middleDiagnosisFlagMessageLost;
+		if(middleDiagnosisStatus.Flags & middleDiagnosisFlagAcknowledgeMode)
+			return;
+	}
+
+	// ESC system time, the DC time in ns once the master has synchronised the clocks
+	ESC_read(ESCREG_LOCALTIME,timeStamp,sizeof(timeStamp));
+
+	message = middleDiagnosisMessageBuffer[middleDiagnosisNext];
+	memset(message,0,middleDiagnosisMessageSize);
+	message = middleDiagnosisPut(message,diagCode,4);
+	message = middleDiagnosisPut(message,type | ((uint16_t)parameters << 8),2);
+	message = middleDiagnosisPut(message,0,2);																					// No text ID, the DiagCode says it all
+	memcpy(message,timeStamp,sizeof(timeStamp));
+	message += sizeof(timeStamp);
+	while(parameters--) {
+		message = middleDiagnosisPut(message,middleDiagnosisParameterUDINT,2);
+		message = middleDiagnosisPut(message,*values++,4);
+	}
+
+	middleDiagnosisStatus.NewestMessage = middleDiagnosisFirstMessage + middleDiagnosisNext;
+	middleDiagnosisNext = (middleDiagnosisNext + 1) % middleDiagnosisMessages;
+	if(middleDiagnosisCount < middleDiagnosisMessages)
+		middleDiagnosisCount++;
+	if(middleDiagnosisUnread < middleDiagnosisMessages)
+		middleDiagnosisUnread++;
+	middleDiagnosisStatus.NewMessagesAvailable = true;
+}
+
+void middleDiagnosisInit(void) {
+	middleDiagnosisStatus.Flags = 0;
+	middleDiagnosisStatus.Stored = 0;
+	middleDiagnosisStatus.Lost = 0;
+	middleDiagnosisClear();
+}
+
+void middleDiagnosisEmergency(uint16_t errorCode, uint8_t errorRegister, middleSOESEmergencyPriorityTypedef priority) {
+	uint32_t parameter = errorRegister;
+	uint16_t type;
+
+	if(errorCode == middleSOESEmergencyErrorReset)
+		type = middleDiagnosisTypeInfo;
+	else if(priority == EMERGENCY_PRIORITY_LOW)
+		type = middleDiagnosisTypeWarning;
+	else
+		type = middleDiagnosisTypeError;
+
+	middleDiagnosisStore(errorCode,type,1,&parameter);
+}
+
+void middleDiagnosisALStatusCode(uint16_t statusCode, uint8_t status) {
+	uint32_t parameters[middleDiagnosisParameters] = {statusCode, status};
+
+	middleDiagnosisStore(middleDiagnosisCodeALStatus,middleDiagnosisTypeError,middleDiagnosisParameters,parameters);
+}
+
+// Called after the master wrote a subindex of 0x10F3, the new value is already in middleDiagnosisStatus
+void middleDiagnosisObjectWrite(uint8_t subIndex) {
+	uint8_t acknowledged = middleDiagnosisStatus.NewestAcknowledgedMessage;
+	uint8_t age;
+
+	switch(subIndex) {
+		case 3:
+			if(acknowledged == 0) {
+				middleDiagnosisClear();
+			}else if(acknowledged >= middleDiagnosisFirstMessage && acknowledged < middleDiagnosisFirstMessage + middleDiagnosisCount) {
+				// Messages newer than the acknowledged one stay unread
+				age = (middleDiagnosisNext + middleDiagnosisMessages - 1 - (acknowledged - middleDiagnosisFirstMessage)) % middleDiagnosisMessages;
+				if(age < middleDiagnosisUnread)
+					middleDiagnosisUnread = age;
+				middleDiagnosisAcknowledged = acknowledged;
+			}else{
+				middleDiagnosisStatus.NewestAcknowledgedMessage = middleDiagnosisAcknowledged;			// Not a message that is there, keep the last one
+			}
+
+			middleDiagnosisStatus.NewMessagesAvailable = (middleDiagnosisUnread != 0);
+			if(!middleDiagnosisUnread)
+				middleDiagnosisMessageLost = false;
+			break;
+		case 5:
+			break;
+		default:
+			return;
+	}
+
+	middleDiagnosisStatus.Flags &= middleDiagnosisFlagsWritable;
+	if(middleDiagnosisMessageLost)
+		middleDiagnosisStatus.Flags |= middleDiagnosisFlagMessageLost;
+}
+
+const middleDiagnosisStatusStruct *middleDiagnosisGetStatus(void) {
+	return &middleDiagnosisStatus;
+}
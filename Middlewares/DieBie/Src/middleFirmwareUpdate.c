@@ -0,0 +1,288 @@
+#include "middleFirmwareUpdate.h"
+#include <string.h>
+#include "modDelay.h"
+
+#define middleFirmwareUpdateSecond						(1000*modDelayMicrosecondsPerMillisecond)
+
+typedef struct {
+	uint8_t Data[driverHWFlashPageSize];
+	uint32_t Address;																																		// Flash page this buffer goes to
+	uint32_t Fill;																																			// Bytes received into it
+	uint32_t Programmed;																																// Bytes of it already in flash
+	bool Queued;																																				// Full, handed to the programmer
+} middleFirmwareUpdatePageStruct;
+
+middleFirmwareUpdateStatusStruct middleFirmwareUpdateStatus;
+static middleFirmwareUpdatePageStruct middleFirmwareUpdatePages[2];
+static middleFirmwareUpdateHeaderStruct middleFirmwareUpdateHeader;
+static uint8_t middleFirmwareUpdateFilling = 0;																			// Buffer FoE writes into, the other one is programmed
+static uint8_t middleFirmwareUpdateTarget = middleBootControlNoSlot;
+static uint32_t middleFirmwareUpdateErasedTo = 0;																		// Target pages below this address are erased
+static uint8_t middleFirmwareUpdateALState = ESCinit;
+static bool middleFirmwareUpdateOnTrial = false;
+static uint32_t middleFirmwareUpdateTrialDeadline = 0;
+static uint32_t middleFirmwareUpdateTrialSeconds = 0;
+
+static bool middleFirmwareUpdateVerify(uint32_t length);
+static bool middleFirmwareUpdateProcessDataRunning(void);
+
+void middleFirmwareUpdateInit(void) {
+	middleBootControlRecordStruct record;
+
+	memset(&middleFirmwareUpdateStatus,0,sizeof(middleFirmwareUpdateStatus));
+	middleFirmwareUpdateStatus.State = FIRMWARE_UPDATE_IDLE;
+	middleFirmwareUpdateStatus.RunningSlot = middleBootControlSlotOf(driverHWBootRunningImage());
+
+	middleBootControlRead(&record);
+	middleFirmwareUpdateStatus.Trial = record.Trial;
+	middleFirmwareUpdateStatus.Rollbacks = record.Rollbacks;
+	if(middleFirmwareUpdateStatus.RunningSlot != middleBootControlNoSlot)
+		middleFirmwareUpdateStatus.RunningVersion = record.Image[middleFirmwareUpdateStatus.RunningSlot].Version;
+
+	// Booted on trial: OP confirms, running out of time resets into the bootloader, which then rolls back
+	middleFirmwareUpdateOnTrial = (record.Trial == BOOT_TRIAL_BOOTED) && (record.Active == middleFirmwareUpdateStatus.RunningSlot);
+	middleFirmwareUpdateTrialSeconds = 0;
+	middleFirmwareUpdateTrialDeadline = modDelayDeadlineSet(middleFirmwareUpdateSecond);
+	middleFirmwareUpdateALState = ESCinit;
+}
+
+// Erase ahead of time is the normal case, this only catches up when programming got to a page first.
+static bool middleFirmwareUpdateEraseTo(uint32_t address) {
+	uint32_t end = middleBootControlSlotAddress(middleFirmwareUpdateTarget) + middleBootControlSlotSize;
+
+	if(address > end)
+		address = end;
+
+	while(middleFirmwareUpdateErasedTo < address) {
+		if(!driverHWFlashErasePage(middleFirmwareUpdateErasedTo))
+			return false;
+		middleFirmwareUpdateErasedTo += driverHWFlashPageSize;
+		middleFirmwareUpdateStatus.PagesErased++;
+	}
+
+	return true;
+}
+
+static bool middleFirmwareUpdateProgram(middleFirmwareUpdatePageStruct *page, uint32_t limit) {
+	uint32_t length = page->Fill - page->Programmed;
+
+	if(length > limit)
+		length = limit;
+
+	if(!middleFirmwareUpdateEraseTo(page->Address + driverHWFlashPageSize))
+		return false;
+	if(!driverHWFlashProgram(page->Address + page->Programmed,&page->Data[page->Programmed],length))
+		return false;
+
+	page->Programmed += length;
+	middleFirmwareUpdateStatus.Programmed += length;
+	if(page->Programmed >= page->Fill)
+		page->Queued = false;
+
+	return true;
+}
+
+// The slot that is about to be overwritten is invalidated first, a download cut off halfway never boots.
+static bool middleFirmwareUpdateStart(void) {
+	uint8_t running = middleBootControlSlotOf(driverHWBootRunningImage());
+
+	middleFirmwareUpdateStatus.State = FIRMWARE_UPDATE_FAILED;
+	middleFirmwareUpdateStatus.Received = 0;
+	middleFirmwareUpdateStatus.Programmed = 0;
+	middleFirmwareUpdateStatus.PagesErased = 0;
+	middleFirmwareUpdateStatus.Stalls = 0;
+	middleFirmwareUpdateStatus.WorstWriteTime = 0;
+	middleFirmwareUpdateStatus.VerifyTime = 0;
+	middleFirmwareUpdateStatus.Checksum = 0;
+	middleFirmwareUpdateStatus.Version = 0;
+
+	if(running == middleBootControlNoSlot)
+		return false;																																		// Not started by the bootloader, no slot to go to
+
+	middleFirmwareUpdateTarget = running ^ 1;
+	if(!middleBootControlInvalidate(middleFirmwareUpdateTarget))
+		return false;
+
+	memset(middleFirmwareUpdatePages,0,sizeof(middleFirmwareUpdatePages));
+	memset(&middleFirmwareUpdateHeader,0,sizeof(middleFirmwareUpdateHeader));
+	middleFirmwareUpdateFilling = 0;
+	middleFirmwareUpdatePages[0].Address = middleBootControlSlotAddress(middleFirmwareUpdateTarget);
+	middleFirmwareUpdateErasedTo = middleBootControlSlotAddress(middleFirmwareUpdateTarget);
+	middleFirmwareUpdateStatus.State = FIRMWARE_UPDATE_RECEIVING;
+	return true;
+}
+
+// Hands the full buffer to the programmer and starts filling the other one. That one is normally programmed by now,
+// if not FoE has outrun the flash and waits for it here.
+static bool middleFirmwareUpdateSwap(void) {
+	middleFirmwareUpdatePageStruct *full = &middleFirmwareUpdatePages[middleFirmwareUpdateFilling];
+	middleFirmwareUpdatePageStruct *next = &middleFirmwareUpdatePages[middleFirmwareUpdateFilling ^ 1];
+
+	if(next->Queued) {
+		middleFirmwareUpdateStatus.Stalls++;
+		if(!middleFirmwareUpdateProgram(next,driverHWFlashPageSize))
+			return false;
+	}
+
+	full->Queued = true;
+	next->Address = full->Address + driverHWFlashPageSize;
+	next->Fill = 0;
+	next->Programmed = 0;
+	middleFirmwareUpdateFilling ^= 1;
+	return true;
+}
+
+uint32_t middleFirmwareUpdateFoEWrite(foe_writefile_cfg_t *self, uint8_t *data, uint32_t length) {
+	uint32_t start = modDelayGetMicroseconds();
+	uint32_t offset = self->address_offset;
+
+	if(middleFirmwareUpdateProcessDataRunning()) {
+		if(middleFirmwareUpdateStatus.State == FIRMWARE_UPDATE_RECEIVING)
+			middleFirmwareUpdateStatus.State = FIRMWARE_UPDATE_FAILED;
+		return 1;
+	}
+
+	if(offset == 0 && !middleFirmwareUpdateStart())
+		return 1;
+
+	if(middleFirmwareUpdateStatus.State != FIRMWARE_UPDATE_RECEIVING ||
+		offset + length > sizeof(middleFirmwareUpdateHeaderStruct) + middleBootControlSlotSize) {
+		middleFirmwareUpdateStatus.State = FIRMWARE_UPDATE_FAILED;
+		return 1;
+	}
+
+	// The header stays in RAM, the image goes to the slot start where its vector table has to be
+	if(offset < sizeof(middleFirmwareUpdateHeaderStruct)) {
+		uint32_t chunk = sizeof(middleFirmwareUpdateHeaderStruct) - offset;
+		if(chunk > length)
+			chunk = length;
+
+		memcpy((uint8_t *)&middleFirmwareUpdateHeader + offset,data,chunk);
+		data += chunk;
+		length -= chunk;
+		middleFirmwareUpdateStatus.Received += chunk;
+	}
+
+	while(length) {
+		middleFirmwareUpdatePageStruct *page = &middleFirmwareUpdatePages[middleFirmwareUpdateFilling];
+		uint32_t chunk = driverHWFlashPageSize - page->Fill;
+		if(chunk > length)
+			chunk = length;
+
+		memcpy(&page->Data[page->Fill],data,chunk);
+		page->Fill += chunk;
+		data += chunk;
+		length -= chunk;
+		middleFirmwareUpdateStatus.Received += chunk;
+
+		if(page->Fill == driverHWFlashPageSize && !middleFirmwareUpdateSwap()) {
+			middleFirmwareUpdateStatus.State = FIRMWARE_UPDATE_FAILED;
+			return 1;
+		}
+	}
+
+	uint32_t elapsed = modDelayGetMicroseconds() - start;
+	if(elapsed > middleFirmwareUpdateStatus.WorstWriteTime)
+		middleFirmwareUpdateStatus.WorstWriteTime = elapsed;
+
+	return 0;
+}
+
+// FoE waits for the ack of the last packet until this returns, so everything still buffered goes to flash here.
+uint32_t middleFirmwareUpdateFoEClose(foe_writefile_cfg_t *self, uint32_t length) {
+	uint32_t start = modDelayGetMicroseconds();
+	bool ok = (middleFirmwareUpdateStatus.State == FIRMWARE_UPDATE_RECEIVING) && !middleFirmwareUpdateProcessDataRunning();
+
+	for(uint8_t buffer = 1; ok && buffer <= 2; buffer++) {
+		middleFirmwareUpdatePageStruct *page = &middleFirmwareUpdatePages[middleFirmwareUpdateFilling ^ (buffer & 1)];	// Queued one first
+		if(page->Fill & 1)
+			page->Data[page->Fill++] = 0xFF;
+		if(page->Programmed < page->Fill)
+			ok = middleFirmwareUpdateProgram(page,driverHWFlashPageSize);
+	}
+
+	ok = ok && middleFirmwareUpdateVerify(length);
+	if(ok) {
+		middleBootControlImageStruct image = {middleFirmwareUpdateHeader.Length, middleFirmwareUpdateHeader.Checksum, middleFirmwareUpdateHeader.Version};
+		ok = middleBootControlCommit(middleFirmwareUpdateTarget,&image);
+	}
+
+	middleFirmwareUpdateStatus.State = ok ? FIRMWARE_UPDATE_VALID : FIRMWARE_UPDATE_FAILED;
+	middleFirmwareUpdateStatus.VerifyTime = modDelayGetMicroseconds() - start;
+
+	return ok ? 0 : 1;
+}
+
+static bool middleFirmwareUpdateVerify(uint32_t length) {
+	const uint8_t *image = driverHWFlashRead(middleBootControlSlotAddress(middleFirmwareUpdateTarget));
+
+	if(length < sizeof(middleFirmwareUpdateHeaderStruct) || middleFirmwareUpdateHeader.Magic != middleFirmwareUpdateMagic ||
+		middleFirmwareUpdateHeader.Length > length - sizeof(middleFirmwareUpdateHeaderStruct) ||
+		!middleBootControlVectorsValid(middleFirmwareUpdateTarget,image))
+		return false;																																		// Also catches an image linked for the other slot
+
+	middleFirmwareUpdateStatus.Checksum = middleBootControlCRC(0,image,middleFirmwareUpdateHeader.Length);
+	if(middleFirmwareUpdateStatus.Checksum != middleFirmwareUpdateHeader.Checksum)
+		return false;
+
+	middleFirmwareUpdateStatus.Version = middleFirmwareUpdateHeader.Version;
+	return true;
+}
+
+// Background side of the pipeline: program a slice of the queued buffer, else erase the next page ahead. One flash
+// operation per run keeps the stall per run short. Also feeds the watchdog of a trial boot and decides the trial.
+void middleFirmwareUpdateTask(void) {
+	middleFirmwareUpdatePageStruct *queued = &middleFirmwareUpdatePages[middleFirmwareUpdateFilling ^ 1];
+	uint8_t state = ESCvar.ALstatus & 0x0f;
+	bool ok = true;
+
+	driverHWBootWatchdogKick();
+
+	if(middleFirmwareUpdateOnTrial) {
+		if(state == ESCop) {
+			middleFirmwareUpdateOnTrial = !middleBootControlConfirm(middleFirmwareUpdateStatus.RunningSlot);
+			if(!middleFirmwareUpdateOnTrial)
+				middleFirmwareUpdateStatus.Trial = BOOT_TRIAL_NONE;
+		}else if(modDelayDeadlineExpired(middleFirmwareUpdateTrialDeadline)) {
+			middleFirmwareUpdateTrialDeadline = modDelayDeadlineSet(middleFirmwareUpdateSecond);
+			if(++middleFirmwareUpdateTrialSeconds >= middleFirmwareUpdateTrialTimeout)
+				driverHWBootReset();
+		}
+	}
+
+	// Master done with BOOT: start the new image right away
+	if(middleFirmwareUpdateALState == ESCboot && state == ESCinit && middleFirmwareUpdateStatus.State == FIRMWARE_UPDATE_VALID)
+		driverHWBootReset();
+	middleFirmwareUpdateALState = state;
+
+	if(middleFirmwareUpdateStatus.State != FIRMWARE_UPDATE_RECEIVING)
+		return;
+
+	// A download left running into SAFEOP would erase and program next to the process data, it is given up instead
+	if(middleFirmwareUpdateProcessDataRunning()) {
+		middleFirmwareUpdateStatus.State = FIRMWARE_UPDATE_FAILED;
+		return;
+	}
+
+	if(queued->Queued) {
+		ok = middleFirmwareUpdateProgram(queued,middleFirmwareUpdateProgramSlice);
+	}else{
+		uint32_t eraseTarget = middleFirmwareUpdatePages[middleFirmwareUpdateFilling].Address + (middleFirmwareUpdateEraseAhead + 1)*driverHWFlashPageSize;
+		if(middleFirmwareUpdateErasedTo < eraseTarget)
+			ok = middleFirmwareUpdateEraseTo(middleFirmwareUpdateErasedTo + driverHWFlashPageSize);
+	}
+
+	if(!ok)
+		middleFirmwareUpdateStatus.State = FIRMWARE_UPDATE_FAILED;
+}
+
+// Erases stall the core for ~20ms and programming for ~1.6ms per slice, no flash work with process data running.
+static bool middleFirmwareUpdateProcessDataRunning(void) {
+	uint8_t state = ESCvar.ALstatus & 0x0f;
+
+	return (state == ESCsafeop) || (state == ESCop);
+}
+
+const middleFirmwareUpdateStatusStruct *middleFirmwareUpdateGetStatus(void) {
+	return &middleFirmwareUpdateStatus;
+}
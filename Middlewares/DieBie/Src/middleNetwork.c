@@ -0,0 +1,384 @@
+#include "middleNetwork.h"
+#include <string.h>
+
+#define middleNetworkTypeARP									0x0806
+#define middleNetworkTypeIPv4									0x0800
+#define middleNetworkProtocolICMP							1
+#define middleNetworkProtocolUDP							17
+#define middleNetworkARPSize									28
+#define middleNetworkARPOperationRequest			1
+#define middleNetworkARPOperationReply				2
+#define middleNetworkICMPHeaderSize						8
+#define middleNetworkICMPEchoReply						0
+#define middleNetworkICMPEchoRequest					8
+#define middleNetworkIPDontFragment						0x4000
+#define middleNetworkIPFragmentMask						0x3FFF														// More fragments and the offset
+
+typedef struct {
+	uint16_t Port;
+	middleNetworkUDPHandlerTypedef Handler;
+} middleNetworkBindingStruct;
+
+static void middleNetworkHandleFrame(uint8_t *frame, uint16_t size);
+static uint16_t middleNetworkSetParam(const eoe_param_t *param);
+
+static uint8_t middleNetworkRxFrame[middleNetworkFrameSize];
+static uint8_t middleNetworkTxFrame[middleNetworkFrameSize];
+eoe_cfg_t middleNetworkEoE = {middleNetworkRxFrame, middleNetworkFrameSize, middleNetworkTxFrame, middleNetworkFrameSize,
+	&middleNetworkHandleFrame, &middleNetworkSetParam};
+const uint8_t middleNetworkBroadcast[6] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+
+middleNetworkStatusStruct middleNetworkStatus;
+middleNetworkBindingStruct middleNetworkBindings[middleNetworkUDPPorts];
+uint16_t middleNetworkIdentification;
+bool middleNetworkARPPending;																													// ARP reply waiting for the tx buffer
+uint8_t middleNetworkARPPendingMAC[6];
+uint32_t middleNetworkARPPendingIP;
+uint16_t middleNetworkEchoPendingLength;																							// ICMP bytes of an echo waiting, 0 if none
+uint8_t middleNetworkEchoPendingMAC[6];
+uint32_t middleNetworkEchoPendingIP;
+uint8_t middleNetworkEchoPending[middleNetworkEchoDeferSize];
+
+void (*middleNetworkTransmitReadyEventFunctionPointer)(void);
+
+static uint16_t middleNetworkGet16(const uint8_t *data) {
+	return ((uint16_t)data[0] << 8) | data[1];
+}
+
+static uint32_t middleNetworkGet32(const uint8_t *data) {
+	return ((uint32_t)data[0] << 24) | ((uint32_t)data[1] << 16) | ((uint32_t)data[2] << 8) | data[3];
+}
+
+static void middleNetworkPut16(uint8_t *data, uint16_t value) {
+	data[0] = (uint8_t)(value >> 8);
+	data[1] = (uint8_t)value;
+}
+
+static void middleNetworkPut32(uint8_t *data, uint32_t value) {
+	data[0] = (uint8_t)(value >> 24);
+	data[1] = (uint8_t)(value >> 16);
+	data[2] = (uint8_t)(value >> 8);
+	data[3] = (uint8_t)value;
+}
+
+// Internet checksum, summed in big endian words and folded at the end. Data that checks out folds to 0.
+static uint32_t middleNetworkChecksumAdd(uint32_t sum, const uint8_t *data, uint16_t length) {
+	while(length > 1) {
+		sum += middleNetworkGet16(data);
+		data += 2;
+		length -= 2;
+	}
+	if(length)
+		sum += (uint16_t)data[0] << 8;
+
+	return sum;
+}
+
+static uint16_t middleNetworkChecksumFold(uint32_t sum) {
+	while(sum >> 16)
+		sum = (sum & 0xFFFF) + (sum >> 16);
+
+	return (uint16_t)~sum;
+}
+
+static uint32_t middleNetworkPseudoHeader(uint32_t source, uint32_t destination, uint8_t protocol, uint16_t length) {
+	return (source >> 16) + (source & 0xFFFF) + (destination >> 16) + (destination & 0xFFFF) + protocol + length;
+}
+
+static void middleNetworkEthernetHeader(const uint8_t *destination, uint16_t type) {
+	memcpy(&middleNetworkTxFrame[0],destination,6);
+	memcpy(&middleNetworkTxFrame[6],middleNetworkStatus.MAC,6);
+	middleNetworkPut16(&middleNetworkTxFrame[12],type);
+}
+
+static void middleNetworkIPHeader(uint32_t destination, uint8_t protocol, uint16_t length) {
+	uint8_t *packet = &middleNetworkTxFrame[middleNetworkEthernetHeaderSize];
+
+	packet[0] = 0x45;																																		// Version 4, no options
+	packet[1] = 0;
+	middleNetworkPut16(&packet[2],length);
+	middleNetworkPut16(&packet[4],middleNetworkIdentification++);
+	middleNetworkPut16(&packet[6],middleNetworkIPDontFragment);
+	packet[8] = middleNetworkTimeToLive;
+	packet[9] = protocol;
+	middleNetworkPut16(&packet[10],0);
+	middleNetworkPut32(&packet[12],middleNetworkStatus.IP);
+	middleNetworkPut32(&packet[16],destination);
+	middleNetworkPut16(&packet[10],middleNetworkChecksumFold(middleNetworkChecksumAdd(0,packet,middleNetworkIPHeaderSize)));
+}
+
+static void middleNetworkTransmit(uint16_t length) {
+	if(length < middleNetworkMinimumFrameSize) {
+		memset(&middleNetworkTxFrame[length],0,middleNetworkMinimumFrameSize - length);
+		length = middleNetworkMinimumFrameSize;
+	}
+
+	EOE_send(length);
+	middleNetworkStatus.TxFrames++;
+}
+
+static void middleNetworkARPReply(const uint8_t *mac, uint32_t ip) {
+	uint8_t *arp = &middleNetworkTxFrame[middleNetworkEthernetHeaderSize];
+
+	middleNetworkEthernetHeader(mac,middleNetworkTypeARP);
+	middleNetworkPut16(&arp[0],1);																											// Ethernet
+	middleNetworkPut16(&arp[2],middleNetworkTypeIPv4);
+	arp[4] = 6;
+	arp[5] = 4;
+	middleNetworkPut16(&arp[6],middleNetworkARPOperationReply);
+	memcpy(&arp[8],middleNetworkStatus.MAC,6);
+	middleNetworkPut32(&arp[14],middleNetworkStatus.IP);
+	memcpy(&arp[18],mac,6);
+	middleNetworkPut32(&arp[24],ip);
+
+	middleNetworkTransmit(middleNetworkEthernetHeaderSize + middleNetworkARPSize);
+	middleNetworkStatus.ARPReplies++;
+}
+
+static void middleNetworkEchoReply(const uint8_t *mac, uint32_t ip, const uint8_t *request, uint16_t length) {
+	uint8_t *reply = &middleNetworkTxFrame[middleNetworkEthernetHeaderSize + middleNetworkIPHeaderSize];
+
+	memcpy(reply,request,length);
+	reply[0] = middleNetworkICMPEchoReply;
+	reply[1] = 0;
+	middleNetworkPut16(&reply[2],0);
+	middleNetworkPut16(&reply[2],middleNetworkChecksumFold(middleNetworkChecksumAdd(0,reply,length)));
+
+	middleNetworkEthernetHeader(mac,middleNetworkTypeIPv4);
+	middleNetworkIPHeader(ip,middleNetworkProtocolICMP,middleNetworkIPHeaderSize + length);
+	middleNetworkTransmit(middleNetworkEthernetHeaderSize + middleNetworkIPHeaderSize + length);
+	middleNetworkStatus.EchoReplies++;
+}
+
+static bool middleNetworkReceiveARP(const uint8_t *arp, uint16_t length) {
+	if(length < middleNetworkARPSize || middleNetworkGet16(&arp[0]) != 1 || middleNetworkGet16(&arp[2]) != middleNetworkTypeIPv4 ||
+		arp[4] != 6 || arp[5] != 4)
+		return false;
+
+	if(middleNetworkGet16(&arp[6]) != middleNetworkARPOperationRequest || middleNetworkGet32(&arp[24]) != middleNetworkStatus.IP)
+		return true;																																			// Fine, just not asking for us
+
+	if(!EOE_tx_busy()) {
+		middleNetworkARPReply(&arp[8],middleNetworkGet32(&arp[14]));
+	}else if(!middleNetworkARPPending) {
+		memcpy(middleNetworkARPPendingMAC,&arp[8],6);
+		middleNetworkARPPendingIP = middleNetworkGet32(&arp[14]);
+		middleNetworkARPPending = true;
+	}else{
+		middleNetworkStatus.TxBusy++;
+	}
+
+	return true;
+}
+
+static bool middleNetworkReceiveICMP(const uint8_t *mac, uint32_t source, const uint8_t *icmp, uint16_t length) {
+	if(length < middleNetworkICMPHeaderSize || middleNetworkChecksumFold(middleNetworkChecksumAdd(0,icmp,length)))
+		return false;
+	if(icmp[0] != middleNetworkICMPEchoRequest)
+		return true;
+
+	if(!EOE_tx_busy()) {
+		middleNetworkEchoReply(mac,source,icmp,length);
+	}else if(!middleNetworkEchoPendingLength && length <= middleNetworkEchoDeferSize) {
+		memcpy(middleNetworkEchoPendingMAC,mac,6);
+		middleNetworkEchoPendingIP = source;
+		memcpy(middleNetworkEchoPending,icmp,length);
+		middleNetworkEchoPendingLength = length;
+	}else{
+		middleNetworkStatus.TxBusy++;
+	}
+
+	return true;
+}
+
+static bool middleNetworkReceiveUDP(const uint8_t *mac, uint32_t source, uint32_t destination, const uint8_t *udp, uint16_t length) {
+	middleNetworkEndpointStruct from;
+	uint16_t udpLength, checksum, port;
+	uint8_t binding;
+
+	if(length < middleNetworkUDPHeaderSize)
+		return false;
+	udpLength = middleNetworkGet16(&udp[4]);
+	checksum = middleNetworkGet16(&udp[6]);
+	if(udpLength < middleNetworkUDPHeaderSize || udpLength > length)
+		return false;
+	if(checksum && middleNetworkChecksumFold(middleNetworkChecksumAdd(middleNetworkPseudoHeader(source,destination,middleNetworkProtocolUDP,udpLength),udp,udpLength)))
+		return false;																																			// 0 means the sender did not compute one
+
+	port = middleNetworkGet16(&udp[2]);
+	for(binding = 0; binding < middleNetworkUDPPorts; binding++) {
+		if(middleNetworkBindings[binding].Handler && middleNetworkBindings[binding].Port == port)
+			break;
+	}
+	if(binding == middleNetworkUDPPorts) {
+		middleNetworkStatus.UDPUnreachable++;
+		return true;
+	}
+
+	memcpy(from.MAC,mac,6);
+	from.IP = source;
+	from.Port = middleNetworkGet16(&udp[0]);
+	middleNetworkStatus.UDPReceived++;
+	middleNetworkBindings[binding].Handler(&from,&udp[middleNetworkUDPHeaderSize],udpLength - middleNetworkUDPHeaderSize);
+
+	return true;
+}
+
+static bool middleNetworkReceiveIP(const uint8_t *mac, const uint8_t *packet, uint16_t length) {
+	uint16_t header, total;
+	uint32_t source, destination;
+
+	if(length < middleNetworkIPHeaderSize || (packet[0] >> 4) != 4)
+		return false;
+	header = (packet[0] & 0x0F)*4;
+	total = middleNetworkGet16(&packet[2]);
+	if(header < middleNetworkIPHeaderSize || total < header || total > length)
+		return false;
+	if(middleNetworkGet16(&packet[6]) & middleNetworkIPFragmentMask)
+		return false;																																			// No reassembly
+	if(middleNetworkChecksumFold(middleNetworkChecksumAdd(0,packet,header)))
+		return false;
+
+	source = middleNetworkGet32(&packet[12]);
+	destination = middleNetworkGet32(&packet[16]);
+	if(destination != middleNetworkStatus.IP && destination != 0xFFFFFFFF && destination != (middleNetworkStatus.IP | ~middleNetworkStatus.Subnet))
+		return false;
+
+	switch(packet[9]) {
+		case middleNetworkProtocolICMP:
+			if(destination != middleNetworkStatus.IP)
+				return true;																																	// No echo to broadcasts
+			return middleNetworkReceiveICMP(mac,source,&packet[header],total - header);
+		case middleNetworkProtocolUDP:
+			return middleNetworkReceiveUDP(mac,source,destination,&packet[header],total - header);
+		default:
+			return false;
+	}
+}
+
+// Every complete frame from the EoE reassembly, in the mailbox task. The buffer is reused once this returns.
+static void middleNetworkHandleFrame(uint8_t *frame, uint16_t size) {
+	bool accepted = false;
+
+	middleNetworkStatus.RxFrames++;
+	if(size >= middleNetworkEthernetHeaderSize && middleNetworkStatus.IP &&
+		(!memcmp(&frame[0],middleNetworkStatus.MAC,6) || !memcmp(&frame[0],middleNetworkBroadcast,6))) {
+		switch(middleNetworkGet16(&frame[12])) {
+			case middleNetworkTypeARP:
+				accepted = middleNetworkReceiveARP(&frame[middleNetworkEthernetHeaderSize],size - middleNetworkEthernetHeaderSize);
+				break;
+			case middleNetworkTypeIPv4:
+				accepted = middleNetworkReceiveIP(&frame[6],&frame[middleNetworkEthernetHeaderSize],size - middleNetworkEthernetHeaderSize);
+				break;
+			default:
+				break;
+		}
+	}
+
+	if(!accepted)
+		middleNetworkStatus.RxDropped++;
+}
+
+// Set IP parameter request from the master.
+static uint16_t middleNetworkSetParam(const eoe_param_t *param) {
+	if(param->mac_set)
+		memcpy(middleNetworkStatus.MAC,param->mac,6);
+	if(param->ip_set)
+		middleNetworkStatus.IP = param->ip;
+	if(param->subnet_set)
+		middleNetworkStatus.Subnet = param->subnet;
+	if(param->default_gateway_set)
+		middleNetworkStatus.Gateway = param->default_gateway;
+
+	// Replies still waiting were meant for the old addresses
+	middleNetworkARPPending = false;
+	middleNetworkEchoPendingLength = 0;
+
+	return EOE_RESULT_SUCCESS;
+}
+
+void middleNetworkInit(void) {
+	const uint8_t defaultMAC[6] = middleNetworkDefaultMAC;
+
+	memset(&middleNetworkStatus,0,sizeof(middleNetworkStatus));
+	memset(middleNetworkBindings,0,sizeof(middleNetworkBindings));
+	memcpy(middleNetworkStatus.MAC,defaultMAC,6);
+	middleNetworkIdentification = 0;
+	middleNetworkARPPending = false;
+	middleNetworkEchoPendingLength = 0;
+
+	middleSOESEoEConfig(&middleNetworkEoE);
+}
+
+// Replies that found the buffer busy go first, then the services get the buffer.
+void middleNetworkTask(void) {
+	if(middleNetworkARPPending && !EOE_tx_busy()) {
+		middleNetworkARPPending = false;
+		middleNetworkARPReply(middleNetworkARPPendingMAC,middleNetworkARPPendingIP);
+	}
+
+	if(middleNetworkEchoPendingLength && !EOE_tx_busy()) {
+		middleNetworkEchoReply(middleNetworkEchoPendingMAC,middleNetworkEchoPendingIP,middleNetworkEchoPending,middleNetworkEchoPendingLength);
+		middleNetworkEchoPendingLength = 0;
+	}
+
+	if(middleNetworkStatus.IP && !EOE_tx_busy() && middleNetworkTransmitReadyEventFunctionPointer)
+		middleNetworkTransmitReadyEventFunctionPointer();
+}
+
+bool middleNetworkUDPBind(uint16_t port, middleNetworkUDPHandlerTypedef handler) {
+	for(uint8_t binding = 0; binding < middleNetworkUDPPorts; binding++) {
+		if(!middleNetworkBindings[binding].Handler) {
+			middleNetworkBindings[binding].Port = port;
+			middleNetworkBindings[binding].Handler = handler;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// Where the payload of the next datagram goes, NULL while the buffer is taken or there is no address yet.
+uint8_t *middleNetworkUDPPayload(uint16_t *capacity) {
+	if(!middleNetworkStatus.IP || EOE_tx_busy() || middleNetworkARPPending || middleNetworkEchoPendingLength)
+		return NULL;
+
+	if(capacity)
+		*capacity = middleNetworkFrameSize - middleNetworkUDPPayloadOffset;
+
+	return &middleNetworkTxFrame[middleNetworkUDPPayloadOffset];
+}
+
+// Sends length bytes written at middleNetworkUDPPayload. The destination MAC is taken from the endpoint, the
+// services answer whoever asked, so there is no ARP cache.
+bool middleNetworkUDPSend(const middleNetworkEndpointStruct *to, uint16_t sourcePort, uint16_t length) {
+	uint8_t *udp = &middleNetworkTxFrame[middleNetworkEthernetHeaderSize + middleNetworkIPHeaderSize];
+	uint16_t udpLength = middleNetworkUDPHeaderSize + length;
+	uint16_t checksum;
+
+	if(!middleNetworkStatus.IP || EOE_tx_busy() || length > middleNetworkFrameSize - middleNetworkUDPPayloadOffset)
+		return false;
+
+	middleNetworkPut16(&udp[0],sourcePort);
+	middleNetworkPut16(&udp[2],to->Port);
+	middleNetworkPut16(&udp[4],udpLength);
+	middleNetworkPut16(&udp[6],0);
+	checksum = middleNetworkChecksumFold(middleNetworkChecksumAdd(middleNetworkPseudoHeader(middleNetworkStatus.IP,to->IP,middleNetworkProtocolUDP,udpLength),udp,udpLength));
+	middleNetworkPut16(&udp[6],checksum ? checksum : 0xFFFF);
+
+	middleNetworkEthernetHeader(to->MAC,middleNetworkTypeIPv4);
+	middleNetworkIPHeader(to->IP,middleNetworkProtocolUDP,middleNetworkIPHeaderSize + udpLength);
+	middleNetworkTransmit(middleNetworkUDPPayloadOffset + length);
+	middleNetworkStatus.UDPSent++;
+
+	return true;
+}
+
+void middleNetworkTransmitReadyEvent(void (*eventFunctionPointer)(void)) {
+	if(eventFunctionPointer)
+		middleNetworkTransmitReadyEventFunctionPointer = eventFunctionPointer;
+}
+
+const middleNetworkStatusStruct *middleNetworkGetStatus(void) {
+	return &middleNetworkStatus;
+}
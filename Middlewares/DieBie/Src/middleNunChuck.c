@@ -1,4 +1,5 @@
 #include "middleNunChuck.h"
+#include "middleCalibration.h"
 
 driverSWNunChuckCalibrationDataStruct middleNunChuckCalibrationData;
 bool																	middleNunChuckCalibrationDataValid;
@@ -6,71 +7,122 @@ uint64_t 															middleNunChuckID;
 driverSWNunChuckSensorDataStruct			middleNunChuckSensorData;
 middleNunChuckDataStruct 							middleNunChuckData;
 uint32_t 															middleNunChuckMeasureIntervalLastTick;
-uint32_t															middleNunChuckMeasureIntervalDesired;
 uint32_t															middleNunChuckMeasureInterval;
+uint32_t															middleNunChuckValidSamples;
+uint8_t																middleNunChuckFaults;
+bool																	middleNunChuckConnecting;												// An I2C sequence is in flight
+bool																	middleNunChuckSampling;
+middleNunChuckSettingsStruct					middleNunChuckSettings = {middleNunChuckDefaultMeasureInterval*modDelayMicrosecondsPerMillisecond};	// 100Hz, not reset by the re-inits after a fault
 
 void (*middleNunChuckEventFunctionPointer)(middleNunChuckDataStruct newData);
+void (*middleNunChuckFaultEventFunctionPointer)(uint8_t fault, bool active);
+static void middleNunChuckSetFault(uint8_t fault, bool active);
+static void middleNunChuckConnected(bool valid);
+static void middleNunChuckSampled(bool newDataValid);
 int32_t middleNunchuckMapVariable(int32_t inputVariable, int32_t inputLowerLimit, int32_t inputUpperLimit, int32_t outputLowerLimit, int32_t outputUpperLimit);
 
+// Nothing here waits on the bus: init and the task only start I2C sequences, every release of the task moves the one
+// in flight a step further, see driverSWNunChuckPoll. Data and faults follow when a sequence is over.
 void middleNunChuckInit(void) {
-  driverSWNunChuckInit();
+	middleNunChuckCalibrationDataValid = false;
+	middleNunChuckSampling = false;
+	middleNunChuckConnecting = (driverSWNunChuckConnect(&middleNunChuckCalibrationData,&middleNunChuckID) == NUNCHUCK_BUSY);
+	if(!middleNunChuckConnecting)
+		middleNunChuckConnected(false);
 	
-  middleNunChuckCalibrationDataValid  = driverSWNunChuckGetCalibrationData(&middleNunChuckCalibrationData);
-  middleNunChuckCalibrationDataValid &= driverSWNunChuckGetID(&middleNunChuckID);
-	
-	middleNunChuckMeasureIntervalDesired = middleNunChuckDefaultMeasureInterval;				// 100Hz Measure interval
-	middleNunChuckMeasureIntervalLastTick = HAL_GetTick();
-	
-	middleNunChuckData.nunChuckID = middleNunChuckID;
+	middleNunChuckMeasureIntervalLastTick = modDelayGetMicroseconds();
 }
 
 void middleNunChuckTask(void) {
-	bool newDataValid = false;
+	driverSWNunChuckStatusTypedef status = driverSWNunChuckPoll();
+	
+	if(status == NUNCHUCK_BUSY)
+		return;
+	
+	if(middleNunChuckConnecting) {
+		middleNunChuckConnecting = false;
+		middleNunChuckConnected(status == NUNCHUCK_DONE);
+	}
+	
+	if(middleNunChuckSampling) {
+		middleNunChuckSampling = false;
+		middleNunChuckSampled(status == NUNCHUCK_DONE);
+	}
 	
-	if(modDelayTick1ms(&middleNunChuckMeasureIntervalLastTick,10)) {
+	if(modDelayTick1us(&middleNunChuckMeasureIntervalLastTick,middleNunChuckMeasureInterval)) {
 		if(middleNunChuckCalibrationDataValid) {
-			middleNunChuckMeasureInterval = middleNunChuckMeasureIntervalDesired;
-			newDataValid = driverSWNunChuckGetSensorData(&middleNunChuckSensorData);
+			middleNunChuckMeasureInterval = middleNunChuckSettings.MeasureInterval;
+			middleNunChuckSampling = true;
+			if(driverSWNunChuckGetSensorData(&middleNunChuckSensorData) != NUNCHUCK_BUSY) {
+				middleNunChuckSampling = false;
+				middleNunChuckSampled(false);
+			}
 		}else{
-			middleNunChuckMeasureInterval = middleNunChuckErrortMeasureInterval;
+			middleNunChuckMeasureInterval = middleNunChuckErrortMeasureInterval*modDelayMicrosecondsPerMillisecond;
+			middleNunChuckSampled(false);
 			middleNunChuckInit();
 		}
+	}
+}
+
+static void middleNunChuckConnected(bool valid) {
+	middleNunChuckCalibrationDataValid = valid;
+	middleNunChuckData.nunChuckID = middleNunChuckID;
+	
+	if(middleNunChuckCalibrationDataValid) {
+		middleNunChuckSetFault(middleNunChuckFaultCommunication,false);
+		middleNunChuckSetFault(middleNunChuckFaultCalibration,middleCalibrationSelect(middleNunChuckID,&middleNunChuckCalibrationData) == CALIBRATION_SOURCE_NOMINAL);
+	}else{
+		middleNunChuckSetFault(middleNunChuckFaultCommunication,true);
+	}
+}
+
+// Also called without a read, e.g. while no nunchuck answers, so the data goes on being reported as invalid.
+static void middleNunChuckSampled(bool newDataValid) {
+	if(newDataValid) {
+		middleNunChuckData.dataValid = true;
+		middleNunChuckValidSamples++;
+		middleNunChuckSetFault(middleNunChuckFaultCommunication,false);
+		middleNunChuckMeasureInterval = middleNunChuckSettings.MeasureInterval;
+		if(middleCalibrationSample(&middleNunChuckSensorData,&middleNunChuckCalibrationData))
+			middleNunChuckSetFault(middleNunChuckFaultCalibration,middleCalibrationGetStatus()->Source == CALIBRATION_SOURCE_NOMINAL);
 		
-		if(newDataValid) {
-			middleNunChuckData.dataValid = true;
-			middleNunChuckMeasureInterval = middleNunChuckMeasureIntervalDesired;
-			
-			// Convert the raw sensor values to usable data
-			middleNunChuckData.buttonC = middleNunChuckSensorData.buttonC;
-			middleNunChuckData.buttonZ = middleNunChuckSensorData.buttonZ;
-			int32_t middleNunChuckDataJoystickXCentered = middleNunChuckSensorData.joystickX - middleNunChuckCalibrationData.joystickXCenter;
-			int32_t middleNunChuckDataJoystickYCentered = middleNunChuckSensorData.joystickY - middleNunChuckCalibrationData.joystickYCenter;
-			
-			if(middleNunChuckDataJoystickXCentered >= 0)
-				middleNunChuckData.joystickX = middleNunchuckMapVariable(middleNunChuckDataJoystickXCentered,0,middleNunChuckCalibrationData.joystickXMax - middleNunChuckCalibrationData.joystickXCenter,0,127);
-			else
-				middleNunChuckData.joystickX = middleNunchuckMapVariable(middleNunChuckDataJoystickXCentered,middleNunChuckCalibrationData.joystickXMin - middleNunChuckCalibrationData.joystickXCenter,-1,-127,0);
+		// Convert the raw sensor values to usable data
+		middleNunChuckData.buttonC = middleNunChuckSensorData.buttonC;
+		middleNunChuckData.buttonZ = middleNunChuckSensorData.buttonZ;
+		int32_t middleNunChuckDataJoystickXCentered = middleNunChuckSensorData.joystickX - middleNunChuckCalibrationData.joystickXCenter;
+		int32_t middleNunChuckDataJoystickYCentered = middleNunChuckSensorData.joystickY - middleNunChuckCalibrationData.joystickYCenter;
+		
+		if(middleNunChuckDataJoystickXCentered >= 0)
+			middleNunChuckData.joystickX = middleNunchuckMapVariable(middleNunChuckDataJoystickXCentered,0,middleNunChuckCalibrationData.joystickXMax - middleNunChuckCalibrationData.joystickXCenter,0,127);
+		else
+			middleNunChuckData.joystickX = middleNunchuckMapVariable(middleNunChuckDataJoystickXCentered,middleNunChuckCalibrationData.joystickXMin - middleNunChuckCalibrationData.joystickXCenter,-1,-127,0);
 
-			if(middleNunChuckDataJoystickYCentered >= 0)
-				middleNunChuckData.joystickY = middleNunchuckMapVariable(middleNunChuckDataJoystickYCentered,0,middleNunChuckCalibrationData.joystickYMax - middleNunChuckCalibrationData.joystickYCenter,0,127);
-			else
-				middleNunChuckData.joystickY = middleNunchuckMapVariable(middleNunChuckDataJoystickYCentered,middleNunChuckCalibrationData.joystickYMin - middleNunChuckCalibrationData.joystickYCenter,-1,-127,0);
-			
-			// TODO: Map data to the correct range			
-			middleNunChuckData.accelerometerX = middleNunchuckMapVariable((middleNunChuckSensorData.accelerometerX - middleNunChuckCalibrationData.accelero0GX),-(middleNunChuckCalibrationData.accelero1GX-middleNunChuckCalibrationData.accelero0GX)*2,(middleNunChuckCalibrationData.accelero1GX-middleNunChuckCalibrationData.accelero0GX)*2,INT16_MIN,INT16_MAX);
-			middleNunChuckData.accelerometerY = middleNunchuckMapVariable((middleNunChuckSensorData.accelerometerY - middleNunChuckCalibrationData.accelero0GY),-(middleNunChuckCalibrationData.accelero1GY-middleNunChuckCalibrationData.accelero0GY)*2,(middleNunChuckCalibrationData.accelero1GY-middleNunChuckCalibrationData.accelero0GY)*2,INT16_MIN,INT16_MAX);
-			middleNunChuckData.accelerometerZ = middleNunchuckMapVariable((middleNunChuckSensorData.accelerometerZ - middleNunChuckCalibrationData.accelero0GZ),-(middleNunChuckCalibrationData.accelero1GZ-middleNunChuckCalibrationData.accelero0GZ)*2,(middleNunChuckCalibrationData.accelero1GZ-middleNunChuckCalibrationData.accelero0GZ)*2,INT16_MIN,INT16_MAX);
-			
-		}else{
-			middleNunChuckData.dataValid = false;
-			middleNunChuckMeasureInterval = middleNunChuckErrortMeasureInterval;
-			middleNunChuckInit();
-		}
+		if(middleNunChuckDataJoystickYCentered >= 0)
+			middleNunChuckData.joystickY = middleNunchuckMapVariable(middleNunChuckDataJoystickYCentered,0,middleNunChuckCalibrationData.joystickYMax - middleNunChuckCalibrationData.joystickYCenter,0,127);
+		else
+			middleNunChuckData.joystickY = middleNunchuckMapVariable(middleNunChuckDataJoystickYCentered,middleNunChuckCalibrationData.joystickYMin - middleNunChuckCalibrationData.joystickYCenter,-1,-127,0);
 		
-		// If callback is given, call it
-		if(middleNunChuckEventFunctionPointer)
-			middleNunChuckEventFunctionPointer(middleNunChuckData);													// Also update if data is invalid
+		// TODO: Map data to the correct range			
+		middleNunChuckData.accelerometerX = middleNunchuckMapVariable((middleNunChuckSensorData.accelerometerX - middleNunChuckCalibrationData.accelero0GX),-(middleNunChuckCalibrationData.accelero1GX-middleNunChuckCalibrationData.accelero0GX)*2,(middleNunChuckCalibrationData.accelero1GX-middleNunChuckCalibrationData.accelero0GX)*2,INT16_MIN,INT16_MAX);
+		middleNunChuckData.accelerometerY = middleNunchuckMapVariable((middleNunChuckSensorData.accelerometerY - middleNunChuckCalibrationData.accelero0GY),-(middleNunChuckCalibrationData.accelero1GY-middleNunChuckCalibrationData.accelero0GY)*2,(middleNunChuckCalibrationData.accelero1GY-middleNunChuckCalibrationData.accelero0GY)*2,INT16_MIN,INT16_MAX);
+		middleNunChuckData.accelerometerZ = middleNunchuckMapVariable((middleNunChuckSensorData.accelerometerZ - middleNunChuckCalibrationData.accelero0GZ),-(middleNunChuckCalibrationData.accelero1GZ-middleNunChuckCalibrationData.accelero0GZ)*2,(middleNunChuckCalibrationData.accelero1GZ-middleNunChuckCalibrationData.accelero0GZ)*2,INT16_MIN,INT16_MAX);
+		
+	}else if(middleNunChuckCalibrationDataValid) {
+		if(middleNunChuckData.dataValid)
+			modTraceEvent(TRACE_NUNCHUCK_DROPOUT,middleNunChuckValidSamples,0);
+		middleNunChuckValidSamples = 0;
+		middleNunChuckData.dataValid = false;
+		middleNunChuckSetFault(middleNunChuckFaultCommunication,true);
+		middleNunChuckMeasureInterval = middleNunChuckErrortMeasureInterval*modDelayMicrosecondsPerMillisecond;
+		middleNunChuckInit();
+	}else{
+		middleNunChuckData.dataValid = false;
 	}
+	
+	// If callback is given, call it
+	if(middleNunChuckEventFunctionPointer)
+		middleNunChuckEventFunctionPointer(middleNunChuckData);														// Also update if data is invalid
 }
 
 bool middleNunChuckDataValid(void) {
@@ -82,8 +134,35 @@ void middleNunChuckNewDataEvent(void (*eventFunctionPointer)(middleNunChuckDataS
 		middleNunChuckEventFunctionPointer = eventFunctionPointer;
 }
 
+// A fault already present, e.g. no nunchuck at start-up, is reported right away.
+void middleNunChuckFaultEvent(void (*eventFunctionPointer)(uint8_t fault, bool active)) {
+	if(eventFunctionPointer) {
+		middleNunChuckFaultEventFunctionPointer = eventFunctionPointer;
+		for(uint8_t fault = middleNunChuckFaultCommunication; fault <= middleNunChuckFaultCalibration; fault <<= 1)
+			if(middleNunChuckFaults & fault)
+				eventFunctionPointer(fault,true);
+	}
+}
+
+static void middleNunChuckSetFault(uint8_t fault, bool active) {
+	if(((middleNunChuckFaults & fault) != 0) == active)
+		return;
+	
+	if(active)
+		middleNunChuckFaults |= fault;
+	else
+		middleNunChuckFaults &= ~fault;
+	
+	if(middleNunChuckFaultEventFunctionPointer)
+		middleNunChuckFaultEventFunctionPointer(fault,active);
+}
+
 void middleNunChuckSetMeasureInterval(uint32_t delayInMS) {
-	middleNunChuckMeasureIntervalDesired = delayInMS;
+	middleNunChuckSetMeasureIntervalMicroseconds(delayInMS*modDelayMicrosecondsPerMillisecond);
+}
+
+void middleNunChuckSetMeasureIntervalMicroseconds(uint32_t delayInUS) {
+	middleNunChuckSettings.MeasureInterval = delayInUS;
 }
 
 int32_t middleNunchuckMapVariable(int32_t inputVariable, int32_t inputLowerLimit, int32_t inputUpperLimit, int32_t outputLowerLimit, int32_t outputUpperLimit) {
@@ -0,0 +1,455 @@
+#include "middleParameter.h"
+#include <string.h>
+#include <stddef.h>
+
+#define middleParameterNoPage								0xFF
+#define middleParameterKeyAny								middleParameterKeyErased							// Find any record, no record has this key
+#define middleParameterQueue								((uint8_t *)middleParameterQueueWords)
+#define middleParameterSequenceErased				0xFFFFFFFF
+#define middleParameterCompactSlots					256																// Power of two, more than the records a page holds
+#define middleParameterSuperseded						0x8000														// Compaction slot flag, the queue holds a newer one
+
+typedef struct {
+	uint32_t Magic;
+	uint32_t Sequence;
+} middleParameterPageStruct;
+
+typedef struct {
+	uint32_t Key;
+	uint16_t Length;																																		// Data bytes, without the padding
+	uint16_t Reserved;
+} middleParameterRecordStruct;
+
+CC_STATIC_ASSERT(objectlistParameterCount <= 32);																			// Loaded entries are bits of a word
+CC_STATIC_ASSERT(middleParameterCompactSlots > driverHWFlashPageSize/(sizeof(middleParameterRecordStruct) + sizeof(uint32_t)));
+
+middleParameterStatusStruct middleParameterStatus = {middleParameterOnCommand, middleParameterOnCommand};
+static uint32_t middleParameterQueueWords[middleParameterQueueSize/sizeof(uint32_t)];									// Records are read in place
+static uint16_t middleParameterQueued = 0;																						// Bytes of records in the queue
+static uint16_t middleParameterBatch = 0;																							// Leading queue bytes being programmed
+static uint16_t middleParameterProgrammed = 0;																				// Of the batch
+static bool middleParameterCompacting = false;																				// The batch goes to the other page
+static uint8_t middleParameterActive = middleParameterNoPage;
+static uint32_t middleParameterSequence = 0;																					// Of the active page
+static uint16_t middleParameterEnd = 0;																								// First free byte in the active page
+static bool middleParameterSpareErased = false;
+static uint16_t middleParameterCompactTable[middleParameterCompactSlots];											// Page offset of the latest record of a key, 0 free
+
+void (*middleParameterObjectWriteFunctionPointer)(uint16_t index, uint8_t subIndex);
+
+static uint32_t middleParameterPageAddress(uint8_t page) {
+	return middleParameterJournalAddress + page*driverHWFlashPageSize;
+}
+
+static uint8_t middleParameterSpare(void) {
+	return (middleParameterActive == middleParameterNoPage) ? 0 : middleParameterActive ^ 1;
+}
+
+static uint16_t middleParameterRecordSize(uint16_t length) {
+	return sizeof(middleParameterRecordStruct) + ((length + 3) & ~3) + sizeof(uint32_t);
+}
+
+// Next record of a run, NULL at the end. A header cut short by a reset ends the run, nothing behind it can be trusted;
+// a record cut short further on fails its CRC, it is skipped and the one before it stays current.
+static const middleParameterRecordStruct *middleParameterNext(const uint8_t *records, uint16_t length, uint16_t *offset, bool *valid) {
+	const middleParameterRecordStruct *record = (const middleParameterRecordStruct *)&records[*offset];
+	uint32_t checksum;
+	uint16_t size;
+
+	if(*offset + sizeof(middleParameterRecordStruct) > length || record->Key == middleParameterKeyErased)
+		return NULL;
+
+	size = middleParameterRecordSize(record->Length);
+	if(record->Length > middleParameterMaximumLength || *offset + size > length) {
+		*offset = length;
+		return NULL;
+	}
+
+	memcpy(&checksum,&records[*offset + size - sizeof(checksum)],sizeof(checksum));
+	*valid = (checksum == middleBootControlCRC(0,(const uint8_t *)record,size - sizeof(checksum)));
+	*offset += size;
+	return record;
+}
+
+// Latest valid record of key from offset on, a restore marker forgets the ones before it.
+static const middleParameterRecordStruct *middleParameterScan(const uint8_t *records, uint16_t length, uint16_t offset, uint32_t key,
+	const middleParameterRecordStruct *latest) {
+	const middleParameterRecordStruct *record;
+	bool valid;
+
+	while((record = middleParameterNext(records,length,&offset,&valid))) {
+		if(!valid)
+			continue;
+		if(record->Key == middleParameterKeyDefaults)
+			latest = NULL;
+		else if(record->Key == key || key == middleParameterKeyAny)
+			latest = record;
+	}
+
+	return latest;
+}
+
+// Offset behind the last valid restore marker, where the records that count start.
+static uint16_t middleParameterRestoredAt(const uint8_t *records, uint16_t length, uint16_t offset) {
+	const middleParameterRecordStruct *record;
+	uint16_t start = offset;
+	bool valid;
+
+	while((record = middleParameterNext(records,length,&offset,&valid)))
+		if(valid && record->Key == middleParameterKeyDefaults)
+			start = offset;
+
+	return start;
+}
+
+// The active page first, then the queue, which is newer.
+static const middleParameterRecordStruct *middleParameterFind(uint32_t key) {
+	const middleParameterRecordStruct *latest = NULL;
+
+	if(middleParameterActive != middleParameterNoPage)
+		latest = middleParameterScan(driverHWFlashRead(middleParameterPageAddress(middleParameterActive)),middleParameterEnd,
+			sizeof(middleParameterPageStruct),key,NULL);
+
+	return middleParameterScan(middleParameterQueue,middleParameterQueued,0,key,latest);
+}
+
+static bool middleParameterEnqueue(uint32_t key, const void *data, uint16_t length) {
+	middleParameterRecordStruct record = {key, length, 0xFFFF};
+	uint16_t size = middleParameterRecordSize(length);
+	uint8_t *out = &middleParameterQueue[middleParameterQueued];
+	uint32_t checksum;
+
+	if(length > middleParameterMaximumLength || middleParameterQueued + size > middleParameterQueueSize)
+		return false;
+
+	memset(out,0xFF,size);																														// Padding left erased, saves programming it
+	memcpy(out,&record,sizeof(record));
+	if(length)
+		memcpy(out + sizeof(record),data,length);
+	checksum = middleBootControlCRC(0,out,size - sizeof(checksum));
+	memcpy(out + size - sizeof(checksum),&checksum,sizeof(checksum));
+	middleParameterQueued += size;
+
+	if(middleParameterStatus.State != PARAMETER_WAITING)
+		middleParameterStatus.State = PARAMETER_WRITING;
+	return true;
+}
+
+static bool middleParameterPageErased(uint8_t page) {
+	const uint8_t *bytes = driverHWFlashRead(middleParameterPageAddress(page));
+
+	for(uint16_t n = 0; n < driverHWFlashPageSize; n++)
+		if(bytes[n] != 0xFF)
+			return false;
+
+	return true;
+}
+
+// Slot of key in the compaction table: the one holding it, else the free one it would go to.
+static uint16_t *middleParameterCompactSlot(const uint8_t *page, uint32_t key) {
+	uint16_t slot = (uint16_t)((uint32_t)(key*2654435761u) >> 16) & (middleParameterCompactSlots - 1);						// Fibonacci hash
+	uint16_t entry;
+
+	while((entry = middleParameterCompactTable[slot] & ~middleParameterSuperseded) &&
+		((const middleParameterRecordStruct *)&page[entry])->Key != key)
+		slot = (slot + 1) & (middleParameterCompactSlots - 1);
+
+	return &middleParameterCompactTable[slot];
+}
+
+// Builds the batch for the other page: the records still current in the active page, then the queue. A restore
+// marker in the queue voids the page and what was queued before it, the fresh page then starts without it. Every
+// record is looked at a fixed number of times, the table keeps the latest page record of each key.
+static bool middleParameterCompact(void) {
+	const middleParameterRecordStruct *record;
+	const uint8_t *page;
+	uint16_t restored = middleParameterRestoredAt(middleParameterQueue,middleParameterQueued,0);
+	uint16_t start, offset, live = 0, *slot;
+	bool valid;
+
+	if(restored) {
+		middleParameterQueued -= restored;
+		memmove(middleParameterQueue,&middleParameterQueue[restored],middleParameterQueued);
+	}else if(middleParameterActive != middleParameterNoPage) {
+		page = driverHWFlashRead(middleParameterPageAddress(middleParameterActive));
+		start = middleParameterRestoredAt(page,middleParameterEnd,sizeof(middleParameterPageStruct));
+		memset(middleParameterCompactTable,0,sizeof(middleParameterCompactTable));
+
+		// Later records of a key take its slot over, the queued ones supersede it
+		offset = start;
+		while((record = middleParameterNext(page,middleParameterEnd,&offset,&valid)))
+			if(valid)
+				*middleParameterCompactSlot(page,record->Key) = (uint16_t)((const uint8_t *)record - page);
+		offset = 0;
+		while((record = middleParameterNext(middleParameterQueue,middleParameterQueued,&offset,&valid)))
+			if(valid && *(slot = middleParameterCompactSlot(page,record->Key)))
+				*slot |= middleParameterSuperseded;
+
+		for(uint16_t n = 0; n < middleParameterCompactSlots; n++)
+			if(middleParameterCompactTable[n] && !(middleParameterCompactTable[n] & middleParameterSuperseded))
+				live += middleParameterRecordSize(((const middleParameterRecordStruct *)&page[middleParameterCompactTable[n]])->Length);
+		if(live + middleParameterQueued > middleParameterQueueSize)
+			return false;
+
+		// Copied in page order in front of the queue
+		memmove(&middleParameterQueue[live],middleParameterQueue,middleParameterQueued);
+		middleParameterQueued += live;
+		live = 0;
+		offset = start;
+		while((record = middleParameterNext(page,middleParameterEnd,&offset,&valid))) {
+			if(!valid || *middleParameterCompactSlot(page,record->Key) != (uint16_t)((const uint8_t *)record - page))
+				continue;																																			// Superseded
+			memcpy(&middleParameterQueue[live],record,middleParameterRecordSize(record->Length));
+			live += middleParameterRecordSize(record->Length);
+		}
+	}
+
+	return (middleParameterQueued <= driverHWFlashPageSize - sizeof(middleParameterPageStruct));
+}
+
+static void middleParameterFail(void) {
+	middleParameterStatus.State = PARAMETER_FAILED;
+	if(middleParameterCompacting)
+		middleParameterSpareErased = false;
+	else
+		middleParameterEnd = driverHWFlashPageSize;																	// Partly written, the next store compacts
+	middleParameterCompacting = false;
+	middleParameterQueued = 0;
+	middleParameterBatch = 0;
+}
+
+// Finds the active page and its end, the module records can be read from here on.
+void middleParameterInit(void) {
+	const middleParameterPageStruct *header;
+	const uint8_t *page;
+	uint16_t offset;
+	bool valid;
+
+	middleParameterActive = middleParameterNoPage;
+	for(uint8_t p = 0; p < middleParameterJournalPages; p++) {
+		header = (const middleParameterPageStruct *)driverHWFlashRead(middleParameterPageAddress(p));
+		if(header->Magic == middleParameterPageMagic && header->Sequence != middleParameterSequenceErased &&
+			(middleParameterActive == middleParameterNoPage || header->Sequence > middleParameterSequence)) {
+			middleParameterActive = p;
+			middleParameterSequence = header->Sequence;
+		}
+	}
+
+	middleParameterQueued = 0;
+	middleParameterBatch = 0;
+	middleParameterCompacting = false;
+	middleParameterSpareErased = middleParameterPageErased(middleParameterSpare());
+	middleParameterEnd = sizeof(middleParameterPageStruct);
+	middleParameterStatus.Save = middleParameterOnCommand;
+	middleParameterStatus.Restore = middleParameterOnCommand;
+	middleParameterStatus.State = PARAMETER_IDLE;
+	middleParameterStatus.Records = 0;
+	middleParameterStatus.Compactions = 0;
+
+	if(middleParameterActive != middleParameterNoPage) {
+		page = driverHWFlashRead(middleParameterPageAddress(middleParameterActive));
+		offset = middleParameterEnd;
+		while(middleParameterNext(page,driverHWFlashPageSize,&offset,&valid));
+		middleParameterEnd = offset;
+	}
+	middleParameterStatus.Free = driverHWFlashPageSize - middleParameterEnd;
+}
+
+// After the module inits, puts the stored dictionary values in place. One pass from the last restore marker on,
+// later records overwrite earlier ones.
+void middleParameterLoad(void) {
+	const middleParameterRecordStruct *record;
+	const uint8_t *page;
+	uint16_t offset;
+	uint32_t loaded = 0;
+	bool valid;
+
+	if(middleParameterActive != middleParameterNoPage) {
+		page = driverHWFlashRead(middleParameterPageAddress(middleParameterActive));
+		offset = middleParameterRestoredAt(page,middleParameterEnd,sizeof(middleParameterPageStruct));
+		while((record = middleParameterNext(page,middleParameterEnd,&offset,&valid))) {
+			for(uint8_t n = 0; valid && n < objectlistParameterCount; n++) {
+				if(objectlistParameters[n].Key == record->Key && objectlistParameters[n].Size == record->Length) {
+					memcpy(objectlistParameters[n].Data,record + 1,record->Length);
+					loaded |= 1UL << n;
+				}
+			}
+		}
+	}
+
+	// Through the same handler as an SDO download, so the modules take the values up
+	for(uint8_t n = 0; n < objectlistParameterCount; n++)
+		if((loaded & (1UL << n)) && middleParameterObjectWriteFunctionPointer)
+			middleParameterObjectWriteFunctionPointer(objectlistParameters[n].Key >> 8,objectlistParameters[n].Key & 0xFF);
+}
+
+// One flash operation per run: an erase, or a slice of the batch, then the page header when compacting. Flash work
+// stalls the core, with process data running the records stay queued and a batch part way waits where it is.
+void middleParameterTask(void) {
+	uint8_t state = ESCvar.ALstatus & 0x0f;
+	uint8_t spare = middleParameterSpare();
+	uint32_t address;
+	uint16_t slice, offset = 0;
+	bool valid;
+
+	if(state == ESCsafeop || state == ESCop) {
+		if(middleParameterQueued)
+			middleParameterStatus.State = PARAMETER_WAITING;
+		return;
+	}
+
+	if(!middleParameterBatch) {
+		if(!middleParameterQueued) {
+			// Nothing to write, get the other page ready for the next compaction
+			if(!middleParameterSpareErased && middleParameterActive != middleParameterNoPage) {
+				if(driverHWFlashErasePage(middleParameterPageAddress(spare)))
+					middleParameterSpareErased = true;
+			}
+			return;
+		}
+
+		if(middleParameterActive != middleParameterNoPage && middleParameterEnd + middleParameterQueued <= driverHWFlashPageSize) {
+			middleParameterCompacting = false;
+		}else{
+			if(!middleParameterSpareErased) {
+				if(!driverHWFlashErasePage(middleParameterPageAddress(spare))) {
+					middleParameterFail();
+					return;
+				}
+				middleParameterSpareErased = true;
+				return;
+			}
+			if(!middleParameterCompact()) {
+				middleParameterFail();
+				return;
+			}
+			middleParameterCompacting = true;
+		}
+
+		middleParameterBatch = middleParameterQueued;
+		middleParameterProgrammed = 0;
+	}
+	middleParameterStatus.State = PARAMETER_WRITING;
+
+	address = middleParameterCompacting ? middleParameterPageAddress(spare) + sizeof(middleParameterPageStruct) :
+		middleParameterPageAddress(middleParameterActive) + middleParameterEnd;
+	slice = middleParameterBatch - middleParameterProgrammed;
+	if(slice > middleParameterProgramSlice)
+		slice = middleParameterProgramSlice;
+	if(!driverHWFlashProgram(address + middleParameterProgrammed,&middleParameterQueue[middleParameterProgrammed],slice)) {
+		middleParameterFail();
+		return;
+	}
+	middleParameterProgrammed += slice;
+	if(middleParameterProgrammed < middleParameterBatch)
+		return;
+
+	if(middleParameterCompacting) {
+		// Header last, the sequence before the magic that makes the page valid
+		middleParameterPageStruct header = {middleParameterPageMagic, middleParameterSequence + 1};
+		address = middleParameterPageAddress(spare);
+		if(!driverHWFlashProgram(address + offsetof(middleParameterPageStruct,Sequence),(const uint8_t *)&header.Sequence,sizeof(header.Sequence)) ||
+			!driverHWFlashProgram(address,(const uint8_t *)&header.Magic,sizeof(header.Magic))) {
+			middleParameterFail();
+			return;
+		}
+		middleParameterActive = spare;
+		middleParameterSequence = header.Sequence;
+		middleParameterEnd = sizeof(middleParameterPageStruct);
+		middleParameterSpareErased = false;
+		middleParameterCompacting = false;
+		middleParameterStatus.Compactions++;
+	}
+
+	while(middleParameterNext(middleParameterQueue,middleParameterBatch,&offset,&valid))
+		middleParameterStatus.Records++;
+	middleParameterEnd += middleParameterBatch;
+	middleParameterQueued -= middleParameterBatch;
+	memmove(middleParameterQueue,&middleParameterQueue[middleParameterBatch],middleParameterQueued);
+	middleParameterBatch = 0;
+	middleParameterStatus.Free = driverHWFlashPageSize - middleParameterEnd;
+	middleParameterStatus.State = middleParameterQueued ? PARAMETER_WRITING : PARAMETER_IDLE;
+}
+
+void middleParameterObjectWriteEvent(void (*eventFunctionPointer)(uint16_t index, uint8_t subIndex)) {
+	if(eventFunctionPointer)
+		middleParameterObjectWriteFunctionPointer = eventFunctionPointer;
+}
+
+// Whether the latest record of key holds this data already.
+static bool middleParameterUnchanged(uint32_t key, const void *data, uint16_t length) {
+	const middleParameterRecordStruct *record = middleParameterFind(key);
+
+	return record && record->Length == length && !memcmp(record + 1,data,length);
+}
+
+// Whether the queue takes all that a store (0x1010) or restore (0x1011) would queue now. Asked before the download is
+// confirmed, the master gets an abort instead of a command that never reaches flash.
+bool middleParameterCommandFits(uint16_t index) {
+	uint16_t size = 0;
+
+	if(index == 0x1011)
+		return middleParameterBatch + middleParameterRecordSize(0) <= middleParameterQueueSize;
+
+	for(uint8_t n = 0; n < objectlistParameterCount; n++)
+		if(!middleParameterUnchanged(objectlistParameters[n].Key,objectlistParameters[n].Data,objectlistParameters[n].Size))
+			size += middleParameterRecordSize(objectlistParameters[n].Size);
+
+	return middleParameterQueued + size <= middleParameterQueueSize;
+}
+
+// 0x1010:01 written with the signature. Queues every flagged entry that differs from its stored value, all of them or
+// none.
+bool middleParameterStore(void) {
+	bool ok = true;
+
+	middleParameterStatus.Save = middleParameterOnCommand;
+	if(!middleParameterCommandFits(0x1010)) {
+		middleParameterStatus.State = PARAMETER_FAILED;
+		return false;
+	}
+	for(uint8_t n = 0; n < objectlistParameterCount; n++)
+		ok = middleParameterWrite(objectlistParameters[n].Key,objectlistParameters[n].Data,objectlistParameters[n].Size) && ok;
+
+	return ok;
+}
+
+// 0x1011:01 written with the signature. The values in use stay until the next reset, as CiA 301 has it.
+bool middleParameterRestoreDefaults(void) {
+	middleParameterStatus.Restore = middleParameterOnCommand;
+	middleParameterQueued = middleParameterBatch;																		// Not on its way to flash yet, void anyway
+
+	if(!middleParameterFind(middleParameterKeyAny))
+		return true;																																		// Nothing stored, spare the flash a marker
+	if(!middleParameterEnqueue(middleParameterKeyDefaults,NULL,0)) {
+		middleParameterStatus.State = PARAMETER_FAILED;
+		return false;
+	}
+	return true;
+}
+
+// Queues a record unless the latest one of the key holds the same data already.
+bool middleParameterWrite(uint32_t key, const void *data, uint16_t length) {
+	if(key == middleParameterKeyDefaults || key == middleParameterKeyErased)
+		return false;
+
+	if(middleParameterUnchanged(key,data,length))
+		return true;
+
+	return middleParameterEnqueue(key,data,length);
+}
+
+// Latest value of key, queued or in flash. False when there is none of that length.
+bool middleParameterRead(uint32_t key, void *data, uint16_t length) {
+	const middleParameterRecordStruct *record = middleParameterFind(key);
+
+	if(!record || record->Length != length)
+		return false;
+
+	memcpy(data,record + 1,length);
+	return true;
+}
+
+const middleParameterStatusStruct *middleParameterGetStatus(void) {
+	return &middleParameterStatus;
+}
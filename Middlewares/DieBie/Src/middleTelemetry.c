@@ -0,0 +1,290 @@
+#include "middleTelemetry.h"
+#include "middleCapture.h"
+#include "modDelay.h"
+#include <string.h>
+
+static void middleTelemetryReceive(const middleNetworkEndpointStruct *from, const uint8_t *data, uint16_t length);
+static void middleTelemetryTransmitReady(void);
+static bool middleTelemetryPushSamples(void);
+static bool middleTelemetryPushProfile(void);
+static bool middleTelemetryPushTrace(void);
+
+#define middleTelemetryStreamCount						3
+
+static bool (*const middleTelemetryPushFunctions[middleTelemetryStreamCount])(void) = {		// In middleTelemetryStream* bit order
+	&middleTelemetryPushSamples,
+	&middleTelemetryPushProfile,
+	&middleTelemetryPushTrace
+};
+
+middleTelemetryStatusStruct middleTelemetryStatus;
+middleTelemetrySampleStruct middleTelemetrySamples[middleTelemetrySampleRecords];
+uint32_t middleTelemetrySampleHead;																										// Samples since start-up
+uint32_t middleTelemetrySampleNext;																										// First one not pushed yet
+uint32_t middleTelemetryTraceNext;																										// First trace record not pushed yet
+bool middleTelemetrySubscribed;
+middleNetworkEndpointStruct middleTelemetrySubscriber;
+uint8_t middleTelemetryDue;																														// Streams with something to push
+uint8_t middleTelemetryLastStream;
+uint32_t middleTelemetryLastPush;
+uint8_t middleTelemetryPushSequence;
+bool middleTelemetryResponsePending;																									// Waiting for the tx buffer
+middleNetworkEndpointStruct middleTelemetryResponseTo;
+middleTelemetryHeaderStruct middleTelemetryResponseHeader;
+uint8_t middleTelemetryResponseResult;
+
+void middleTelemetryInit(void) {
+	memset(&middleTelemetryStatus,0,sizeof(middleTelemetryStatus));
+	middleTelemetrySampleHead = 0;
+	middleTelemetrySampleNext = 0;
+	middleTelemetryTraceNext = 0;
+	middleTelemetrySubscribed = false;
+	middleTelemetryDue = 0;
+	middleTelemetryLastStream = 0;
+	middleTelemetryPushSequence = 0;
+	middleTelemetryResponsePending = false;
+
+	middleNetworkUDPBind(middleTelemetryPort,&middleTelemetryReceive);
+	middleNetworkTransmitReadyEvent(&middleTelemetryTransmitReady);
+}
+
+// Every sensor sample, from the nunchuck data event. Only kept until pushed, without a subscriber the ring just wraps.
+void middleTelemetrySample(const middleNunChuckDataStruct *data) {
+	middleTelemetrySampleStruct *sample = &middleTelemetrySamples[middleTelemetrySampleHead % middleTelemetrySampleRecords];
+
+	sample->Time = modDelayGetMicroseconds();
+	sample->AcceleroMeter[0] = data->accelerometerX;
+	sample->AcceleroMeter[1] = data->accelerometerY;
+	sample->AcceleroMeter[2] = data->accelerometerZ;
+	sample->JoyStickX = data->joystickX;
+	sample->JoyStickY = data->joystickY;
+	sample->Flags = (data->buttonC ? middleCaptureFlagButtonC : 0) | (data->buttonZ ? middleCaptureFlagButtonZ : 0) |
+		(data->dataValid ? middleCaptureFlagDataValid : 0);
+	sample->Reserved = 0;
+
+	middleTelemetrySampleHead++;
+}
+
+static uint8_t *middleTelemetryStart(uint16_t *capacity, uint8_t type, uint8_t sequence) {
+	middleTelemetryHeaderStruct header = {middleTelemetryMagic, type, sequence};
+	uint8_t *payload = middleNetworkUDPPayload(capacity);
+
+	if(payload)
+		memcpy(payload,&header,sizeof(header));
+
+	return payload;
+}
+
+static bool middleTelemetrySendResponse(void) {
+	middleTelemetryResponseStruct response;
+	uint8_t *payload = middleTelemetryStart(NULL,middleTelemetryResponseHeader.Type,middleTelemetryResponseHeader.Sequence);
+
+	if(!payload)
+		return false;
+
+	response.Result = middleTelemetryResponseResult;
+	response.Streams = middleTelemetryStatus.Streams;
+	response.Period = middleTelemetryStatus.Period;
+	response.Uptime = modDelayGetMicroseconds();
+	memcpy(payload + sizeof(middleTelemetryHeaderStruct),&response,sizeof(response));
+
+	middleTelemetryResponsePending = false;
+	return middleNetworkUDPSend(&middleTelemetryResponseTo,middleTelemetryPort,sizeof(middleTelemetryHeaderStruct) + sizeof(response));
+}
+
+static bool middleTelemetryPush(uint16_t length) {
+	middleTelemetryPushSequence++;
+	middleTelemetryStatus.Pushes++;
+
+	return middleNetworkUDPSend(&middleTelemetrySubscriber,middleTelemetryPort,sizeof(middleTelemetryHeaderStruct) + length);
+}
+
+// Each push function returns whether it sent a datagram, and takes its stream off the due list once caught up.
+static bool middleTelemetryPushSamples(void) {
+	middleTelemetrySamplesStruct samples;
+	uint32_t pending = middleTelemetrySampleHead - middleTelemetrySampleNext;
+	uint8_t *payload;
+
+	samples.Dropped = 0;
+	if(pending > middleTelemetrySampleRecords) {
+		samples.Dropped = pending - middleTelemetrySampleRecords;
+		middleTelemetryStatus.SamplesDropped += samples.Dropped;
+		middleTelemetrySampleNext = middleTelemetrySampleHead - middleTelemetrySampleRecords;
+		pending = middleTelemetrySampleRecords;
+	}
+	if(!pending) {
+		middleTelemetryDue &= ~middleTelemetryStreamSamples;
+		return false;
+	}
+
+	payload = middleTelemetryStart(NULL,TELEMETRY_SAMPLES,middleTelemetryPushSequence);
+	if(!payload)
+		return false;
+
+	samples.FirstSequence = middleTelemetrySampleNext;
+	samples.Count = (pending > middleTelemetrySamplesPerDatagram) ? middleTelemetrySamplesPerDatagram : pending;
+	payload += sizeof(middleTelemetryHeaderStruct);
+	memcpy(payload,&samples,sizeof(samples));
+	payload += sizeof(samples);
+	for(uint16_t sample = 0; sample < samples.Count; sample++) {
+		memcpy(payload,&middleTelemetrySamples[(middleTelemetrySampleNext + sample) % middleTelemetrySampleRecords],sizeof(middleTelemetrySampleStruct));
+		payload += sizeof(middleTelemetrySampleStruct);
+	}
+
+	middleTelemetrySampleNext += samples.Count;
+	if(middleTelemetrySampleNext == middleTelemetrySampleHead)
+		middleTelemetryDue &= ~middleTelemetryStreamSamples;
+
+	return middleTelemetryPush(sizeof(samples) + samples.Count*sizeof(middleTelemetrySampleStruct));
+}
+
+static bool middleTelemetryPushProfile(void) {
+	middleTelemetryProfileStruct profile;
+	middleTelemetryTaskStruct task;
+	const modSchedulerTaskStruct *schedulerTask;
+	const modSchedulerIdleStruct *idle = modSchedulerGetIdle();
+	uint8_t *payload = middleTelemetryStart(NULL,TELEMETRY_PROFILE,middleTelemetryPushSequence);
+	uint8_t *records;
+
+	if(!payload)
+		return false;
+
+	memset(&profile,0,sizeof(profile));
+	profile.SleepTime = idle->SleepTime;
+	profile.WakeCount = idle->WakeCount;
+	profile.WorstWakeLatency = idle->WorstWakeLatency;
+	records = payload + sizeof(middleTelemetryHeaderStruct) + sizeof(profile);
+	while((schedulerTask = modSchedulerGetTask(profile.Tasks)) != NULL) {
+		memset(task.Name,0,sizeof(task.Name));
+		memcpy(task.Name,schedulerTask->Name,strnlen(schedulerTask->Name,sizeof(task.Name)));
+		task.RunCount = schedulerTask->RunCount;
+		task.DeadlineMisses = schedulerTask->DeadlineMisses;
+		task.BudgetOverruns = schedulerTask->BudgetOverruns;
+		task.WorstExecutionTime = schedulerTask->WorstExecutionTime;
+		task.WorstReleaseLatency = schedulerTask->WorstReleaseLatency;
+		memcpy(records + profile.Tasks*sizeof(task),&task,sizeof(task));
+		profile.Tasks++;
+	}
+	memcpy(payload + sizeof(middleTelemetryHeaderStruct),&profile,sizeof(profile));
+
+	middleTelemetryDue &= ~middleTelemetryStreamProfile;
+	return middleTelemetryPush(sizeof(profile) + profile.Tasks*sizeof(task));
+}
+
+static bool middleTelemetryPushTrace(void) {
+	middleTelemetryTraceStruct trace;
+	modTraceSnapshotStruct snapshot;
+	uint8_t *payload;
+
+	modTraceSnapshotSince(&snapshot,middleTelemetryTraceNext);
+	if(!snapshot.Records) {
+		middleTelemetryDue &= ~middleTelemetryStreamTrace;
+		return false;
+	}
+
+	payload = middleTelemetryStart(NULL,TELEMETRY_TRACE,middleTelemetryPushSequence);
+	if(!payload)
+		return false;
+
+	trace.FirstSequence = snapshot.FirstSequence;
+	trace.Records = (snapshot.Records > middleTelemetryTracePerDatagram) ? middleTelemetryTracePerDatagram : snapshot.Records;
+	trace.TicksPerMicrosecond = modTraceTicksPerMicrosecond;
+	payload += sizeof(middleTelemetryHeaderStruct);
+	memcpy(payload,&trace,sizeof(trace));
+	modTraceRead(&snapshot,sizeof(modTraceHeaderStruct),payload + sizeof(trace),trace.Records*sizeof(modTraceRecordStruct));
+
+	middleTelemetryTraceNext = snapshot.FirstSequence + trace.Records;
+	if(trace.Records == snapshot.Records)
+		middleTelemetryDue &= ~middleTelemetryStreamTrace;
+
+	return middleTelemetryPush(sizeof(trace) + trace.Records*sizeof(modTraceRecordStruct));
+}
+
+// The network buffer is free. An answer goes first, then at most one push.
+static void middleTelemetryTransmitReady(void) {
+	if(middleTelemetryResponsePending) {
+		middleTelemetrySendResponse();
+		return;
+	}
+	if(!middleTelemetrySubscribed)
+		return;
+
+	if(modDelayTick1us(&middleTelemetryLastPush,middleTelemetryStatus.Period*modDelayMicrosecondsPerMillisecond))
+		middleTelemetryDue |= middleTelemetryStatus.Streams;
+
+	// Round robin from the stream after the last one pushed, a link slower than the period still gets every stream through
+	for(uint8_t turn = 0; turn < middleTelemetryStreamCount; turn++) {
+		middleTelemetryLastStream = (middleTelemetryLastStream + 1) % middleTelemetryStreamCount;
+		if((middleTelemetryDue & (1 << middleTelemetryLastStream)) && middleTelemetryPushFunctions[middleTelemetryLastStream]())
+			return;
+	}
+}
+
+static void middleTelemetryReceive(const middleNetworkEndpointStruct *from, const uint8_t *data, uint16_t length) {
+	middleTelemetryHeaderStruct header;
+	middleTelemetrySubscribeStruct subscribe;
+	modTraceSnapshotStruct snapshot;
+	uint8_t result = TELEMETRY_OK;
+
+	if(length < sizeof(header)) {
+		middleTelemetryStatus.Invalid++;
+		return;
+	}
+	memcpy(&header,data,sizeof(header));
+	if(header.Magic != middleTelemetryMagic || (header.Type & middleTelemetryResponse)) {
+		middleTelemetryStatus.Invalid++;
+		return;																																						// Not ours, or an answer bounced back
+	}
+	middleTelemetryStatus.Requests++;
+	length -= sizeof(header);
+
+	switch(header.Type) {
+		case TELEMETRY_PING:
+			break;
+		case TELEMETRY_SUBSCRIBE:
+			if(length < sizeof(subscribe)) {
+				result = TELEMETRY_INVALID;
+				break;
+			}
+			memcpy(&subscribe,data + sizeof(header),sizeof(subscribe));
+			if(!subscribe.Streams || (subscribe.Streams & ~middleTelemetryStreams)) {
+				result = TELEMETRY_INVALID;
+				break;
+			}
+
+			// Samples from now on, the trace with the history still in the ring
+			modTraceSnapshot(&snapshot);
+			middleTelemetryTraceNext = snapshot.FirstSequence;
+			middleTelemetrySampleNext = middleTelemetrySampleHead;
+			memcpy(&middleTelemetrySubscriber,from,sizeof(middleTelemetrySubscriber));
+			middleTelemetryStatus.Streams = subscribe.Streams;
+			middleTelemetryStatus.Period = subscribe.Period ? subscribe.Period : middleTelemetryDefaultPeriod;
+			middleTelemetryLastPush = modDelayGetMicroseconds();
+			middleTelemetryDue = 0;
+			middleTelemetrySubscribed = true;
+			break;
+		case TELEMETRY_UNSUBSCRIBE:
+			middleTelemetrySubscribed = false;
+			middleTelemetryStatus.Streams = 0;
+			middleTelemetryDue = 0;
+			break;
+		default:
+			result = TELEMETRY_UNKNOWN_TYPE;
+			break;
+	}
+	if(result != TELEMETRY_OK)
+		middleTelemetryStatus.Invalid++;
+
+	// Answered right away when the buffer is free, else from the transmit ready event. A newer request replaces one
+	// still waiting, the client resends on a timeout anyway
+	memcpy(&middleTelemetryResponseTo,from,sizeof(middleTelemetryResponseTo));
+	middleTelemetryResponseHeader = header;
+	middleTelemetryResponseHeader.Type |= middleTelemetryResponse;
+	middleTelemetryResponseResult = result;
+	middleTelemetryResponsePending = true;
+	middleTelemetrySendResponse();
+}
+
+const middleTelemetryStatusStruct *middleTelemetryGetStatus(void) {
+	return &middleTelemetryStatus;
+}
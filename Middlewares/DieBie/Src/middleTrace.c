@@ -0,0 +1,77 @@
+#include "middleTrace.h"
+
+middleTraceStatusStruct middleTraceStatus;
+modTraceSnapshotStruct middleTraceFoESnapshot;
+modTraceSnapshotStruct middleTraceStreamSnapshot;
+uint8_t middleTraceStreamBuffer[middleTraceStreamChunk];
+uint16_t middleTraceStreamBuffered;																										// Bytes waiting in the buffer to be accepted
+uint32_t middleTraceStreamOffset;
+bool middleTraceStreaming;
+volatile bool middleTraceStreamRequested;
+
+bool (*middleTraceStreamTransmitFunctionPointer)(uint8_t *data, uint16_t length);
+
+void middleTraceInit(void) {
+	memset(&middleTraceStatus,0,sizeof(middleTraceStatus));
+	middleTraceStreamBuffered = 0;
+	middleTraceStreaming = false;
+	middleTraceStreamRequested = false;
+}
+
+void middleTraceTask(void) {
+	modTraceTask();
+
+	if(middleTraceStreamRequested && !middleTraceStreaming) {
+		middleTraceStreamRequested = false;
+		modTraceSnapshot(&middleTraceStreamSnapshot);
+		middleTraceStreamOffset = 0;
+		middleTraceStreamBuffered = 0;
+		middleTraceStreaming = true;
+		middleTraceStatus.StreamDumps++;
+	}
+
+	// As many packets as the port takes right away. A packet stays in the buffer until it is accepted, the transmitter
+	// copies it into the USB packet memory then
+	while(middleTraceStreaming) {
+		if(!middleTraceStreamBuffered) {
+			middleTraceStreamBuffered = modTraceRead(&middleTraceStreamSnapshot,middleTraceStreamOffset,middleTraceStreamBuffer,middleTraceStreamChunk);
+			if(!middleTraceStreamBuffered) {
+				middleTraceStreaming = false;
+				break;
+			}
+		}
+
+		if(!middleTraceStreamTransmitFunctionPointer || !middleTraceStreamTransmitFunctionPointer(middleTraceStreamBuffer,middleTraceStreamBuffered))
+			break;
+
+		middleTraceStreamOffset += middleTraceStreamBuffered;
+		middleTraceStatus.StreamBytes += middleTraceStreamBuffered;
+		middleTraceStreamBuffered = 0;
+	}
+}
+
+// Read hook of trace.bin. The first packet fixes what the file holds, the rest is copied from the ring as it goes.
+uint32_t middleTraceFoERead(foe_writefile_cfg_t *self, uint32_t offset, uint8_t *data, uint32_t length) {
+	if(!offset) {
+		modTraceSnapshot(&middleTraceFoESnapshot);
+		middleTraceStatus.FoEReads++;
+	}
+
+	return modTraceRead(&middleTraceFoESnapshot,offset,data,length);
+}
+
+void middleTraceStreamTransmitter(bool (*transmitFunctionPointer)(uint8_t *data, uint16_t length)) {
+	middleTraceStreamTransmitFunctionPointer = transmitFunctionPointer;
+}
+
+// Called from the USB receive interrupt, the dump itself runs in middleTraceTask.
+void middleTraceStreamReceive(uint8_t *data, uint32_t length) {
+	while(length--) {
+		if(*data++ == middleTraceStreamCommand)
+			middleTraceStreamRequested = true;
+	}
+}
+
+const middleTraceStatusStruct *middleTraceGetStatus(void) {
+	return &middleTraceStatus;
+}
@@ -8,13 +8,21 @@ extern "C"
 
 #include <assert.h>
 #include <stdint.h>
+#include "modTrace.h"
 
 #define CC_PACKED_BEGIN
 #define CC_PACKED_END
 #define CC_PACKED       __attribute__((packed))
 
 #define CC_ASSERT(exp) assert (exp)
+#if defined(__ARMCC_VERSION) && (__ARMCC_VERSION < 6000000)
+/* ARM Compiler 5 has no _Static_assert, a negative array size fails the build the same way */
+#define CC_STATIC_ASSERT_NAME(line) CC_STATIC_ASSERT_LINE(line)
+#define CC_STATIC_ASSERT_LINE(line) cc_static_assert_##line
+#define CC_STATIC_ASSERT(exp) typedef char CC_STATIC_ASSERT_NAME(__LINE__)[(exp) ? 1 : -1]
+#else
 #define CC_STATIC_ASSERT(exp) _Static_assert (exp, "")
+#endif
 
 #define CC_SWAP32(x) __builtin_bswap32 (x)
 #define CC_SWAP16(x) ((uint16_t)(x) >> 8 | ((uint16_t)(x) & 0xFF) << 8)
@@ -37,6 +45,9 @@ extern "C"
 #define DPRINT(...)
 #endif  /* DEBUG */
 
+/* Stack events go to the binary trace ring, see modTrace.h */
+#define ESC_TRACE(event, arg0, arg1) modTraceEvent ((event), (arg0), (arg1))
+
 #ifdef __cplusplus
 }
 #endif
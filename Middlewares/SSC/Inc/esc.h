@@ -39,6 +39,7 @@
 #define ESCREG_ALCONTROL         0x0120
 #define ESCREG_ALSTATUS          0x0130
 #define ESCREG_ALERROR           0x0134
+#define ESCREG_ALEVENTMASK       0x0204
 #define ESCREG_ALEVENT_SM_MASK   0x0310
 #define ESCREG_ALEVENT_SMCHANGE  0x0010
 #define ESCREG_ALEVENT_CONTROL   0x0001
@@ -97,9 +98,16 @@
 #define ALERR_INVALIDBOOTMBXCONFIG  0x0015
 #define ALERR_INVALIDMBXCONFIG      0x0016
 #define ALERR_INVALIDSMCONFIG       0x0017
+#define ALERR_SYNCERROR             0x001A
 #define ALERR_WATCHDOG              0x001B
 #define ALERR_INVALIDOUTPUTSM       0x001D
 #define ALERR_INVALIDINPUTSM        0x001E
+#define ALERR_FATALSYNCERROR        0x002C
+#define ALERR_NOSYNCERROR           0x002D
+#define ALERR_SYNC0NOTRECEIVED      0x0036
+#define ALERR_SYNC1NOTRECEIVED      0x0037
+#define ALERR_EEPROMNOACCESS        0x0050
+#define ALERR_EEPROMERROR           0x0051
 
 #define MBXERR_SYNTAX                   0x0001
 #define MBXERR_UNSUPPORTEDPROTOCOL      0x0002
@@ -119,6 +127,7 @@
 #define ABORT_TYPEMISMATCH              0x06070010
 #define ABORT_NOSUBINDEX                0x06090011
 #define ABORT_GENERALERROR              0x08000000
+#define ABORT_NOTSTORED                 0x08000020
 #define ABORT_NOTINTHISSTATE            0x08000022
 
 #define MBXstate_idle                   0x00
@@ -132,6 +141,7 @@
 #define COE_DEFAULTLENGTH               0x0a
 #define COE_HEADERSIZE                  0x0a
 #define COE_SEGMENTHEADERSIZE           0x03
+#define COE_EMERGENCY                   0x01
 #define COE_SDOREQUEST                  0x02
 #define COE_SDORESPONSE                 0x03
 #define COE_SDOINFORMATION              0x08
@@ -158,6 +168,9 @@
 #define COE_VALUEINFO_MINIMUM           0x20
 #define COE_VALUEINFO_MAXIMUM           0x40
 #define COE_MINIMUM_LENGTH              8
+#define COE_EMERGENCY_DATASIZE          5
+#define COE_SIGNATURE_SAVE              0x65766173
+#define COE_SIGNATURE_LOAD              0x64616F6C
 
 #define MBXHSIZE                       sizeof(_MBXh)
 #define MBXDSIZE                       MBXSIZE-MBXHSIZE
@@ -363,6 +376,15 @@ typedef struct CC_PACKED
    char name;
 } _COEentdesc;
 
+typedef struct CC_PACKED
+{
+   _MBXh mbxheader;
+   _COEh coeheader;
+   uint16_t errorcode;
+   uint8_t errorregister;
+   uint8_t data[COE_EMERGENCY_DATASIZE];
+} _COEemcy;
+
 #pragma anon_unions
 typedef struct CC_PACKED
 {
@@ -426,9 +448,9 @@ void ESC_stopoutput (void);
 void ESC_state (void);
 
 /* From hardware file */
-void ESC_read(uint16_t address, void *buf, uint16_t len);
-void ESC_write(uint16_t address, void *buf, uint16_t len);
-void ESC_ReadAlEvent(void);
+PDI_StatusTypeDef ESC_read(uint16_t address, void *buf, uint16_t len);
+PDI_StatusTypeDef ESC_write(uint16_t address, void *buf, uint16_t len);
+PDI_StatusTypeDef ESC_ReadAlEvent(void);
 void ESC_init(void);
 void ESC_reset(void);
 
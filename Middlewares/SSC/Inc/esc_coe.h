@@ -57,6 +57,21 @@ typedef struct CC_PACKED
    const _objd *objdesc;
 } _objectlist;
 
+/** Precomputed SDO Information response: the mailbox data after the mailbox
+ * header, length is what goes into the mailbox header length field.
+ */
+typedef struct
+{
+   uint16_t length;
+   const uint8_t *data;
+} _COEinfo;
+
+typedef struct
+{
+   _COEinfo description;
+   const _COEinfo *entries;
+} _objectinfo;
+
 #define OBJH_READ               0
 #define OBJH_WRITE              1
 
@@ -101,11 +116,16 @@ typedef struct CC_PACKED
 #define ATYPE_TXPDO             0x80
 
 void ESC_coeprocess (void);
+uint8_t COE_emergency (uint16_t errorcode, uint8_t errorregister, const uint8_t *data);
 uint16_t sizeTXPDO (void);
 uint16_t sizeRXPDO (void);
 
 extern void ESC_objecthandler (uint16_t index, uint8_t subindex);
 extern const _objectlist SDOobjects[];
+extern const _objectinfo SDOinfo[];
+extern const _COEinfo SDOodcount;
+extern const _COEinfo SDOodlist[];
+extern const uint16_t SDOodlistfrags;
 extern const _objd SDO1C12[];
 extern const _objd SDO1C13[];
 
@@ -0,0 +1,164 @@
+/*
+ * SOES Simple Open EtherCAT Slave
+ *
+ * Copyright (C) 2007-2013 Arthur Ketels
+ * Copyright (C) 2012-2013 rt-labs.
+ *
+ * SOES is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License version 2 as published by the Free
+ * Software Foundation.
+ *
+ * SOES is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * for more details.
+ *
+ * As a special exception, if other files instantiate templates or use macros
+ * or inline functions from this file, or you compile this file and link it
+ * with other works to produce a work based on this file, this file does not
+ * by itself cause the resulting work to be covered by the GNU General Public
+ * License. However the source code for this file must still be made available
+ * in accordance with section (3) of the GNU General Public License.
+ *
+ * This exception does not invalidate any other reasons why a work based on
+ * this file might be covered by the GNU General Public License.
+ *
+ * The EtherCAT Technology, the trade name and logo "EtherCAT" are the intellectual
+ * property of, and protected by Beckhoff Automation GmbH.
+ */
+
+/** \file
+ * \brief
+ * Headerfile for esc_eoe.c
+ */
+
+#ifndef __esc_eoe__
+#define __esc_eoe__
+
+#include <cc.h>
+
+/** EoE frame types, the low nibble of the first header word */
+#define EOE_TYPE_FRAG_DATA              0x00
+#define EOE_TYPE_TIMESTAMP              0x01
+#define EOE_TYPE_INIT_REQ               0x02
+#define EOE_TYPE_INIT_RESP              0x03
+#define EOE_TYPE_MACFILTER_REQ          0x04
+#define EOE_TYPE_MACFILTER_RESP         0x05
+
+/** First header word */
+#define EOE_HDR_FRAME_TYPE_MASK         0x000F
+#define EOE_HDR_FRAME_PORT_SHIFT        4
+#define EOE_HDR_FRAME_PORT_MASK         0x00F0
+#define EOE_HDR_LAST_FRAGMENT           0x0100
+#define EOE_HDR_TIME_APPEND             0x0200
+#define EOE_HDR_TIME_REQUEST            0x0400
+
+/** Second header word, the size and offset are counted in 32 byte blocks */
+#define EOE_HDR_FRAG_NO_MASK            0x003F
+#define EOE_HDR_FRAME_OFFSET_SHIFT      6
+#define EOE_HDR_FRAME_OFFSET_MASK       0x0FC0
+#define EOE_HDR_FRAME_NO_SHIFT          12
+#define EOE_HDR_FRAME_NO_MASK           0xF000
+#define EOE_HDR_FRAME_BLOCK             32
+
+#define EOE_TIMESTAMP_SIZE              4
+
+/** Set IP parameter request, which fields follow the flags */
+#define EOE_PARAM_MAC_INCLUDE           0x01
+#define EOE_PARAM_IP_INCLUDE            0x02
+#define EOE_PARAM_SUBNET_IP_INCLUDE     0x04
+#define EOE_PARAM_DEFAULT_GATEWAY_INCLUDE 0x08
+#define EOE_PARAM_DNS_IP_INCLUDE        0x10
+#define EOE_PARAM_DNS_NAME_INCLUDE      0x20
+#define EOE_DNS_NAME_LENGTH             32
+
+/** Results in the second header word of an init or filter response */
+#define EOE_RESULT_SUCCESS              0x0000
+#define EOE_RESULT_UNSPECIFIED_ERROR    0x0001
+#define EOE_RESULT_UNSUPPORTED_TYPE     0x0002
+#define EOE_RESULT_NO_IP_SUPPORT        0x0201
+#define EOE_RESULT_NO_MACFILTER_SUPPORT 0x0401
+
+#define EOEHSIZE        (sizeof(_EOEh))
+#define EOE_DATA_SIZE   (MBXSIZE - (MBXHSIZE+EOEHSIZE))
+/** Payload of a fragment that is not the last one, whole blocks only */
+#define EOE_FRAG_SIZE   (EOE_DATA_SIZE & ~(EOE_HDR_FRAME_BLOCK - 1))
+
+typedef struct CC_PACKED
+{
+   uint16_t frameinfo1;
+   /** Fragment and frame numbers, the result code in a response */
+   uint16_t frameinfo2;
+} _EOEh;
+
+typedef struct CC_PACKED
+{
+   _MBXh mbxheader;
+   _EOEh eoeheader;
+   uint8_t data[EOE_DATA_SIZE];
+} _EOE;
+
+/** IP addresses are kept the way the master sends them: a little endian
+ * 32 bit value with the first octet in the most significant byte, so
+ * 192.168.1.10 is 0xC0A8010A.
+ */
+typedef struct eoe_param
+{
+   uint8_t  mac_set;
+   uint8_t  ip_set;
+   uint8_t  subnet_set;
+   uint8_t  default_gateway_set;
+   uint8_t  dns_ip_set;
+   uint8_t  dns_name_set;
+   uint8_t  mac[6];
+   uint32_t ip;
+   uint32_t subnet;
+   uint32_t default_gateway;
+   uint32_t dns_ip;
+   char     dns_name[EOE_DNS_NAME_LENGTH];
+} eoe_param_t;
+
+typedef struct eoe_cfg
+{
+   /** Frame reassembly buffer, frames that do not fit are dropped */
+   uint8_t * rxbuffer;
+   uint16_t  rxbuffer_size;
+   /** Frame to send, the application builds it here while EOE_tx_busy is 0 */
+   uint8_t * txbuffer;
+   uint16_t  txbuffer_size;
+   /** Called with every complete frame, the buffer is reused once it returns */
+   void      (*handle_frame) (uint8_t * frame, uint16_t size);
+   /** Called with a set IP parameter request, returns an EOE_RESULT_ code */
+   uint16_t  (*set_param) (const eoe_param_t * param);
+} eoe_cfg_t;
+
+typedef struct
+{
+   /** Bytes of the frame being received, 0 while waiting for its first fragment */
+   uint16_t rxposition;
+   /** Fragment number expected next */
+   uint8_t  rxfragment;
+   /** Frame number of the frame being received */
+   uint8_t  rxframe;
+   /** Set when a fragment did not fit, the rest of that frame is ignored */
+   uint8_t  rxdiscard;
+   /** Size of the frame being sent, 0 when the tx buffer is free */
+   uint16_t txsize;
+   /** Bytes of it already handed to the mailbox */
+   uint16_t txposition;
+   uint8_t  txfragment;
+   uint8_t  txframe;
+   uint32_t rxframes;
+   uint32_t rxdropped;
+   uint32_t txframes;
+} _EOEvar;
+
+void EOE_config (eoe_cfg_t * cfg);
+void EOE_init (void);
+uint8_t EOE_tx_busy (void);
+void EOE_send (uint16_t size);
+void ESC_eoeprocess (void);
+void ESC_eoeprocess_tx (void);
+const _EOEvar * EOE_status (void);
+
+#endif
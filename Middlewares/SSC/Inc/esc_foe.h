@@ -55,7 +55,12 @@ struct foe_writefile_cfg
    /* FoE password */
    uint32_t       filepass;
    /* Pointer to application foe write function */
-   uint32_t       (*write_function) (foe_writefile_cfg_t * self, uint8_t * data);
+   uint32_t       (*write_function) (foe_writefile_cfg_t * self, uint8_t * data, uint32_t length);
+   /* Optional, called once the last data is written with the received file length */
+   uint32_t       (*close_function) (foe_writefile_cfg_t * self, uint32_t length);
+   /* Optional, makes the file readable. Copies up to length bytes from offset
+    * straight into the outgoing mailbox, fewer than asked for ends the file */
+   uint32_t       (*read_function) (foe_writefile_cfg_t * self, uint32_t offset, uint8_t * data, uint32_t length);
 };
 
 typedef struct foe_cfg
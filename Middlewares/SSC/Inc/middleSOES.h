@@ -5,13 +5,64 @@
 #include <stdint.h>
 #include "esc.h"
 #include "esc_coe.h"
+#include "esc_foe.h"
+#include "esc_eoe.h"
 #include "objectlist.h"
 #include "driverSWNunChuck.h"
 
 #include "modEffect.h"
+#include "modIndicator.h"
 
-void middleSOESInit(void);
+#define middleSOESProcessDataPeriod		10000																// us, fallback poll, normally released by the ESC IRQ
+#define middleSOESMailboxPeriod				10000																// us, fallback poll, normally released by the ESC IRQ
+#define middleSOESEventPollPeriod			100000															// us, AL event read without an IRQ, should an edge get lost
+
+// CoE emergencies wait in a small queue until the outbox is free, the most urgent first and in order within a priority.
+// They go out no closer together than middleSOESEmergencyInterval. A full queue gives up the least urgent newest one,
+// the same error queued twice in a row is sent once.
+#define middleSOESEmergencyQueueSize	8
+#define middleSOESEmergencyInterval		10000																// us between two emergencies at least
+
+// Emergency error codes
+#define middleSOESEmergencyErrorReset							0x0000													// Error gone, sent with the error register left
+#define middleSOESEmergencySensorCommunication		0x5000													// Device hardware, nunchuck not answering on I2C
+#define middleSOESEmergencySensorCalibration			0x6300													// Data set, nunchuck calibration implausible
+#define middleSOESEmergencyWatchdog								0x8130													// Monitoring, process data watchdog expired
+
+// Error register (0x1001) bits
+#define middleSOESErrorRegisterGeneric						0x01
+#define middleSOESErrorRegisterCommunication			0x10
+#define middleSOESErrorRegisterDeviceProfile			0x20
+#define middleSOESErrorRegisterManufacturer				0x80
+
+typedef enum {
+	EMERGENCY_PRIORITY_HIGH = 0,
+	EMERGENCY_PRIORITY_NORMAL,
+	EMERGENCY_PRIORITY_LOW
+} middleSOESEmergencyPriorityTypedef;
+
+typedef struct {
+	uint32_t Queued;
+	uint32_t Sent;
+	uint32_t Merged;																																		// Repeats of the error queued last
+	uint32_t Dropped;																																		// Given up with the queue full
+} middleSOESEmergencyStatusStruct;
+
+extern uint8_t middleSOESPDIAccountingReset;
+extern uint8_t middleSOESErrorRegister;
+
+bool middleSOESInit(void);
 void middleSOESTask(void);
+void middleSOESProcessDataTask(void);
+void middleSOESMailboxTask(void);
 void middleSOESReadBufferUpdateEvent(void (*eventFunctionPointer)(void));
+void middleSOESESCEvent(void (*eventFunctionPointer)(void));
+void middleSOESObjectWriteEvent(void (*eventFunctionPointer)(uint16_t index, uint8_t subindex));
+void middleSOESFoEConfig(foe_cfg_t *cfg, foe_writefile_cfg_t *files);
+void middleSOESEoEConfig(eoe_cfg_t *cfg);
+bool middleSOESEmergency(uint16_t errorCode, uint8_t errorRegisterBits, middleSOESEmergencyPriorityTypedef priority, const uint8_t *data);
+const middleSOESEmergencyStatusStruct *middleSOESEmergencyGetStatus(void);
+void middleSOESEmergencyEvent(void (*eventFunctionPointer)(uint16_t errorCode, uint8_t errorRegister, middleSOESEmergencyPriorityTypedef priority));
+void middleSOESALStatusCodeEvent(void (*eventFunctionPointer)(uint16_t statusCode, uint8_t status));
 
 #endif
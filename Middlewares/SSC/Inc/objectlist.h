@@ -1,9 +1,13 @@
+// Generated by ESIEtherCAT/esigen.py from DieBieSlave-NunChuck.esx, edit the description and regenerate.
 #ifndef __OBJECTLIST_H
 #define __OBJECTLIST_H
 
 #include "esc_coe.h"
 #include <stddef.h>
 
+#define objectlistRxPDOSize						1											// SM2 bytes, the Outputs Sm DefaultSize in the ESI
+#define objectlistTxPDOSize						9											// SM3 bytes, the Inputs Sm DefaultSize in the ESI
+
 typedef struct CC_PACKED {
 	struct CC_PACKED {
 		int8_t JoyStickX;
@@ -19,21 +23,49 @@ typedef struct CC_PACKED {
 } middleSOESReadbufferTypedef;
 
 typedef struct {
-		int8_t ButtonC;
-		int8_t ButtonZ;
-		int8_t NunChuckDataValid;
-		int8_t LED0;
+	int8_t ButtonC;
+	int8_t ButtonZ;
+	int8_t NunChuckDataValid;
+	int8_t LED0;
+	int8_t CaptureTrigger;
 } middleSOESReadBufferBooleansTypedef;
 
 typedef struct CC_PACKED {
-   struct CC_PACKED {
-      uint8_t LED0:1;
-      uint8_t pad0:7;
-   } Digital_outputs;
+	struct CC_PACKED {
+		uint8_t LED0:1;
+		uint8_t CaptureTrigger:1;
+		uint8_t pad0:6;
+	} Digital_outputs;
 } middleSOESWritebufferTypedef;
 
+// The buffers go to and from the SMs in one copy, so their layout must be the one declared in the ESI
+CC_STATIC_ASSERT(sizeof(middleSOESReadbufferTypedef) == objectlistTxPDOSize);
+CC_STATIC_ASSERT(offsetof(middleSOESReadbufferTypedef,NunChuck) == 0);
+CC_STATIC_ASSERT(sizeof(((middleSOESReadbufferTypedef *)0)->NunChuck) == 9);
+CC_STATIC_ASSERT(offsetof(middleSOESReadbufferTypedef,NunChuck.JoyStickX) == 0);
+CC_STATIC_ASSERT(offsetof(middleSOESReadbufferTypedef,NunChuck.JoyStickY) == 1);
+CC_STATIC_ASSERT(offsetof(middleSOESReadbufferTypedef,NunChuck.AcceleroMeterX) == 2);
+CC_STATIC_ASSERT(offsetof(middleSOESReadbufferTypedef,NunChuck.AcceleroMeterY) == 4);
+CC_STATIC_ASSERT(offsetof(middleSOESReadbufferTypedef,NunChuck.AcceleroMeterZ) == 6);
+CC_STATIC_ASSERT(sizeof(middleSOESWritebufferTypedef) == objectlistRxPDOSize);
+CC_STATIC_ASSERT(offsetof(middleSOESWritebufferTypedef,Digital_outputs) == 0);
+CC_STATIC_ASSERT(sizeof(((middleSOESWritebufferTypedef *)0)->Digital_outputs) == 1);
+
 extern middleSOESReadbufferTypedef 					middleSOESReadBuffer;
 extern middleSOESReadBufferBooleansTypedef	middleSOESReadBufferBooleans;
 extern middleSOESWritebufferTypedef 				middleSOESWriteBuffer;
 
+// Entries flagged <Backup> in the description, what 0x1010 stores
+typedef struct {
+	uint32_t Key;																																		// Index << 8 | SubIndex
+	void *Data;
+	uint16_t Size;																																		// Bytes
+} objectlistParameterTypedef;
+
+#define objectlistParameterCount				6
+extern const objectlistParameterTypedef objectlistParameters[];
+
+void objectlistTxPDOShadowUpdate(void);															// Bit inputs to their SDO shadows, after the buffer changed
+void objectlistRxPDOShadowUpdate(void);															// Bit outputs to their SDO shadows, after the buffer changed
+
 #endif //__OBJECTLIST_H
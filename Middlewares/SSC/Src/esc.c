@@ -41,16 +41,53 @@
  */
 static esc_cfg_t * esc_cfg = NULL;
 
+/* AL status and AL status code writes that still failed after their retries,
+ * written again on the next ESC_state. */
+#define ESC_AL_WRITE_ATTEMPTS    3
+#define ESC_AL_WRITE_STATUS      0x01
+#define ESC_AL_WRITE_ERROR       0x02
+static uint8_t ESC_ALwritepending = 0;
+
+/** Write an AL register. The master only sees a state or status code once it
+ * is in the ESC, so a failed write is retried and, if it keeps failing, left
+ * pending for the next ESC_state.
+ *
+ * @param[in] address   = ESCREG_ALSTATUS or ESCREG_ALERROR
+ * @param[in] value     = Register value in host byte order
+ * @param[in] pending   = ESC_AL_WRITE_STATUS or ESC_AL_WRITE_ERROR
+ */
+static void ESC_ALwrite (uint16_t address, uint16_t value, uint8_t pending)
+{
+   uint16_t dummy = htoes (value);
+   PDI_StatusTypeDef status = PDI_OK;
+   uint8_t attempt;
+
+   for (attempt = 0; attempt < ESC_AL_WRITE_ATTEMPTS; attempt++)
+   {
+      status = ESC_write (address, &dummy, sizeof (dummy));
+      if (status == PDI_OK)
+      {
+         ESC_ALwritepending &= ~pending;
+         return;
+      }
+   }
+   ESC_TRACE (TRACE_PDI_ERROR, address, status);
+   ESC_ALwritepending |= pending;
+}
+
 /** Write AL Status Code to the ESC.
  *
  * @param[in] errornumber   = Write an by EtherCAT specified Error number register 0x134 AL Status Code
  */
 void ESC_ALerror (uint16_t errornumber)
 {
-   uint16_t dummy;
+   if (errornumber != ESCvar.ALerror)
+   {
+      ESC_TRACE (TRACE_AL_ERROR, errornumber, ESCvar.ALstatus);
+   }
    ESCvar.ALerror = errornumber;
-   dummy = htoes (errornumber);
-   ESC_write (ESCREG_ALERROR, &dummy, sizeof (dummy));
+   ESC_ALwrite (ESCREG_ALERROR, errornumber, ESC_AL_WRITE_ERROR);
+   PDI_UpdateLED (ESCvar.ALstatus, ESCvar.ALerror);
 }
 /** Write AL Status to the ESC.
  *
@@ -59,10 +96,13 @@ void ESC_ALerror (uint16_t errornumber)
  */
 void ESC_ALstatus (uint8_t status)
 {
-   uint16_t dummy;
+   if (status != ESCvar.ALstatus)
+   {
+      ESC_TRACE (TRACE_AL_STATUS, status, ESCvar.ALstatus);
+   }
    ESCvar.ALstatus = status;
-   dummy = htoes ((uint16_t) status);
-   ESC_write(ESCREG_ALSTATUS, &dummy, sizeof (dummy));
+   ESC_ALwrite (ESCREG_ALSTATUS, status, ESC_AL_WRITE_STATUS);
+   PDI_UpdateLED (ESCvar.ALstatus, ESCvar.ALerror);
 }
 
 /** Read SM Status register 0x805(+ offset to SyncManager n) to acknowledge a
@@ -296,44 +336,42 @@ void ESC_stopmbx (void)
 
 /** Read Receive mailbox and store data in local ESCvar.MBX variable.
  * Combined function for bootstrap and other states. State check decides
- * which one to read.
+ * which one to read. Stops at the first failed access, the mailbox then
+ * stays full in the ESC and is read again whole.
+ *
+ * @return PDI_OK, or the error of the access that failed
  */
-void ESC_readmbx (void)
+static PDI_StatusTypeDef ESC_readmbx (void)
 {
    _MBX *MB = &MBX[0];
    uint16_t length;
+   uint16_t sma = (ESCvar.ALstatus == ESCboot) ? MBX0_sma_b : MBX0_sma;
+   uint16_t sml = (ESCvar.ALstatus == ESCboot) ? MBX0_sml_b : MBX0_sml;
+   PDI_StatusTypeDef status;
 
-   if (ESCvar.ALstatus == ESCboot)
+   status = ESC_read (sma, MB, MBXHSIZE);
+   if (status == PDI_OK)
    {
-      ESC_read (MBX0_sma_b, MB, MBXHSIZE);
       length = etohs (MB->header.length);
 
-      if (length > (MBX0_sml_b - MBXHSIZE))
+      if (length > (sml - MBXHSIZE))
       {
-         length = MBX0_sml_b - MBXHSIZE;
+         length = sml - MBXHSIZE;
       }
-      ESC_read (MBX0_sma_b + MBXHSIZE, &(MB->b[0]), length);
-      if (length + MBXHSIZE < MBX0_sml_b)
+      status = ESC_read (sma + MBXHSIZE, &(MB->b[0]), length);
+      if ((status == PDI_OK) && (length + MBXHSIZE < sml))
       {
-         ESC_read (MBX0_sme_b, &length, 1);
+         /* the last byte releases the mailbox */
+         status = ESC_read (sma + sml - 1, &length, 1);
       }
    }
-   else
+   if (status != PDI_OK)
    {
-      ESC_read (MBX0_sma, MB, MBXHSIZE);
-      length = etohs (MB->header.length);
-
-      if (length > (MBX0_sml - MBXHSIZE))
-      {
-         length = MBX0_sml - MBXHSIZE;
-      }
-      ESC_read (MBX0_sma + MBXHSIZE, &(MB->b[0]), length);
-      if (length + MBXHSIZE < MBX0_sml)
-      {
-         ESC_read (MBX0_sme, &length, 1);
-      }
+      ESC_TRACE (TRACE_PDI_ERROR, sma, status);
+      return status;
    }
    MBXcontrol[0].state = MBXstate_inclaim;
+   return PDI_OK;
 }
 /** Write local mailbox buffer ESCvar.MBX[n] to Send mailbox.
  * Combined function for bootstrap and other states. State check decides
@@ -445,6 +483,7 @@ void MBX_error (uint16_t error)
 {
    uint8_t MBXout;
    _MBXerr *mbxerr;
+   ESC_TRACE (TRACE_MBX_ERROR, error, 0);
    MBXout = ESC_claimbuffer ();
    if (MBXout)
    {
@@ -554,7 +593,12 @@ uint8_t ESC_mbxprocess (void)
    if (ESCvar.SM[0].MBXstat && !MBXcontrol[0].state && !ESCvar.mbxoutpost
        && !ESCvar.xoe)
    {
-      ESC_readmbx ();
+      if (ESC_readmbx () != PDI_OK)
+      {
+         /* drop mailbox, SM0 stays full and it is read again next pass */
+         MBXcontrol[0].state = MBXstate_idle;
+         return 0;
+      }
       ESCvar.SM[0].MBXstat = 0;
       if (etohs (MB->header.length) == 0)
       {
@@ -562,6 +606,13 @@ uint8_t ESC_mbxprocess (void)
          /* drop mailbox */
          MBXcontrol[0].state = MBXstate_idle;
       }
+      else if (etohs (MB->header.length) > (MBX0_sml - MBXHSIZE))
+      {
+         /* the handlers trust the header length, it must fit the mailbox */
+         MBX_error (MBXERR_INVALIDSIZE);
+         /* drop mailbox */
+         MBXcontrol[0].state = MBXstate_idle;
+      }
       if ((MB->header.mbxcnt != 0) && (MB->header.mbxcnt == ESCvar.mbxincnt))
       {
          /* drop mailbox */
@@ -714,6 +765,16 @@ void ESC_state (void) {
    uint8_t ac, an, as, ax, ax23;
    uint8_t handle_smchanged = 0;
 
+   /* AL registers the last writes did not get into */
+   if (ESC_ALwritepending & ESC_AL_WRITE_STATUS)
+   {
+      ESC_ALwrite (ESCREG_ALSTATUS, ESCvar.ALstatus, ESC_AL_WRITE_STATUS);
+   }
+   if (ESC_ALwritepending & ESC_AL_WRITE_ERROR)
+   {
+      ESC_ALwrite (ESCREG_ALERROR, ESCvar.ALerror, ESC_AL_WRITE_ERROR);
+   }
+
    /* Do we have a state change request pending */
    if (ESCvar.ALevent & ESCREG_ALEVENT_CONTROL) {
       ESC_read(ESCREG_ALCONTROL, (void *) &ESCvar.ALcontrol,sizeof (ESCvar.ALcontrol));
@@ -956,8 +1017,14 @@ void ESC_config (esc_cfg_t * cfg)
    esc_cfg = cfg;
 }
 
-void ESC_read(uint16_t address, void *buf, uint16_t len) {
+/** Read len bytes from the ESC, split into the access sizes the LAN9252 CSR
+ * path supports. Stops at the first failed access.
+ *
+ * @return PDI_OK, or the error of the access that failed
+ */
+PDI_StatusTypeDef ESC_read(uint16_t address, void *buf, uint16_t len) {
 	volatile unsigned int int_status;
+	PDI_StatusTypeDef status;
 	uint16_t i;
 	uint8_t *pTmpData = (uint8_t *)buf;
 
@@ -977,16 +1044,26 @@ void ESC_read(uint16_t address, void *buf, uint16_t len) {
 							i=1;
 					}
 			}
-			PDIReadReg(pTmpData, address, i);
+			status = PDIReadReg(pTmpData, address, i);
+			if (status != PDI_OK) {
+					return status;
+			}
 			
 			len -= i;
 			pTmpData += i;
 			address += i;
 	}
+	return PDI_OK;
 }
 
-void ESC_write(uint16_t address, void *buf, uint16_t len) {
+/** Write len bytes to the ESC, split like ESC_read. Stops at the first failed
+ * access.
+ *
+ * @return PDI_OK, or the error of the access that failed
+ */
+PDI_StatusTypeDef ESC_write(uint16_t address, void *buf, uint16_t len) {
     volatile unsigned int int_status;
+    PDI_StatusTypeDef status;
     uint16_t i;
     uint8_t *pTmpData = (uint8_t *)buf;
 
@@ -1006,16 +1083,32 @@ void ESC_write(uint16_t address, void *buf, uint16_t len) {
             }
         }
         /* start transmission */
-        PDIWriteReg(pTmpData, address, i);
+        status = PDIWriteReg(pTmpData, address, i);
+        if (status != PDI_OK) {
+            return status;
+        }
         /* next address */
         len -= i;
         pTmpData += i;
         address += i;
     }
+    return PDI_OK;
 }
 
-void ESC_ReadAlEvent(void) {
-	ESCvar.ALevent = PDIReadAlEventReg();
+/** Read the AL event request register into ESCvar.ALevent. On a failed read
+ * the previous events are kept, the latched requests are read again later.
+ *
+ * @return PDI_OK, or the error of the read
+ */
+PDI_StatusTypeDef ESC_ReadAlEvent(void) {
+	uint16_t event;
+	PDI_StatusTypeDef status = PDIReadAlEventReg(&event);
+
+	if (status == PDI_OK)
+		ESCvar.ALevent = event;
+	else
+		ESC_TRACE (TRACE_PDI_ERROR, 0x220, status);
+	return status;
 }
 
 void ESC_init(void) {
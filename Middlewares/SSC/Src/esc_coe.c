@@ -30,7 +30,7 @@
  * \brief
  * CAN over EtherCAT (CoE) module.
  *
- * SDO read / write and SDO service functions
+ * SDO read / write, SDO service functions and Emergency messages
  */
 
 #include <stddef.h>
@@ -43,6 +43,7 @@
 
 extern uint8_t txpdoitems;
 extern uint8_t rxpdoitems;
+extern bool middleParameterCommandFits (uint16_t index);
 
 /** Search for an object index matching the wanted value in the Object List.
  *
@@ -201,6 +202,7 @@ void SDO_abort (uint16_t index, uint8_t subindex, uint32_t abortcode)
 {
    uint8_t MBXout;
    _COEsdo *coeres;
+   ESC_TRACE (TRACE_SDO_ABORT, ((uint32_t) index << 8) | subindex, abortcode);
    MBXout = ESC_claimbuffer ();
    if (MBXout)
    {
@@ -217,6 +219,46 @@ void SDO_abort (uint16_t index, uint8_t subindex, uint32_t abortcode)
    }
 }
 
+/** Function for sending an Emergency message. Only posted when no other
+ * reply waits for the outbox, a busy outbox leaves it to the caller to try
+ * again later.
+ *
+ * @param[in] errorcode      = Emergency error code
+ * @param[in] errorregister  = Error register (object 0x1001) to send along
+ * @param[in] data           = COE_EMERGENCY_DATASIZE manufacturer specific bytes, or NULL
+ * @return 1 when the message was posted, 0 when the outbox was busy.
+ */
+uint8_t COE_emergency (uint16_t errorcode, uint8_t errorregister, const uint8_t *data)
+{
+   uint8_t MBXout;
+   _COEemcy *coeemcy;
+   if (!MBXrun || ESCvar.txcue || ESCvar.mbxoutpost)
+   {
+      return 0;
+   }
+   MBXout = ESC_claimbuffer ();
+   if (!MBXout)
+   {
+      return 0;
+   }
+   coeemcy = (_COEemcy *) &MBX[MBXout];
+   coeemcy->mbxheader.length = htoes (COE_DEFAULTLENGTH);
+   coeemcy->mbxheader.mbxtype = MBXCOE;
+   coeemcy->coeheader.numberservice = htoes (COE_EMERGENCY << 12);
+   coeemcy->errorcode = htoes (errorcode);
+   coeemcy->errorregister = errorregister;
+   if (data)
+   {
+      memcpy (coeemcy->data, data, COE_EMERGENCY_DATASIZE);
+   }
+   else
+   {
+      memset (coeemcy->data, 0, COE_EMERGENCY_DATASIZE);
+   }
+   MBXcontrol[MBXout].state = MBXstate_outreq;
+   return 1;
+}
+
 /** Function for responding on requested SDO Upload, sending the content
  *  requested in a free Mailbox buffer. Depending of size of data expedited,
  *  normal or segmented transfer is used. On error an SDO Abort will be sent.
@@ -387,10 +429,29 @@ void SDO_uploadsegment (void)
  *
  * @param[in] index      = index of SDO download request to check
  * @param[in] sub-index  = sub-index of SDO download request to check
+ * @param[in] data       = downloaded data, not copied to the object yet
  * @return 1 if the SDO Download is correct. 0 If not correct.
  */
-int ESC_pre_objecthandler (uint16_t index, uint8_t subindex)
+int ESC_pre_objecthandler (uint16_t index, uint8_t subindex, const void *data)
 {
+   uint32_t signature;
+
+   /* Store and restore only act on their signature, "save" and "load" */
+   if (((index == 0x1010) || (index == 0x1011)) && (subindex > 0))
+   {
+      memcpy (&signature, data, sizeof (signature));
+      if (etohl (signature) != ((index == 0x1010) ? COE_SIGNATURE_SAVE : COE_SIGNATURE_LOAD))
+      {
+         SDO_abort (index, subindex, ABORT_NOTSTORED);
+         return 0;
+      }
+      /* Refused while the parameter queue has no room for what the command queues */
+      if (!middleParameterCommandFits (index))
+      {
+         SDO_abort (index, subindex, ABORT_NOTSTORED);
+         return 0;
+      }
+   }
    if ((index == 0x1c12) && (subindex > 0) && (rxpdoitems != 0))
    {
       SDO_abort (index, subindex, ABORT_READONLY);
@@ -446,7 +507,7 @@ void SDO_download (void)
             actsize = ((objd + nsub)->bitlength + 7) >> 3;
             if (actsize == size)
             {
-               if (ESC_pre_objecthandler (index, subindex))
+               if (ESC_pre_objecthandler (index, subindex, mbxdata))
                {
                   copy2mbx (mbxdata, (objd + nsub)->data, size);
                   MBXout = ESC_claimbuffer ();
@@ -521,29 +582,35 @@ void SDO_infoerror (uint32_t abortcode)
       coeres->index = htoel (abortcode);
       MBXcontrol[MBXout].state = MBXstate_outreq;
    }
+   /* release the request, it would be answered again on every pass */
+   MBXcontrol[0].state = MBXstate_idle;
+   ESCvar.xoe = 0;
 }
 
-#define ODLISTSIZE  ((MBX1_sml - MBXHSIZE - sizeof(_COEh) - sizeof(_INFOh) - 2) & 0xfffe)
+/** Post a precomputed SDO Information response from the object list. It is
+ * copied into the claimed mailbox buffer as a whole, the buffer is kept for a
+ * repeat request like any other.
+ *
+ * @param[in] MBXout = claimed mailbox buffer
+ * @param[in] info   = response to post
+ */
+static void SDO_postinfo (uint8_t MBXout, const _COEinfo *info)
+{
+   _MBX *MB = &MBX[MBXout];
+   MB->header.length = htoes (info->length);
+   MB->header.mbxtype = MBXCOE;
+   memcpy (MB->b, info->data, info->length);
+   MBXcontrol[MBXout].state = MBXstate_outreq;
+}
 
 /** Function for handling incoming requested SDO Get OD List, validating the
  * request and sending an response. On error an SDO Info Error will be sent.
  */
 void SDO_getodlist (void)
 {
-   uint16_t frags;
    uint8_t MBXout = 0;
-   uint16_t entries = 0;
-   uint16_t i, n;
-   uint16_t *p;
-   _COEobjdesc *coel, *coer;
+   _COEobjdesc *coer;
 
-   while (SDOobjects[entries].index != 0xffff)
-   {
-      entries++;
-   }
-   ESCvar.entries = entries;
-   frags = ((entries << 1) + ODLISTSIZE - 1);
-   frags /= ODLISTSIZE;
    coer = (_COEobjdesc *) &MBX[0];
    /* check for unsupported opcodes */
    if (etohs (coer->index) > 0x01)
@@ -556,66 +623,29 @@ void SDO_getodlist (void)
    }
    if (MBXout)
    {
-      coel = (_COEobjdesc *) &MBX[MBXout];
-      coel->mbxheader.mbxtype = MBXCOE;
-      coel->coeheader.numberservice =
-         htoes ((0 & 0x01f) | (COE_SDOINFORMATION << 12));
-      coel->infoheader.opcode = COE_GETODLISTRESPONSE;
       /* number of objects request */
       if (etohs (coer->index) == 0x00)
       {
-         coel->index = htoes ((uint16_t) 0x00);
-         coel->infoheader.incomplete = 0;
-         coel->infoheader.reserved = 0x00;
-         coel->infoheader.fragmentsleft = htoes ((uint16_t) 0);
+         SDO_postinfo (MBXout, &SDOodcount);
          MBXcontrol[0].state = MBXstate_idle;
          ESCvar.xoe = 0;
-         ESCvar.frags = frags;
-         ESCvar.fragsleft = frags - 1;
-         p = (uint16_t *) &(coel->datatype);
-         *p = htoes (entries);
-         p++;
-         *p = 0;
-         p++;
-         *p = 0;
-         p++;
-         *p = 0;
-         p++;
-         *p = 0;
-         coel->mbxheader.length = htoes (0x08 + (5 << 1));
       }
       /* only return all objects */
       if (etohs (coer->index) == 0x01)
       {
-         if (frags > 1)
+         SDO_postinfo (MBXout, &SDOodlist[0]);
+         ESCvar.frags = SDOodlistfrags;
+         ESCvar.fragsleft = SDOodlistfrags - 1;
+         if (ESCvar.fragsleft)
          {
-            coel->infoheader.incomplete = 1;
             ESCvar.xoe = MBXCOE + MBXODL;
-            n = ODLISTSIZE >> 1;
          }
          else
          {
-            coel->infoheader.incomplete = 0;
             MBXcontrol[0].state = MBXstate_idle;
             ESCvar.xoe = 0;
-            n = entries;
          }
-         coel->infoheader.reserved = 0x00;
-         ESCvar.frags = frags;
-         ESCvar.fragsleft = frags - 1;
-         coel->infoheader.fragmentsleft = htoes (ESCvar.fragsleft);
-         coel->index = htoes ((uint16_t) 0x01);
-
-         p = (uint16_t *) &(coel->datatype);
-         for (i = 0; i < n; i++)
-         {
-            *p = htoes (SDOobjects[i].index);
-            p++;
-         }
-
-         coel->mbxheader.length = htoes (0x08 + (n << 1));
       }
-      MBXcontrol[MBXout].state = MBXstate_outreq;
    }
 }
 /** Function for continuing sending left overs from previous requested
@@ -625,43 +655,17 @@ void SDO_getodlist (void)
 void SDO_getodlistcont (void)
 {
    uint8_t MBXout;
-   uint16_t i, n, s;
-   uint16_t *p;
-   _COEobjdesc *coel;
 
    MBXout = ESC_claimbuffer ();
    if (MBXout)
    {
-      coel = (_COEobjdesc *) &MBX[MBXout];
-      coel->mbxheader.mbxtype = MBXCOE;
-      coel->coeheader.numberservice =
-         htoes ((0 & 0x01f) | (COE_SDOINFORMATION << 12));
-      coel->infoheader.opcode = COE_GETODLISTRESPONSE;
-      s = (ESCvar.frags - ESCvar.fragsleft) * (ODLISTSIZE >> 1);
-      if (ESCvar.fragsleft > 1)
-      {
-         coel->infoheader.incomplete = 1;
-         n = s + (ODLISTSIZE >> 1);
-      }
-      else
+      SDO_postinfo (MBXout, &SDOodlist[ESCvar.frags - ESCvar.fragsleft]);
+      ESCvar.fragsleft--;
+      if (!ESCvar.fragsleft)
       {
-         coel->infoheader.incomplete = 0;
          MBXcontrol[0].state = MBXstate_idle;
          ESCvar.xoe = 0;
-         n = ESCvar.entries;
-      }
-      coel->infoheader.reserved = 0x00;
-      ESCvar.fragsleft--;
-      coel->infoheader.fragmentsleft = htoes (ESCvar.fragsleft);
-      /* pointer 2 bytes back to exclude index */
-      p = (uint16_t *) &(coel->index);
-      for (i = s; i < n; i++)
-      {
-         *p = htoes (SDOobjects[i].index);
-         p++;
       }
-      coel->mbxheader.length = htoes (0x06 + ((n - s) << 1));
-      MBXcontrol[MBXout].state = MBXstate_outreq;
    }
 }
 
@@ -672,53 +676,16 @@ void SDO_getodlistcont (void)
 void SDO_getod (void)
 {
    uint8_t MBXout;
-   uint16_t index;
    int32_t nidx;
-   uint8_t *d;
-   const uint8_t *s;
-   uint8_t n = 0;
-   _COEobjdesc *coer, *coel;
+   _COEobjdesc *coer;
    coer = (_COEobjdesc *) &MBX[0];
-   index = etohs (coer->index);
-   nidx = SDO_findobject (index);
+   nidx = SDO_findobject (etohs (coer->index));
    if (nidx >= 0)
    {
       MBXout = ESC_claimbuffer ();
       if (MBXout)
       {
-         coel = (_COEobjdesc *) &MBX[MBXout];
-         coel->mbxheader.mbxtype = MBXCOE;
-         coel->coeheader.numberservice =
-            htoes ((0 & 0x01f) | (COE_SDOINFORMATION << 12));
-         coel->infoheader.opcode = COE_GETODRESPONSE;
-         coel->infoheader.incomplete = 0;
-         coel->infoheader.reserved = 0x00;
-         coel->infoheader.fragmentsleft = htoes (0);
-         coel->index = htoes (index);
-         if (SDOobjects[nidx].objtype == OTYPE_VAR)
-         {
-            int32_t nsub = SDO_findsubindex (nidx, 0);
-            const _objd *objd = SDOobjects[nidx].objdesc;
-            coel->datatype = htoes ((objd + nsub)->datatype);
-         }
-         else
-         {
-            coel->datatype = htoes (0);
-         }
-         coel->maxsub = SDOobjects[nidx].maxsub;
-         coel->objectcode = SDOobjects[nidx].objtype;
-         s = (uint8_t *) SDOobjects[nidx].name;
-         d = (uint8_t *) &(coel->name);
-         while (*s && (n < (MBXDSIZE - 0x0c)))
-         {
-            *d = *s;
-            n++;
-            s++;
-            d++;
-         }
-         *d = *s;
-         coel->mbxheader.length = htoes ((uint16_t) 0x0c + n);
-         MBXcontrol[MBXout].state = MBXstate_outreq;
+         SDO_postinfo (MBXout, &SDOinfo[nidx].description);
          MBXcontrol[0].state = MBXstate_idle;
          ESCvar.xoe = 0;
       }
@@ -736,54 +703,19 @@ void SDO_getod (void)
 void SDO_geted (void)
 {
    uint8_t MBXout;
-   uint16_t index;
    int32_t nidx, nsub;
-   uint8_t subindex;
-   uint8_t *d;
-   const uint8_t *s;
-   const _objd *objd;
-   uint8_t n = 0;
-   _COEentdesc *coer, *coel;
+   _COEentdesc *coer;
    coer = (_COEentdesc *) &MBX[0];
-   index = etohs (coer->index);
-   subindex = coer->subindex;
-   nidx = SDO_findobject (index);
+   nidx = SDO_findobject (etohs (coer->index));
    if (nidx >= 0)
    {
-      nsub = SDO_findsubindex (nidx, subindex);
+      nsub = SDO_findsubindex (nidx, coer->subindex);
       if (nsub >= 0)
       {
-         objd = SDOobjects[nidx].objdesc;
          MBXout = ESC_claimbuffer ();
          if (MBXout)
          {
-            coel = (_COEentdesc *) &MBX[MBXout];
-            coel->mbxheader.mbxtype = MBXCOE;
-            coel->coeheader.numberservice =
-               htoes ((0 & 0x01f) | (COE_SDOINFORMATION << 12));
-            coel->infoheader.opcode = COE_ENTRYDESCRIPTIONRESPONSE;
-            coel->infoheader.incomplete = 0;
-            coel->infoheader.reserved = 0x00;
-            coel->infoheader.fragmentsleft = htoes ((uint16_t) 0);
-            coel->index = htoes (index);
-            coel->subindex = subindex;
-            coel->valueinfo = COE_VALUEINFO_ACCESS +
-               COE_VALUEINFO_OBJECT + COE_VALUEINFO_MAPPABLE;
-            coel->datatype = htoes ((objd + nsub)->datatype);
-            coel->bitlength = htoes ((objd + nsub)->bitlength);
-            coel->access = htoes ((objd + nsub)->access);
-            s = (uint8_t *) (objd + nsub)->name;
-            d = (uint8_t *) &(coel->name);
-            while (*s && (n < (MBXDSIZE - 0x10)))
-            {
-               *d = *s;
-               n++;
-               s++;
-               d++;
-            }
-            *d = *s;
-            coel->mbxheader.length = htoes ((uint16_t) 0x10 + n);
-            MBXcontrol[MBXout].state = MBXstate_outreq;
+            SDO_postinfo (MBXout, &SDOinfo[nidx].entries[nsub]);
             MBXcontrol[0].state = MBXstate_idle;
             ESCvar.xoe = 0;
          }
@@ -0,0 +1,382 @@
+/*
+ * SOES Simple Open EtherCAT Slave
+ *
+ * Copyright (C) 2007-2013 Arthur Ketels
+ * Copyright (C) 2012-2013 rt-labs.
+ *
+ * SOES is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License version 2 as published by the Free
+ * Software Foundation.
+ *
+ * SOES is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * for more details.
+ *
+ * As a special exception, if other files instantiate templates or use macros
+ * or inline functions from this file, or you compile this file and link it
+ * with other works to produce a work based on this file, this file does not
+ * by itself cause the resulting work to be covered by the GNU General Public
+ * License. However the source code for this file must still be made available
+ * in accordance with section (3) of the GNU General Public License.
+ *
+ * This exception does not invalidate any other reasons why a work based on
+ * this file might be covered by the GNU General Public License.
+ *
+ * The EtherCAT Technology, the trade name and logo "EtherCAT" are the intellectual
+ * property of, and protected by Beckhoff Automation GmbH.
+ */
+
+ /** \file
+ * \brief
+ * Ethernet over EtherCAT (EoE) module.
+ *
+ * Reassembles the Ethernet frames the master sends in mailbox fragments and
+ * hands them to the application, fragments the frames the application sends
+ * back and answers set IP parameter requests. One frame is buffered each way.
+ */
+
+#include <cc.h>
+#include "esc.h"
+#include "esc_eoe.h"
+#include <string.h>
+
+/** Application buffers and callbacks, see eoe_cfg_t.
+ */
+static eoe_cfg_t * eoe_cfg;
+/** Main EoE status data array.
+ */
+static _EOEvar EOEvar;
+
+/** Take the application configuration.
+ *
+ * @param[in] cfg   = Pointer to by the Application static declared
+ * configuration variable holding the frame buffers and callbacks.
+ */
+void EOE_config (eoe_cfg_t * cfg)
+{
+   eoe_cfg = cfg;
+}
+
+/** Drop the frames in flight, used when the mailbox stops.
+ */
+void EOE_init (void)
+{
+   EOEvar.rxposition = 0;
+   EOEvar.rxfragment = 0;
+   EOEvar.rxdiscard = 0;
+   EOEvar.txsize = 0;
+   EOEvar.txposition = 0;
+   EOEvar.txfragment = 0;
+}
+
+/** Send an init or filter response carrying only a result code.
+ *
+ * @param[in] type     = Response frame type
+ * @param[in] result   = EOE_RESULT_ code
+ */
+static void EOE_response (uint8_t type, uint16_t result)
+{
+   _EOE *eoembx;
+   uint8_t mbxhandle;
+
+   mbxhandle = ESC_claimbuffer ();
+   if (mbxhandle)
+   {
+      eoembx = (_EOE *) &MBX[mbxhandle];
+      eoembx->mbxheader.length = htoes ((uint16_t) EOEHSIZE);
+      eoembx->mbxheader.mbxtype = MBXEOE;
+      eoembx->eoeheader.frameinfo1 = htoes ((uint16_t) (type | EOE_HDR_LAST_FRAGMENT));
+      eoembx->eoeheader.frameinfo2 = htoes (result);
+      MBXcontrol[mbxhandle].state = MBXstate_outreq;
+   }
+}
+
+/** Copy the next field of a set IP parameter request.
+ *
+ * @return 1 if the request was long enough to hold it, 0 otherwise.
+ */
+static uint8_t EOE_param_field (const uint8_t * data, uint16_t length, uint16_t * position, void * field, uint16_t size)
+{
+   if ((uint32_t) *position + size > length)
+   {
+      return 0;
+   }
+   memcpy (field, data + *position, size);
+   *position += size;
+   return 1;
+}
+
+/** Set IP parameter request. Only the fields flagged as included follow
+ * the flags, in the order of the flag bits.
+ */
+static void EOE_init_request (_EOE * eoembx)
+{
+   eoe_param_t param;
+   uint16_t length = etohs (eoembx->mbxheader.length) - EOEHSIZE;
+   uint16_t position = 0;
+   uint16_t result = EOE_RESULT_UNSPECIFIED_ERROR;
+   uint32_t flags;
+   uint8_t ok;
+
+   memset (&param, 0, sizeof (param));
+   ok = EOE_param_field (eoembx->data, length, &position, &flags, sizeof (flags));
+   flags = etohl (flags);
+   if (ok && (flags & EOE_PARAM_MAC_INCLUDE))
+   {
+      ok = param.mac_set = EOE_param_field (eoembx->data, length, &position, param.mac, sizeof (param.mac));
+   }
+   if (ok && (flags & EOE_PARAM_IP_INCLUDE))
+   {
+      ok = param.ip_set = EOE_param_field (eoembx->data, length, &position, &param.ip, sizeof (param.ip));
+      param.ip = etohl (param.ip);
+   }
+   if (ok && (flags & EOE_PARAM_SUBNET_IP_INCLUDE))
+   {
+      ok = param.subnet_set = EOE_param_field (eoembx->data, length, &position, &param.subnet, sizeof (param.subnet));
+      param.subnet = etohl (param.subnet);
+   }
+   if (ok && (flags & EOE_PARAM_DEFAULT_GATEWAY_INCLUDE))
+   {
+      ok = param.default_gateway_set = EOE_param_field (eoembx->data, length, &position, &param.default_gateway, sizeof (param.default_gateway));
+      param.default_gateway = etohl (param.default_gateway);
+   }
+   if (ok && (flags & EOE_PARAM_DNS_IP_INCLUDE))
+   {
+      ok = param.dns_ip_set = EOE_param_field (eoembx->data, length, &position, &param.dns_ip, sizeof (param.dns_ip));
+      param.dns_ip = etohl (param.dns_ip);
+   }
+   if (ok && (flags & EOE_PARAM_DNS_NAME_INCLUDE))
+   {
+      ok = param.dns_name_set = EOE_param_field (eoembx->data, length, &position, param.dns_name, sizeof (param.dns_name));
+      param.dns_name[EOE_DNS_NAME_LENGTH - 1] = '\0';
+   }
+
+   if (ok)
+   {
+      result = eoe_cfg->set_param ? eoe_cfg->set_param (&param) : EOE_RESULT_NO_IP_SUPPORT;
+   }
+   EOE_response (EOE_TYPE_INIT_RESP, result);
+}
+
+/** Stop reassembling the current frame, the rest of its fragments are ignored.
+ */
+static void EOE_discard (void)
+{
+   if (!EOEvar.rxdiscard)
+   {
+      EOEvar.rxdropped++;
+      ESC_TRACE (TRACE_EOE_DROPPED, EOEvar.rxposition, EOEvar.rxfragment);
+   }
+   EOEvar.rxdiscard = 1;
+   EOEvar.rxposition = 0;
+   EOEvar.rxfragment = 0;
+}
+
+/** One fragment of an Ethernet frame. The first one starts a frame, every
+ * following one has to continue it exactly, a gap drops the frame.
+ */
+static void EOE_fragment (_EOE * eoembx)
+{
+   uint16_t frameinfo1 = etohs (eoembx->eoeheader.frameinfo1);
+   uint16_t frameinfo2 = etohs (eoembx->eoeheader.frameinfo2);
+   uint8_t fragment = frameinfo2 & EOE_HDR_FRAG_NO_MASK;
+   uint8_t frame = (frameinfo2 & EOE_HDR_FRAME_NO_MASK) >> EOE_HDR_FRAME_NO_SHIFT;
+   uint16_t offset = ((frameinfo2 & EOE_HDR_FRAME_OFFSET_MASK) >> EOE_HDR_FRAME_OFFSET_SHIFT) * EOE_HDR_FRAME_BLOCK;
+   uint16_t size = etohs (eoembx->mbxheader.length) - EOEHSIZE;
+
+   if ((frameinfo1 & EOE_HDR_LAST_FRAGMENT) && (frameinfo1 & EOE_HDR_TIME_APPEND))
+   {
+      size = (size > EOE_TIMESTAMP_SIZE) ? size - EOE_TIMESTAMP_SIZE : 0;
+   }
+
+   if (fragment == 0)
+   {
+      /* A new frame, the offset field holds its complete size */
+      if (EOEvar.rxfragment)
+      {
+         EOE_discard ();
+      }
+      EOEvar.rxdiscard = 0;
+      EOEvar.rxposition = 0;
+      EOEvar.rxfragment = 0;
+      EOEvar.rxframe = frame;
+   }
+   else if (EOEvar.rxdiscard)
+   {
+      return;
+   }
+   else if ((fragment != EOEvar.rxfragment) || (frame != EOEvar.rxframe) || (offset != EOEvar.rxposition))
+   {
+      EOE_discard ();
+      return;
+   }
+
+   if (((uint32_t) EOEvar.rxposition + size) > eoe_cfg->rxbuffer_size)
+   {
+      EOE_discard ();
+      return;
+   }
+   memcpy (eoe_cfg->rxbuffer + EOEvar.rxposition, eoembx->data, size);
+   EOEvar.rxposition += size;
+   EOEvar.rxfragment++;
+
+   if (frameinfo1 & EOE_HDR_LAST_FRAGMENT)
+   {
+      EOEvar.rxframes++;
+      if (eoe_cfg->handle_frame)
+      {
+         eoe_cfg->handle_frame (eoe_cfg->rxbuffer, EOEvar.rxposition);
+      }
+      EOEvar.rxposition = 0;
+      EOEvar.rxfragment = 0;
+   }
+}
+
+/** Whether the frame handed to EOE_send is still being sent.
+ *
+ * @return 0 when the tx buffer may be written.
+ */
+uint8_t EOE_tx_busy (void)
+{
+   return (EOEvar.txsize != 0);
+}
+
+/** Send the frame the application built in the tx buffer. The fragments go
+ * out from ESC_eoeprocess_tx, one per mailbox read of the master.
+ *
+ * @param[in] size   = Frame size in bytes
+ */
+void EOE_send (uint16_t size)
+{
+   if (EOEvar.txsize || !size || (size > eoe_cfg->txbuffer_size))
+   {
+      return;
+   }
+   EOEvar.txsize = size;
+   EOEvar.txposition = 0;
+   EOEvar.txfragment = 0;
+   EOEvar.txframe = (EOEvar.txframe + 1) & (EOE_HDR_FRAME_NO_MASK >> EOE_HDR_FRAME_NO_SHIFT);
+}
+
+/** Post the next fragment of the frame being sent. It only claims a buffer
+ * while nothing else waits for the outbox and the master has no mailbox
+ * waiting in SM0: ESC_mbxprocess only reads the inbox with the outbox free,
+ * so a frame streamed back to back would otherwise lock the master out.
+ */
+void ESC_eoeprocess_tx (void)
+{
+   _EOE *eoembx;
+   uint8_t mbxhandle;
+   uint16_t size, frameinfo1, frameinfo2, offset;
+
+   if (!MBXrun || !EOEvar.txsize || ESCvar.txcue || ESCvar.mbxoutpost ||
+       ESCvar.SM[0].MBXstat || MBXcontrol[0].state)
+   {
+      return;
+   }
+   mbxhandle = ESC_claimbuffer ();
+   if (!mbxhandle)
+   {
+      return;
+   }
+
+   size = EOEvar.txsize - EOEvar.txposition;
+   frameinfo1 = EOE_TYPE_FRAG_DATA | EOE_HDR_LAST_FRAGMENT;
+   if (size > EOE_DATA_SIZE)
+   {
+      size = EOE_FRAG_SIZE;
+      frameinfo1 = EOE_TYPE_FRAG_DATA;
+   }
+   /* The first fragment carries the complete size, the others their offset */
+   offset = EOEvar.txfragment ? EOEvar.txposition : EOEvar.txsize + EOE_HDR_FRAME_BLOCK - 1;
+   frameinfo2 = (EOEvar.txfragment & EOE_HDR_FRAG_NO_MASK) |
+      (((offset / EOE_HDR_FRAME_BLOCK) << EOE_HDR_FRAME_OFFSET_SHIFT) & EOE_HDR_FRAME_OFFSET_MASK) |
+      ((EOEvar.txframe << EOE_HDR_FRAME_NO_SHIFT) & EOE_HDR_FRAME_NO_MASK);
+
+   eoembx = (_EOE *) &MBX[mbxhandle];
+   eoembx->mbxheader.length = htoes ((uint16_t) (EOEHSIZE + size));
+   eoembx->mbxheader.mbxtype = MBXEOE;
+   eoembx->eoeheader.frameinfo1 = htoes (frameinfo1);
+   eoembx->eoeheader.frameinfo2 = htoes (frameinfo2);
+   memcpy (eoembx->data, eoe_cfg->txbuffer + EOEvar.txposition, size);
+   MBXcontrol[mbxhandle].state = MBXstate_outreq;
+
+   EOEvar.txposition += size;
+   EOEvar.txfragment++;
+   if (frameinfo1 & EOE_HDR_LAST_FRAGMENT)
+   {
+      EOEvar.txsize = 0;
+      EOEvar.txframes++;
+   }
+}
+
+/** Main EoE function checking the status on current mailbox buffers carrying
+ * data, distributing the mailboxes to appropriate EoE functions depending on
+ * requested frame type.
+ */
+void ESC_eoeprocess (void)
+{
+   _MBXh *mbh;
+   _EOE *eoembx;
+
+   if (!MBXrun)
+   {
+      return;
+   }
+   if (!ESCvar.xoe && (MBXcontrol[0].state == MBXstate_inclaim))
+   {
+      mbh = (_MBXh *) &MBX[0];
+      if (mbh->mbxtype == MBXEOE)
+      {
+         ESCvar.xoe = MBXEOE;
+      }
+   }
+   if (ESCvar.xoe == MBXEOE)
+   {
+      eoembx = (_EOE *) &MBX[0];
+      if (etohs (eoembx->mbxheader.length) < EOEHSIZE)
+      {
+         MBX_error (MBXERR_SIZETOOSHORT);
+      }
+      else
+      {
+         switch (etohs (eoembx->eoeheader.frameinfo1) & EOE_HDR_FRAME_TYPE_MASK)
+         {
+            case EOE_TYPE_FRAG_DATA:
+            {
+               DPRINT("EOE_TYPE_FRAG_DATA\n");
+               EOE_fragment (eoembx);
+               break;
+            }
+            case EOE_TYPE_INIT_REQ:
+            {
+               DPRINT("EOE_TYPE_INIT_REQ\n");
+               EOE_init_request (eoembx);
+               break;
+            }
+            case EOE_TYPE_MACFILTER_REQ:
+            {
+               DPRINT("EOE_TYPE_MACFILTER_REQ\n");
+               EOE_response (EOE_TYPE_MACFILTER_RESP, EOE_RESULT_NO_MACFILTER_SUPPORT);
+               break;
+            }
+            default:
+            {
+               DPRINT("EOE unsupported frame type\n");
+               EOE_response (EOE_TYPE_INIT_RESP, EOE_RESULT_UNSUPPORTED_TYPE);
+               break;
+            }
+         }
+      }
+      MBXcontrol[0].state = MBXstate_idle;
+      ESCvar.xoe = 0;
+   }
+}
+
+/** Frame counters for diagnostics.
+ */
+const _EOEvar * EOE_status (void)
+{
+   return &EOEvar;
+}
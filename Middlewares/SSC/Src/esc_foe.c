@@ -47,7 +47,7 @@
  */
 
 //define if FOE_read should be supported
-//#define FOE_READ_SUPPORTED
+#define FOE_READ_SUPPORTED
 
 /** Variable holding current filename read at FOE Open.
  */
@@ -101,18 +101,28 @@ int FOE_fopen (char *name, uint8_t num_chars, uint32_t pass, uint8_t op)
       if ((0 == strncmp (foe_file_name, foe_files[i].name, num_chars)) &&
           (pass == foe_files[i].filepass))
       {
-         foe_file = &foe_files[i];
-         foe_file->address_offset = 0;
          switch (op)
          {
             case FOE_OP_RRQ:
             {
+               if (!foe_files[i].read_function)
+               {
+                  return FOE_ERR_ACCESS;
+               }
+               foe_file = &foe_files[i];
+               foe_file->address_offset = 0;
                FOEvar.fposition = 0;
                FOEvar.fend = foe_files[i].max_data;
                return 0;
             }
             case FOE_OP_WRQ:
             {
+               if (!foe_files[i].write_function)
+               {
+                  return FOE_ERR_ACCESS;
+               }
+               foe_file = &foe_files[i];
+               foe_file->address_offset = 0;
                FOEvar.fposition = 0;
                FOEvar.fend = foe_files[i].max_data;
                return 0;
@@ -125,9 +135,10 @@ int FOE_fopen (char *name, uint8_t num_chars, uint32_t pass, uint8_t op)
 }
 
 #ifdef FOE_READ_SUPPORTED
-/** Function writing local data to mailbox buffer to be sent as next FoE frame.
- * It will try to fill the Mailbox buffer available if there is enough data
- * left to read.
+/** Function writing file data to mailbox buffer to be sent as next FoE frame.
+ * The application read hook copies straight into the mailbox buffer, there is
+ * no intermediate file buffer. A hook returning less than asked for ends the
+ * file.
  *
  * @param[in] data      = pointer to buffer
  * @param[in] maxlength = max length of data possible to read, controlled by
@@ -137,14 +148,20 @@ int FOE_fopen (char *name, uint8_t num_chars, uint32_t pass, uint8_t op)
  */
 uint16_t FOE_fread (uint8_t * data, uint16_t maxlength)
 {
-   uint16_t ncopied = 0;
+   uint32_t ncopied;
 
-   while (maxlength && (FOEvar.fend - FOEvar.fposition))
+   FOEvar.fprevposition = FOEvar.fposition;
+   if (maxlength > (FOEvar.fend - FOEvar.fposition))
    {
-      maxlength--;
-      *(data++) = fbuffer[FOEvar.fposition++];
-      ncopied++;
+      maxlength = FOEvar.fend - FOEvar.fposition;
    }
+   ncopied = foe_file->read_function (foe_file, FOEvar.fposition, data, maxlength);
+   if (ncopied > maxlength)
+   {
+      ncopied = maxlength;
+   }
+   FOEvar.fposition += ncopied;
+   foe_file->address_offset = FOEvar.fposition;
 
    return ncopied;
 }
@@ -174,7 +191,7 @@ uint16_t FOE_fwrite (uint8_t *data, uint16_t length)
        foe_cfg->fbuffer[FOEvar.fbufposition++] = *(data++);
        if(FOEvar.fbufposition >= foe_cfg->buffer_size)
        {
-          failed = foe_file->write_function (foe_file, foe_cfg->fbuffer);
+          failed = foe_file->write_function (foe_file, foe_cfg->fbuffer, foe_cfg->buffer_size);
           FOEvar.fbufposition = 0;
           foe_file->address_offset += foe_cfg->buffer_size;
        }
@@ -188,7 +205,7 @@ uint16_t FOE_fwrite (uint8_t *data, uint16_t length)
 
 
 /** Function handling the final FOE_fwrite when we close up regardless
- * if we have filled the buffers or not.
+ * if we have filled the buffers or not, then the application close hook.
  *
  * @return Number of copied bytes on success, 0= if failed.
  */
@@ -206,11 +223,15 @@ uint32_t FOE_fclose (void)
       {
          foe_cfg->fbuffer[FOEvar.fbufposition++] = foe_cfg->empty_write;
       }
-      failed = foe_file->write_function (foe_file, foe_cfg->fbuffer);
+      failed = foe_file->write_function (foe_file, foe_cfg->fbuffer, foe_cfg->buffer_size);
       FOEvar.fbufposition = 0;
       foe_file->address_offset += foe_cfg->buffer_size;
       DPRINT("FOE_fclose EXTRA write ended\n");
    }
+   if (!failed && foe_file->close_function)
+   {
+      failed = foe_file->close_function (foe_file, FOEvar.fposition);
+   }
    return failed;
 }
 
@@ -238,6 +259,7 @@ void FOE_abort (uint32_t code)
 
    if (code)
    {
+      ESC_TRACE (TRACE_FOE_ABORT, code, 0);
       /* Send back an error packet. */
       mbxhandle = ESC_claimbuffer ();
       if (mbxhandle)
@@ -357,7 +379,12 @@ void FOE_read ()
        * Attempt to send the packet
        */
       res = FOE_send_data_packet ();
-      if (res <= (int)FOE_DATA_SIZE)
+      if (res < (int)FOE_DATA_SIZE)
+      {
+         /* Whole file in the first packet, its ack ends the transfer */
+         FOEvar.foestate = FOE_WAIT_FOR_FINAL_ACK;
+      }
+      else if (res == (int)FOE_DATA_SIZE)
       {
          FOEvar.foestate = FOE_WAIT_FOR_ACK;
       }
@@ -480,10 +507,17 @@ void FOE_data ()
    }
    else if (data_len == 0)
    {
-      DPRINT("FOE_data completed\n");
-      FOE_fclose ();
-      res = FOE_send_ack ();
-      FOE_init ();
+      if (FOE_fclose ())
+      {
+         DPRINT("FOE_fclose failed\n");
+         FOE_abort (FOE_ERR_PROGERROR);
+      }
+      else
+      {
+         DPRINT("FOE_data completed\n");
+         res = FOE_send_ack ();
+         FOE_init ();
+      }
    }
    else if (FOEvar.fposition + data_len > FOEvar.fend)
    {
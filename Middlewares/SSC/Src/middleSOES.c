@@ -1,10 +1,13 @@
 #include "middleSOES.h"
 
-#define WD_RESET           1000
+#define WD_TIMEOUT_US      100000																				// Process data watchdog in us
 #define DEFAULTTXPDOMAP    0x1a00
 #define DEFAULTRXPDOMAP    0x1600
 #define DEFAULTTXPDOITEMS  1
 #define DEFAULTRXPDOITEMS  1
+#define STARTUP_TIMEOUT_US 1000000																				// ESC EEPROM load and PDI ready, in us
+#define ALEVENTMASK        (ESCREG_ALEVENT_CONTROL | ESCREG_ALEVENT_SM_MASK | ESCREG_ALEVENT_SM2 | ESCREG_ALEVENT_SM3)	// Only events the stack acknowledges, so IRQ deasserts again
+#define MBXEVENTMASK       (ESCREG_ALEVENT_CONTROL | ESCREG_ALEVENT_SM_MASK)						// Events for the state machine and the mailbox
 
 volatile _ESCvar  									ESCvar;
 _MBX              									MBX[MBXBUFFERS];
@@ -16,15 +19,48 @@ middleSOESReadBufferBooleansTypedef middleSOESReadBufferBooleans;
 middleSOESWritebufferTypedef				middleSOESWriteBuffer;
 middleSOESAppTypedef								App;
 uint16_t          									TXPDOsize,RXPDOsize;
-int               									wd_cnt = WD_RESET;
+uint32_t          									wd_deadline;
 volatile uint8_t  									digoutput;
 volatile uint8_t  									diginput;
 uint16_t          									txpdomap = DEFAULTTXPDOMAP;
 uint16_t          									rxpdomap = DEFAULTRXPDOMAP;
 uint8_t           									txpdoitems = DEFAULTTXPDOITEMS;
 uint8_t           									rxpdoitems = DEFAULTTXPDOITEMS;
+uint8_t           									middleSOESPDIAccountingReset = 0;
+volatile bool     									middleSOESEventPending = true;									// IRQ since the last AL event read, the first pass reads
+uint16_t          									middleSOESMailboxEvents = 0;									// Latched from any AL event read until the mailbox task ran
+bool              									middleSOESEventRecheck = false;								// Mailbox events were set on the last read, read once more
+bool              									middleSOESEventReadFailed = false;							// Last AL event read failed, the SM status may be stale
+uint32_t          									middleSOESEventPollDeadline;
+bool              									middleSOESFoEEnabled = false;
+bool              									middleSOESEoEEnabled = false;
+uint8_t           									middleSOESErrorRegister = 0;
+bool              									middleSOESWatchdogTripped = false;
+uint16_t          									middleSOESLastALStatusCode = ALERR_NONE;
+
+typedef struct {
+	uint16_t ErrorCode;
+	uint8_t ErrorRegister;
+	uint8_t Priority;
+	uint8_t Sequence;
+	uint8_t Data[COE_EMERGENCY_DATASIZE];
+} middleSOESEmergencyStruct;
+
+middleSOESEmergencyStruct						middleSOESEmergencyQueue[middleSOESEmergencyQueueSize];
+uint8_t															middleSOESEmergencyCount = 0;
+uint8_t															middleSOESEmergencySequence = 0;
+bool																middleSOESEmergencyHoldOff = false;
+uint32_t														middleSOESEmergencyDeadline;
+middleSOESEmergencyStatusStruct			middleSOESEmergencyStatus;
 
 void (*middleSOESReadBufferUpdateEventFunctionPointer)(void);
+void (*middleSOESESCEventFunctionPointer)(void);
+void (*middleSOESObjectWriteEventFunctionPointer)(uint16_t index, uint8_t subindex);
+void (*middleSOESEmergencyEventFunctionPointer)(uint16_t errorCode, uint8_t errorRegister, middleSOESEmergencyPriorityTypedef priority);
+void (*middleSOESALStatusCodeEventFunctionPointer)(uint16_t statusCode, uint8_t status);
+
+void middleSOESESCInterruptHandler(void);
+static void middleSOESEmergencyTransmit(void);
 
 /** Mandatory: Hook called from the slave stack SDO Download handler to act on
  * user specified Index and Sub-index.
@@ -57,6 +93,13 @@ void ESC_objecthandler(uint16_t index, uint8_t subindex) {
          TXPDOsize = SM3_sml = sizeTXPDO();
          break;
       }
+      case 0x2100: {
+         if (middleSOESPDIAccountingReset) {
+            PDI_ResetAccounting();
+            middleSOESPDIAccountingReset = 0;
+         }
+         break;
+      }
       case 0x7100: {
          switch (subindex) {
             default:
@@ -64,10 +107,10 @@ void ESC_objecthandler(uint16_t index, uint8_t subindex) {
          }
          break;
       }
-      case 0x8001: {
-         switch (subindex) {
-            default:
-               break;
+      default: {
+         /* Application objects, e.g. commands to a middleware */
+         if (middleSOESObjectWriteEventFunctionPointer) {
+            middleSOESObjectWriteEventFunctionPointer(index, subindex);
          }
          break;
       }
@@ -86,17 +129,18 @@ void APP_safeoutput(void) {
  */
 void TXPDO_update(void) {
 	ESC_write(SM3_sma, &middleSOESReadBuffer, TXPDOsize);
-	
-	middleSOESReadBufferBooleans.ButtonC 						= middleSOESReadBuffer.NunChuck.ButtonC;
-	middleSOESReadBufferBooleans.ButtonZ 						= middleSOESReadBuffer.NunChuck.ButtonZ;
-	middleSOESReadBufferBooleans.NunChuckDataValid 	= middleSOESReadBuffer.NunChuck.NunChuckDataValid;	
+	objectlistTxPDOShadowUpdate();
 }
 /** Mandatory: Read Sync Manager 2 to local process data, Master Outputs.
  */
 void RXPDO_update(void) {
-  ESC_read(SM2_sma, &middleSOESWriteBuffer, RXPDOsize);
+	middleSOESWritebufferTypedef outputs;
+	
+	/* Only take over outputs that were read completely, a failed read keeps the last ones */
+	if (ESC_read(SM2_sma, &outputs, RXPDOsize) == PDI_OK)
+		memcpy(&middleSOESWriteBuffer, &outputs, RXPDOsize);
 	
-	middleSOESReadBufferBooleans.LED0 = middleSOESWriteBuffer.Digital_outputs.LED0;
+	objectlistRxPDOShadowUpdate();
 }
 
 /** Mandatory: Function to update local I/O, call read ethercat outputs, call
@@ -104,16 +148,17 @@ void RXPDO_update(void) {
  * made state change affecting the App.state.
  */
 void DIG_process(void) {
-	if (wd_cnt){
-		wd_cnt--;
-	}
-	
 	if (App.state & APPSTATE_OUTPUT){
 		/* SM2 trigger ? */
 		if (ESCvar.ALevent & ESCREG_ALEVENT_SM2) {
 			 ESCvar.ALevent &= ~ESCREG_ALEVENT_SM2;
 			 RXPDO_update();
-			 wd_cnt = WD_RESET;
+			 wd_deadline = modDelayDeadlineSet(WD_TIMEOUT_US);
+			 
+			 if (middleSOESWatchdogTripped) {
+					middleSOESWatchdogTripped = false;
+					middleSOESEmergency(middleSOESEmergencyErrorReset,middleSOESErrorRegisterCommunication,EMERGENCY_PRIORITY_NORMAL,NULL);
+			 }
 			 
 			 if (middleSOESWriteBuffer.Digital_outputs.LED0) {
 					modEffectChangeState(STAT_LED_DEBUG,STAT_SET);
@@ -122,16 +167,20 @@ void DIG_process(void) {
 			 }
 		}
 	
-		if (!wd_cnt) {
+		if (modDelayDeadlineExpired(wd_deadline)) {
 			 //DPRINT("DIG_process watchdog tripped\n");
 			 ESC_stopoutput();
 			 /* watchdog, invalid outputs */
 			 ESC_ALerror(ALERR_WATCHDOG);
 			 /* goto safe-op with error bit set */
 			 ESC_ALstatus(ESCsafeop | ESCerror);
+			 if (!middleSOESWatchdogTripped) {
+					middleSOESWatchdogTripped = true;
+					middleSOESEmergency(middleSOESEmergencyWatchdog,middleSOESErrorRegisterCommunication,EMERGENCY_PRIORITY_HIGH,NULL);
+			 }
 		}
 	}else{
-		wd_cnt = WD_RESET;
+		wd_deadline = modDelayDeadlineSet(WD_TIMEOUT_US);
 		modEffectChangeState(STAT_LED_DEBUG,STAT_RESET);
 	}
 	
@@ -163,26 +212,46 @@ void DIG_process(void) {
  * the application loop for cyclic read the EtherCAT state and staus, update
  * of I/O.
  */
-void middleSOESInit(void) {
+bool middleSOESInit(void) {
 	DPRINT ("SOES (Simple Open EtherCAT Slave)\n");
 
 	ESC_reset();
 	ESC_init();
+	PDI_BindLEDUpdate(&modIndicatorUpdate);
 
 	TXPDOsize = SM3_sml = sizeTXPDO();
 	RXPDOsize = SM2_sml = sizeRXPDO();
 	
+	middleSOESErrorRegister = 0;
+	middleSOESWatchdogTripped = false;
+	middleSOESLastALStatusCode = ALERR_NONE;
+	middleSOESEmergencyCount = 0;
+	middleSOESEmergencyHoldOff = false;
+	
+	// Both startup waits share one deadline, a missing or dead LAN9252 must not hang the slave
+	uint32_t startupDeadline = modDelayDeadlineSet(STARTUP_TIMEOUT_US);
+	bool expired;
+
 	//Check BYTE-ORDER register 0x64.
 	uint32_t data = 0;
 	do {
+		expired = modDelayDeadlineExpired(startupDeadline);
 		data = PDIReadLAN9252DirectReg(LAN9252_BYTE_ORDER_REG);
-	}while(0x87654321 != data);
+	}while((0x87654321 != data) && !expired);
+	
+	if(0x87654321 != data)
+		return false;
 
 	/*  wait until ESC is started up */
+	ESCvar.DLstatus = 0;
 	do {
+		expired = modDelayDeadlineExpired(startupDeadline);
 		ESC_read(ESCREG_DLSTATUS, (void *)&ESCvar.DLstatus,sizeof(ESCvar.DLstatus));
 		//ESCvar.DLstatus = etohs(ESCvar.DLstatus);
-	} while ((ESCvar.DLstatus & 0x0001) == 0);
+	} while (((ESCvar.DLstatus & 0x0001) == 0) && !expired);
+	
+	if((ESCvar.DLstatus & 0x0001) == 0)
+		return false;
 
 	/* reset ESC to init state */
 	ESC_ALstatus(ESCinit);
@@ -190,9 +259,61 @@ void middleSOESInit(void) {
 	ESC_stopmbx();
 	ESC_stopinput();
 	ESC_stopoutput();
+
+	/* Let the ESC raise IRQ on AL events and SYNC0, the tasks are released from there */
+	uint32_t alEventMask = htoel(ALEVENTMASK);
+	ESC_write(ESCREG_ALEVENTMASK, (void *)&alEventMask, sizeof(alEventMask));
+	middleSOESEventPending = true;
+	middleSOESMailboxEvents = 0;
+	middleSOESEventRecheck = false;
+	middleSOESEventReadFailed = false;
+	middleSOESEventPollDeadline = modDelayDeadlineSet(middleSOESEventPollPeriod);
+	PDI_BindISR_IRQ(&middleSOESESCInterruptHandler);
+	PDI_BindISR_SYNC0(&middleSOESESCInterruptHandler);
+	PDI_Init_IRQ_Interrupt();
+	PDI_Init_SYNC_Interrupts();
+	
+	return true;
 }
 
 void middleSOESTask(void) {
+	middleSOESProcessDataTask();
+	middleSOESMailboxTask();
+}
+
+// False when the read failed, the events of the last read are not handed over again then.
+static bool middleSOESReadALEvent(void) {
+	middleSOESEventPending = false;																						// Before the read, an IRQ from here on is seen by the next pass
+	middleSOESEventReadFailed = (ESC_ReadAlEvent() != PDI_OK);
+	if(middleSOESEventReadFailed) {
+		middleSOESEventPending = true;																					// Still latched in the ESC, read again next pass
+		return false;
+	}
+	middleSOESMailboxEvents |= ESCvar.ALevent & MBXEVENTMASK;
+	middleSOESEventPollDeadline = modDelayDeadlineSet(middleSOESEventPollPeriod);
+	return true;
+}
+
+void middleSOESProcessDataTask(void) {
+	PDI_CallerTypeDef previousCaller = PDI_SetCaller(PDI_CALLER_PDO);
+
+	/* Without process data DIG_process does no ESC access, leave the events to the mailbox task */
+	if (App.state) {
+		/* Read local time from ESC*/
+		ESC_read(ESCREG_LOCALTIME, (void *) &ESCvar.Time, sizeof (ESCvar.Time));
+		ESCvar.Time = etohl(ESCvar.Time);
+
+		middleSOESReadALEvent();
+	}
+
+	DIG_process();
+
+	PDI_SetCaller(previousCaller);
+}
+
+void middleSOESMailboxTask(void) {
+	PDI_CallerTypeDef previousCaller = PDI_SetCaller(PDI_CALLER_STATE);
+
 	/* On init restore PDO mappings to default size */
 	
 	if((ESCvar.ALstatus & 0x0f) == ESCinit) {
@@ -200,15 +321,41 @@ void middleSOESTask(void) {
 		rxpdomap = DEFAULTRXPDOMAP;
 		txpdoitems = DEFAULTTXPDOITEMS;
 		rxpdoitems = DEFAULTTXPDOITEMS;
+		
+		/* No mailbox in init, a transfer cut off by the state change starts over */
+		if(middleSOESFoEEnabled)
+			FOE_init();
+		if(middleSOESEoEEnabled)
+			EOE_init();
 	}
-	/* Read local time from ESC*/
-	ESC_read(ESCREG_LOCALTIME, (void *) &ESCvar.Time, sizeof (ESCvar.Time));
-	ESCvar.Time = etohl(ESCvar.Time);
 
-	ESC_ReadAlEvent();
+	/* AL event request bits stay latched until acknowledged. With process data the PDO task reads them on every IRQ and
+	 * hands the mailbox ones over, otherwise they are fetched here on an IRQ only. A read that still finds mailbox events
+	 * is followed by one more, those keep the IRQ line asserted so no new edge comes, the slow poll covers a lost edge. */
+	if ((middleSOESEventPending && !App.state) || middleSOESEventRecheck || modDelayDeadlineExpired(middleSOESEventPollDeadline)) {
+		middleSOESEventRecheck = middleSOESReadALEvent() && (ESCvar.ALevent & MBXEVENTMASK);
+	}
+
+	/* The SM events of a failed read are missing, the mailbox would run on SM status from before and could post over an
+	 * unread reply. Events handed over so far stay latched until a read succeeds. */
+	if (middleSOESEventReadFailed) {
+		PDI_SetCaller(previousCaller);
+		return;
+	}
+	ESCvar.ALevent = middleSOESMailboxEvents;
+	middleSOESMailboxEvents = 0;
 
 	/* Check the state machine */
 	ESC_state();
+	
+	/* AL status codes set here or by the process data watchdog, each one reported once */
+	if (ESCvar.ALerror != middleSOESLastALStatusCode) {
+		middleSOESLastALStatusCode = ESCvar.ALerror;
+		if ((ESCvar.ALerror != ALERR_NONE) && middleSOESALStatusCodeEventFunctionPointer)
+			middleSOESALStatusCodeEventFunctionPointer(ESCvar.ALerror, ESCvar.ALstatus);
+	}
+
+	PDI_SetCaller(PDI_CALLER_MAILBOX);
 
 	/* If else to two separate execution paths
 	* If we're running BOOSTRAP
@@ -217,13 +364,150 @@ void middleSOESTask(void) {
 	* Else we're running normal execution
 	*  - MailBox
 	*   - CoE
+	*   - EoE
 	*/
-	if (ESC_mbxprocess()) {
-		 ESC_coeprocess();
+	if (((ESCvar.ALevent & ESCREG_ALEVENT_SM_MASK) || ESCvar.txcue || ESCvar.SM[0].MBXstat) && ESC_mbxprocess()) {		// Mailbox event or work left over
+		 if ((ESCvar.ALstatus & 0x0f) != ESCboot)
+				ESC_coeprocess();
+		 if (middleSOESFoEEnabled)
+				ESC_foeprocess();
+		 if (middleSOESEoEEnabled && ((ESCvar.ALstatus & 0x0f) != ESCboot))
+				ESC_eoeprocess();
 		 ESC_xoeprocess();
 	}
+
+	/* Emergencies go ahead of frames to the master, those go out one fragment per pass whenever the outbox is free */
+	middleSOESEmergencyTransmit();
+	if (middleSOESEoEEnabled)
+		ESC_eoeprocess_tx();
+
+	PDI_SetCaller(previousCaller);
+}
+
+// FoE stays off (answered as unsupported protocol) until the application hands in its files.
+void middleSOESFoEConfig(foe_cfg_t *cfg, foe_writefile_cfg_t *files) {
+	FOE_config(cfg,files);
+	FOE_init();
+	middleSOESFoEEnabled = true;
+}
+
+// EoE likewise, the application hands in its frame buffers and handlers.
+void middleSOESEoEConfig(eoe_cfg_t *cfg) {
+	EOE_config(cfg);
+	EOE_init();
+	middleSOESEoEEnabled = true;
+}
+
+// Queues an emergency and updates the error register: an error sets errorRegisterBits, middleSOESEmergencyErrorReset
+// clears them again. Returns false when the queue was full of more urgent ones.
+bool middleSOESEmergency(uint16_t errorCode, uint8_t errorRegisterBits, middleSOESEmergencyPriorityTypedef priority, const uint8_t *data) {
+	middleSOESEmergencyStruct *emergency;
+	uint8_t position;
+	
+	if(errorCode == middleSOESEmergencyErrorReset)
+		middleSOESErrorRegister &= ~errorRegisterBits;
+	else
+		middleSOESErrorRegister |= errorRegisterBits;
+	if(middleSOESErrorRegister & ~middleSOESErrorRegisterGeneric)
+		middleSOESErrorRegister |= middleSOESErrorRegisterGeneric;
+	else
+		middleSOESErrorRegister = 0;
+	
+	// Every report, also the ones merged or dropped below
+	if(middleSOESEmergencyEventFunctionPointer)
+		middleSOESEmergencyEventFunctionPointer(errorCode,middleSOESErrorRegister,priority);
+	
+	// The last one queued, if it still waits
+	for(position = 0; position < middleSOESEmergencyCount; position++) {
+		emergency = &middleSOESEmergencyQueue[position];
+		if(emergency->Sequence == middleSOESEmergencySequence && emergency->ErrorCode == errorCode && emergency->ErrorRegister == middleSOESErrorRegister &&
+			(!data || !memcmp(emergency->Data,data,COE_EMERGENCY_DATASIZE))) {
+			middleSOESEmergencyStatus.Merged++;
+			return true;
+		}
+	}
+	
+	if(middleSOESEmergencyCount == middleSOESEmergencyQueueSize) {
+		emergency = &middleSOESEmergencyQueue[middleSOESEmergencyQueueSize - 1];
+		middleSOESEmergencyStatus.Dropped++;
+		if(emergency->Priority <= priority) {
+			modTraceEvent(TRACE_EMCY_DROPPED,errorCode,middleSOESEmergencyCount);
+			return false;
+		}
+		modTraceEvent(TRACE_EMCY_DROPPED,emergency->ErrorCode,middleSOESEmergencyCount);
+		middleSOESEmergencyCount--;
+	}
+	
+	// Behind everything as urgent or more
+	position = middleSOESEmergencyCount;
+	while(position && middleSOESEmergencyQueue[position - 1].Priority > priority) {
+		middleSOESEmergencyQueue[position] = middleSOESEmergencyQueue[position - 1];
+		position--;
+	}
+	
+	emergency = &middleSOESEmergencyQueue[position];
+	emergency->ErrorCode = errorCode;
+	emergency->ErrorRegister = middleSOESErrorRegister;
+	emergency->Priority = priority;
+	emergency->Sequence = ++middleSOESEmergencySequence;
+	if(data)
+		memcpy(emergency->Data,data,COE_EMERGENCY_DATASIZE);
+	else
+		memset(emergency->Data,0,COE_EMERGENCY_DATASIZE);
+	middleSOESEmergencyCount++;
+	middleSOESEmergencyStatus.Queued++;
+	
+	return true;
+}
+
+const middleSOESEmergencyStatusStruct *middleSOESEmergencyGetStatus(void) {
+	return &middleSOESEmergencyStatus;
+}
+
+// From the mailbox task, the queue head goes out once the outbox is free and the last one is old enough.
+static void middleSOESEmergencyTransmit(void) {
+	middleSOESEmergencyStruct *emergency = &middleSOESEmergencyQueue[0];
+	
+	if(middleSOESEmergencyHoldOff) {
+		if(!modDelayDeadlineExpired(middleSOESEmergencyDeadline))
+			return;
+		middleSOESEmergencyHoldOff = false;
+	}
 	
-	DIG_process();	
+	if(!middleSOESEmergencyCount || !COE_emergency(emergency->ErrorCode,emergency->ErrorRegister,emergency->Data))
+		return;
+	
+	middleSOESEmergencyCount--;
+	memmove(&middleSOESEmergencyQueue[0],&middleSOESEmergencyQueue[1],middleSOESEmergencyCount*sizeof(middleSOESEmergencyStruct));
+	middleSOESEmergencyStatus.Sent++;
+	middleSOESEmergencyHoldOff = true;
+	middleSOESEmergencyDeadline = modDelayDeadlineSet(middleSOESEmergencyInterval);
+}
+
+void middleSOESESCEvent(void (*eventFunctionPointer)(void)) {
+	if(eventFunctionPointer)
+		middleSOESESCEventFunctionPointer = eventFunctionPointer;
+}
+
+void middleSOESEmergencyEvent(void (*eventFunctionPointer)(uint16_t errorCode, uint8_t errorRegister, middleSOESEmergencyPriorityTypedef priority)) {
+	if(eventFunctionPointer)
+		middleSOESEmergencyEventFunctionPointer = eventFunctionPointer;
+}
+
+void middleSOESALStatusCodeEvent(void (*eventFunctionPointer)(uint16_t statusCode, uint8_t status)) {
+	if(eventFunctionPointer)
+		middleSOESALStatusCodeEventFunctionPointer = eventFunctionPointer;
+}
+
+void middleSOESObjectWriteEvent(void (*eventFunctionPointer)(uint16_t index, uint8_t subindex)) {
+	if(eventFunctionPointer)
+		middleSOESObjectWriteEventFunctionPointer = eventFunctionPointer;
+}
+
+void middleSOESESCInterruptHandler(void) {
+	middleSOESEventPending = true;
+	if(middleSOESESCEventFunctionPointer)
+		middleSOESESCEventFunctionPointer();																				// Runs in ISR context
 }
 
 void middleSOESReadBufferUpdateEvent(void (*eventFunctionPointer)(void)) {
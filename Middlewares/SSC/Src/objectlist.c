@@ -1,23 +1,63 @@
+// Generated by ESIEtherCAT/esigen.py from DieBieSlave-NunChuck.esx, edit the description and regenerate.
 #include "objectlist.h"
+#include "middleSOES.h"
+#include "middleFirmwareUpdate.h"
+#include "middleCapture.h"
+#include "middleDiagnosis.h"
+#include "middleParameter.h"
+#include "middleNunChuck.h"
+#include "middleCalibration.h"
 
 static const char acName1000[] = "Device Type";
 static const char acName1000_0[] = "Device Type";
+static const char acName1001[] = "Error Register";
+static const char acName1001_0[] = "Error Register";
 static const char acName1008[] = "Device Name";
 static const char acName1008_0[] = "Device Name";
 static const char acName1009[] = "Hardware Version";
 static const char acName1009_0[] = "Hardware Version";
 static const char acName100A[] = "Software Version";
 static const char acName100A_0[] = "Software Version";
+static const char acName1010[] = "Store Parameters";
+static const char acName1010_00[] = "Number of Elements";
+static const char acName1010_01[] = "Save All Parameters";
+static const char acName1011[] = "Restore Default Parameters";
+static const char acName1011_00[] = "Number of Elements";
+static const char acName1011_01[] = "Restore All Default Parameters";
 static const char acName1018[] = "Identity Object";
 static const char acName1018_00[] = "Number of Elements";
 static const char acName1018_01[] = "Vendor ID";
 static const char acName1018_02[] = "Product Code";
 static const char acName1018_03[] = "Revision Number";
 static const char acName1018_04[] = "Serial Number";
+static const char acName10F3[] = "Diagnosis History";
+static const char acName10F3_00[] = "Number of Elements";
+static const char acName10F3_01[] = "Maximum Messages";
+static const char acName10F3_02[] = "Newest Message";
+static const char acName10F3_03[] = "Newest Acknowledged Message";
+static const char acName10F3_04[] = "New Messages Available";
+static const char acName10F3_05[] = "Flags";
+static const char acName10F3_06[] = "Diagnosis Message 001";
+static const char acName10F3_07[] = "Diagnosis Message 002";
+static const char acName10F3_08[] = "Diagnosis Message 003";
+static const char acName10F3_09[] = "Diagnosis Message 004";
+static const char acName10F3_0A[] = "Diagnosis Message 005";
+static const char acName10F3_0B[] = "Diagnosis Message 006";
+static const char acName10F3_0C[] = "Diagnosis Message 007";
+static const char acName10F3_0D[] = "Diagnosis Message 008";
+static const char acName10F3_0E[] = "Diagnosis Message 009";
+static const char acName10F3_0F[] = "Diagnosis Message 010";
+static const char acName10F3_10[] = "Diagnosis Message 011";
+static const char acName10F3_11[] = "Diagnosis Message 012";
+static const char acName10F3_12[] = "Diagnosis Message 013";
+static const char acName10F3_13[] = "Diagnosis Message 014";
+static const char acName10F3_14[] = "Diagnosis Message 015";
+static const char acName10F3_15[] = "Diagnosis Message 016";
 static const char acName1600[] = "Digital outputs";
 static const char acName1600_00[] = "Number of Elements";
 static const char acName1600_01[] = "LED0";
-static const char acName1600_02[] = "Padding";
+static const char acName1600_02[] = "CaptureTrigger";
+static const char acName1600_03[] = "Padding";
 static const char acName1A00[] = "NunChuck";
 static const char acName1A00_00[] = "Number of Elements";
 static const char acName1A00_01[] = "JoyStickX";
@@ -41,6 +81,76 @@ static const char acName1C12_01[] = "PDO Mapping";
 static const char acName1C13[] = "Sync Manager 3 PDO Assignment";
 static const char acName1C13_00[] = "Number of Elements";
 static const char acName1C13_01[] = "PDO Mapping";
+static const char acName2100[] = "PDI Accounting";
+static const char acName2100_00[] = "Number of Elements";
+static const char acName2100_01[] = "CSRTransactions";
+static const char acName2100_02[] = "CSRBytes";
+static const char acName2100_03[] = "CSRCSCycles";
+static const char acName2100_04[] = "CSRBusyPolls";
+static const char acName2100_05[] = "CSRTimeUs";
+static const char acName2100_06[] = "PRAMTransactions";
+static const char acName2100_07[] = "PRAMBytes";
+static const char acName2100_08[] = "PRAMCSCycles";
+static const char acName2100_09[] = "PRAMBusyPolls";
+static const char acName2100_0A[] = "PRAMTimeUs";
+static const char acName2100_0B[] = "StateTransactions";
+static const char acName2100_0C[] = "StateBytes";
+static const char acName2100_0D[] = "StateCSCycles";
+static const char acName2100_0E[] = "StateBusyPolls";
+static const char acName2100_0F[] = "StateTimeUs";
+static const char acName2100_10[] = "MailboxTransactions";
+static const char acName2100_11[] = "MailboxBytes";
+static const char acName2100_12[] = "MailboxCSCycles";
+static const char acName2100_13[] = "MailboxBusyPolls";
+static const char acName2100_14[] = "MailboxTimeUs";
+static const char acName2100_15[] = "PDOTransactions";
+static const char acName2100_16[] = "PDOBytes";
+static const char acName2100_17[] = "PDOCSCycles";
+static const char acName2100_18[] = "PDOBusyPolls";
+static const char acName2100_19[] = "PDOTimeUs";
+static const char acName2100_1A[] = "OtherTransactions";
+static const char acName2100_1B[] = "OtherBytes";
+static const char acName2100_1C[] = "OtherCSCycles";
+static const char acName2100_1D[] = "OtherBusyPolls";
+static const char acName2100_1E[] = "OtherTimeUs";
+static const char acName2100_1F[] = "Reset";
+static const char acName2100_20[] = "PollWaits";
+static const char acName2100_21[] = "PollTimeouts";
+static const char acName2100_22[] = "PollTimeUs";
+static const char acName2100_23[] = "WorstPollTimeUs";
+static const char acName2101[] = "Firmware Update";
+static const char acName2101_00[] = "Number of Elements";
+static const char acName2101_01[] = "State";
+static const char acName2101_02[] = "Received";
+static const char acName2101_03[] = "Programmed";
+static const char acName2101_04[] = "PagesErased";
+static const char acName2101_05[] = "Stalls";
+static const char acName2101_06[] = "WorstWriteTime";
+static const char acName2101_07[] = "VerifyTime";
+static const char acName2101_08[] = "CRC";
+static const char acName2101_09[] = "Version";
+static const char acName2101_0A[] = "RunningSlot";
+static const char acName2101_0B[] = "RunningVersion";
+static const char acName2101_0C[] = "Trial";
+static const char acName2101_0D[] = "Rollbacks";
+static const char acName2102[] = "Capture";
+static const char acName2102_00[] = "Number of Elements";
+static const char acName2102_01[] = "Control";
+static const char acName2102_02[] = "Triggers";
+static const char acName2102_03[] = "Threshold";
+static const char acName2102_04[] = "PostTrigger";
+static const char acName2102_05[] = "State";
+static const char acName2102_06[] = "TriggerSource";
+static const char acName2102_07[] = "Samples";
+static const char acName2102_08[] = "Bytes";
+static const char acName2102_09[] = "Duration";
+static const char acName2102_0A[] = "BlocksDropped";
+static const char acName2103[] = "Parameter Store";
+static const char acName2103_00[] = "Number of Elements";
+static const char acName2103_01[] = "State";
+static const char acName2103_02[] = "Records";
+static const char acName2103_03[] = "Compactions";
+static const char acName2103_04[] = "Free";
 static const char acName6000[] = "NunChuck";
 static const char acName6000_00[] = "Number of Elements";
 static const char acName6000_01[] = "JoyStickX";
@@ -54,11 +164,47 @@ static const char acName6000_08[] = "NunChuckDataValid";
 static const char acName7000[] = "Digital outputs";
 static const char acName7000_00[] = "Number of Elements";
 static const char acName7000_01[] = "LED0";
+static const char acName7000_02[] = "CaptureTrigger";
+static const char acName8000[] = "NunChuck Settings";
+static const char acName8000_00[] = "Number of Elements";
+static const char acName8000_01[] = "Measure Interval";
+static const char acName8001[] = "NunChuck Calibration";
+static const char acName8001_00[] = "Number of Elements";
+static const char acName8001_01[] = "Control";
+static const char acName8001_02[] = "State";
+static const char acName8001_03[] = "Source";
+static const char acName8001_04[] = "NunChuck ID";
+static const char acName8001_05[] = "Accelerometer X 0g";
+static const char acName8001_06[] = "Accelerometer Y 0g";
+static const char acName8001_07[] = "Accelerometer Z 0g";
+static const char acName8001_08[] = "Accelerometer X 1g";
+static const char acName8001_09[] = "Accelerometer Y 1g";
+static const char acName8001_0A[] = "Accelerometer Z 1g";
+static const char acName8001_0B[] = "Joystick X Max";
+static const char acName8001_0C[] = "Joystick X Min";
+static const char acName8001_0D[] = "Joystick X Center";
+static const char acName8001_0E[] = "Joystick Y Max";
+static const char acName8001_0F[] = "Joystick Y Min";
+static const char acName8001_10[] = "Joystick Y Center";
+static const char acName8002[] = "NunChuck Tracking";
+static const char acName8002_00[] = "Number of Elements";
+static const char acName8002_01[] = "Enable";
+static const char acName8002_02[] = "Still";
+static const char acName8002_03[] = "Updates";
+static const char acName8002_04[] = "Joystick X Center";
+static const char acName8002_05[] = "Joystick Y Center";
+static const char acName8002_06[] = "Accelerometer X Bias";
+static const char acName8002_07[] = "Accelerometer Y Bias";
+static const char acName8002_08[] = "Accelerometer Z Bias";
 
 const _objd SDO1000[] =
 {
   {0x0, DTYPE_UNSIGNED32, 32, ATYPE_RO, acName1000_0, 0x01901389, NULL},
 };
+const _objd SDO1001[] =
+{
+  {0x0, DTYPE_UNSIGNED8, 8, ATYPE_RO, acName1001_0, 0, &middleSOESErrorRegister},
+};
 const _objd SDO1008[] =
 {
   {0x0, DTYPE_VISIBLE_STRING, 176, ATYPE_RO, acName1008_0, 0, "DieBieSlave - NunChuck"},
@@ -71,7 +217,16 @@ const _objd SDO100A[] =
 {
   {0x0, DTYPE_VISIBLE_STRING, 24, ATYPE_RO, acName100A_0, 0, "0.3"},
 };
-
+const _objd SDO1010[] =
+{
+  {0x00, DTYPE_UNSIGNED8, 8, ATYPE_RO, acName1010_00, 1, NULL},
+  {0x01, DTYPE_UNSIGNED32, 32, ATYPE_RW, acName1010_01, 0, &middleParameterStatus.Save},
+};
+const _objd SDO1011[] =
+{
+  {0x00, DTYPE_UNSIGNED8, 8, ATYPE_RO, acName1011_00, 1, NULL},
+  {0x01, DTYPE_UNSIGNED32, 32, ATYPE_RW, acName1011_01, 0, &middleParameterStatus.Restore},
+};
 const _objd SDO1018[] =
 {
   {0x00, DTYPE_UNSIGNED8, 8, ATYPE_RO, acName1018_00, 4, NULL},
@@ -80,11 +235,37 @@ const _objd SDO1018[] =
   {0x03, DTYPE_UNSIGNED32, 32, ATYPE_RO, acName1018_03, 0, NULL},
   {0x04, DTYPE_UNSIGNED32, 32, ATYPE_RO, acName1018_04, 0x00000000, NULL},
 };
+const _objd SDO10F3[] =
+{
+  {0x00, DTYPE_UNSIGNED8, 8, ATYPE_RO, acName10F3_00, 21, NULL},
+  {0x01, DTYPE_UNSIGNED8, 8, ATYPE_RO, acName10F3_01, 16, NULL},
+  {0x02, DTYPE_UNSIGNED8, 8, ATYPE_RO, acName10F3_02, 0, &middleDiagnosisStatus.NewestMessage},
+  {0x03, DTYPE_UNSIGNED8, 8, ATYPE_RW, acName10F3_03, 0, &middleDiagnosisStatus.NewestAcknowledgedMessage},
+  {0x04, DTYPE_BOOLEAN, 1, ATYPE_RO, acName10F3_04, 0, &middleDiagnosisStatus.NewMessagesAvailable},
+  {0x05, DTYPE_UNSIGNED16, 16, ATYPE_RW, acName10F3_05, 0, &middleDiagnosisStatus.Flags},
+  {0x06, DTYPE_OCTET_STRING, 224, ATYPE_RO, acName10F3_06, 0, &middleDiagnosisMessageBuffer[0]},
+  {0x07, DTYPE_OCTET_STRING, 224, ATYPE_RO, acName10F3_07, 0, &middleDiagnosisMessageBuffer[1]},
+  {0x08, DTYPE_OCTET_STRING, 224, ATYPE_RO, acName10F3_08, 0, &middleDiagnosisMessageBuffer[2]},
+  {0x09, DTYPE_OCTET_STRING, 224, ATYPE_RO, acName10F3_09, 0, &middleDiagnosisMessageBuffer[3]},
+  {0x0A, DTYPE_OCTET_STRING, 224, ATYPE_RO, acName10F3_0A, 0, &middleDiagnosisMessageBuffer[4]},
+  {0x0B, DTYPE_OCTET_STRING, 224, ATYPE_RO, acName10F3_0B, 0, &middleDiagnosisMessageBuffer[5]},
+  {0x0C, DTYPE_OCTET_STRING, 224, ATYPE_RO, acName10F3_0C, 0, &middleDiagnosisMessageBuffer[6]},
+  {0x0D, DTYPE_OCTET_STRING, 224, ATYPE_RO, acName10F3_0D, 0, &middleDiagnosisMessageBuffer[7]},
+  {0x0E, DTYPE_OCTET_STRING, 224, ATYPE_RO, acName10F3_0E, 0, &middleDiagnosisMessageBuffer[8]},
+  {0x0F, DTYPE_OCTET_STRING, 224, ATYPE_RO, acName10F3_0F, 0, &middleDiagnosisMessageBuffer[9]},
+  {0x10, DTYPE_OCTET_STRING, 224, ATYPE_RO, acName10F3_10, 0, &middleDiagnosisMessageBuffer[10]},
+  {0x11, DTYPE_OCTET_STRING, 224, ATYPE_RO, acName10F3_11, 0, &middleDiagnosisMessageBuffer[11]},
+  {0x12, DTYPE_OCTET_STRING, 224, ATYPE_RO, acName10F3_12, 0, &middleDiagnosisMessageBuffer[12]},
+  {0x13, DTYPE_OCTET_STRING, 224, ATYPE_RO, acName10F3_13, 0, &middleDiagnosisMessageBuffer[13]},
+  {0x14, DTYPE_OCTET_STRING, 224, ATYPE_RO, acName10F3_14, 0, &middleDiagnosisMessageBuffer[14]},
+  {0x15, DTYPE_OCTET_STRING, 224, ATYPE_RO, acName10F3_15, 0, &middleDiagnosisMessageBuffer[15]},
+};
 const _objd SDO1600[] =
 {
-  {0x00, DTYPE_UNSIGNED8, 8, ATYPE_RO, acName1600_00, 2, NULL},
+  {0x00, DTYPE_UNSIGNED8, 8, ATYPE_RO, acName1600_00, 3, NULL},
   {0x01, DTYPE_UNSIGNED32, 32, ATYPE_RO, acName1600_01, 0x70000101, NULL},
-  {0x02, DTYPE_UNSIGNED32, 32, ATYPE_RO, acName1600_02, 0x00000007, NULL},
+  {0x02, DTYPE_UNSIGNED32, 32, ATYPE_RO, acName1600_02, 0x70000201, NULL},
+  {0x03, DTYPE_UNSIGNED32, 32, ATYPE_RO, acName1600_03, 0x00000006, NULL},
 };
 const _objd SDO1A00[] =
 {
@@ -117,6 +298,84 @@ const _objd SDO1C13[] =
   {0x00, DTYPE_UNSIGNED8, 8, ATYPE_RO, acName1C13_00, 1, NULL},
   {0x01, DTYPE_UNSIGNED16, 16, ATYPE_RO, acName1C13_01, 0x1A00, NULL},
 };
+const _objd SDO2100[] =
+{
+  {0x00, DTYPE_UNSIGNED8, 8, ATYPE_RO, acName2100_00, 35, NULL},
+  {0x01, DTYPE_UNSIGNED32, 32, ATYPE_RO, acName2100_01, 0, &driverSWLAN9252ClassAccounting[PDI_CLASS_CSR].Transactions},
+  {0x02, DTYPE_UNSIGNED32, 32, ATYPE_RO, acName2100_02, 0, &driverSWLAN9252ClassAccounting[PDI_CLASS_CSR].Bytes},
+  {0x03, DTYPE_UNSIGNED32, 32, ATYPE_RO, acName2100_03, 0, &driverSWLAN9252ClassAccounting[PDI_CLASS_CSR].CSCycles},
+  {0x04, DTYPE_UNSIGNED32, 32, ATYPE_RO, acName2100_04, 0, &driverSWLAN9252ClassAccounting[PDI_CLASS_CSR].BusyPolls},
+  {0x05, DTYPE_UNSIGNED32, 32, ATYPE_RO, acName2100_05, 0, &driverSWLAN9252ClassAccounting[PDI_CLASS_CSR].Time},
+  {0x06, DTYPE_UNSIGNED32, 32, ATYPE_RO, acName2100_06, 0, &driverSWLAN9252ClassAccounting[PDI_CLASS_PRAM].Transactions},
+  {0x07, DTYPE_UNSIGNED32, 32, ATYPE_RO, acName2100_07, 0, &driverSWLAN9252ClassAccounting[PDI_CLASS_PRAM].Bytes},
+  {0x08, DTYPE_UNSIGNED32, 32, ATYPE_RO, acName2100_08, 0, &driverSWLAN9252ClassAccounting[PDI_CLASS_PRAM].CSCycles},
+  {0x09, DTYPE_UNSIGNED32, 32, ATYPE_RO, acName2100_09, 0, &driverSWLAN9252ClassAccounting[PDI_CLASS_PRAM].BusyPolls},
+  {0x0A, DTYPE_UNSIGNED32, 32, ATYPE_RO, acName2100_0A, 0, &driverSWLAN9252ClassAccounting[PDI_CLASS_PRAM].Time},
+  {0x0B, DTYPE_UNSIGNED32, 32, ATYPE_RO, acName2100_0B, 0, &driverSWLAN9252CallerAccounting[PDI_CALLER_STATE].Transactions},
+  {0x0C, DTYPE_UNSIGNED32, 32, ATYPE_RO, acName2100_0C, 0, &driverSWLAN9252CallerAccounting[PDI_CALLER_STATE].Bytes},
+  {0x0D, DTYPE_UNSIGNED32, 32, ATYPE_RO, acName2100_0D, 0, &driverSWLAN9252CallerAccounting[PDI_CALLER_STATE].CSCycles},
+  {0x0E, DTYPE_UNSIGNED32, 32, ATYPE_RO, acName2100_0E, 0, &driverSWLAN9252CallerAccounting[PDI_CALLER_STATE].BusyPolls},
+  {0x0F, DTYPE_UNSIGNED32, 32, ATYPE_RO, acName2100_0F, 0, &driverSWLAN9252CallerAccounting[PDI_CALLER_STATE].Time},
+  {0x10, DTYPE_UNSIGNED32, 32, ATYPE_RO, acName2100_10, 0, &driverSWLAN9252CallerAccounting[PDI_CALLER_MAILBOX].Transactions},
+  {0x11, DTYPE_UNSIGNED32, 32, ATYPE_RO, acName2100_11, 0, &driverSWLAN9252CallerAccounting[PDI_CALLER_MAILBOX].Bytes},
+  {0x12, DTYPE_UNSIGNED32, 32, ATYPE_RO, acName2100_12, 0, &driverSWLAN9252CallerAccounting[PDI_CALLER_MAILBOX].CSCycles},
+  {0x13, DTYPE_UNSIGNED32, 32, ATYPE_RO, acName2100_13, 0, &driverSWLAN9252CallerAccounting[PDI_CALLER_MAILBOX].BusyPolls},
+  {0x14, DTYPE_UNSIGNED32, 32, ATYPE_RO, acName2100_14, 0, &driverSWLAN9252CallerAccounting[PDI_CALLER_MAILBOX].Time},
+  {0x15, DTYPE_UNSIGNED32, 32, ATYPE_RO, acName2100_15, 0, &driverSWLAN9252CallerAccounting[PDI_CALLER_PDO].Transactions},
+  {0x16, DTYPE_UNSIGNED32, 32, ATYPE_RO, acName2100_16, 0, &driverSWLAN9252CallerAccounting[PDI_CALLER_PDO].Bytes},
+  {0x17, DTYPE_UNSIGNED32, 32, ATYPE_RO, acName2100_17, 0, &driverSWLAN9252CallerAccounting[PDI_CALLER_PDO].CSCycles},
+  {0x18, DTYPE_UNSIGNED32, 32, ATYPE_RO, acName2100_18, 0, &driverSWLAN9252CallerAccounting[PDI_CALLER_PDO].BusyPolls},
+  {0x19, DTYPE_UNSIGNED32, 32, ATYPE_RO, acName2100_19, 0, &driverSWLAN9252CallerAccounting[PDI_CALLER_PDO].Time},
+  {0x1A, DTYPE_UNSIGNED32, 32, ATYPE_RO, acName2100_1A, 0, &driverSWLAN9252CallerAccounting[PDI_CALLER_OTHER].Transactions},
+  {0x1B, DTYPE_UNSIGNED32, 32, ATYPE_RO, acName2100_1B, 0, &driverSWLAN9252CallerAccounting[PDI_CALLER_OTHER].Bytes},
+  {0x1C, DTYPE_UNSIGNED32, 32, ATYPE_RO, acName2100_1C, 0, &driverSWLAN9252CallerAccounting[PDI_CALLER_OTHER].CSCycles},
+  {0x1D, DTYPE_UNSIGNED32, 32, ATYPE_RO, acName2100_1D, 0, &driverSWLAN9252CallerAccounting[PDI_CALLER_OTHER].BusyPolls},
+  {0x1E, DTYPE_UNSIGNED32, 32, ATYPE_RO, acName2100_1E, 0, &driverSWLAN9252CallerAccounting[PDI_CALLER_OTHER].Time},
+  {0x1F, DTYPE_UNSIGNED8, 8, ATYPE_RW, acName2100_1F, 0, &middleSOESPDIAccountingReset},
+  {0x20, DTYPE_UNSIGNED32, 32, ATYPE_RO, acName2100_20, 0, &driverSWLAN9252PollStatistics.Polls},
+  {0x21, DTYPE_UNSIGNED32, 32, ATYPE_RO, acName2100_21, 0, &driverSWLAN9252PollStatistics.Timeouts},
+  {0x22, DTYPE_UNSIGNED32, 32, ATYPE_RO, acName2100_22, 0, &driverSWLAN9252PollStatistics.PollTime},
+  {0x23, DTYPE_UNSIGNED32, 32, ATYPE_RO, acName2100_23, 0, &driverSWLAN9252PollStatistics.WorstPollTime},
+};
+const _objd SDO2101[] =
+{
+  {0x00, DTYPE_UNSIGNED8, 8, ATYPE_RO, acName2101_00, 13, NULL},
+  {0x01, DTYPE_UNSIGNED8, 8, ATYPE_RO, acName2101_01, 0, &middleFirmwareUpdateStatus.State},
+  {0x02, DTYPE_UNSIGNED32, 32, ATYPE_RO, acName2101_02, 0, &middleFirmwareUpdateStatus.Received},
+  {0x03, DTYPE_UNSIGNED32, 32, ATYPE_RO, acName2101_03, 0, &middleFirmwareUpdateStatus.Programmed},
+  {0x04, DTYPE_UNSIGNED32, 32, ATYPE_RO, acName2101_04, 0, &middleFirmwareUpdateStatus.PagesErased},
+  {0x05, DTYPE_UNSIGNED32, 32, ATYPE_RO, acName2101_05, 0, &middleFirmwareUpdateStatus.Stalls},
+  {0x06, DTYPE_UNSIGNED32, 32, ATYPE_RO, acName2101_06, 0, &middleFirmwareUpdateStatus.WorstWriteTime},
+  {0x07, DTYPE_UNSIGNED32, 32, ATYPE_RO, acName2101_07, 0, &middleFirmwareUpdateStatus.VerifyTime},
+  {0x08, DTYPE_UNSIGNED32, 32, ATYPE_RO, acName2101_08, 0, &middleFirmwareUpdateStatus.Checksum},
+  {0x09, DTYPE_UNSIGNED32, 32, ATYPE_RO, acName2101_09, 0, &middleFirmwareUpdateStatus.Version},
+  {0x0A, DTYPE_UNSIGNED8, 8, ATYPE_RO, acName2101_0A, 0, &middleFirmwareUpdateStatus.RunningSlot},
+  {0x0B, DTYPE_UNSIGNED32, 32, ATYPE_RO, acName2101_0B, 0, &middleFirmwareUpdateStatus.RunningVersion},
+  {0x0C, DTYPE_UNSIGNED8, 8, ATYPE_RO, acName2101_0C, 0, &middleFirmwareUpdateStatus.Trial},
+  {0x0D, DTYPE_UNSIGNED16, 16, ATYPE_RO, acName2101_0D, 0, &middleFirmwareUpdateStatus.Rollbacks},
+};
+const _objd SDO2102[] =
+{
+  {0x00, DTYPE_UNSIGNED8, 8, ATYPE_RO, acName2102_00, 10, NULL},
+  {0x01, DTYPE_UNSIGNED8, 8, ATYPE_RW, acName2102_01, 0, &middleCaptureStatus.Control},
+  {0x02, DTYPE_UNSIGNED8, 8, ATYPE_RW, acName2102_02, 0, &middleCaptureStatus.Triggers},
+  {0x03, DTYPE_UNSIGNED16, 16, ATYPE_RW, acName2102_03, 0, &middleCaptureStatus.Threshold},
+  {0x04, DTYPE_UNSIGNED32, 32, ATYPE_RW, acName2102_04, 0, &middleCaptureStatus.PostTrigger},
+  {0x05, DTYPE_UNSIGNED8, 8, ATYPE_RO, acName2102_05, 0, &middleCaptureStatus.State},
+  {0x06, DTYPE_UNSIGNED8, 8, ATYPE_RO, acName2102_06, 0, &middleCaptureStatus.TriggerSource},
+  {0x07, DTYPE_UNSIGNED32, 32, ATYPE_RO, acName2102_07, 0, &middleCaptureStatus.Samples},
+  {0x08, DTYPE_UNSIGNED32, 32, ATYPE_RO, acName2102_08, 0, &middleCaptureStatus.Bytes},
+  {0x09, DTYPE_UNSIGNED32, 32, ATYPE_RO, acName2102_09, 0, &middleCaptureStatus.Duration},
+  {0x0A, DTYPE_UNSIGNED32, 32, ATYPE_RO, acName2102_0A, 0, &middleCaptureStatus.BlocksDropped},
+};
+const _objd SDO2103[] =
+{
+  {0x00, DTYPE_UNSIGNED8, 8, ATYPE_RO, acName2103_00, 4, NULL},
+  {0x01, DTYPE_UNSIGNED8, 8, ATYPE_RO, acName2103_01, 0, &middleParameterStatus.State},
+  {0x02, DTYPE_UNSIGNED16, 16, ATYPE_RO, acName2103_02, 0, &middleParameterStatus.Records},
+  {0x03, DTYPE_UNSIGNED16, 16, ATYPE_RO, acName2103_03, 0, &middleParameterStatus.Compactions},
+  {0x04, DTYPE_UNSIGNED16, 16, ATYPE_RO, acName2103_04, 0, &middleParameterStatus.Free},
+};
 const _objd SDO6000[] =
 {
   {0x00, DTYPE_UNSIGNED8, 8, ATYPE_RO, acName6000_00, 8, NULL},
@@ -131,23 +390,1572 @@ const _objd SDO6000[] =
 };
 const _objd SDO7000[] =
 {
-  {0x00, DTYPE_UNSIGNED8, 8, ATYPE_RO, acName7000_00, 1, NULL},
+  {0x00, DTYPE_UNSIGNED8, 8, ATYPE_RO, acName7000_00, 2, NULL},
   {0x01, DTYPE_BOOLEAN, 1, ATYPE_RO, acName7000_01, 0, &middleSOESReadBufferBooleans.LED0},
+  {0x02, DTYPE_BOOLEAN, 1, ATYPE_RO, acName7000_02, 0, &middleSOESReadBufferBooleans.CaptureTrigger},
+};
+const _objd SDO8000[] =
+{
+  {0x00, DTYPE_UNSIGNED8, 8, ATYPE_RO, acName8000_00, 1, NULL},
+  {0x01, DTYPE_UNSIGNED32, 32, ATYPE_RW, acName8000_01, 0, &middleNunChuckSettings.MeasureInterval},
+};
+const _objd SDO8001[] =
+{
+  {0x00, DTYPE_UNSIGNED8, 8, ATYPE_RO, acName8001_00, 16, NULL},
+  {0x01, DTYPE_UNSIGNED8, 8, ATYPE_RW, acName8001_01, 0, &middleCalibrationStatus.Control},
+  {0x02, DTYPE_UNSIGNED8, 8, ATYPE_RO, acName8001_02, 0, &middleCalibrationStatus.State},
+  {0x03, DTYPE_UNSIGNED8, 8, ATYPE_RO, acName8001_03, 0, &middleCalibrationStatus.Source},
+  {0x04, DTYPE_OCTET_STRING, 64, ATYPE_RO, acName8001_04, 0, &middleCalibrationStatus.ID},
+  {0x05, DTYPE_UNSIGNED16, 16, ATYPE_RW, acName8001_05, 0, &middleCalibrationStatus.Values.accelero0GX},
+  {0x06, DTYPE_UNSIGNED16, 16, ATYPE_RW, acName8001_06, 0, &middleCalibrationStatus.Values.accelero0GY},
+  {0x07, DTYPE_UNSIGNED16, 16, ATYPE_RW, acName8001_07, 0, &middleCalibrationStatus.Values.accelero0GZ},
+  {0x08, DTYPE_UNSIGNED16, 16, ATYPE_RW, acName8001_08, 0, &middleCalibrationStatus.Values.accelero1GX},
+  {0x09, DTYPE_UNSIGNED16, 16, ATYPE_RW, acName8001_09, 0, &middleCalibrationStatus.Values.accelero1GY},
+  {0x0A, DTYPE_UNSIGNED16, 16, ATYPE_RW, acName8001_0A, 0, &middleCalibrationStatus.Values.accelero1GZ},
+  {0x0B, DTYPE_UNSIGNED8, 8, ATYPE_RW, acName8001_0B, 0, &middleCalibrationStatus.Values.joystickXMax},
+  {0x0C, DTYPE_UNSIGNED8, 8, ATYPE_RW, acName8001_0C, 0, &middleCalibrationStatus.Values.joystickXMin},
+  {0x0D, DTYPE_UNSIGNED8, 8, ATYPE_RW, acName8001_0D, 0, &middleCalibrationStatus.Values.joystickXCenter},
+  {0x0E, DTYPE_UNSIGNED8, 8, ATYPE_RW, acName8001_0E, 0, &middleCalibrationStatus.Values.joystickYMax},
+  {0x0F, DTYPE_UNSIGNED8, 8, ATYPE_RW, acName8001_0F, 0, &middleCalibrationStatus.Values.joystickYMin},
+  {0x10, DTYPE_UNSIGNED8, 8, ATYPE_RW, acName8001_10, 0, &middleCalibrationStatus.Values.joystickYCenter},
+};
+const _objd SDO8002[] =
+{
+  {0x00, DTYPE_UNSIGNED8, 8, ATYPE_RO, acName8002_00, 8, NULL},
+  {0x01, DTYPE_UNSIGNED8, 8, ATYPE_RW, acName8002_01, 0, &middleCalibrationTracking.Enable},
+  {0x02, DTYPE_UNSIGNED8, 8, ATYPE_RO, acName8002_02, 0, &middleCalibrationTracking.Still},
+  {0x03, DTYPE_UNSIGNED32, 32, ATYPE_RO, acName8002_03, 0, &middleCalibrationTracking.Updates},
+  {0x04, DTYPE_INTEGER8, 8, ATYPE_RO, acName8002_04, 0, &middleCalibrationTracking.JoystickXCenter},
+  {0x05, DTYPE_INTEGER8, 8, ATYPE_RO, acName8002_05, 0, &middleCalibrationTracking.JoystickYCenter},
+  {0x06, DTYPE_INTEGER16, 16, ATYPE_RO, acName8002_06, 0, &middleCalibrationTracking.AcceleroMeterX},
+  {0x07, DTYPE_INTEGER16, 16, ATYPE_RO, acName8002_07, 0, &middleCalibrationTracking.AcceleroMeterY},
+  {0x08, DTYPE_INTEGER16, 16, ATYPE_RO, acName8002_08, 0, &middleCalibrationTracking.AcceleroMeterZ},
 };
 
 const _objectlist SDOobjects[] =
 {
   {0x1000, OTYPE_VAR, 0, 0, acName1000, SDO1000},
+  {0x1001, OTYPE_VAR, 0, 0, acName1001, SDO1001},
   {0x1008, OTYPE_VAR, 0, 0, acName1008, SDO1008},
   {0x1009, OTYPE_VAR, 0, 0, acName1009, SDO1009},
   {0x100A, OTYPE_VAR, 0, 0, acName100A, SDO100A},
+  {0x1010, OTYPE_RECORD, 1, 0, acName1010, SDO1010},
+  {0x1011, OTYPE_RECORD, 1, 0, acName1011, SDO1011},
   {0x1018, OTYPE_RECORD, 4, 0, acName1018, SDO1018},
-  {0x1600, OTYPE_RECORD, 2, 0, acName1600, SDO1600},
+  {0x10F3, OTYPE_RECORD, 21, 0, acName10F3, SDO10F3},
+  {0x1600, OTYPE_RECORD, 3, 0, acName1600, SDO1600},
   {0x1A00, OTYPE_RECORD, 9, 0, acName1A00, SDO1A00},
   {0x1C00, OTYPE_ARRAY, 4, 0, acName1C00, SDO1C00},
   {0x1C12, OTYPE_ARRAY, 1, 0, acName1C12, SDO1C12},
   {0x1C13, OTYPE_ARRAY, 1, 0, acName1C13, SDO1C13},
+  {0x2100, OTYPE_RECORD, 35, 0, acName2100, SDO2100},
+  {0x2101, OTYPE_RECORD, 13, 0, acName2101, SDO2101},
+  {0x2102, OTYPE_RECORD, 10, 0, acName2102, SDO2102},
+  {0x2103, OTYPE_RECORD, 4, 0, acName2103, SDO2103},
   {0x6000, OTYPE_RECORD, 8, 0, acName6000, SDO6000},
-  {0x7000, OTYPE_RECORD, 1, 0, acName7000, SDO7000},
+  {0x7000, OTYPE_RECORD, 2, 0, acName7000, SDO7000},
+  {0x8000, OTYPE_RECORD, 1, 0, acName8000, SDO8000},
+  {0x8001, OTYPE_RECORD, 16, 0, acName8001, SDO8001},
+  {0x8002, OTYPE_RECORD, 8, 0, acName8002, SDO8002},
   {0xffff, 0xff, 0xff, 0xff, NULL, NULL}
 };
+
+const objectlistParameterTypedef objectlistParameters[] =
+{
+  {0x10F305, &middleDiagnosisStatus.Flags, 2},
+  {0x210202, &middleCaptureStatus.Triggers, 1},
+  {0x210203, &middleCaptureStatus.Threshold, 2},
+  {0x210204, &middleCaptureStatus.PostTrigger, 4},
+  {0x800001, &middleNunChuckSettings.MeasureInterval, 4},
+  {0x800201, &middleCalibrationTracking.Enable, 1},
+};
+
+#if MBXSIZE != 128
+#error "The SDO information responses were built for a 128 byte mailbox, regenerate"
+#endif
+
+// Get OD list, number of objects
+static const uint8_t SDOodcountdata[] =
+{
+  0x00, 0x80, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x17, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00,
+};
+// Get OD list, all objects, fragment 0
+static const uint8_t SDOodlist0[] =
+{
+  0x00, 0x80, 0x02, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x10, 0x01, 0x10, 0x08, 0x10, 0x09, 0x10,
+  0x0A, 0x10, 0x10, 0x10, 0x11, 0x10, 0x18, 0x10, 0xF3, 0x10, 0x00, 0x16, 0x00, 0x1A, 0x00, 0x1C,
+  0x12, 0x1C, 0x13, 0x1C, 0x00, 0x21, 0x01, 0x21, 0x02, 0x21, 0x03, 0x21, 0x00, 0x60, 0x00, 0x70,
+  0x00, 0x80, 0x01, 0x80, 0x02, 0x80,
+};
+// Object description 0x1000
+static const uint8_t SDOod1000[] =
+{
+  0x00, 0x80, 0x04, 0x00, 0x00, 0x00, 0x00, 0x10, 0x07, 0x00, 0x00, 0x07, 0x44, 0x65, 0x76, 0x69,
+  0x63, 0x65, 0x20, 0x54, 0x79, 0x70, 0x65,
+};
+// Entry description 0x1000:00
+static const uint8_t SDOed1000_00[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x44, 0x65, 0x76, 0x69, 0x63, 0x65, 0x20, 0x54, 0x79, 0x70, 0x65,
+};
+// Object description 0x1001
+static const uint8_t SDOod1001[] =
+{
+  0x00, 0x80, 0x04, 0x00, 0x00, 0x00, 0x01, 0x10, 0x05, 0x00, 0x00, 0x07, 0x45, 0x72, 0x72, 0x6F,
+  0x72, 0x20, 0x52, 0x65, 0x67, 0x69, 0x73, 0x74, 0x65, 0x72,
+};
+// Entry description 0x1001:00
+static const uint8_t SDOed1001_00[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x01, 0x10, 0x00, 0x07, 0x05, 0x00, 0x08, 0x00, 0x07, 0x00,
+  0x45, 0x72, 0x72, 0x6F, 0x72, 0x20, 0x52, 0x65, 0x67, 0x69, 0x73, 0x74, 0x65, 0x72,
+};
+// Object description 0x1008
+static const uint8_t SDOod1008[] =
+{
+  0x00, 0x80, 0x04, 0x00, 0x00, 0x00, 0x08, 0x10, 0x09, 0x00, 0x00, 0x07, 0x44, 0x65, 0x76, 0x69,
+  0x63, 0x65, 0x20, 0x4E, 0x61, 0x6D, 0x65,
+};
+// Entry description 0x1008:00
+static const uint8_t SDOed1008_00[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x08, 0x10, 0x00, 0x07, 0x09, 0x00, 0xB0, 0x00, 0x07, 0x00,
+  0x44, 0x65, 0x76, 0x69, 0x63, 0x65, 0x20, 0x4E, 0x61, 0x6D, 0x65,
+};
+// Object description 0x1009
+static const uint8_t SDOod1009[] =
+{
+  0x00, 0x80, 0x04, 0x00, 0x00, 0x00, 0x09, 0x10, 0x09, 0x00, 0x00, 0x07, 0x48, 0x61, 0x72, 0x64,
+  0x77, 0x61, 0x72, 0x65, 0x20, 0x56, 0x65, 0x72, 0x73, 0x69, 0x6F, 0x6E,
+};
+// Entry description 0x1009:00
+static const uint8_t SDOed1009_00[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x09, 0x10, 0x00, 0x07, 0x09, 0x00, 0x18, 0x00, 0x07, 0x00,
+  0x48, 0x61, 0x72, 0x64, 0x77, 0x61, 0x72, 0x65, 0x20, 0x56, 0x65, 0x72, 0x73, 0x69, 0x6F, 0x6E,
+};
+// Object description 0x100A
+static const uint8_t SDOod100A[] =
+{
+  0x00, 0x80, 0x04, 0x00, 0x00, 0x00, 0x0A, 0x10, 0x09, 0x00, 0x00, 0x07, 0x53, 0x6F, 0x66, 0x74,
+  0x77, 0x61, 0x72, 0x65, 0x20, 0x56, 0x65, 0x72, 0x73, 0x69, 0x6F, 0x6E,
+};
+// Entry description 0x100A:00
+static const uint8_t SDOed100A_00[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x0A, 0x10, 0x00, 0x07, 0x09, 0x00, 0x18, 0x00, 0x07, 0x00,
+  0x53, 0x6F, 0x66, 0x74, 0x77, 0x61, 0x72, 0x65, 0x20, 0x56, 0x65, 0x72, 0x73, 0x69, 0x6F, 0x6E,
+};
+// Object description 0x1010
+static const uint8_t SDOod1010[] =
+{
+  0x00, 0x80, 0x04, 0x00, 0x00, 0x00, 0x10, 0x10, 0x00, 0x00, 0x01, 0x09, 0x53, 0x74, 0x6F, 0x72,
+  0x65, 0x20, 0x50, 0x61, 0x72, 0x61, 0x6D, 0x65, 0x74, 0x65, 0x72, 0x73,
+};
+// Entry description 0x1010:00
+static const uint8_t SDOed1010_00[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x10, 0x10, 0x00, 0x07, 0x05, 0x00, 0x08, 0x00, 0x07, 0x00,
+  0x4E, 0x75, 0x6D, 0x62, 0x65, 0x72, 0x20, 0x6F, 0x66, 0x20, 0x45, 0x6C, 0x65, 0x6D, 0x65, 0x6E,
+  0x74, 0x73,
+};
+// Entry description 0x1010:01
+static const uint8_t SDOed1010_01[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x10, 0x10, 0x01, 0x07, 0x07, 0x00, 0x20, 0x00, 0x3F, 0x00,
+  0x53, 0x61, 0x76, 0x65, 0x20, 0x41, 0x6C, 0x6C, 0x20, 0x50, 0x61, 0x72, 0x61, 0x6D, 0x65, 0x74,
+  0x65, 0x72, 0x73,
+};
+// Object description 0x1011
+static const uint8_t SDOod1011[] =
+{
+  0x00, 0x80, 0x04, 0x00, 0x00, 0x00, 0x11, 0x10, 0x00, 0x00, 0x01, 0x09, 0x52, 0x65, 0x73, 0x74,
+  0x6F, 0x72, 0x65, 0x20, 0x44, 0x65, 0x66, 0x61, 0x75, 0x6C, 0x74, 0x20, 0x50, 0x61, 0x72, 0x61,
+  0x6D, 0x65, 0x74, 0x65, 0x72, 0x73,
+};
+// Entry description 0x1011:00
+static const uint8_t SDOed1011_00[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x11, 0x10, 0x00, 0x07, 0x05, 0x00, 0x08, 0x00, 0x07, 0x00,
+  0x4E, 0x75, 0x6D, 0x62, 0x65, 0x72, 0x20, 0x6F, 0x66, 0x20, 0x45, 0x6C, 0x65, 0x6D, 0x65, 0x6E,
+  0x74, 0x73,
+};
+// Entry description 0x1011:01
+static const uint8_t SDOed1011_01[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x11, 0x10, 0x01, 0x07, 0x07, 0x00, 0x20, 0x00, 0x3F, 0x00,
+  0x52, 0x65, 0x73, 0x74, 0x6F, 0x72, 0x65, 0x20, 0x41, 0x6C, 0x6C, 0x20, 0x44, 0x65, 0x66, 0x61,
+  0x75, 0x6C, 0x74, 0x20, 0x50, 0x61, 0x72, 0x61, 0x6D, 0x65, 0x74, 0x65, 0x72, 0x73,
+};
+// Object description 0x1018
+static const uint8_t SDOod1018[] =
+{
+  0x00, 0x80, 0x04, 0x00, 0x00, 0x00, 0x18, 0x10, 0x00, 0x00, 0x04, 0x09, 0x49, 0x64, 0x65, 0x6E,
+  0x74, 0x69, 0x74, 0x79, 0x20, 0x4F, 0x62, 0x6A, 0x65, 0x63, 0x74,
+};
+// Entry description 0x1018:00
+static const uint8_t SDOed1018_00[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x18, 0x10, 0x00, 0x07, 0x05, 0x00, 0x08, 0x00, 0x07, 0x00,
+  0x4E, 0x75, 0x6D, 0x62, 0x65, 0x72, 0x20, 0x6F, 0x66, 0x20, 0x45, 0x6C, 0x65, 0x6D, 0x65, 0x6E,
+  0x74, 0x73,
+};
+// Entry description 0x1018:01
+static const uint8_t SDOed1018_01[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x18, 0x10, 0x01, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x56, 0x65, 0x6E, 0x64, 0x6F, 0x72, 0x20, 0x49, 0x44,
+};
+// Entry description 0x1018:02
+static const uint8_t SDOed1018_02[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x18, 0x10, 0x02, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x50, 0x72, 0x6F, 0x64, 0x75, 0x63, 0x74, 0x20, 0x43, 0x6F, 0x64, 0x65,
+};
+// Entry description 0x1018:03
+static const uint8_t SDOed1018_03[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x18, 0x10, 0x03, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x52, 0x65, 0x76, 0x69, 0x73, 0x69, 0x6F, 0x6E, 0x20, 0x4E, 0x75, 0x6D, 0x62, 0x65, 0x72,
+};
+// Entry description 0x1018:04
+static const uint8_t SDOed1018_04[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x18, 0x10, 0x04, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x53, 0x65, 0x72, 0x69, 0x61, 0x6C, 0x20, 0x4E, 0x75, 0x6D, 0x62, 0x65, 0x72,
+};
+// Object description 0x10F3
+static const uint8_t SDOod10F3[] =
+{
+  0x00, 0x80, 0x04, 0x00, 0x00, 0x00, 0xF3, 0x10, 0x00, 0x00, 0x15, 0x09, 0x44, 0x69, 0x61, 0x67,
+  0x6E, 0x6F, 0x73, 0x69, 0x73, 0x20, 0x48, 0x69, 0x73, 0x74, 0x6F, 0x72, 0x79,
+};
+// Entry description 0x10F3:00
+static const uint8_t SDOed10F3_00[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0xF3, 0x10, 0x00, 0x07, 0x05, 0x00, 0x08, 0x00, 0x07, 0x00,
+  0x4E, 0x75, 0x6D, 0x62, 0x65, 0x72, 0x20, 0x6F, 0x66, 0x20, 0x45, 0x6C, 0x65, 0x6D, 0x65, 0x6E,
+  0x74, 0x73,
+};
+// Entry description 0x10F3:01
+static const uint8_t SDOed10F3_01[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0xF3, 0x10, 0x01, 0x07, 0x05, 0x00, 0x08, 0x00, 0x07, 0x00,
+  0x4D, 0x61, 0x78, 0x69, 0x6D, 0x75, 0x6D, 0x20, 0x4D, 0x65, 0x73, 0x73, 0x61, 0x67, 0x65, 0x73,
+};
+// Entry description 0x10F3:02
+static const uint8_t SDOed10F3_02[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0xF3, 0x10, 0x02, 0x07, 0x05, 0x00, 0x08, 0x00, 0x07, 0x00,
+  0x4E, 0x65, 0x77, 0x65, 0x73, 0x74, 0x20, 0x4D, 0x65, 0x73, 0x73, 0x61, 0x67, 0x65,
+};
+// Entry description 0x10F3:03
+static const uint8_t SDOed10F3_03[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0xF3, 0x10, 0x03, 0x07, 0x05, 0x00, 0x08, 0x00, 0x3F, 0x00,
+  0x4E, 0x65, 0x77, 0x65, 0x73, 0x74, 0x20, 0x41, 0x63, 0x6B, 0x6E, 0x6F, 0x77, 0x6C, 0x65, 0x64,
+  0x67, 0x65, 0x64, 0x20, 0x4D, 0x65, 0x73, 0x73, 0x61, 0x67, 0x65,
+};
+// Entry description 0x10F3:04
+static const uint8_t SDOed10F3_04[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0xF3, 0x10, 0x04, 0x07, 0x01, 0x00, 0x01, 0x00, 0x07, 0x00,
+  0x4E, 0x65, 0x77, 0x20, 0x4D, 0x65, 0x73, 0x73, 0x61, 0x67, 0x65, 0x73, 0x20, 0x41, 0x76, 0x61,
+  0x69, 0x6C, 0x61, 0x62, 0x6C, 0x65,
+};
+// Entry description 0x10F3:05
+static const uint8_t SDOed10F3_05[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0xF3, 0x10, 0x05, 0x07, 0x06, 0x00, 0x10, 0x00, 0x3F, 0x00,
+  0x46, 0x6C, 0x61, 0x67, 0x73,
+};
+// Entry description 0x10F3:06
+static const uint8_t SDOed10F3_06[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0xF3, 0x10, 0x06, 0x07, 0x0A, 0x00, 0xE0, 0x00, 0x07, 0x00,
+  0x44, 0x69, 0x61, 0x67, 0x6E, 0x6F, 0x73, 0x69, 0x73, 0x20, 0x4D, 0x65, 0x73, 0x73, 0x61, 0x67,
+  0x65, 0x20, 0x30, 0x30, 0x31,
+};
+// Entry description 0x10F3:07
+static const uint8_t SDOed10F3_07[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0xF3, 0x10, 0x07, 0x07, 0x0A, 0x00, 0xE0, 0x00, 0x07, 0x00,
+  0x44, 0x69, 0x61, 0x67, 0x6E, 0x6F, 0x73, 0x69, 0x73, 0x20, 0x4D, 0x65, 0x73, 0x73, 0x61, 0x67,
+  0x65, 0x20, 0x30, 0x30, 0x32,
+};
+// Entry description 0x10F3:08
+static const uint8_t SDOed10F3_08[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0xF3, 0x10, 0x08, 0x07, 0x0A, 0x00, 0xE0, 0x00, 0x07, 0x00,
+  0x44, 0x69, 0x61, 0x67, 0x6E, 0x6F, 0x73, 0x69, 0x73, 0x20, 0x4D, 0x65, 0x73, 0x73, 0x61, 0x67,
+  0x65, 0x20, 0x30, 0x30, 0x33,
+};
+// Entry description 0x10F3:09
+static const uint8_t SDOed10F3_09[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0xF3, 0x10, 0x09, 0x07, 0x0A, 0x00, 0xE0, 0x00, 0x07, 0x00,
+  0x44, 0x69, 0x61, 0x67, 0x6E, 0x6F, 0x73, 0x69, 0x73, 0x20, 0x4D, 0x65, 0x73, 0x73, 0x61, 0x67,
+  0x65, 0x20, 0x30, 0x30, 0x34,
+};
+// Entry description 0x10F3:0A
+static const uint8_t SDOed10F3_0A[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0xF3, 0x10, 0x0A, 0x07, 0x0A, 0x00, 0xE0, 0x00, 0x07, 0x00,
+  0x44, 0x69, 0x61, 0x67, 0x6E, 0x6F, 0x73, 0x69, 0x73, 0x20, 0x4D, 0x65, 0x73, 0x73, 0x61, 0x67,
+  0x65, 0x20, 0x30, 0x30, 0x35,
+};
+// Entry description 0x10F3:0B
+static const uint8_t SDOed10F3_0B[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0xF3, 0x10, 0x0B, 0x07, 0x0A, 0x00, 0xE0, 0x00, 0x07, 0x00,
+  0x44, 0x69, 0x61, 0x67, 0x6E, 0x6F, 0x73, 0x69, 0x73, 0x20, 0x4D, 0x65, 0x73, 0x73, 0x61, 0x67,
+  0x65, 0x20, 0x30, 0x30, 0x36,
+};
+// Entry description 0x10F3:0C
+static const uint8_t SDOed10F3_0C[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0xF3, 0x10, 0x0C, 0x07, 0x0A, 0x00, 0xE0, 0x00, 0x07, 0x00,
+  0x44, 0x69, 0x61, 0x67, 0x6E, 0x6F, 0x73, 0x69, 0x73, 0x20, 0x4D, 0x65, 0x73, 0x73, 0x61, 0x67,
+  0x65, 0x20, 0x30, 0x30, 0x37,
+};
+// Entry description 0x10F3:0D
+static const uint8_t SDOed10F3_0D[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0xF3, 0x10, 0x0D, 0x07, 0x0A, 0x00, 0xE0, 0x00, 0x07, 0x00,
+  0x44, 0x69, 0x61, 0x67, 0x6E, 0x6F, 0x73, 0x69, 0x73, 0x20, 0x4D, 0x65, 0x73, 0x73, 0x61, 0x67,
+  0x65, 0x20, 0x30, 0x30, 0x38,
+};
+// Entry description 0x10F3:0E
+static const uint8_t SDOed10F3_0E[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0xF3, 0x10, 0x0E, 0x07, 0x0A, 0x00, 0xE0, 0x00, 0x07, 0x00,
+  0x44, 0x69, 0x61, 0x67, 0x6E, 0x6F, 0x73, 0x69, 0x73, 0x20, 0x4D, 0x65, 0x73, 0x73, 0x61, 0x67,
+  0x65, 0x20, 0x30, 0x30, 0x39,
+};
+// Entry description 0x10F3:0F
+static const uint8_t SDOed10F3_0F[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0xF3, 0x10, 0x0F, 0x07, 0x0A, 0x00, 0xE0, 0x00, 0x07, 0x00,
+  0x44, 0x69, 0x61, 0x67, 0x6E, 0x6F, 0x73, 0x69, 0x73, 0x20, 0x4D, 0x65, 0x73, 0x73, 0x61, 0x67,
+  0x65, 0x20, 0x30, 0x31, 0x30,
+};
+// Entry description 0x10F3:10
+static const uint8_t SDOed10F3_10[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0xF3, 0x10, 0x10, 0x07, 0x0A, 0x00, 0xE0, 0x00, 0x07, 0x00,
+  0x44, 0x69, 0x61, 0x67, 0x6E, 0x6F, 0x73, 0x69, 0x73, 0x20, 0x4D, 0x65, 0x73, 0x73, 0x61, 0x67,
+  0x65, 0x20, 0x30, 0x31, 0x31,
+};
+// Entry description 0x10F3:11
+static const uint8_t SDOed10F3_11[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0xF3, 0x10, 0x11, 0x07, 0x0A, 0x00, 0xE0, 0x00, 0x07, 0x00,
+  0x44, 0x69, 0x61, 0x67, 0x6E, 0x6F, 0x73, 0x69, 0x73, 0x20, 0x4D, 0x65, 0x73, 0x73, 0x61, 0x67,
+  0x65, 0x20, 0x30, 0x31, 0x32,
+};
+// Entry description 0x10F3:12
+static const uint8_t SDOed10F3_12[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0xF3, 0x10, 0x12, 0x07, 0x0A, 0x00, 0xE0, 0x00, 0x07, 0x00,
+  0x44, 0x69, 0x61, 0x67, 0x6E, 0x6F, 0x73, 0x69, 0x73, 0x20, 0x4D, 0x65, 0x73, 0x73, 0x61, 0x67,
+  0x65, 0x20, 0x30, 0x31, 0x33,
+};
+// Entry description 0x10F3:13
+static const uint8_t SDOed10F3_13[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0xF3, 0x10, 0x13, 0x07, 0x0A, 0x00, 0xE0, 0x00, 0x07, 0x00,
+  0x44, 0x69, 0x61, 0x67, 0x6E, 0x6F, 0x73, 0x69, 0x73, 0x20, 0x4D, 0x65, 0x73, 0x73, 0x61, 0x67,
+  0x65, 0x20, 0x30, 0x31, 0x34,
+};
+// Entry description 0x10F3:14
+static const uint8_t SDOed10F3_14[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0xF3, 0x10, 0x14, 0x07, 0x0A, 0x00, 0xE0, 0x00, 0x07, 0x00,
+  0x44, 0x69, 0x61, 0x67, 0x6E, 0x6F, 0x73, 0x69, 0x73, 0x20, 0x4D, 0x65, 0x73, 0x73, 0x61, 0x67,
+  0x65, 0x20, 0x30, 0x31, 0x35,
+};
+// Entry description 0x10F3:15
+static const uint8_t SDOed10F3_15[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0xF3, 0x10, 0x15, 0x07, 0x0A, 0x00, 0xE0, 0x00, 0x07, 0x00,
+  0x44, 0x69, 0x61, 0x67, 0x6E, 0x6F, 0x73, 0x69, 0x73, 0x20, 0x4D, 0x65, 0x73, 0x73, 0x61, 0x67,
+  0x65, 0x20, 0x30, 0x31, 0x36,
+};
+// Object description 0x1600
+static const uint8_t SDOod1600[] =
+{
+  0x00, 0x80, 0x04, 0x00, 0x00, 0x00, 0x00, 0x16, 0x00, 0x00, 0x03, 0x09, 0x44, 0x69, 0x67, 0x69,
+  0x74, 0x61, 0x6C, 0x20, 0x6F, 0x75, 0x74, 0x70, 0x75, 0x74, 0x73,
+};
+// Entry description 0x1600:00
+static const uint8_t SDOed1600_00[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x16, 0x00, 0x07, 0x05, 0x00, 0x08, 0x00, 0x07, 0x00,
+  0x4E, 0x75, 0x6D, 0x62, 0x65, 0x72, 0x20, 0x6F, 0x66, 0x20, 0x45, 0x6C, 0x65, 0x6D, 0x65, 0x6E,
+  0x74, 0x73,
+};
+// Entry description 0x1600:01
+static const uint8_t SDOed1600_01[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x16, 0x01, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x4C, 0x45, 0x44, 0x30,
+};
+// Entry description 0x1600:02
+static const uint8_t SDOed1600_02[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x16, 0x02, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x43, 0x61, 0x70, 0x74, 0x75, 0x72, 0x65, 0x54, 0x72, 0x69, 0x67, 0x67, 0x65, 0x72,
+};
+// Entry description 0x1600:03
+static const uint8_t SDOed1600_03[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x16, 0x03, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x50, 0x61, 0x64, 0x64, 0x69, 0x6E, 0x67,
+};
+// Object description 0x1A00
+static const uint8_t SDOod1A00[] =
+{
+  0x00, 0x80, 0x04, 0x00, 0x00, 0x00, 0x00, 0x1A, 0x00, 0x00, 0x09, 0x09, 0x4E, 0x75, 0x6E, 0x43,
+  0x68, 0x75, 0x63, 0x6B,
+};
+// Entry description 0x1A00:00
+static const uint8_t SDOed1A00_00[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x1A, 0x00, 0x07, 0x05, 0x00, 0x08, 0x00, 0x07, 0x00,
+  0x4E, 0x75, 0x6D, 0x62, 0x65, 0x72, 0x20, 0x6F, 0x66, 0x20, 0x45, 0x6C, 0x65, 0x6D, 0x65, 0x6E,
+  0x74, 0x73,
+};
+// Entry description 0x1A00:01
+static const uint8_t SDOed1A00_01[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x1A, 0x01, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x4A, 0x6F, 0x79, 0x53, 0x74, 0x69, 0x63, 0x6B, 0x58,
+};
+// Entry description 0x1A00:02
+static const uint8_t SDOed1A00_02[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x1A, 0x02, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x4A, 0x6F, 0x79, 0x53, 0x74, 0x69, 0x63, 0x6B, 0x59,
+};
+// Entry description 0x1A00:03
+static const uint8_t SDOed1A00_03[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x1A, 0x03, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x41, 0x63, 0x63, 0x65, 0x6C, 0x65, 0x72, 0x6F, 0x4D, 0x65, 0x74, 0x65, 0x72, 0x58,
+};
+// Entry description 0x1A00:04
+static const uint8_t SDOed1A00_04[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x1A, 0x04, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x41, 0x63, 0x63, 0x65, 0x6C, 0x65, 0x72, 0x6F, 0x4D, 0x65, 0x74, 0x65, 0x72, 0x59,
+};
+// Entry description 0x1A00:05
+static const uint8_t SDOed1A00_05[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x1A, 0x05, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x41, 0x63, 0x63, 0x65, 0x6C, 0x65, 0x72, 0x6F, 0x4D, 0x65, 0x74, 0x65, 0x72, 0x5A,
+};
+// Entry description 0x1A00:06
+static const uint8_t SDOed1A00_06[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x1A, 0x06, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x42, 0x75, 0x74, 0x74, 0x6F, 0x6E, 0x43,
+};
+// Entry description 0x1A00:07
+static const uint8_t SDOed1A00_07[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x1A, 0x07, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x42, 0x75, 0x74, 0x74, 0x6F, 0x6E, 0x5A,
+};
+// Entry description 0x1A00:08
+static const uint8_t SDOed1A00_08[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x1A, 0x08, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x4E, 0x75, 0x6E, 0x43, 0x68, 0x75, 0x63, 0x6B, 0x44, 0x61, 0x74, 0x61, 0x56, 0x61, 0x6C, 0x69,
+  0x64,
+};
+// Entry description 0x1A00:09
+static const uint8_t SDOed1A00_09[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x1A, 0x09, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x50, 0x61, 0x64, 0x64, 0x69, 0x6E, 0x67,
+};
+// Object description 0x1C00
+static const uint8_t SDOod1C00[] =
+{
+  0x00, 0x80, 0x04, 0x00, 0x00, 0x00, 0x00, 0x1C, 0x00, 0x00, 0x04, 0x08, 0x53, 0x79, 0x6E, 0x63,
+  0x20, 0x4D, 0x61, 0x6E, 0x61, 0x67, 0x65, 0x72, 0x20, 0x43, 0x6F, 0x6D, 0x6D, 0x75, 0x6E, 0x69,
+  0x63, 0x61, 0x74, 0x69, 0x6F, 0x6E, 0x20, 0x54, 0x79, 0x70, 0x65,
+};
+// Entry description 0x1C00:00
+static const uint8_t SDOed1C00_00[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x1C, 0x00, 0x07, 0x05, 0x00, 0x08, 0x00, 0x07, 0x00,
+  0x4E, 0x75, 0x6D, 0x62, 0x65, 0x72, 0x20, 0x6F, 0x66, 0x20, 0x45, 0x6C, 0x65, 0x6D, 0x65, 0x6E,
+  0x74, 0x73,
+};
+// Entry description 0x1C00:01
+static const uint8_t SDOed1C00_01[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x1C, 0x01, 0x07, 0x05, 0x00, 0x08, 0x00, 0x07, 0x00,
+  0x43, 0x6F, 0x6D, 0x6D, 0x75, 0x6E, 0x69, 0x63, 0x61, 0x74, 0x69, 0x6F, 0x6E, 0x73, 0x20, 0x54,
+  0x79, 0x70, 0x65, 0x20, 0x53, 0x4D, 0x30,
+};
+// Entry description 0x1C00:02
+static const uint8_t SDOed1C00_02[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x1C, 0x02, 0x07, 0x05, 0x00, 0x08, 0x00, 0x07, 0x00,
+  0x43, 0x6F, 0x6D, 0x6D, 0x75, 0x6E, 0x69, 0x63, 0x61, 0x74, 0x69, 0x6F, 0x6E, 0x73, 0x20, 0x54,
+  0x79, 0x70, 0x65, 0x20, 0x53, 0x4D, 0x31,
+};
+// Entry description 0x1C00:03
+static const uint8_t SDOed1C00_03[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x1C, 0x03, 0x07, 0x05, 0x00, 0x08, 0x00, 0x07, 0x00,
+  0x43, 0x6F, 0x6D, 0x6D, 0x75, 0x6E, 0x69, 0x63, 0x61, 0x74, 0x69, 0x6F, 0x6E, 0x73, 0x20, 0x54,
+  0x79, 0x70, 0x65, 0x20, 0x53, 0x4D, 0x32,
+};
+// Entry description 0x1C00:04
+static const uint8_t SDOed1C00_04[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x1C, 0x04, 0x07, 0x05, 0x00, 0x08, 0x00, 0x07, 0x00,
+  0x43, 0x6F, 0x6D, 0x6D, 0x75, 0x6E, 0x69, 0x63, 0x61, 0x74, 0x69, 0x6F, 0x6E, 0x73, 0x20, 0x54,
+  0x79, 0x70, 0x65, 0x20, 0x53, 0x4D, 0x33,
+};
+// Object description 0x1C12
+static const uint8_t SDOod1C12[] =
+{
+  0x00, 0x80, 0x04, 0x00, 0x00, 0x00, 0x12, 0x1C, 0x00, 0x00, 0x01, 0x08, 0x53, 0x79, 0x6E, 0x63,
+  0x20, 0x4D, 0x61, 0x6E, 0x61, 0x67, 0x65, 0x72, 0x20, 0x32, 0x20, 0x50, 0x44, 0x4F, 0x20, 0x41,
+  0x73, 0x73, 0x69, 0x67, 0x6E, 0x6D, 0x65, 0x6E, 0x74,
+};
+// Entry description 0x1C12:00
+static const uint8_t SDOed1C12_00[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x12, 0x1C, 0x00, 0x07, 0x05, 0x00, 0x08, 0x00, 0x07, 0x00,
+  0x4E, 0x75, 0x6D, 0x62, 0x65, 0x72, 0x20, 0x6F, 0x66, 0x20, 0x45, 0x6C, 0x65, 0x6D, 0x65, 0x6E,
+  0x74, 0x73,
+};
+// Entry description 0x1C12:01
+static const uint8_t SDOed1C12_01[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x12, 0x1C, 0x01, 0x07, 0x06, 0x00, 0x10, 0x00, 0x07, 0x00,
+  0x50, 0x44, 0x4F, 0x20, 0x4D, 0x61, 0x70, 0x70, 0x69, 0x6E, 0x67,
+};
+// Object description 0x1C13
+static const uint8_t SDOod1C13[] =
+{
+  0x00, 0x80, 0x04, 0x00, 0x00, 0x00, 0x13, 0x1C, 0x00, 0x00, 0x01, 0x08, 0x53, 0x79, 0x6E, 0x63,
+  0x20, 0x4D, 0x61, 0x6E, 0x61, 0x67, 0x65, 0x72, 0x20, 0x33, 0x20, 0x50, 0x44, 0x4F, 0x20, 0x41,
+  0x73, 0x73, 0x69, 0x67, 0x6E, 0x6D, 0x65, 0x6E, 0x74,
+};
+// Entry description 0x1C13:00
+static const uint8_t SDOed1C13_00[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x13, 0x1C, 0x00, 0x07, 0x05, 0x00, 0x08, 0x00, 0x07, 0x00,
+  0x4E, 0x75, 0x6D, 0x62, 0x65, 0x72, 0x20, 0x6F, 0x66, 0x20, 0x45, 0x6C, 0x65, 0x6D, 0x65, 0x6E,
+  0x74, 0x73,
+};
+// Entry description 0x1C13:01
+static const uint8_t SDOed1C13_01[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x13, 0x1C, 0x01, 0x07, 0x06, 0x00, 0x10, 0x00, 0x07, 0x00,
+  0x50, 0x44, 0x4F, 0x20, 0x4D, 0x61, 0x70, 0x70, 0x69, 0x6E, 0x67,
+};
+// Object description 0x2100
+static const uint8_t SDOod2100[] =
+{
+  0x00, 0x80, 0x04, 0x00, 0x00, 0x00, 0x00, 0x21, 0x00, 0x00, 0x23, 0x09, 0x50, 0x44, 0x49, 0x20,
+  0x41, 0x63, 0x63, 0x6F, 0x75, 0x6E, 0x74, 0x69, 0x6E, 0x67,
+};
+// Entry description 0x2100:00
+static const uint8_t SDOed2100_00[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x21, 0x00, 0x07, 0x05, 0x00, 0x08, 0x00, 0x07, 0x00,
+  0x4E, 0x75, 0x6D, 0x62, 0x65, 0x72, 0x20, 0x6F, 0x66, 0x20, 0x45, 0x6C, 0x65, 0x6D, 0x65, 0x6E,
+  0x74, 0x73,
+};
+// Entry description 0x2100:01
+static const uint8_t SDOed2100_01[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x21, 0x01, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x43, 0x53, 0x52, 0x54, 0x72, 0x61, 0x6E, 0x73, 0x61, 0x63, 0x74, 0x69, 0x6F, 0x6E, 0x73,
+};
+// Entry description 0x2100:02
+static const uint8_t SDOed2100_02[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x21, 0x02, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x43, 0x53, 0x52, 0x42, 0x79, 0x74, 0x65, 0x73,
+};
+// Entry description 0x2100:03
+static const uint8_t SDOed2100_03[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x21, 0x03, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x43, 0x53, 0x52, 0x43, 0x53, 0x43, 0x79, 0x63, 0x6C, 0x65, 0x73,
+};
+// Entry description 0x2100:04
+static const uint8_t SDOed2100_04[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x21, 0x04, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x43, 0x53, 0x52, 0x42, 0x75, 0x73, 0x79, 0x50, 0x6F, 0x6C, 0x6C, 0x73,
+};
+// Entry description 0x2100:05
+static const uint8_t SDOed2100_05[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x21, 0x05, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x43, 0x53, 0x52, 0x54, 0x69, 0x6D, 0x65, 0x55, 0x73,
+};
+// Entry description 0x2100:06
+static const uint8_t SDOed2100_06[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x21, 0x06, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x50, 0x52, 0x41, 0x4D, 0x54, 0x72, 0x61, 0x6E, 0x73, 0x61, 0x63, 0x74, 0x69, 0x6F, 0x6E, 0x73,
+};
+// Entry description 0x2100:07
+static const uint8_t SDOed2100_07[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x21, 0x07, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x50, 0x52, 0x41, 0x4D, 0x42, 0x79, 0x74, 0x65, 0x73,
+};
+// Entry description 0x2100:08
+static const uint8_t SDOed2100_08[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x21, 0x08, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x50, 0x52, 0x41, 0x4D, 0x43, 0x53, 0x43, 0x79, 0x63, 0x6C, 0x65, 0x73,
+};
+// Entry description 0x2100:09
+static const uint8_t SDOed2100_09[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x21, 0x09, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x50, 0x52, 0x41, 0x4D, 0x42, 0x75, 0x73, 0x79, 0x50, 0x6F, 0x6C, 0x6C, 0x73,
+};
+// Entry description 0x2100:0A
+static const uint8_t SDOed2100_0A[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x21, 0x0A, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x50, 0x52, 0x41, 0x4D, 0x54, 0x69, 0x6D, 0x65, 0x55, 0x73,
+};
+// Entry description 0x2100:0B
+static const uint8_t SDOed2100_0B[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x21, 0x0B, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x53, 0x74, 0x61, 0x74, 0x65, 0x54, 0x72, 0x61, 0x6E, 0x73, 0x61, 0x63, 0x74, 0x69, 0x6F, 0x6E,
+  0x73,
+};
+// Entry description 0x2100:0C
+static const uint8_t SDOed2100_0C[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x21, 0x0C, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x53, 0x74, 0x61, 0x74, 0x65, 0x42, 0x79, 0x74, 0x65, 0x73,
+};
+// Entry description 0x2100:0D
+static const uint8_t SDOed2100_0D[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x21, 0x0D, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x53, 0x74, 0x61, 0x74, 0x65, 0x43, 0x53, 0x43, 0x79, 0x63, 0x6C, 0x65, 0x73,
+};
+// Entry description 0x2100:0E
+static const uint8_t SDOed2100_0E[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x21, 0x0E, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x53, 0x74, 0x61, 0x74, 0x65, 0x42, 0x75, 0x73, 0x79, 0x50, 0x6F, 0x6C, 0x6C, 0x73,
+};
+// Entry description 0x2100:0F
+static const uint8_t SDOed2100_0F[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x21, 0x0F, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x53, 0x74, 0x61, 0x74, 0x65, 0x54, 0x69, 0x6D, 0x65, 0x55, 0x73,
+};
+// Entry description 0x2100:10
+static const uint8_t SDOed2100_10[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x21, 0x10, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x4D, 0x61, 0x69, 0x6C, 0x62, 0x6F, 0x78, 0x54, 0x72, 0x61, 0x6E, 0x73, 0x61, 0x63, 0x74, 0x69,
+  0x6F, 0x6E, 0x73,
+};
+// Entry description 0x2100:11
+static const uint8_t SDOed2100_11[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x21, 0x11, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x4D, 0x61, 0x69, 0x6C, 0x62, 0x6F, 0x78, 0x42, 0x79, 0x74, 0x65, 0x73,
+};
+// Entry description 0x2100:12
+static const uint8_t SDOed2100_12[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x21, 0x12, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x4D, 0x61, 0x69, 0x6C, 0x62, 0x6F, 0x78, 0x43, 0x53, 0x43, 0x79, 0x63, 0x6C, 0x65, 0x73,
+};
+// Entry description 0x2100:13
+static const uint8_t SDOed2100_13[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x21, 0x13, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x4D, 0x61, 0x69, 0x6C, 0x62, 0x6F, 0x78, 0x42, 0x75, 0x73, 0x79, 0x50, 0x6F, 0x6C, 0x6C, 0x73,
+};
+// Entry description 0x2100:14
+static const uint8_t SDOed2100_14[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x21, 0x14, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x4D, 0x61, 0x69, 0x6C, 0x62, 0x6F, 0x78, 0x54, 0x69, 0x6D, 0x65, 0x55, 0x73,
+};
+// Entry description 0x2100:15
+static const uint8_t SDOed2100_15[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x21, 0x15, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x50, 0x44, 0x4F, 0x54, 0x72, 0x61, 0x6E, 0x73, 0x61, 0x63, 0x74, 0x69, 0x6F, 0x6E, 0x73,
+};
+// Entry description 0x2100:16
+static const uint8_t SDOed2100_16[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x21, 0x16, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x50, 0x44, 0x4F, 0x42, 0x79, 0x74, 0x65, 0x73,
+};
+// Entry description 0x2100:17
+static const uint8_t SDOed2100_17[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x21, 0x17, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x50, 0x44, 0x4F, 0x43, 0x53, 0x43, 0x79, 0x63, 0x6C, 0x65, 0x73,
+};
+// Entry description 0x2100:18
+static const uint8_t SDOed2100_18[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x21, 0x18, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x50, 0x44, 0x4F, 0x42, 0x75, 0x73, 0x79, 0x50, 0x6F, 0x6C, 0x6C, 0x73,
+};
+// Entry description 0x2100:19
+static const uint8_t SDOed2100_19[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x21, 0x19, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x50, 0x44, 0x4F, 0x54, 0x69, 0x6D, 0x65, 0x55, 0x73,
+};
+// Entry description 0x2100:1A
+static const uint8_t SDOed2100_1A[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x21, 0x1A, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x4F, 0x74, 0x68, 0x65, 0x72, 0x54, 0x72, 0x61, 0x6E, 0x73, 0x61, 0x63, 0x74, 0x69, 0x6F, 0x6E,
+  0x73,
+};
+// Entry description 0x2100:1B
+static const uint8_t SDOed2100_1B[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x21, 0x1B, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x4F, 0x74, 0x68, 0x65, 0x72, 0x42, 0x79, 0x74, 0x65, 0x73,
+};
+// Entry description 0x2100:1C
+static const uint8_t SDOed2100_1C[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x21, 0x1C, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x4F, 0x74, 0x68, 0x65, 0x72, 0x43, 0x53, 0x43, 0x79, 0x63, 0x6C, 0x65, 0x73,
+};
+// Entry description 0x2100:1D
+static const uint8_t SDOed2100_1D[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x21, 0x1D, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x4F, 0x74, 0x68, 0x65, 0x72, 0x42, 0x75, 0x73, 0x79, 0x50, 0x6F, 0x6C, 0x6C, 0x73,
+};
+// Entry description 0x2100:1E
+static const uint8_t SDOed2100_1E[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x21, 0x1E, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x4F, 0x74, 0x68, 0x65, 0x72, 0x54, 0x69, 0x6D, 0x65, 0x55, 0x73,
+};
+// Entry description 0x2100:1F
+static const uint8_t SDOed2100_1F[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x21, 0x1F, 0x07, 0x05, 0x00, 0x08, 0x00, 0x3F, 0x00,
+  0x52, 0x65, 0x73, 0x65, 0x74,
+};
+// Entry description 0x2100:20
+static const uint8_t SDOed2100_20[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x21, 0x20, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x50, 0x6F, 0x6C, 0x6C, 0x57, 0x61, 0x69, 0x74, 0x73,
+};
+// Entry description 0x2100:21
+static const uint8_t SDOed2100_21[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x21, 0x21, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x50, 0x6F, 0x6C, 0x6C, 0x54, 0x69, 0x6D, 0x65, 0x6F, 0x75, 0x74, 0x73,
+};
+// Entry description 0x2100:22
+static const uint8_t SDOed2100_22[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x21, 0x22, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x50, 0x6F, 0x6C, 0x6C, 0x54, 0x69, 0x6D, 0x65, 0x55, 0x73,
+};
+// Entry description 0x2100:23
+static const uint8_t SDOed2100_23[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x21, 0x23, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x57, 0x6F, 0x72, 0x73, 0x74, 0x50, 0x6F, 0x6C, 0x6C, 0x54, 0x69, 0x6D, 0x65, 0x55, 0x73,
+};
+// Object description 0x2101
+static const uint8_t SDOod2101[] =
+{
+  0x00, 0x80, 0x04, 0x00, 0x00, 0x00, 0x01, 0x21, 0x00, 0x00, 0x0D, 0x09, 0x46, 0x69, 0x72, 0x6D,
+  0x77, 0x61, 0x72, 0x65, 0x20, 0x55, 0x70, 0x64, 0x61, 0x74, 0x65,
+};
+// Entry description 0x2101:00
+static const uint8_t SDOed2101_00[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x01, 0x21, 0x00, 0x07, 0x05, 0x00, 0x08, 0x00, 0x07, 0x00,
+  0x4E, 0x75, 0x6D, 0x62, 0x65, 0x72, 0x20, 0x6F, 0x66, 0x20, 0x45, 0x6C, 0x65, 0x6D, 0x65, 0x6E,
+  0x74, 0x73,
+};
+// Entry description 0x2101:01
+static const uint8_t SDOed2101_01[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x01, 0x21, 0x01, 0x07, 0x05, 0x00, 0x08, 0x00, 0x07, 0x00,
+  0x53, 0x74, 0x61, 0x74, 0x65,
+};
+// Entry description 0x2101:02
+static const uint8_t SDOed2101_02[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x01, 0x21, 0x02, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x52, 0x65, 0x63, 0x65, 0x69, 0x76, 0x65, 0x64,
+};
+// Entry description 0x2101:03
+static const uint8_t SDOed2101_03[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x01, 0x21, 0x03, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x50, 0x72, 0x6F, 0x67, 0x72, 0x61, 0x6D, 0x6D, 0x65, 0x64,
+};
+// Entry description 0x2101:04
+static const uint8_t SDOed2101_04[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x01, 0x21, 0x04, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x50, 0x61, 0x67, 0x65, 0x73, 0x45, 0x72, 0x61, 0x73, 0x65, 0x64,
+};
+// Entry description 0x2101:05
+static const uint8_t SDOed2101_05[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x01, 0x21, 0x05, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x53, 0x74, 0x61, 0x6C, 0x6C, 0x73,
+};
+// Entry description 0x2101:06
+static const uint8_t SDOed2101_06[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x01, 0x21, 0x06, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x57, 0x6F, 0x72, 0x73, 0x74, 0x57, 0x72, 0x69, 0x74, 0x65, 0x54, 0x69, 0x6D, 0x65,
+};
+// Entry description 0x2101:07
+static const uint8_t SDOed2101_07[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x01, 0x21, 0x07, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x56, 0x65, 0x72, 0x69, 0x66, 0x79, 0x54, 0x69, 0x6D, 0x65,
+};
+// Entry description 0x2101:08
+static const uint8_t SDOed2101_08[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x01, 0x21, 0x08, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x43, 0x52, 0x43,
+};
+// Entry description 0x2101:09
+static const uint8_t SDOed2101_09[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x01, 0x21, 0x09, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x56, 0x65, 0x72, 0x73, 0x69, 0x6F, 0x6E,
+};
+// Entry description 0x2101:0A
+static const uint8_t SDOed2101_0A[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x01, 0x21, 0x0A, 0x07, 0x05, 0x00, 0x08, 0x00, 0x07, 0x00,
+  0x52, 0x75, 0x6E, 0x6E, 0x69, 0x6E, 0x67, 0x53, 0x6C, 0x6F, 0x74,
+};
+// Entry description 0x2101:0B
+static const uint8_t SDOed2101_0B[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x01, 0x21, 0x0B, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x52, 0x75, 0x6E, 0x6E, 0x69, 0x6E, 0x67, 0x56, 0x65, 0x72, 0x73, 0x69, 0x6F, 0x6E,
+};
+// Entry description 0x2101:0C
+static const uint8_t SDOed2101_0C[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x01, 0x21, 0x0C, 0x07, 0x05, 0x00, 0x08, 0x00, 0x07, 0x00,
+  0x54, 0x72, 0x69, 0x61, 0x6C,
+};
+// Entry description 0x2101:0D
+static const uint8_t SDOed2101_0D[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x01, 0x21, 0x0D, 0x07, 0x06, 0x00, 0x10, 0x00, 0x07, 0x00,
+  0x52, 0x6F, 0x6C, 0x6C, 0x62, 0x61, 0x63, 0x6B, 0x73,
+};
+// Object description 0x2102
+static const uint8_t SDOod2102[] =
+{
+  0x00, 0x80, 0x04, 0x00, 0x00, 0x00, 0x02, 0x21, 0x00, 0x00, 0x0A, 0x09, 0x43, 0x61, 0x70, 0x74,
+  0x75, 0x72, 0x65,
+};
+// Entry description 0x2102:00
+static const uint8_t SDOed2102_00[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x02, 0x21, 0x00, 0x07, 0x05, 0x00, 0x08, 0x00, 0x07, 0x00,
+  0x4E, 0x75, 0x6D, 0x62, 0x65, 0x72, 0x20, 0x6F, 0x66, 0x20, 0x45, 0x6C, 0x65, 0x6D, 0x65, 0x6E,
+  0x74, 0x73,
+};
+// Entry description 0x2102:01
+static const uint8_t SDOed2102_01[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x02, 0x21, 0x01, 0x07, 0x05, 0x00, 0x08, 0x00, 0x3F, 0x00,
+  0x43, 0x6F, 0x6E, 0x74, 0x72, 0x6F, 0x6C,
+};
+// Entry description 0x2102:02
+static const uint8_t SDOed2102_02[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x02, 0x21, 0x02, 0x07, 0x05, 0x00, 0x08, 0x00, 0x3F, 0x00,
+  0x54, 0x72, 0x69, 0x67, 0x67, 0x65, 0x72, 0x73,
+};
+// Entry description 0x2102:03
+static const uint8_t SDOed2102_03[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x02, 0x21, 0x03, 0x07, 0x06, 0x00, 0x10, 0x00, 0x3F, 0x00,
+  0x54, 0x68, 0x72, 0x65, 0x73, 0x68, 0x6F, 0x6C, 0x64,
+};
+// Entry description 0x2102:04
+static const uint8_t SDOed2102_04[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x02, 0x21, 0x04, 0x07, 0x07, 0x00, 0x20, 0x00, 0x3F, 0x00,
+  0x50, 0x6F, 0x73, 0x74, 0x54, 0x72, 0x69, 0x67, 0x67, 0x65, 0x72,
+};
+// Entry description 0x2102:05
+static const uint8_t SDOed2102_05[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x02, 0x21, 0x05, 0x07, 0x05, 0x00, 0x08, 0x00, 0x07, 0x00,
+  0x53, 0x74, 0x61, 0x74, 0x65,
+};
+// Entry description 0x2102:06
+static const uint8_t SDOed2102_06[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x02, 0x21, 0x06, 0x07, 0x05, 0x00, 0x08, 0x00, 0x07, 0x00,
+  0x54, 0x72, 0x69, 0x67, 0x67, 0x65, 0x72, 0x53, 0x6F, 0x75, 0x72, 0x63, 0x65,
+};
+// Entry description 0x2102:07
+static const uint8_t SDOed2102_07[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x02, 0x21, 0x07, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x53, 0x61, 0x6D, 0x70, 0x6C, 0x65, 0x73,
+};
+// Entry description 0x2102:08
+static const uint8_t SDOed2102_08[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x02, 0x21, 0x08, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x42, 0x79, 0x74, 0x65, 0x73,
+};
+// Entry description 0x2102:09
+static const uint8_t SDOed2102_09[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x02, 0x21, 0x09, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x44, 0x75, 0x72, 0x61, 0x74, 0x69, 0x6F, 0x6E,
+};
+// Entry description 0x2102:0A
+static const uint8_t SDOed2102_0A[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x02, 0x21, 0x0A, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x42, 0x6C, 0x6F, 0x63, 0x6B, 0x73, 0x44, 0x72, 0x6F, 0x70, 0x70, 0x65, 0x64,
+};
+// Object description 0x2103
+static const uint8_t SDOod2103[] =
+{
+  0x00, 0x80, 0x04, 0x00, 0x00, 0x00, 0x03, 0x21, 0x00, 0x00, 0x04, 0x09, 0x50, 0x61, 0x72, 0x61,
+  0x6D, 0x65, 0x74, 0x65, 0x72, 0x20, 0x53, 0x74, 0x6F, 0x72, 0x65,
+};
+// Entry description 0x2103:00
+static const uint8_t SDOed2103_00[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x03, 0x21, 0x00, 0x07, 0x05, 0x00, 0x08, 0x00, 0x07, 0x00,
+  0x4E, 0x75, 0x6D, 0x62, 0x65, 0x72, 0x20, 0x6F, 0x66, 0x20, 0x45, 0x6C, 0x65, 0x6D, 0x65, 0x6E,
+  0x74, 0x73,
+};
+// Entry description 0x2103:01
+static const uint8_t SDOed2103_01[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x03, 0x21, 0x01, 0x07, 0x05, 0x00, 0x08, 0x00, 0x07, 0x00,
+  0x53, 0x74, 0x61, 0x74, 0x65,
+};
+// Entry description 0x2103:02
+static const uint8_t SDOed2103_02[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x03, 0x21, 0x02, 0x07, 0x06, 0x00, 0x10, 0x00, 0x07, 0x00,
+  0x52, 0x65, 0x63, 0x6F, 0x72, 0x64, 0x73,
+};
+// Entry description 0x2103:03
+static const uint8_t SDOed2103_03[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x03, 0x21, 0x03, 0x07, 0x06, 0x00, 0x10, 0x00, 0x07, 0x00,
+  0x43, 0x6F, 0x6D, 0x70, 0x61, 0x63, 0x74, 0x69, 0x6F, 0x6E, 0x73,
+};
+// Entry description 0x2103:04
+static const uint8_t SDOed2103_04[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x03, 0x21, 0x04, 0x07, 0x06, 0x00, 0x10, 0x00, 0x07, 0x00,
+  0x46, 0x72, 0x65, 0x65,
+};
+// Object description 0x6000
+static const uint8_t SDOod6000[] =
+{
+  0x00, 0x80, 0x04, 0x00, 0x00, 0x00, 0x00, 0x60, 0x00, 0x00, 0x08, 0x09, 0x4E, 0x75, 0x6E, 0x43,
+  0x68, 0x75, 0x63, 0x6B,
+};
+// Entry description 0x6000:00
+static const uint8_t SDOed6000_00[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x60, 0x00, 0x07, 0x05, 0x00, 0x08, 0x00, 0x07, 0x00,
+  0x4E, 0x75, 0x6D, 0x62, 0x65, 0x72, 0x20, 0x6F, 0x66, 0x20, 0x45, 0x6C, 0x65, 0x6D, 0x65, 0x6E,
+  0x74, 0x73,
+};
+// Entry description 0x6000:01
+static const uint8_t SDOed6000_01[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x60, 0x01, 0x07, 0x02, 0x00, 0x08, 0x00, 0x07, 0x00,
+  0x4A, 0x6F, 0x79, 0x53, 0x74, 0x69, 0x63, 0x6B, 0x58,
+};
+// Entry description 0x6000:02
+static const uint8_t SDOed6000_02[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x60, 0x02, 0x07, 0x02, 0x00, 0x08, 0x00, 0x07, 0x00,
+  0x4A, 0x6F, 0x79, 0x53, 0x74, 0x69, 0x63, 0x6B, 0x59,
+};
+// Entry description 0x6000:03
+static const uint8_t SDOed6000_03[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x60, 0x03, 0x07, 0x03, 0x00, 0x10, 0x00, 0x07, 0x00,
+  0x41, 0x63, 0x63, 0x65, 0x6C, 0x65, 0x72, 0x6F, 0x4D, 0x65, 0x74, 0x65, 0x72, 0x58,
+};
+// Entry description 0x6000:04
+static const uint8_t SDOed6000_04[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x60, 0x04, 0x07, 0x03, 0x00, 0x10, 0x00, 0x07, 0x00,
+  0x41, 0x63, 0x63, 0x65, 0x6C, 0x65, 0x72, 0x6F, 0x4D, 0x65, 0x74, 0x65, 0x72, 0x59,
+};
+// Entry description 0x6000:05
+static const uint8_t SDOed6000_05[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x60, 0x05, 0x07, 0x03, 0x00, 0x10, 0x00, 0x07, 0x00,
+  0x41, 0x63, 0x63, 0x65, 0x6C, 0x65, 0x72, 0x6F, 0x4D, 0x65, 0x74, 0x65, 0x72, 0x5A,
+};
+// Entry description 0x6000:06
+static const uint8_t SDOed6000_06[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x60, 0x06, 0x07, 0x01, 0x00, 0x01, 0x00, 0x07, 0x00,
+  0x42, 0x75, 0x74, 0x74, 0x6F, 0x6E, 0x43,
+};
+// Entry description 0x6000:07
+static const uint8_t SDOed6000_07[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x60, 0x07, 0x07, 0x01, 0x00, 0x01, 0x00, 0x07, 0x00,
+  0x42, 0x75, 0x74, 0x74, 0x6F, 0x6E, 0x5A,
+};
+// Entry description 0x6000:08
+static const uint8_t SDOed6000_08[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x60, 0x08, 0x07, 0x01, 0x00, 0x01, 0x00, 0x07, 0x00,
+  0x4E, 0x75, 0x6E, 0x43, 0x68, 0x75, 0x63, 0x6B, 0x44, 0x61, 0x74, 0x61, 0x56, 0x61, 0x6C, 0x69,
+  0x64,
+};
+// Object description 0x7000
+static const uint8_t SDOod7000[] =
+{
+  0x00, 0x80, 0x04, 0x00, 0x00, 0x00, 0x00, 0x70, 0x00, 0x00, 0x02, 0x09, 0x44, 0x69, 0x67, 0x69,
+  0x74, 0x61, 0x6C, 0x20, 0x6F, 0x75, 0x74, 0x70, 0x75, 0x74, 0x73,
+};
+// Entry description 0x7000:00
+static const uint8_t SDOed7000_00[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x70, 0x00, 0x07, 0x05, 0x00, 0x08, 0x00, 0x07, 0x00,
+  0x4E, 0x75, 0x6D, 0x62, 0x65, 0x72, 0x20, 0x6F, 0x66, 0x20, 0x45, 0x6C, 0x65, 0x6D, 0x65, 0x6E,
+  0x74, 0x73,
+};
+// Entry description 0x7000:01
+static const uint8_t SDOed7000_01[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x70, 0x01, 0x07, 0x01, 0x00, 0x01, 0x00, 0x07, 0x00,
+  0x4C, 0x45, 0x44, 0x30,
+};
+// Entry description 0x7000:02
+static const uint8_t SDOed7000_02[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x70, 0x02, 0x07, 0x01, 0x00, 0x01, 0x00, 0x07, 0x00,
+  0x43, 0x61, 0x70, 0x74, 0x75, 0x72, 0x65, 0x54, 0x72, 0x69, 0x67, 0x67, 0x65, 0x72,
+};
+// Object description 0x8000
+static const uint8_t SDOod8000[] =
+{
+  0x00, 0x80, 0x04, 0x00, 0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x01, 0x09, 0x4E, 0x75, 0x6E, 0x43,
+  0x68, 0x75, 0x63, 0x6B, 0x20, 0x53, 0x65, 0x74, 0x74, 0x69, 0x6E, 0x67, 0x73,
+};
+// Entry description 0x8000:00
+static const uint8_t SDOed8000_00[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x80, 0x00, 0x07, 0x05, 0x00, 0x08, 0x00, 0x07, 0x00,
+  0x4E, 0x75, 0x6D, 0x62, 0x65, 0x72, 0x20, 0x6F, 0x66, 0x20, 0x45, 0x6C, 0x65, 0x6D, 0x65, 0x6E,
+  0x74, 0x73,
+};
+// Entry description 0x8000:01
+static const uint8_t SDOed8000_01[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x80, 0x01, 0x07, 0x07, 0x00, 0x20, 0x00, 0x3F, 0x00,
+  0x4D, 0x65, 0x61, 0x73, 0x75, 0x72, 0x65, 0x20, 0x49, 0x6E, 0x74, 0x65, 0x72, 0x76, 0x61, 0x6C,
+};
+// Object description 0x8001
+static const uint8_t SDOod8001[] =
+{
+  0x00, 0x80, 0x04, 0x00, 0x00, 0x00, 0x01, 0x80, 0x00, 0x00, 0x10, 0x09, 0x4E, 0x75, 0x6E, 0x43,
+  0x68, 0x75, 0x63, 0x6B, 0x20, 0x43, 0x61, 0x6C, 0x69, 0x62, 0x72, 0x61, 0x74, 0x69, 0x6F, 0x6E,
+};
+// Entry description 0x8001:00
+static const uint8_t SDOed8001_00[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x01, 0x80, 0x00, 0x07, 0x05, 0x00, 0x08, 0x00, 0x07, 0x00,
+  0x4E, 0x75, 0x6D, 0x62, 0x65, 0x72, 0x20, 0x6F, 0x66, 0x20, 0x45, 0x6C, 0x65, 0x6D, 0x65, 0x6E,
+  0x74, 0x73,
+};
+// Entry description 0x8001:01
+static const uint8_t SDOed8001_01[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x01, 0x80, 0x01, 0x07, 0x05, 0x00, 0x08, 0x00, 0x3F, 0x00,
+  0x43, 0x6F, 0x6E, 0x74, 0x72, 0x6F, 0x6C,
+};
+// Entry description 0x8001:02
+static const uint8_t SDOed8001_02[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x01, 0x80, 0x02, 0x07, 0x05, 0x00, 0x08, 0x00, 0x07, 0x00,
+  0x53, 0x74, 0x61, 0x74, 0x65,
+};
+// Entry description 0x8001:03
+static const uint8_t SDOed8001_03[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x01, 0x80, 0x03, 0x07, 0x05, 0x00, 0x08, 0x00, 0x07, 0x00,
+  0x53, 0x6F, 0x75, 0x72, 0x63, 0x65,
+};
+// Entry description 0x8001:04
+static const uint8_t SDOed8001_04[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x01, 0x80, 0x04, 0x07, 0x0A, 0x00, 0x40, 0x00, 0x07, 0x00,
+  0x4E, 0x75, 0x6E, 0x43, 0x68, 0x75, 0x63, 0x6B, 0x20, 0x49, 0x44,
+};
+// Entry description 0x8001:05
+static const uint8_t SDOed8001_05[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x01, 0x80, 0x05, 0x07, 0x06, 0x00, 0x10, 0x00, 0x3F, 0x00,
+  0x41, 0x63, 0x63, 0x65, 0x6C, 0x65, 0x72, 0x6F, 0x6D, 0x65, 0x74, 0x65, 0x72, 0x20, 0x58, 0x20,
+  0x30, 0x67,
+};
+// Entry description 0x8001:06
+static const uint8_t SDOed8001_06[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x01, 0x80, 0x06, 0x07, 0x06, 0x00, 0x10, 0x00, 0x3F, 0x00,
+  0x41, 0x63, 0x63, 0x65, 0x6C, 0x65, 0x72, 0x6F, 0x6D, 0x65, 0x74, 0x65, 0x72, 0x20, 0x59, 0x20,
+  0x30, 0x67,
+};
+// Entry description 0x8001:07
+static const uint8_t SDOed8001_07[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x01, 0x80, 0x07, 0x07, 0x06, 0x00, 0x10, 0x00, 0x3F, 0x00,
+  0x41, 0x63, 0x63, 0x65, 0x6C, 0x65, 0x72, 0x6F, 0x6D, 0x65, 0x74, 0x65, 0x72, 0x20, 0x5A, 0x20,
+  0x30, 0x67,
+};
+// Entry description 0x8001:08
+static const uint8_t SDOed8001_08[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x01, 0x80, 0x08, 0x07, 0x06, 0x00, 0x10, 0x00, 0x3F, 0x00,
+  0x41, 0x63, 0x63, 0x65, 0x6C, 0x65, 0x72, 0x6F, 0x6D, 0x65, 0x74, 0x65, 0x72, 0x20, 0x58, 0x20,
+  0x31, 0x67,
+};
+// Entry description 0x8001:09
+static const uint8_t SDOed8001_09[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x01, 0x80, 0x09, 0x07, 0x06, 0x00, 0x10, 0x00, 0x3F, 0x00,
+  0x41, 0x63, 0x63, 0x65, 0x6C, 0x65, 0x72, 0x6F, 0x6D, 0x65, 0x74, 0x65, 0x72, 0x20, 0x59, 0x20,
+  0x31, 0x67,
+};
+// Entry description 0x8001:0A
+static const uint8_t SDOed8001_0A[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x01, 0x80, 0x0A, 0x07, 0x06, 0x00, 0x10, 0x00, 0x3F, 0x00,
+  0x41, 0x63, 0x63, 0x65, 0x6C, 0x65, 0x72, 0x6F, 0x6D, 0x65, 0x74, 0x65, 0x72, 0x20, 0x5A, 0x20,
+  0x31, 0x67,
+};
+// Entry description 0x8001:0B
+static const uint8_t SDOed8001_0B[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x01, 0x80, 0x0B, 0x07, 0x05, 0x00, 0x08, 0x00, 0x3F, 0x00,
+  0x4A, 0x6F, 0x79, 0x73, 0x74, 0x69, 0x63, 0x6B, 0x20, 0x58, 0x20, 0x4D, 0x61, 0x78,
+};
+// Entry description 0x8001:0C
+static const uint8_t SDOed8001_0C[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x01, 0x80, 0x0C, 0x07, 0x05, 0x00, 0x08, 0x00, 0x3F, 0x00,
+  0x4A, 0x6F, 0x79, 0x73, 0x74, 0x69, 0x63, 0x6B, 0x20, 0x58, 0x20, 0x4D, 0x69, 0x6E,
+};
+// Entry description 0x8001:0D
+static const uint8_t SDOed8001_0D[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x01, 0x80, 0x0D, 0x07, 0x05, 0x00, 0x08, 0x00, 0x3F, 0x00,
+  0x4A, 0x6F, 0x79, 0x73, 0x74, 0x69, 0x63, 0x6B, 0x20, 0x58, 0x20, 0x43, 0x65, 0x6E, 0x74, 0x65,
+  0x72,
+};
+// Entry description 0x8001:0E
+static const uint8_t SDOed8001_0E[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x01, 0x80, 0x0E, 0x07, 0x05, 0x00, 0x08, 0x00, 0x3F, 0x00,
+  0x4A, 0x6F, 0x79, 0x73, 0x74, 0x69, 0x63, 0x6B, 0x20, 0x59, 0x20, 0x4D, 0x61, 0x78,
+};
+// Entry description 0x8001:0F
+static const uint8_t SDOed8001_0F[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x01, 0x80, 0x0F, 0x07, 0x05, 0x00, 0x08, 0x00, 0x3F, 0x00,
+  0x4A, 0x6F, 0x79, 0x73, 0x74, 0x69, 0x63, 0x6B, 0x20, 0x59, 0x20, 0x4D, 0x69, 0x6E,
+};
+// Entry description 0x8001:10
+static const uint8_t SDOed8001_10[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x01, 0x80, 0x10, 0x07, 0x05, 0x00, 0x08, 0x00, 0x3F, 0x00,
+  0x4A, 0x6F, 0x79, 0x73, 0x74, 0x69, 0x63, 0x6B, 0x20, 0x59, 0x20, 0x43, 0x65, 0x6E, 0x74, 0x65,
+  0x72,
+};
+// Object description 0x8002
+static const uint8_t SDOod8002[] =
+{
+  0x00, 0x80, 0x04, 0x00, 0x00, 0x00, 0x02, 0x80, 0x00, 0x00, 0x08, 0x09, 0x4E, 0x75, 0x6E, 0x43,
+  0x68, 0x75, 0x63, 0x6B, 0x20, 0x54, 0x72, 0x61, 0x63, 0x6B, 0x69, 0x6E, 0x67,
+};
+// Entry description 0x8002:00
+static const uint8_t SDOed8002_00[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x02, 0x80, 0x00, 0x07, 0x05, 0x00, 0x08, 0x00, 0x07, 0x00,
+  0x4E, 0x75, 0x6D, 0x62, 0x65, 0x72, 0x20, 0x6F, 0x66, 0x20, 0x45, 0x6C, 0x65, 0x6D, 0x65, 0x6E,
+  0x74, 0x73,
+};
+// Entry description 0x8002:01
+static const uint8_t SDOed8002_01[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x02, 0x80, 0x01, 0x07, 0x05, 0x00, 0x08, 0x00, 0x3F, 0x00,
+  0x45, 0x6E, 0x61, 0x62, 0x6C, 0x65,
+};
+// Entry description 0x8002:02
+static const uint8_t SDOed8002_02[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x02, 0x80, 0x02, 0x07, 0x05, 0x00, 0x08, 0x00, 0x07, 0x00,
+  0x53, 0x74, 0x69, 0x6C, 0x6C,
+};
+// Entry description 0x8002:03
+static const uint8_t SDOed8002_03[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x02, 0x80, 0x03, 0x07, 0x07, 0x00, 0x20, 0x00, 0x07, 0x00,
+  0x55, 0x70, 0x64, 0x61, 0x74, 0x65, 0x73,
+};
+// Entry description 0x8002:04
+static const uint8_t SDOed8002_04[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x02, 0x80, 0x04, 0x07, 0x02, 0x00, 0x08, 0x00, 0x07, 0x00,
+  0x4A, 0x6F, 0x79, 0x73, 0x74, 0x69, 0x63, 0x6B, 0x20, 0x58, 0x20, 0x43, 0x65, 0x6E, 0x74, 0x65,
+  0x72,
+};
+// Entry description 0x8002:05
+static const uint8_t SDOed8002_05[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x02, 0x80, 0x05, 0x07, 0x02, 0x00, 0x08, 0x00, 0x07, 0x00,
+  0x4A, 0x6F, 0x79, 0x73, 0x74, 0x69, 0x63, 0x6B, 0x20, 0x59, 0x20, 0x43, 0x65, 0x6E, 0x74, 0x65,
+  0x72,
+};
+// Entry description 0x8002:06
+static const uint8_t SDOed8002_06[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x02, 0x80, 0x06, 0x07, 0x03, 0x00, 0x10, 0x00, 0x07, 0x00,
+  0x41, 0x63, 0x63, 0x65, 0x6C, 0x65, 0x72, 0x6F, 0x6D, 0x65, 0x74, 0x65, 0x72, 0x20, 0x58, 0x20,
+  0x42, 0x69, 0x61, 0x73,
+};
+// Entry description 0x8002:07
+static const uint8_t SDOed8002_07[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x02, 0x80, 0x07, 0x07, 0x03, 0x00, 0x10, 0x00, 0x07, 0x00,
+  0x41, 0x63, 0x63, 0x65, 0x6C, 0x65, 0x72, 0x6F, 0x6D, 0x65, 0x74, 0x65, 0x72, 0x20, 0x59, 0x20,
+  0x42, 0x69, 0x61, 0x73,
+};
+// Entry description 0x8002:08
+static const uint8_t SDOed8002_08[] =
+{
+  0x00, 0x80, 0x06, 0x00, 0x00, 0x00, 0x02, 0x80, 0x08, 0x07, 0x03, 0x00, 0x10, 0x00, 0x07, 0x00,
+  0x41, 0x63, 0x63, 0x65, 0x6C, 0x65, 0x72, 0x6F, 0x6D, 0x65, 0x74, 0x65, 0x72, 0x20, 0x5A, 0x20,
+  0x42, 0x69, 0x61, 0x73,
+};
+
+const _COEinfo SDOodcount = {sizeof(SDOodcountdata), SDOodcountdata};
+const uint16_t SDOodlistfrags = 1;
+const _COEinfo SDOodlist[] =
+{
+  {sizeof(SDOodlist0), SDOodlist0},
+};
+static const _COEinfo SDOed1000[] =
+{
+  {sizeof(SDOed1000_00), SDOed1000_00},
+};
+static const _COEinfo SDOed1001[] =
+{
+  {sizeof(SDOed1001_00), SDOed1001_00},
+};
+static const _COEinfo SDOed1008[] =
+{
+  {sizeof(SDOed1008_00), SDOed1008_00},
+};
+static const _COEinfo SDOed1009[] =
+{
+  {sizeof(SDOed1009_00), SDOed1009_00},
+};
+static const _COEinfo SDOed100A[] =
+{
+  {sizeof(SDOed100A_00), SDOed100A_00},
+};
+static const _COEinfo SDOed1010[] =
+{
+  {sizeof(SDOed1010_00), SDOed1010_00},
+  {sizeof(SDOed1010_01), SDOed1010_01},
+};
+static const _COEinfo SDOed1011[] =
+{
+  {sizeof(SDOed1011_00), SDOed1011_00},
+  {sizeof(SDOed1011_01), SDOed1011_01},
+};
+static const _COEinfo SDOed1018[] =
+{
+  {sizeof(SDOed1018_00), SDOed1018_00},
+  {sizeof(SDOed1018_01), SDOed1018_01},
+  {sizeof(SDOed1018_02), SDOed1018_02},
+  {sizeof(SDOed1018_03), SDOed1018_03},
+  {sizeof(SDOed1018_04), SDOed1018_04},
+};
+static const _COEinfo SDOed10F3[] =
+{
+  {sizeof(SDOed10F3_00), SDOed10F3_00},
+  {sizeof(SDOed10F3_01), SDOed10F3_01},
+  {sizeof(SDOed10F3_02), SDOed10F3_02},
+  {sizeof(SDOed10F3_03), SDOed10F3_03},
+  {sizeof(SDOed10F3_04), SDOed10F3_04},
+  {sizeof(SDOed10F3_05), SDOed10F3_05},
+  {sizeof(SDOed10F3_06), SDOed10F3_06},
+  {sizeof(SDOed10F3_07), SDOed10F3_07},
+  {sizeof(SDOed10F3_08), SDOed10F3_08},
+  {sizeof(SDOed10F3_09), SDOed10F3_09},
+  {sizeof(SDOed10F3_0A), SDOed10F3_0A},
+  {sizeof(SDOed10F3_0B), SDOed10F3_0B},
+  {sizeof(SDOed10F3_0C), SDOed10F3_0C},
+  {sizeof(SDOed10F3_0D), SDOed10F3_0D},
+  {sizeof(SDOed10F3_0E), SDOed10F3_0E},
+  {sizeof(SDOed10F3_0F), SDOed10F3_0F},
+  {sizeof(SDOed10F3_10), SDOed10F3_10},
+  {sizeof(SDOed10F3_11), SDOed10F3_11},
+  {sizeof(SDOed10F3_12), SDOed10F3_12},
+  {sizeof(SDOed10F3_13), SDOed10F3_13},
+  {sizeof(SDOed10F3_14), SDOed10F3_14},
+  {sizeof(SDOed10F3_15), SDOed10F3_15},
+};
+static const _COEinfo SDOed1600[] =
+{
+  {sizeof(SDOed1600_00), SDOed1600_00},
+  {sizeof(SDOed1600_01), SDOed1600_01},
+  {sizeof(SDOed1600_02), SDOed1600_02},
+  {sizeof(SDOed1600_03), SDOed1600_03},
+};
+static const _COEinfo SDOed1A00[] =
+{
+  {sizeof(SDOed1A00_00), SDOed1A00_00},
+  {sizeof(SDOed1A00_01), SDOed1A00_01},
+  {sizeof(SDOed1A00_02), SDOed1A00_02},
+  {sizeof(SDOed1A00_03), SDOed1A00_03},
+  {sizeof(SDOed1A00_04), SDOed1A00_04},
+  {sizeof(SDOed1A00_05), SDOed1A00_05},
+  {sizeof(SDOed1A00_06), SDOed1A00_06},
+  {sizeof(SDOed1A00_07), SDOed1A00_07},
+  {sizeof(SDOed1A00_08), SDOed1A00_08},
+  {sizeof(SDOed1A00_09), SDOed1A00_09},
+};
+static const _COEinfo SDOed1C00[] =
+{
+  {sizeof(SDOed1C00_00), SDOed1C00_00},
+  {sizeof(SDOed1C00_01), SDOed1C00_01},
+  {sizeof(SDOed1C00_02), SDOed1C00_02},
+  {sizeof(SDOed1C00_03), SDOed1C00_03},
+  {sizeof(SDOed1C00_04), SDOed1C00_04},
+};
+static const _COEinfo SDOed1C12[] =
+{
+  {sizeof(SDOed1C12_00), SDOed1C12_00},
+  {sizeof(SDOed1C12_01), SDOed1C12_01},
+};
+static const _COEinfo SDOed1C13[] =
+{
+  {sizeof(SDOed1C13_00), SDOed1C13_00},
+  {sizeof(SDOed1C13_01), SDOed1C13_01},
+};
+static const _COEinfo SDOed2100[] =
+{
+  {sizeof(SDOed2100_00), SDOed2100_00},
+  {sizeof(SDOed2100_01), SDOed2100_01},
+  {sizeof(SDOed2100_02), SDOed2100_02},
+  {sizeof(SDOed2100_03), SDOed2100_03},
+  {sizeof(SDOed2100_04), SDOed2100_04},
+  {sizeof(SDOed2100_05), SDOed2100_05},
+  {sizeof(SDOed2100_06), SDOed2100_06},
+  {sizeof(SDOed2100_07), SDOed2100_07},
+  {sizeof(SDOed2100_08), SDOed2100_08},
+  {sizeof(SDOed2100_09), SDOed2100_09},
+  {sizeof(SDOed2100_0A), SDOed2100_0A},
+  {sizeof(SDOed2100_0B), SDOed2100_0B},
+  {sizeof(SDOed2100_0C), SDOed2100_0C},
+  {sizeof(SDOed2100_0D), SDOed2100_0D},
+  {sizeof(SDOed2100_0E), SDOed2100_0E},
+  {sizeof(SDOed2100_0F), SDOed2100_0F},
+  {sizeof(SDOed2100_10), SDOed2100_10},
+  {sizeof(SDOed2100_11), SDOed2100_11},
+  {sizeof(SDOed2100_12), SDOed2100_12},
+  {sizeof(SDOed2100_13), SDOed2100_13},
+  {sizeof(SDOed2100_14), SDOed2100_14},
+  {sizeof(SDOed2100_15), SDOed2100_15},
+  {sizeof(SDOed2100_16), SDOed2100_16},
+  {sizeof(SDOed2100_17), SDOed2100_17},
+  {sizeof(SDOed2100_18), SDOed2100_18},
+  {sizeof(SDOed2100_19), SDOed2100_19},
+  {sizeof(SDOed2100_1A), SDOed2100_1A},
+  {sizeof(SDOed2100_1B), SDOed2100_1B},
+  {sizeof(SDOed2100_1C), SDOed2100_1C},
+  {sizeof(SDOed2100_1D), SDOed2100_1D},
+  {sizeof(SDOed2100_1E), SDOed2100_1E},
+  {sizeof(SDOed2100_1F), SDOed2100_1F},
+  {sizeof(SDOed2100_20), SDOed2100_20},
+  {sizeof(SDOed2100_21), SDOed2100_21},
+  {sizeof(SDOed2100_22), SDOed2100_22},
+  {sizeof(SDOed2100_23), SDOed2100_23},
+};
+static const _COEinfo SDOed2101[] =
+{
+  {sizeof(SDOed2101_00), SDOed2101_00},
+  {sizeof(SDOed2101_01), SDOed2101_01},
+  {sizeof(SDOed2101_02), SDOed2101_02},
+  {sizeof(SDOed2101_03), SDOed2101_03},
+  {sizeof(SDOed2101_04), SDOed2101_04},
+  {sizeof(SDOed2101_05), SDOed2101_05},
+  {sizeof(SDOed2101_06), SDOed2101_06},
+  {sizeof(SDOed2101_07), SDOed2101_07},
+  {sizeof(SDOed2101_08), SDOed2101_08},
+  {sizeof(SDOed2101_09), SDOed2101_09},
+  {sizeof(SDOed2101_0A), SDOed2101_0A},
+  {sizeof(SDOed2101_0B), SDOed2101_0B},
+  {sizeof(SDOed2101_0C), SDOed2101_0C},
+  {sizeof(SDOed2101_0D), SDOed2101_0D},
+};
+static const _COEinfo SDOed2102[] =
+{
+  {sizeof(SDOed2102_00), SDOed2102_00},
+  {sizeof(SDOed2102_01), SDOed2102_01},
+  {sizeof(SDOed2102_02), SDOed2102_02},
+  {sizeof(SDOed2102_03), SDOed2102_03},
+  {sizeof(SDOed2102_04), SDOed2102_04},
+  {sizeof(SDOed2102_05), SDOed2102_05},
+  {sizeof(SDOed2102_06), SDOed2102_06},
+  {sizeof(SDOed2102_07), SDOed2102_07},
+  {sizeof(SDOed2102_08), SDOed2102_08},
+  {sizeof(SDOed2102_09), SDOed2102_09},
+  {sizeof(SDOed2102_0A), SDOed2102_0A},
+};
+static const _COEinfo SDOed2103[] =
+{
+  {sizeof(SDOed2103_00), SDOed2103_00},
+  {sizeof(SDOed2103_01), SDOed2103_01},
+  {sizeof(SDOed2103_02), SDOed2103_02},
+  {sizeof(SDOed2103_03), SDOed2103_03},
+  {sizeof(SDOed2103_04), SDOed2103_04},
+};
+static const _COEinfo SDOed6000[] =
+{
+  {sizeof(SDOed6000_00), SDOed6000_00},
+  {sizeof(SDOed6000_01), SDOed6000_01},
+  {sizeof(SDOed6000_02), SDOed6000_02},
+  {sizeof(SDOed6000_03), SDOed6000_03},
+  {sizeof(SDOed6000_04), SDOed6000_04},
+  {sizeof(SDOed6000_05), SDOed6000_05},
+  {sizeof(SDOed6000_06), SDOed6000_06},
+  {sizeof(SDOed6000_07), SDOed6000_07},
+  {sizeof(SDOed6000_08), SDOed6000_08},
+};
+static const _COEinfo SDOed7000[] =
+{
+  {sizeof(SDOed7000_00), SDOed7000_00},
+  {sizeof(SDOed7000_01), SDOed7000_01},
+  {sizeof(SDOed7000_02), SDOed7000_02},
+};
+static const _COEinfo SDOed8000[] =
+{
+  {sizeof(SDOed8000_00), SDOed8000_00},
+  {sizeof(SDOed8000_01), SDOed8000_01},
+};
+static const _COEinfo SDOed8001[] =
+{
+  {sizeof(SDOed8001_00), SDOed8001_00},
+  {sizeof(SDOed8001_01), SDOed8001_01},
+  {sizeof(SDOed8001_02), SDOed8001_02},
+  {sizeof(SDOed8001_03), SDOed8001_03},
+  {sizeof(SDOed8001_04), SDOed8001_04},
+  {sizeof(SDOed8001_05), SDOed8001_05},
+  {sizeof(SDOed8001_06), SDOed8001_06},
+  {sizeof(SDOed8001_07), SDOed8001_07},
+  {sizeof(SDOed8001_08), SDOed8001_08},
+  {sizeof(SDOed8001_09), SDOed8001_09},
+  {sizeof(SDOed8001_0A), SDOed8001_0A},
+  {sizeof(SDOed8001_0B), SDOed8001_0B},
+  {sizeof(SDOed8001_0C), SDOed8001_0C},
+  {sizeof(SDOed8001_0D), SDOed8001_0D},
+  {sizeof(SDOed8001_0E), SDOed8001_0E},
+  {sizeof(SDOed8001_0F), SDOed8001_0F},
+  {sizeof(SDOed8001_10), SDOed8001_10},
+};
+static const _COEinfo SDOed8002[] =
+{
+  {sizeof(SDOed8002_00), SDOed8002_00},
+  {sizeof(SDOed8002_01), SDOed8002_01},
+  {sizeof(SDOed8002_02), SDOed8002_02},
+  {sizeof(SDOed8002_03), SDOed8002_03},
+  {sizeof(SDOed8002_04), SDOed8002_04},
+  {sizeof(SDOed8002_05), SDOed8002_05},
+  {sizeof(SDOed8002_06), SDOed8002_06},
+  {sizeof(SDOed8002_07), SDOed8002_07},
+  {sizeof(SDOed8002_08), SDOed8002_08},
+};
+
+const _objectinfo SDOinfo[] =
+{
+  {{sizeof(SDOod1000), SDOod1000}, SDOed1000},
+  {{sizeof(SDOod1001), SDOod1001}, SDOed1001},
+  {{sizeof(SDOod1008), SDOod1008}, SDOed1008},
+  {{sizeof(SDOod1009), SDOod1009}, SDOed1009},
+  {{sizeof(SDOod100A), SDOod100A}, SDOed100A},
+  {{sizeof(SDOod1010), SDOod1010}, SDOed1010},
+  {{sizeof(SDOod1011), SDOod1011}, SDOed1011},
+  {{sizeof(SDOod1018), SDOod1018}, SDOed1018},
+  {{sizeof(SDOod10F3), SDOod10F3}, SDOed10F3},
+  {{sizeof(SDOod1600), SDOod1600}, SDOed1600},
+  {{sizeof(SDOod1A00), SDOod1A00}, SDOed1A00},
+  {{sizeof(SDOod1C00), SDOod1C00}, SDOed1C00},
+  {{sizeof(SDOod1C12), SDOod1C12}, SDOed1C12},
+  {{sizeof(SDOod1C13), SDOod1C13}, SDOed1C13},
+  {{sizeof(SDOod2100), SDOod2100}, SDOed2100},
+  {{sizeof(SDOod2101), SDOod2101}, SDOed2101},
+  {{sizeof(SDOod2102), SDOod2102}, SDOed2102},
+  {{sizeof(SDOod2103), SDOod2103}, SDOed2103},
+  {{sizeof(SDOod6000), SDOod6000}, SDOed6000},
+  {{sizeof(SDOod7000), SDOod7000}, SDOed7000},
+  {{sizeof(SDOod8000), SDOod8000}, SDOed8000},
+  {{sizeof(SDOod8001), SDOod8001}, SDOed8001},
+  {{sizeof(SDOod8002), SDOod8002}, SDOed8002},
+};
+
+void objectlistTxPDOShadowUpdate(void) {
+	middleSOESReadBufferBooleans.ButtonC = middleSOESReadBuffer.NunChuck.ButtonC;
+	middleSOESReadBufferBooleans.ButtonZ = middleSOESReadBuffer.NunChuck.ButtonZ;
+	middleSOESReadBufferBooleans.NunChuckDataValid = middleSOESReadBuffer.NunChuck.NunChuckDataValid;
+}
+
+void objectlistRxPDOShadowUpdate(void) {
+	middleSOESReadBufferBooleans.LED0 = middleSOESWriteBuffer.Digital_outputs.LED0;
+	middleSOESReadBufferBooleans.CaptureTrigger = middleSOESWriteBuffer.Digital_outputs.CaptureTrigger;
+}
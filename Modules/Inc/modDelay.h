@@ -1,6 +1,14 @@
 #include "stm32f3xx_hal.h"
 #include "stdbool.h"
+#include "driverHWECATTickTimer.h"
+
+#define modDelayMicrosecondsPerMillisecond		1000
 
 void modDelayInit(void);
+uint32_t modDelayGetMicroseconds(void);
+uint32_t modDelayDeadlineSet(uint32_t timeoutMicroseconds);
+bool modDelayDeadlineExpired(uint32_t deadline);
+int32_t modDelayDeadlineRemaining(uint32_t deadline);
+uint8_t modDelayTick1us(uint32_t *last, uint32_t ticks);
 uint8_t modDelayTick1ms(uint32_t *last, uint32_t ticks);
 uint8_t modDelayTick100ms(uint32_t *last, uint32_t ticks);
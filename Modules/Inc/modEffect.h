@@ -1,13 +1,12 @@
 #include "modDelay.h"
 #include "driverHWStatus.h"
+#include "driverHWECATTickTimer.h"
+
+#define modEffectFlashPeriod					500000											// us per edge
+#define modEffectFlashFastPeriod			100000
+#define modEffectBlinkShortPeriod			50000
+#define modEffectBlinkLongPeriod			500000
 
 // Public functions:
 void modEffectInit(void);
-void modEffectTask(void);
 void modEffectChangeState(STATIDTypedef id, STATStateTypedef status);
-
-// Private functions:
-STATStateTypedef modEffectTaskFlash(void);
-STATStateTypedef modEffectTaskFlashFast(void);
-STATStateTypedef modEffectTaskBlinkShort(uint32_t LEDPointer, uint32_t blinkTime);
-STATStateTypedef modEffectTaskBlinkLong(uint32_t LEDPointer, uint32_t blinkTime);
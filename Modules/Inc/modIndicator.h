@@ -0,0 +1,11 @@
+#include "modEffect.h"
+
+#define modIndicatorRunLED						STAT_GPIO1
+#define modIndicatorErrorLED					STAT_GPIO2
+
+#define modIndicatorStateMask					0x0F							// AL status state bits
+
+// Public functions:
+void modIndicatorUpdate(uint8_t alStatus, uint16_t alError);
+STATStateTypedef modIndicatorRunState(uint8_t alStatus);
+STATStateTypedef modIndicatorErrorState(uint8_t alStatus, uint16_t alError);
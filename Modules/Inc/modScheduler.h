@@ -0,0 +1,56 @@
+#ifndef __MODSCHEDULER_H
+#define __MODSCHEDULER_H
+
+#include "stm32f3xx_hal.h"
+#include "stdbool.h"
+#include "modDelay.h"
+#include "driverHWECATTickTimer.h"
+
+#define modSchedulerMaxTasks						8
+#define modSchedulerNoTask							-1
+#define modSchedulerSleepWhenIdle				true																	// Default, modSchedulerSetSleepWhenIdle changes it
+#define modSchedulerMinimumSleepTime		20																		// us, closer releases are spun out instead of slept
+
+typedef enum {
+	SCHEDULER_PERIODIC = 0,																								// Released every period, a trigger releases it early
+	SCHEDULER_EVENT																												// Released by modSchedulerTrigger, e.g. from an ISR
+} modSchedulerTriggerTypedef;
+
+typedef struct {
+	const char *Name;
+	void (*Function)(void);
+	modSchedulerTriggerTypedef Trigger;
+	uint8_t Priority;																											// 0 is the highest priority
+	uint32_t Period;																											// Release period in us, periodic tasks only
+	uint32_t Budget;																											// Allowed execution time in us, 0 = unlimited
+	uint32_t NextRelease;																									// us timestamp of the next release
+	volatile bool EventPending;
+	volatile uint32_t EventTime;																					// us timestamp of the oldest pending trigger
+	uint32_t RunCount;
+	uint32_t DeadlineMisses;																							// Started after its deadline (release + period)
+	uint32_t BudgetOverruns;																							// Ran longer than its budget
+	uint32_t WorstExecutionTime;																					// us
+	uint32_t WorstReleaseLatency;																					// us between release and start
+} modSchedulerTaskStruct;
+
+typedef struct {
+	uint32_t SleepCount;
+	uint32_t SleepTime;																										// us spent in WFI
+	uint32_t WakeCount;																										// Wakeups that released a task by trigger
+	uint32_t LastWakeLatency;																							// us from trigger to service start after a sleep
+	uint32_t WorstWakeLatency;
+} modSchedulerIdleStruct;
+
+// Public functions:
+void modSchedulerInit(void);
+int8_t modSchedulerAddPeriodicTask(const char *name, void (*function)(void), uint8_t priority, uint32_t period, uint32_t budget);
+int8_t modSchedulerAddEventTask(const char *name, void (*function)(void), uint8_t priority, uint32_t budget);
+void modSchedulerTrigger(int8_t taskHandle);
+bool modSchedulerRunNext(void);
+void modSchedulerTask(void);
+const modSchedulerTaskStruct *modSchedulerGetTask(int8_t taskHandle);
+const modSchedulerIdleStruct *modSchedulerGetIdle(void);
+void modSchedulerResetStatistics(void);
+void modSchedulerSetSleepWhenIdle(bool sleep);
+
+#endif
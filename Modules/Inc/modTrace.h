@@ -0,0 +1,73 @@
+#ifndef __MODTRACE_H
+#define __MODTRACE_H
+
+#include <string.h>
+#include "stm32f3xx_hal.h"
+#include "stdbool.h"
+#include "modDelay.h"
+
+// Binary event trace. Records go into a fixed ring in RAM and are never formatted on the target, logging one is a
+// slot claim with an exclusive load/store pair, a timer read and four stores, so it can be called from any
+// ISR or task. A writer interrupted by another one simply keeps the slot it claimed first. Sequence is stored last: a
+// record whose Sequence does not match its position was still being written, or was overwritten while it was read.
+//
+//	Export		modTraceHeaderStruct, then Records modTraceRecordStruct oldest first
+//	Time		modDelay us (TIM2, counts on in WFI), wraps every ~71 minutes. TRACE_TIME records mark the wraps
+
+#define modTraceMagic													0x43525444												// "DTRC"
+#define modTraceFormat												2																	// 1 had DWT cycles, frozen while asleep
+#define modTraceRecords												256																// Power of two, 4kB
+#define modTraceTimeMarkPeriod								10000000													// us, well within a wrap
+#define modTraceTicksPerMicrosecond						1
+
+typedef enum {
+	TRACE_NONE = 0,
+	TRACE_TIME,																																					// Arg0 modDelay us, Arg1 Time ticks per us
+	TRACE_AL_STATUS = 0x10,																															// Arg0 new AL status, Arg1 previous one
+	TRACE_AL_ERROR,																																			// Arg0 AL status code, Arg1 AL status
+	TRACE_PDI_ERROR,																																		// Arg0 ESC address, Arg1 PDI status of the last attempt
+	TRACE_MBX_ERROR = 0x20,																															// Arg0 mailbox error code
+	TRACE_SDO_ABORT,																																		// Arg0 index << 8 | subindex, Arg1 abort code
+	TRACE_FOE_ABORT,																																		// Arg0 FoE error code
+	TRACE_EOE_DROPPED,																																	// Arg0 bytes of the frame received so far, Arg1 its next fragment number
+	TRACE_EMCY_DROPPED,																																	// Arg0 error code of the emergency given up, Arg1 emergencies waiting
+	TRACE_I2C_ERROR = 0x30,																															// Arg0 address byte << 16 | HAL status, Arg1 HAL error code
+	TRACE_NUNCHUCK_DROPOUT																															// Arg0 valid samples since the last dropout
+} modTraceEventTypedef;
+
+typedef struct {
+	uint32_t Time;																																			// modDelay us
+	uint16_t Event;																																			// modTraceEventTypedef
+	uint16_t Sequence;																																	// Low half of the record number, written last
+	uint32_t Arg0;
+	uint32_t Arg1;
+} modTraceRecordStruct;
+
+typedef struct {
+	uint32_t Magic;
+	uint16_t Format;
+	uint16_t RecordSize;
+	uint32_t Records;																																		// Following this header
+	uint32_t FirstSequence;																															// Records logged since start-up before the first one in the file
+	uint32_t TicksPerMicrosecond;																												// Of Time
+	uint32_t Time;																																			// Record time when the export started
+	uint32_t Microseconds;																															// modDelay us at the same moment
+	uint32_t Reserved;
+} modTraceHeaderStruct;
+
+typedef struct {
+	uint32_t FirstSequence;
+	uint32_t Records;
+	uint32_t Time;
+	uint32_t Microseconds;
+} modTraceSnapshotStruct;
+
+void modTraceInit(void);
+void modTraceEvent(uint16_t event, uint32_t arg0, uint32_t arg1);
+void modTraceTask(void);
+void modTraceSnapshot(modTraceSnapshotStruct *snapshot);
+void modTraceSnapshotSince(modTraceSnapshotStruct *snapshot, uint32_t sequence);
+uint32_t modTraceSnapshotSize(const modTraceSnapshotStruct *snapshot);
+uint32_t modTraceRead(const modTraceSnapshotStruct *snapshot, uint32_t offset, uint8_t *data, uint32_t length);
+
+#endif
@@ -1,40 +1,61 @@
 #include "modDelay.h"
 
-static uint32_t hmsCnt = 0;
+// The time base is the free running 1MHz TIM2 counter, the same one the scheduler wakeup and the alarms are armed on.
+// It keeps counting while the core sleeps in WFI, the DWT cycle counter does not and is only used for short
+// measurements while awake. It wraps every ~71 minutes, all comparisons are done on the unsigned difference so the
+// wrap is harmless.
 
 void modDelayInit(void) {
 	/* Already handled in main file sysclock init.
 	SystemCoreClockUpdate();
-	
+
 	//SystemCoreClock / 1000
 	if(SysTick_Config(72000)){
 		while(1); //Error setting SysTick.
 	}
 	*/
-	
+
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;														// Enable the trace unit
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;																			// Start the cycle counter
+	driverHWECATTickTimerInit();																							// Starts TIM2 once, later calls leave it running
 }
 
-uint8_t modDelayTick1ms(uint32_t *last, uint32_t ticks) {
-	if((uint32_t)(HAL_GetTick() - *last) >= ticks)
-	{
-		*last = HAL_GetTick();
-		return true;
-	}
+uint32_t modDelayGetMicroseconds(void) {
+	return driverHWECATTickTimerGetTimerValue();															// A single register read, safe from ISR and task context
+}
 
-	return false;
+uint32_t modDelayDeadlineSet(uint32_t timeoutMicroseconds) {
+	return modDelayGetMicroseconds() + timeoutMicroseconds;
 }
 
-uint8_t modDelayTick100ms(uint32_t *last, uint32_t ticks) {
-	static uint32_t msTicks = 0;
+bool modDelayDeadlineExpired(uint32_t deadline) {
+	return ((int32_t)(modDelayGetMicroseconds() - deadline) >= 0);						// Overflow safe as long as deadlines lie < 35 minutes ahead
+}
 
-	if(modDelayTick1ms(&msTicks,99))
-		hmsCnt++;
+int32_t modDelayDeadlineRemaining(uint32_t deadline) {
+	return (int32_t)(deadline - modDelayGetMicroseconds());										// Negative when the deadline is already passed
+}
+
+uint8_t modDelayTick1us(uint32_t *last, uint32_t ticks) {
+	uint32_t now = modDelayGetMicroseconds();
+	uint32_t elapsed = now - *last;
 
-	if((uint32_t)(hmsCnt - *last) >= ticks)
-	{
-		*last = hmsCnt;
+	if(elapsed >= ticks) {
+		if(elapsed >= (ticks << 1))
+			*last = now;																													// Fell behind more than a period, resync instead of bursting
+		else
+			*last += ticks;																												// Keep the period free of drift
 		return true;
 	}
 
 	return false;
 }
+
+// The millisecond variants share the microsecond time base, *last holds a microsecond timestamp.
+uint8_t modDelayTick1ms(uint32_t *last, uint32_t ticks) {
+	return modDelayTick1us(last,ticks*modDelayMicrosecondsPerMillisecond);
+}
+
+uint8_t modDelayTick100ms(uint32_t *last, uint32_t ticks) {
+	return modDelayTick1us(last,ticks*100*modDelayMicrosecondsPerMillisecond);
+}
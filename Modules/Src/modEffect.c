@@ -1,134 +1,165 @@
 #include "modEffect.h"
 
+// Effects run from the TIM2 alarm, it only fires when the next LED edge is due. Every LED keeps its own timing. Edge
+// times come from modDelayGetMicroseconds, which reads the TIM2 counter, and the alarm is armed at the edge time itself.
 STATStatusStruct STATStatuses[NoOfSTATs] = 								// Hold all STAT StateIndicator data
 {
-	{STAT_OFF,0},																						// STAT_LED_DEBUG
-	{STAT_OFF,0},																						// GPIO0
-	{STAT_OFF,0},																						// GPIO1
-	{STAT_OFF,0}																						// GPIO2	
+	{STAT_OFF,0,STAT_RESET,0,false,0},												// STAT_LED_DEBUG
+	{STAT_OFF,0,STAT_RESET,0,false,0},												// GPIO0
+	{STAT_OFF,0,STAT_RESET,0,false,0},												// GPIO1
+	{STAT_OFF,0,STAT_RESET,0,false,0}													// GPIO2	
 };
 
+static void modEffectAlarmHandler(void);
+static void modEffectUpdate(uint32_t now);
+static STATStateTypedef modEffectStep(uint32_t LEDPointer, uint32_t now);
+static STATStateTypedef modEffectToggle(uint32_t LEDPointer, uint32_t now, uint32_t period);
+static STATStateTypedef modEffectBlink(uint32_t LEDPointer, uint32_t now, uint32_t blinkTime, uint32_t maxCycles);
+static STATStateTypedef modEffectPattern(uint32_t LEDPointer, uint32_t now, const uint32_t *pattern, uint8_t noOfSteps);
+
+// On/off step durations in us, even steps are on. Timing as in ETG.1300.
+static const uint32_t modEffectPatternFlicker[] = {50000,50000};
+static const uint32_t modEffectPatternBlinking[] = {200000,200000};
+static const uint32_t modEffectPatternSingleFlash[] = {200000,1000000};
+static const uint32_t modEffectPatternDoubleFlash[] = {200000,200000,200000,1000000};
+
 void modEffectInit(void) {
 	driverHWStatusInit();																		// Init GPIO direction and state
 	modDelayInit();																					// Init delay mechanism
+	driverHWECATTickTimerInit();														// Edges are timed by the free running TIM2
+	driverHWECATTickTimerBindAlarmFunction(&modEffectAlarmHandler);
 }
 
 void modEffectChangeState(STATIDTypedef id, STATStateTypedef NewState) {
+	uint32_t primaskState = __get_PRIMASK();								// The alarm ISR walks the same table
+	__disable_irq();
+	
 	if(STATStatuses[id].State != NewState) {
 		STATStatuses[id].State = NewState;
 		STATStatuses[id].Count = 1;
+		STATStatuses[id].Phase = 0;
+		STATStatuses[id].EdgePending = true;									// Apply right away
+		STATStatuses[id].NextEdge = modDelayGetMicroseconds();
+		modEffectUpdate(STATStatuses[id].NextEdge);
 	}else{
 		STATStatuses[id].Count++;
+		if(!STATStatuses[id].EdgePending && ((NewState == STAT_BLINKSHORT) || (NewState == STAT_BLINKLONG))) {
+			STATStatuses[id].EdgePending = true;								// Idle blinker got new cycles
+			STATStatuses[id].NextEdge = modDelayGetMicroseconds();
+			modEffectUpdate(STATStatuses[id].NextEdge);
+		}
 	}
+	
+	__set_PRIMASK(primaskState);
+}
+
+static void modEffectAlarmHandler(void) {
+	modEffectUpdate(modDelayGetMicroseconds());
 }
 
-void modEffectTask(void) {
+// Steps every LED with a due edge, writes the changed pins in one batch and arms the alarm for the earliest next edge.
+static void modEffectUpdate(uint32_t now) {
 	uint32_t LEDPointer;
+	uint32_t setMask = 0, resetMask = 0;
+	int32_t nextEdgeDelay = INT32_MAX;
+	uint32_t nextEdge = 0;
 	
 	for(LEDPointer = 0; LEDPointer < NoOfSTATs; LEDPointer++) {
-		switch(STATStatuses[LEDPointer].State) {
-			case STAT_RESET:
-			case STAT_OFF:
-				driverHWSetOutput((STATIDTypedef)LEDPointer,STAT_RESET);
-				break;
-			case STAT_SET:
-			case STAT_ON:
-				driverHWSetOutput((STATIDTypedef)LEDPointer,STAT_SET);
-				break;
-			case STAT_FLASH:
-				driverHWSetOutput((STATIDTypedef)LEDPointer,modEffectTaskFlash());
-				break;
-			case STAT_FLASH_FAST:
-				driverHWSetOutput((STATIDTypedef)LEDPointer,modEffectTaskFlashFast());
-				break;
-			case STAT_BLINKSHORT:
-				driverHWSetOutput((STATIDTypedef)LEDPointer,modEffectTaskBlinkShort(LEDPointer,50));
-				break;
-			case STAT_BLINKLONG:
-				driverHWSetOutput((STATIDTypedef)LEDPointer,modEffectTaskBlinkLong(LEDPointer,500));
-				break;
-			default:
-				break;
+		if(!STATStatuses[LEDPointer].EdgePending)
+			continue;
+		
+		if((int32_t)(now - STATStatuses[LEDPointer].NextEdge) >= 0) {
+			STATStateTypedef newOutput = modEffectStep(LEDPointer,now);
+			if(newOutput != STATStatuses[LEDPointer].Output) {
+				STATStatuses[LEDPointer].Output = newOutput;
+				if(newOutput == STAT_SET)
+					setMask |= 1 << LEDPointer;
+				else
+					resetMask |= 1 << LEDPointer;
+			}
 		}
-	}
-}
-
-STATStateTypedef modEffectTaskFlash(void) {
-	static uint32_t lastTick;
-	static STATStateTypedef LEDOnState = STAT_RESET;
-	
-	if(modDelayTick100ms(&lastTick,5)) {
-		if(LEDOnState){
-			LEDOnState = STAT_RESET;
-		}else{
-			LEDOnState = STAT_SET;
+		
+		if(STATStatuses[LEDPointer].EdgePending && ((int32_t)(STATStatuses[LEDPointer].NextEdge - now) < nextEdgeDelay)) {
+			nextEdgeDelay = (int32_t)(STATStatuses[LEDPointer].NextEdge - now);
+			nextEdge = STATStatuses[LEDPointer].NextEdge;
 		}
 	}
 	
-	return LEDOnState;
+	if(setMask | resetMask)
+		driverHWSetOutputs(setMask,resetMask);
+	
+	if(nextEdgeDelay != INT32_MAX)
+		driverHWECATTickTimerSetAlarmAt(nextEdge);																// Time spent since now does not shift the edge
+	else
+		driverHWECATTickTimerCancelAlarm();
 }
 
-STATStateTypedef modEffectTaskFlashFast(void) {
-	static uint32_t lastTick;
-	static STATStateTypedef LEDOnState = STAT_RESET;
-	
-	if(modDelayTick1ms(&lastTick,100)) {
-		if(LEDOnState){
-			LEDOnState = STAT_RESET;
-		}else{
-			LEDOnState = STAT_SET;
-		}
+static STATStateTypedef modEffectStep(uint32_t LEDPointer, uint32_t now) {
+	switch(STATStatuses[LEDPointer].State) {
+		case STAT_SET:
+		case STAT_ON:
+			STATStatuses[LEDPointer].EdgePending = false;
+			return STAT_SET;
+		case STAT_FLASH:
+			return modEffectToggle(LEDPointer,now,modEffectFlashPeriod);
+		case STAT_FLASH_FAST:
+			return modEffectToggle(LEDPointer,now,modEffectFlashFastPeriod);
+		case STAT_BLINKSHORT:
+			return modEffectBlink(LEDPointer,now,modEffectBlinkShortPeriod,MAX_BLINKSHORT_CYCLES);
+		case STAT_BLINKLONG:
+			return modEffectBlink(LEDPointer,now,modEffectBlinkLongPeriod,MAX_BLINKLONG_CYCLES);
+		case STAT_FLICKER:
+			return modEffectPattern(LEDPointer,now,modEffectPatternFlicker,2);
+		case STAT_BLINKING:
+			return modEffectPattern(LEDPointer,now,modEffectPatternBlinking,2);
+		case STAT_SINGLE_FLASH:
+			return modEffectPattern(LEDPointer,now,modEffectPatternSingleFlash,2);
+		case STAT_DOUBLE_FLASH:
+			return modEffectPattern(LEDPointer,now,modEffectPatternDoubleFlash,4);
+		case STAT_RESET:
+		case STAT_OFF:
+		default:
+			STATStatuses[LEDPointer].EdgePending = false;
+			return STAT_RESET;
 	}
+}
+
+static STATStateTypedef modEffectToggle(uint32_t LEDPointer, uint32_t now, uint32_t period) {
+	if((now - STATStatuses[LEDPointer].NextEdge) >= period)
+		STATStatuses[LEDPointer].NextEdge = now + period;									// Fell behind, resync instead of bursting
+	else
+		STATStatuses[LEDPointer].NextEdge += period;										// Keep the period free of drift
 	
-	return LEDOnState;
+	return (STATStatuses[LEDPointer].Output == STAT_SET) ? STAT_RESET : STAT_SET;
 }
 
-STATStateTypedef modEffectTaskBlinkShort(uint32_t LEDPointer, uint32_t blinkTime) {
-	static uint32_t lastTick;
-	static STATStateTypedef LEDOnState = STAT_RESET;
+static STATStateTypedef modEffectBlink(uint32_t LEDPointer, uint32_t now, uint32_t blinkTime, uint32_t maxCycles) {
+	STATStatuses[LEDPointer].NextEdge = now + blinkTime;
 	
-	if(LEDOnState) {
-		if(modDelayTick1ms(&lastTick,blinkTime)) {
-			LEDOnState = STAT_RESET;
-			lastTick = HAL_GetTick();
-		}
-	}else{
-		if(modDelayTick1ms(&lastTick,blinkTime)) {
-			if(STATStatuses[LEDPointer].Count > MAX_BLINKSHORT_CYCLES) {
-				STATStatuses[LEDPointer].Count = MAX_BLINKSHORT_CYCLES;
-			}
-			if(STATStatuses[LEDPointer].Count > 0) {
-				STATStatuses[LEDPointer].Count--;
-				LEDOnState = STAT_SET;
-			}
-			lastTick = HAL_GetTick();
-		}
+	if(STATStatuses[LEDPointer].Output == STAT_SET)
+		return STAT_RESET;																							// On time is over, off time follows
+	
+	if(STATStatuses[LEDPointer].Count > maxCycles)
+		STATStatuses[LEDPointer].Count = maxCycles;
+	
+	if(STATStatuses[LEDPointer].Count > 0) {
+		STATStatuses[LEDPointer].Count--;
+		return STAT_SET;
 	}
 	
-	return LEDOnState;
+	STATStatuses[LEDPointer].EdgePending = false;													// Nothing left to blink, idle until new cycles
+	return STAT_RESET;
 }
 
-STATStateTypedef modEffectTaskBlinkLong(uint32_t LEDPointer, uint32_t blinkTime) {
-	static uint32_t lastTick;
-	static STATStateTypedef LEDOnState = STAT_RESET;
+static STATStateTypedef modEffectPattern(uint32_t LEDPointer, uint32_t now, const uint32_t *pattern, uint8_t noOfSteps) {
+	uint8_t phase = STATStatuses[LEDPointer].Phase;
 	
-	if(LEDOnState) {
-		if(modDelayTick1ms(&lastTick,blinkTime)) {
-			LEDOnState = STAT_RESET;
-			lastTick = HAL_GetTick();
-		}
-	}else{
-		if(modDelayTick1ms(&lastTick,blinkTime)) {
-			if(STATStatuses[LEDPointer].Count > MAX_BLINKLONG_CYCLES) {
-				STATStatuses[LEDPointer].Count = MAX_BLINKLONG_CYCLES;
-			}
-			if(STATStatuses[LEDPointer].Count > 0) {
-				STATStatuses[LEDPointer].Count--;
-				LEDOnState = STAT_SET; 
-			}
-			lastTick = HAL_GetTick();
-		}
-	}
+	if((now - STATStatuses[LEDPointer].NextEdge) >= pattern[phase])
+		STATStatuses[LEDPointer].NextEdge = now + pattern[phase];							// Fell behind, resync instead of bursting
+	else
+		STATStatuses[LEDPointer].NextEdge += pattern[phase];								// Keep the pattern free of drift
+	
+	STATStatuses[LEDPointer].Phase = (phase + 1) % noOfSteps;
 	
-	return LEDOnState;
+	return (phase & 1) ? STAT_RESET : STAT_SET;
 }
@@ -0,0 +1,47 @@
+#include "modIndicator.h"
+#include "esc.h"
+
+// ETG.1300 RUN and ERR indicators, fed with every AL status or AL status code write.
+void modIndicatorUpdate(uint8_t alStatus, uint16_t alError) {
+	modEffectChangeState(modIndicatorRunLED,modIndicatorRunState(alStatus));
+	modEffectChangeState(modIndicatorErrorLED,modIndicatorErrorState(alStatus,alError));
+}
+
+STATStateTypedef modIndicatorRunState(uint8_t alStatus) {
+	switch(alStatus & modIndicatorStateMask) {
+		case ESCpreop:
+			return STAT_BLINKING;
+		case ESCboot:
+			return STAT_FLICKER;
+		case ESCsafeop:
+			return STAT_SINGLE_FLASH;
+		case ESCop:
+			return STAT_ON;
+		case ESCinit:
+		default:
+			return STAT_OFF;
+	}
+}
+
+STATStateTypedef modIndicatorErrorState(uint8_t alStatus, uint16_t alError) {
+	if(!(alStatus & ESCerror))
+		return STAT_OFF;
+	
+	switch(alError) {
+		case ALERR_WATCHDOG:																						// Process data watchdog timeout
+			return STAT_DOUBLE_FLASH;
+		case ALERR_SYNCERROR:																						// Local errors, the slave changed state by itself
+		case ALERR_FATALSYNCERROR:
+		case ALERR_NOSYNCERROR:
+		case ALERR_SYNC0NOTRECEIVED:
+		case ALERR_SYNC1NOTRECEIVED:
+			return STAT_SINGLE_FLASH;
+		case ALERR_BOOTNOTSUPPORTED:																		// Booting errors
+		case ALERR_INVALIDBOOTMBXCONFIG:
+		case ALERR_EEPROMNOACCESS:
+		case ALERR_EEPROMERROR:
+			return STAT_FLICKER;
+		default:																												// Invalid configuration
+			return STAT_BLINKING;
+	}
+}
@@ -0,0 +1,228 @@
+#include "modScheduler.h"
+
+// Static cooperative scheduler. Tasks are kept sorted on priority, after every task run the
+// selection restarts at the top so a released high priority task always runs before lower ones.
+
+modSchedulerTaskStruct modSchedulerTasks[modSchedulerMaxTasks];
+int8_t modSchedulerHandleToIndex[modSchedulerMaxTasks];
+uint8_t modSchedulerNoOfTasks;
+modSchedulerIdleStruct modSchedulerIdle;
+bool modSchedulerWokeFromSleep;
+bool modSchedulerSleepEnabled = modSchedulerSleepWhenIdle;
+
+static int8_t modSchedulerAddTask(const char *name, void (*function)(void), modSchedulerTriggerTypedef trigger, uint8_t priority, uint32_t period, uint32_t budget);
+static bool modSchedulerTaskReady(modSchedulerTaskStruct *task, uint32_t now);
+static void modSchedulerSleep(void);
+
+void modSchedulerInit(void) {
+	uint8_t taskPointer;
+
+	modDelayInit();																												// Scheduler runs on the us time base
+	driverHWECATTickTimerInit();																					// Its free running counter wakes us from WFI
+	modSchedulerNoOfTasks = 0;
+	modSchedulerWokeFromSleep = false;
+
+	for(taskPointer = 0; taskPointer < modSchedulerMaxTasks; taskPointer++)
+		modSchedulerHandleToIndex[taskPointer] = modSchedulerNoTask;
+}
+
+int8_t modSchedulerAddPeriodicTask(const char *name, void (*function)(void), uint8_t priority, uint32_t period, uint32_t budget) {
+	return modSchedulerAddTask(name,function,SCHEDULER_PERIODIC,priority,period,budget);
+}
+
+int8_t modSchedulerAddEventTask(const char *name, void (*function)(void), uint8_t priority, uint32_t budget) {
+	return modSchedulerAddTask(name,function,SCHEDULER_EVENT,priority,0,budget);
+}
+
+void modSchedulerTrigger(int8_t taskHandle) {
+	if((taskHandle < 0) || (taskHandle >= modSchedulerNoOfTasks))
+		return;
+
+	modSchedulerTaskStruct *task = &modSchedulerTasks[modSchedulerHandleToIndex[taskHandle]];
+	if(!task->EventPending)
+		task->EventTime = modDelayGetMicroseconds();														// Latency counts from the first trigger
+	task->EventPending = true;
+}
+
+bool modSchedulerRunNext(void) {
+	uint8_t taskPointer;
+	uint32_t now = modDelayGetMicroseconds();
+
+	for(taskPointer = 0; taskPointer < modSchedulerNoOfTasks; taskPointer++) {
+		modSchedulerTaskStruct *task = &modSchedulerTasks[taskPointer];
+
+		if(!modSchedulerTaskReady(task,now))
+			continue;
+
+		uint32_t releaseLatency;
+		if(task->EventPending) {
+			releaseLatency = now - task->EventTime;
+			task->EventPending = false;																					// Clear before running so a new event during the run is kept
+			if(task->Trigger == SCHEDULER_PERIODIC)
+				task->NextRelease = now + task->Period;														// The period is a fallback, restart it
+
+			if(modSchedulerWokeFromSleep) {
+				modSchedulerIdle.WakeCount++;
+				modSchedulerIdle.LastWakeLatency = releaseLatency;
+				if(releaseLatency > modSchedulerIdle.WorstWakeLatency)
+					modSchedulerIdle.WorstWakeLatency = releaseLatency;
+			}
+		}else{
+			releaseLatency = now - task->NextRelease;
+			if(releaseLatency >= task->Period) {
+				task->DeadlineMisses++;																						// Deadline is the next release
+				task->NextRelease = now + task->Period;														// Skip the lost releases instead of bursting
+			}else{
+				task->NextRelease += task->Period;
+			}
+		}
+
+		modSchedulerWokeFromSleep = false;
+		if(releaseLatency > task->WorstReleaseLatency)
+			task->WorstReleaseLatency = releaseLatency;
+
+		task->Function();
+
+		uint32_t executionTime = modDelayGetMicroseconds() - now;
+		task->RunCount++;
+		if(executionTime > task->WorstExecutionTime)
+			task->WorstExecutionTime = executionTime;
+		if(task->Budget && (executionTime > task->Budget))
+			task->BudgetOverruns++;
+
+		return true;																													// Re-evaluate from the highest priority
+	}
+
+	return false;
+}
+
+void modSchedulerTask(void) {
+	if(!modSchedulerRunNext() && modSchedulerSleepEnabled)
+		modSchedulerSleep();
+}
+
+const modSchedulerTaskStruct *modSchedulerGetTask(int8_t taskHandle) {
+	if((taskHandle < 0) || (taskHandle >= modSchedulerNoOfTasks))
+		return NULL;
+
+	return &modSchedulerTasks[modSchedulerHandleToIndex[taskHandle]];
+}
+
+void modSchedulerResetStatistics(void) {
+	uint8_t taskPointer;
+
+	for(taskPointer = 0; taskPointer < modSchedulerNoOfTasks; taskPointer++) {
+		modSchedulerTasks[taskPointer].RunCount = 0;
+		modSchedulerTasks[taskPointer].DeadlineMisses = 0;
+		modSchedulerTasks[taskPointer].BudgetOverruns = 0;
+		modSchedulerTasks[taskPointer].WorstExecutionTime = 0;
+		modSchedulerTasks[taskPointer].WorstReleaseLatency = 0;
+	}
+
+	modSchedulerIdle.SleepCount = 0;
+	modSchedulerIdle.SleepTime = 0;
+	modSchedulerIdle.WakeCount = 0;
+	modSchedulerIdle.LastWakeLatency = 0;
+	modSchedulerIdle.WorstWakeLatency = 0;
+}
+
+// Spinning instead of sleeping gives the reference for the wake latency.
+void modSchedulerSetSleepWhenIdle(bool sleep) {
+	modSchedulerSleepEnabled = sleep;
+}
+
+const modSchedulerIdleStruct *modSchedulerGetIdle(void) {
+	return &modSchedulerIdle;
+}
+
+static int8_t modSchedulerAddTask(const char *name, void (*function)(void), modSchedulerTriggerTypedef trigger, uint8_t priority, uint32_t period, uint32_t budget) {
+	uint8_t taskPointer, handlePointer;
+	int8_t newHandle;
+
+	if(!function || (modSchedulerNoOfTasks >= modSchedulerMaxTasks))
+		return modSchedulerNoTask;
+
+	if((trigger == SCHEDULER_PERIODIC) && !period)
+		period = 1;																													// A zero period would starve every lower priority
+
+	// Insert behind all tasks of equal or higher priority
+	taskPointer = modSchedulerNoOfTasks;
+	while((taskPointer > 0) && (modSchedulerTasks[taskPointer-1].Priority > priority)) {
+		modSchedulerTasks[taskPointer] = modSchedulerTasks[taskPointer-1];
+		taskPointer--;
+	}
+
+	for(handlePointer = 0; handlePointer < modSchedulerNoOfTasks; handlePointer++) {
+		if(modSchedulerHandleToIndex[handlePointer] >= taskPointer)
+			modSchedulerHandleToIndex[handlePointer]++;
+	}
+
+	modSchedulerTaskStruct *task = &modSchedulerTasks[taskPointer];
+	task->Name = name;
+	task->Function = function;
+	task->Trigger = trigger;
+	task->Priority = priority;
+	task->Period = period;
+	task->Budget = budget;
+	task->NextRelease = modDelayGetMicroseconds();
+	task->EventPending = false;
+	task->EventTime = 0;
+	task->RunCount = 0;
+	task->DeadlineMisses = 0;
+	task->BudgetOverruns = 0;
+	task->WorstExecutionTime = 0;
+	task->WorstReleaseLatency = 0;
+
+	newHandle = modSchedulerNoOfTasks++;
+	modSchedulerHandleToIndex[newHandle] = taskPointer;
+
+	return newHandle;
+}
+
+static bool modSchedulerTaskReady(modSchedulerTaskStruct *task, uint32_t now) {
+	if(task->EventPending)
+		return true;
+
+	if(task->Trigger == SCHEDULER_EVENT)
+		return false;
+
+	return ((int32_t)(now - task->NextRelease) >= 0);
+}
+
+// Sleep until the next periodic release or any interrupt (ESC IRQ, SYNC0, SysTick, USB). Interrupts are masked
+// while deciding, WFI still wakes on a pending interrupt so a trigger arriving after the check is never slept through.
+// The sleep length, the wakeup compare and the time slept are all on TIM2, which counts on while the core is stopped.
+static void modSchedulerSleep(void) {
+	uint8_t taskPointer;
+	int32_t sleepTime = INT32_MAX;
+
+	__disable_irq();
+	uint32_t now = modDelayGetMicroseconds();
+
+	for(taskPointer = 0; taskPointer < modSchedulerNoOfTasks; taskPointer++) {
+		modSchedulerTaskStruct *task = &modSchedulerTasks[taskPointer];
+
+		if(modSchedulerTaskReady(task,now)) {
+			sleepTime = 0;
+			break;
+		}
+
+		if((task->Trigger == SCHEDULER_PERIODIC) && ((int32_t)(task->NextRelease - now) < sleepTime))
+			sleepTime = (int32_t)(task->NextRelease - now);
+	}
+
+	if(sleepTime >= modSchedulerMinimumSleepTime) {
+		if(sleepTime != INT32_MAX)
+			driverHWECATTickTimerSetWakeup(sleepTime);
+
+		__DSB();
+		__WFI();
+
+		driverHWECATTickTimerCancelWakeup();
+		modSchedulerIdle.SleepCount++;
+		modSchedulerIdle.SleepTime += modDelayGetMicroseconds() - now;
+		modSchedulerWokeFromSleep = true;
+	}
+
+	__enable_irq();																												// The waking interrupt is serviced here
+}
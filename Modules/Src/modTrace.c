@@ -0,0 +1,99 @@
+#include "modTrace.h"
+
+static modTraceRecordStruct modTraceRing[modTraceRecords];
+static volatile uint32_t modTraceHead = 0;																		// Records claimed since start-up
+static uint32_t modTraceTimeMarkLastTick = 0;
+
+void modTraceInit(void) {
+	memset(modTraceRing,0,sizeof(modTraceRing));
+	modTraceHead = 0;
+
+	modTraceTimeMarkLastTick = modDelayGetMicroseconds();
+	modTraceEvent(TRACE_TIME,modTraceTimeMarkLastTick,modTraceTicksPerMicrosecond);
+}
+
+void modTraceEvent(uint16_t event, uint32_t arg0, uint32_t arg1) {
+	uint32_t sequence;
+
+	do {
+		sequence = __LDREXW(&modTraceHead);
+	} while(__STREXW(sequence + 1,&modTraceHead));																	// Retried only when an ISR logged in between
+
+	volatile modTraceRecordStruct *record = &modTraceRing[sequence & (modTraceRecords - 1)];
+	record->Time = modDelayGetMicroseconds();
+	record->Event = event;
+	record->Arg0 = arg0;
+	record->Arg1 = arg1;
+	record->Sequence = (uint16_t)sequence;
+}
+
+// Keeps the timestamps decodable across their wraps, also when nothing else is logged for a while.
+void modTraceTask(void) {
+	if(modDelayTick1us(&modTraceTimeMarkLastTick,modTraceTimeMarkPeriod))
+		modTraceEvent(TRACE_TIME,modDelayGetMicroseconds(),modTraceTicksPerMicrosecond);
+}
+
+// Fixes the records an export covers. Records logged after this are left for the next export, the oldest ones may
+// still be overwritten while it is read, their Sequence tells the decoder.
+void modTraceSnapshot(modTraceSnapshotStruct *snapshot) {
+	uint32_t head = modTraceHead;
+
+	snapshot->Records = (head < modTraceRecords) ? head : modTraceRecords;
+	snapshot->FirstSequence = head - snapshot->Records;
+	snapshot->Time = modDelayGetMicroseconds();
+	snapshot->Microseconds = modDelayGetMicroseconds();
+}
+
+// Same, but starting at sequence, for exports that only pass on what is new since their last one.
+void modTraceSnapshotSince(modTraceSnapshotStruct *snapshot, uint32_t sequence) {
+	uint32_t skip;
+
+	modTraceSnapshot(snapshot);
+	if((int32_t)(sequence - snapshot->FirstSequence) > 0) {
+		skip = sequence - snapshot->FirstSequence;
+		if(skip > snapshot->Records)
+			skip = snapshot->Records;
+		snapshot->FirstSequence += skip;
+		snapshot->Records -= skip;
+	}
+}
+
+uint32_t modTraceSnapshotSize(const modTraceSnapshotStruct *snapshot) {
+	return sizeof(modTraceHeaderStruct) + snapshot->Records*sizeof(modTraceRecordStruct);
+}
+
+// Copies the export from offset on straight out of the ring, returns the bytes copied, short once it ends.
+uint32_t modTraceRead(const modTraceSnapshotStruct *snapshot, uint32_t offset, uint8_t *data, uint32_t length) {
+	uint32_t size = modTraceSnapshotSize(snapshot);
+	uint32_t copied = 0;
+
+	if(offset >= size)
+		return 0;
+	if(length > size - offset)
+		length = size - offset;
+
+	if(offset < sizeof(modTraceHeaderStruct)) {
+		modTraceHeaderStruct header = {modTraceMagic, modTraceFormat, sizeof(modTraceRecordStruct), snapshot->Records,
+			snapshot->FirstSequence, modTraceTicksPerMicrosecond, snapshot->Time, snapshot->Microseconds, 0};
+		uint32_t chunk = sizeof(modTraceHeaderStruct) - offset;
+		if(chunk > length)
+			chunk = length;
+
+		memcpy(data,(const uint8_t *)&header + offset,chunk);
+		copied = chunk;
+	}
+
+	while(copied < length) {
+		uint32_t position = offset + copied - sizeof(modTraceHeaderStruct);
+		uint32_t within = position % sizeof(modTraceRecordStruct);
+		uint32_t chunk = sizeof(modTraceRecordStruct) - within;
+		if(chunk > length - copied)
+			chunk = length - copied;
+
+		const modTraceRecordStruct *record = &modTraceRing[(snapshot->FirstSequence + position/sizeof(modTraceRecordStruct)) & (modTraceRecords - 1)];
+		memcpy(data + copied,(const uint8_t *)record + within,chunk);
+		copied += chunk;
+	}
+
+	return copied;
+}